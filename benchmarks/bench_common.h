@@ -0,0 +1,122 @@
+#pragma once
+
+// Shared helpers for libigl benchmarks. Every benchmark runs on procedurally
+// generated meshes so that the suite has no data dependencies and sizes can
+// be scaled freely.
+//
+// Run with
+//
+//     ./bench_igl_core --benchmark_out=out.json --benchmark_out_format=json
+//
+// (or build the `run_bench_igl_core` target) to produce JSON that can be
+// diffed across releases (e.g., with google benchmark's tools/compare.py).
+
+#include <igl/ThreadPool.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/triangulated_grid.h>
+#include <igl/tetrahedralized_grid.h>
+
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace bench_common
+{
+  /// Unit sphere mesh built by subdividing an icosahedron until it has at
+  /// least min_faces faces (20·4^k faces)
+  inline void icosphere(
+    const std::int64_t min_faces,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    while(F.rows() < min_faces)
+    {
+      igl::upsample(V,F);
+      V.rowwise().normalize();
+    }
+  }
+
+  /// Regular triangulated grid over the unit square with roughly num_faces
+  /// faces
+  inline void grid_mesh(
+    const std::int64_t num_faces,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    const int side = std::max(2,int(std::sqrt(num_faces/2.0))+1);
+    igl::triangulated_grid(side,side,V,F);
+  }
+
+  /// Regular tetrahedralized grid over the unit cube with roughly num_tets
+  /// tetrahedra
+  inline void tet_grid(
+    const std::int64_t num_tets,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & T)
+  {
+    const int side = std::max(2,int(std::cbrt(num_tets/5.0))+1);
+    igl::tetrahedralized_grid(
+      side,side,side,igl::TETRAHEDRALIZED_GRID_TYPE_5,V,T);
+  }
+
+  /// Register {elements,threads} argument pairs: every size in
+  /// [min_elements,max_elements] (by powers of 10) is paired with 1,2,4,…
+  /// threads up to the hardware concurrency to produce scaling curves.
+  inline void element_and_thread_args(
+    benchmark::internal::Benchmark * b,
+    const std::int64_t min_elements,
+    const std::int64_t max_elements)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"elements","threads"});
+    for(std::int64_t n = min_elements;n<=max_elements;n*=10)
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({n,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+
+  /// Resize igl::default_thread_pool() to state.range(1) threads for the
+  /// lifetime of this object (i.e., one benchmark) and restore the previous
+  /// size afterwards, so that benchmarks without a thread count do not
+  /// depend on which benchmark ran before them.
+  class ScopedNumThreads
+  {
+  public:
+    explicit ScopedNumThreads(const benchmark::State & state):
+      prev(igl::default_thread_pool().num_threads())
+    {
+      resize(static_cast<unsigned int>(state.range(1)));
+    }
+    ~ScopedNumThreads() { resize(prev); }
+    ScopedNumThreads(const ScopedNumThreads &) = delete;
+    ScopedNumThreads & operator=(const ScopedNumThreads &) = delete;
+  private:
+    static void resize(const unsigned int t)
+    {
+      igl::ThreadPool & pool = igl::default_thread_pool();
+      if(pool.num_threads() != t) { pool.resize(t); }
+    }
+    const unsigned int prev;
+  };
+
+  /// Report throughput per element (elements/s) and the problem size.
+  inline void report(benchmark::State & state, const std::int64_t elements)
+  {
+    state.SetItemsProcessed(state.iterations()*elements);
+    state.counters["elements"] = static_cast<double>(elements);
+    state.counters["threads"] =
+      static_cast<double>(igl::default_thread_pool().num_threads());
+  }
+}
@@ -0,0 +1,111 @@
+#include <bench_common.h>
+#include <igl/AABB.h>
+#include <limits>
+
+static void BM_AABB_init(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  for(auto _ : state)
+  {
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F);
+    benchmark::DoNotOptimize(tree.m_box);
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_AABB_init)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,10'000'000)
+  ->Unit(benchmark::kMillisecond);
+
+static void BM_AABB_squared_distance(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // One query per face, uniformly in a box around the sphere
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(F.rows(),3);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  for(auto _ : state)
+  {
+    tree.squared_distance(V,F,P,sqrD,I,C);
+    benchmark::DoNotOptimize(sqrD.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_AABB_squared_distance)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Same queries against a single-precision copy of the mesh
+static void BM_AABB_squared_distance_float(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  igl::AABB<Eigen::MatrixXf,3> tree;
+  tree.init(Vf,F);
+  const Eigen::MatrixXf P = 1.5f*Eigen::MatrixXf::Random(F.rows(),3);
+  Eigen::VectorXf sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXf C;
+  for(auto _ : state)
+  {
+    tree.squared_distance(Vf,F,P,sqrD,I,C);
+    benchmark::DoNotOptimize(sqrD.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_AABB_squared_distance_float)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Coherent primary rays from a pinhole camera, traced with packets of
+// state.range(1) rays (1 means one ray at a time)
+static void BM_AABB_intersect_ray(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  const int w = 512;
+  Eigen::MatrixXd O(w*w,3),D(w*w,3);
+  for(int i = 0;i<w;i++)
+  {
+    for(int j = 0;j<w;j++)
+    {
+      O.row(i*w+j) << 0,0,3;
+      D.row(i*w+j) << -1.5+3.0*(j+0.5)/w, -1.5+3.0*(i+0.5)/w, -3.0;
+    }
+  }
+  Eigen::VectorXi I;
+  Eigen::VectorXd T;
+  Eigen::MatrixXd UV;
+  for(auto _ : state)
+  {
+    tree.intersect_ray(
+      V,F,O,D,std::numeric_limits<double>::infinity(),I,T,UV,
+      static_cast<int>(state.range(1)));
+    benchmark::DoNotOptimize(T.data());
+  }
+  bench_common::report(state,O.rows());
+}
+BENCHMARK(BM_AABB_intersect_ray)
+  ->ArgNames({"elements","packet"})
+  ->ArgsProduct({{10'000,1'000'000},{1,4,8,16}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
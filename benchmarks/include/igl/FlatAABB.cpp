@@ -0,0 +1,75 @@
+#include <bench_common.h>
+#include <igl/FlatAABB.h>
+#include <limits>
+
+static void BM_FlatAABB_init(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  for(auto _ : state)
+  {
+    igl::FlatAABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F);
+    benchmark::DoNotOptimize(tree.m_nodes.data());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_FlatAABB_init)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,10'000'000)
+  ->Unit(benchmark::kMillisecond);
+
+static void BM_FlatAABB_squared_distance(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  igl::FlatAABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // Same queries as BM_AABB_squared_distance
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(F.rows(),3);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  for(auto _ : state)
+  {
+    tree.squared_distance(V,F,P,sqrD,I,C);
+    benchmark::DoNotOptimize(sqrD.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_FlatAABB_squared_distance)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+static void BM_FlatAABB_intersect_ray(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  igl::FlatAABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // One ray per face from random points in a box around the sphere
+  const Eigen::MatrixXd O = 1.5*Eigen::MatrixXd::Random(F.rows(),3);
+  const Eigen::MatrixXd D = Eigen::MatrixXd::Random(F.rows(),3);
+  Eigen::VectorXi I;
+  Eigen::VectorXd T;
+  Eigen::MatrixXd UV;
+  for(auto _ : state)
+  {
+    tree.intersect_ray(
+      V,F,O,D,std::numeric_limits<double>::infinity(),I,T,UV);
+    benchmark::DoNotOptimize(T.data());
+  }
+  bench_common::report(state,O.rows());
+}
+BENCHMARK(BM_FlatAABB_intersect_ray)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
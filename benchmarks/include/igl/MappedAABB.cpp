@@ -0,0 +1,65 @@
+#include <bench_common.h>
+#include <igl/AABB.h>
+#include <igl/MappedAABB.h>
+#include <igl/readAABB.h>
+#include <igl/writeAABB.h>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+  // Write an .aabb file for an icosphere with at least min_faces faces
+  std::string write_icosphere_aabb(const std::int64_t min_faces)
+  {
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    bench_common::icosphere(min_faces,V,F);
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F);
+    const std::string path = (std::filesystem::temp_directory_path()/
+      ("bench_MappedAABB_"+std::to_string(min_faces)+".aabb")).string();
+    igl::writeAABB(path,V,F,tree);
+    return path;
+  }
+}
+
+// Compare with BM_AABB_init: restoring a tree from disk instead of building
+static void BM_readAABB(benchmark::State & state)
+{
+  const std::string path = write_icosphere_aabb(state.range(0));
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  for(auto _ : state)
+  {
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    igl::readAABB(path,V,F,tree);
+    benchmark::DoNotOptimize(tree.m_box);
+  }
+  bench_common::report(state,F.rows());
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_readAABB)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,1'000'000)
+  ->Unit(benchmark::kMillisecond);
+
+static void BM_MappedAABB_open(benchmark::State & state)
+{
+  const std::string path = write_icosphere_aabb(state.range(0));
+  const bool verify_checksum = state.range(1);
+  std::int64_t num_faces = 0;
+  for(auto _ : state)
+  {
+    igl::MappedAABB<double,int> file;
+    file.open(path,verify_checksum);
+    num_faces = file.F().rows();
+    benchmark::DoNotOptimize(file.leaf().data());
+  }
+  bench_common::report(state,num_faces);
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_MappedAABB_open)
+  ->ArgNames({"elements","verify_checksum"})
+  ->ArgsProduct({{10'000,100'000,1'000'000},{0,1}})
+  ->Unit(benchmark::kMillisecond);
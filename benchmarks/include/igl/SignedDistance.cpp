@@ -0,0 +1,81 @@
+#include <bench_common.h>
+#include <igl/SignedDistance.h>
+#include <igl/signed_distance.h>
+#include <thread>
+
+namespace
+{
+  // Pseudonormal and fast winding number signing at 1,2,4,… threads
+  void sign_type_and_thread_args(benchmark::internal::Benchmark * b)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"sign_type","threads"});
+    for(const std::int64_t type : {
+      igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,
+      igl::SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER})
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({type,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+}
+
+// One "timestep" of a simulation querying 10K points against a ~80K triangle
+// deforming collider: calling igl::signed_distance from scratch …
+static void BM_signed_distance_per_step(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(80'000,V,F);
+  const Eigen::MatrixXd P = 1.2*Eigen::MatrixXd::Random(10'000,3);
+  const auto type = static_cast<igl::SignedDistanceType>(state.range(0));
+  Eigen::VectorXd S;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C,N;
+  int step = 0;
+  for(auto _ : state)
+  {
+    const Eigen::MatrixXd Vt = (1.0+0.1*std::sin(0.1*step++))*V;
+    igl::signed_distance(P,Vt,F,type,S,I,C,N);
+    benchmark::DoNotOptimize(S.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_signed_distance_per_step)
+  ->Apply(sign_type_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// … and refitting a prebuilt igl::SignedDistance
+static void BM_SignedDistance_refit_per_step(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(80'000,V,F);
+  const Eigen::MatrixXd P = 1.2*Eigen::MatrixXd::Random(10'000,3);
+  const auto type = static_cast<igl::SignedDistanceType>(state.range(0));
+  igl::SignedDistance<Eigen::MatrixXd,Eigen::MatrixXi> sdf;
+  sdf.init(V,F,type);
+  Eigen::VectorXd S;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C,N;
+  int step = 0;
+  for(auto _ : state)
+  {
+    const Eigen::MatrixXd Vt = (1.0+0.1*std::sin(0.1*step++))*V;
+    sdf.refit(Vt);
+    sdf.query(P,S,I,C,N);
+    benchmark::DoNotOptimize(S.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_SignedDistance_refit_per_step)
+  ->Apply(sign_type_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,39 @@
+#include <bench_common.h>
+#include <igl/cotmatrix.h>
+#include <Eigen/Sparse>
+
+static void BM_cotmatrix(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  Eigen::SparseMatrix<double> L;
+  for(auto _ : state)
+  {
+    igl::cotmatrix(V,F,L);
+    benchmark::DoNotOptimize(L.valuePtr());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_cotmatrix)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,10'000'000)
+  ->Unit(benchmark::kMillisecond);
+
+static void BM_cotmatrix_tet(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi T;
+  bench_common::tet_grid(state.range(0),V,T);
+  Eigen::SparseMatrix<double> L;
+  for(auto _ : state)
+  {
+    igl::cotmatrix(V,T,L);
+    benchmark::DoNotOptimize(L.valuePtr());
+  }
+  bench_common::report(state,T.rows());
+}
+BENCHMARK(BM_cotmatrix_tet)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,1'000'000)
+  ->Unit(benchmark::kMillisecond);
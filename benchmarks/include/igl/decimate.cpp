@@ -0,0 +1,23 @@
+#include <bench_common.h>
+#include <igl/decimate.h>
+
+static void BM_decimate(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  for(auto _ : state)
+  {
+    // Halve the face count
+    igl::decimate(V,F,int(F.rows()/2),false,U,G,J,I);
+    benchmark::DoNotOptimize(G.data());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_decimate)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,1'000'000)
+  ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,47 @@
+#include <bench_common.h>
+#include <igl/dual_contouring.h>
+#include <functional>
+
+namespace
+{
+  const std::function<double(const Eigen::RowVector3d &)> sphere_sdf =
+    [](const Eigen::RowVector3d & p)->double { return p.norm()-0.6; };
+  const std::function<Eigen::RowVector3d(const Eigen::RowVector3d &)> sphere_grad =
+    [](const Eigen::RowVector3d & p)->Eigen::RowVector3d { return p.normalized(); };
+  void size_and_thread_args(benchmark::internal::Benchmark * b)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"n","threads"});
+    for(const std::int64_t n : {32,64,128})
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({n,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+}
+
+// Sphere on an n³ grid
+static void BM_dual_contouring(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int n = state.range(0);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi Q;
+  for(auto _ : state)
+  {
+    igl::dual_contouring(
+      sphere_sdf,sphere_grad,
+      Eigen::RowVector3d(-1,-1,-1),Eigen::RowVector3d(1,1,1),n,n,n,
+      false,false,true,V,Q);
+    benchmark::DoNotOptimize(Q.data());
+  }
+  state.counters["faces"] = Q.rows();
+}
+BENCHMARK(BM_dual_contouring)
+  ->Apply(size_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,117 @@
+#include <bench_common.h>
+#include <igl/dual_tree_traversal.h>
+#include <igl/mesh_mesh_squared_distance.h>
+#include <igl/AABB.h>
+#include <igl/parallel_for.h>
+#include <utility>
+#include <vector>
+
+// Two spheres (one shrunk and moved) that only overlap in a small cap
+static void two_spheres(
+  const std::int64_t n,
+  const double offset,
+  Eigen::MatrixXd & VA,
+  Eigen::MatrixXi & FA,
+  Eigen::MatrixXd & VB,
+  Eigen::MatrixXi & FB)
+{
+  bench_common::icosphere(n,VA,FA);
+  VB = (0.5*VA).rowwise() + Eigen::RowVector3d(offset,0.1,0.2);
+  FB = FA;
+}
+
+static Eigen::AlignedBox<double,3> triangle_box(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const int f)
+{
+  Eigen::AlignedBox<double,3> box;
+  for(int c = 0;c<3;c++)
+  {
+    box.extend(V.row(F(f,c)).transpose());
+  }
+  return box;
+}
+
+// Candidate pairs by querying the first tree with each triangle of the second
+static void BM_intersecting_leaves_per_triangle(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  two_spheres(state.range(0),1.45,VA,FA,VB,FB);
+  igl::AABB<Eigen::MatrixXd,3> treeA;
+  treeA.init(VA,FA);
+  for(auto _ : state)
+  {
+    std::vector<int> count(FB.rows());
+    igl::parallel_for(FB.rows(),[&](const int f)
+    {
+      std::vector<const igl::AABB<Eigen::MatrixXd,3>*> leaves;
+      treeA.append_intersecting_leaves(triangle_box(VB,FB,f),leaves);
+      count[f] = leaves.size();
+    },1000);
+    benchmark::DoNotOptimize(count.data());
+  }
+  bench_common::report(state,FA.rows()+FB.rows());
+}
+BENCHMARK(BM_intersecting_leaves_per_triangle)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Candidate pairs by traversing both trees simultaneously
+static void BM_dual_tree_traversal(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  two_spheres(state.range(0),1.45,VA,FA,VB,FB);
+  igl::AABB<Eigen::MatrixXd,3> treeA,treeB;
+  treeA.init(VA,FA);
+  treeB.init(VB,FB);
+  for(auto _ : state)
+  {
+    std::vector<std::vector<std::pair<int,int> > > pairs;
+    igl::dual_tree_traversal(treeA,treeB,
+      [&](const size_t n){ pairs.resize(n); },
+      [](
+        const Eigen::AlignedBox<double,3> & a,
+        const Eigen::AlignedBox<double,3> & b){ return a.intersects(b); },
+      [&](const int a,const int b,const size_t t)
+        { pairs[t].emplace_back(a,b); });
+    benchmark::DoNotOptimize(pairs.data());
+  }
+  bench_common::report(state,FA.rows()+FB.rows());
+}
+BENCHMARK(BM_dual_tree_traversal)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Minimum separation between two nearby spheres (trees prebuilt)
+static void BM_mesh_mesh_squared_distance(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  two_spheres(state.range(0),1.6,VA,FA,VB,FB);
+  igl::AABB<Eigen::MatrixXd,3> treeA,treeB;
+  treeA.init(VA,FA);
+  treeB.init(VB,FB);
+  for(auto _ : state)
+  {
+    int fa,fb;
+    Eigen::RowVector3d ca,cb;
+    benchmark::DoNotOptimize(igl::mesh_mesh_squared_distance(
+      treeA,VA,FA,treeB,VB,FB,fa,fb,ca,cb));
+  }
+  bench_common::report(state,FA.rows()+FB.rows());
+}
+BENCHMARK(BM_mesh_mesh_squared_distance)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
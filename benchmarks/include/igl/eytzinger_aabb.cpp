@@ -0,0 +1,30 @@
+#include <bench_common.h>
+#include <igl/eytzinger_aabb.h>
+
+template <igl::EytzingerAABBType type>
+static void BM_eytzinger_aabb(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  using MatrixX3R = Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor>;
+  const MatrixX3R C = MatrixX3R::Random(state.range(0),3);
+  const MatrixX3R PB1 = C.array()-0.001;
+  const MatrixX3R PB2 = C.array()+0.001;
+  MatrixX3R B1,B2;
+  Eigen::VectorXi leaf;
+  for(auto _ : state)
+  {
+    igl::eytzinger_aabb(PB1,PB2,B1,B2,leaf,type);
+    benchmark::DoNotOptimize(leaf.data());
+  }
+  bench_common::report(state,C.rows());
+}
+BENCHMARK_TEMPLATE(BM_eytzinger_aabb,igl::EYTZINGER_AABB_TYPE_MEDIAN)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_eytzinger_aabb,igl::EYTZINGER_AABB_TYPE_MORTON)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,91 @@
+#include <bench_common.h>
+#include <igl/eytzinger_aabb.h>
+#include <igl/eytzinger_aabb_sdf.h>
+#include <igl/eytzinger_aabb_sdf_packet.h>
+#include <functional>
+
+namespace
+{
+  using MatrixX3R = Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor>;
+  // Union of random spheres and a dense grid of queries around them
+  void spheres_and_grid(
+    const std::int64_t num_queries,
+    MatrixX3R & C,
+    Eigen::VectorXd & R,
+    MatrixX3R & B1,
+    MatrixX3R & B2,
+    Eigen::VectorXi & leaf,
+    MatrixX3R & P)
+  {
+    const int m = 10000;
+    C = MatrixX3R::Random(m,3);
+    R = 0.01*(Eigen::VectorXd::Random(m).array()+1.5);
+    const MatrixX3R PB1 = C - R.replicate(1,3);
+    const MatrixX3R PB2 = C + R.replicate(1,3);
+    igl::eytzinger_aabb(PB1,PB2,B1,B2,leaf);
+    const int s = std::max(2,int(std::cbrt(double(num_queries))));
+    P.resize(s*s*s,3);
+    for(int i = 0;i<P.rows();i++)
+    {
+      P.row(i) << i%s, (i/s)%s, i/(s*s);
+    }
+    P = (P.array()/(s-1)*2.2-1.1).matrix();
+  }
+}
+
+static void BM_eytzinger_aabb_sdf(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  MatrixX3R C,B1,B2,P;
+  Eigen::VectorXd R;
+  Eigen::VectorXi leaf;
+  spheres_and_grid(state.range(0),C,R,B1,B2,leaf,P);
+  const std::function<double(const Eigen::Matrix<double,1,3> &,const int)>
+    sdf = [&](const Eigen::Matrix<double,1,3> & p,const int i)
+  {
+    return (p-C.row(i)).norm()-R(i);
+  };
+  Eigen::VectorXd S;
+  for(auto _ : state)
+  {
+    igl::eytzinger_aabb_sdf<false>(P,sdf,B1,B2,leaf,S);
+    benchmark::DoNotOptimize(S.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_eytzinger_aabb_sdf)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+template <int N>
+static void BM_eytzinger_aabb_sdf_packet(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  MatrixX3R C,B1,B2,P;
+  Eigen::VectorXd R;
+  Eigen::VectorXi leaf;
+  spheres_and_grid(state.range(0),C,R,B1,B2,leaf,P);
+  const auto sdf = [&](const Eigen::Array<double,N,3> & Q,const int i)
+  {
+    return ((Q.rowwise()-C.row(i).array()).square().rowwise().sum().sqrt()-R(i)).eval();
+  };
+  Eigen::VectorXd S;
+  for(auto _ : state)
+  {
+    igl::eytzinger_aabb_sdf_packet<false,N>(P,sdf,B1,B2,leaf,S);
+    benchmark::DoNotOptimize(S.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK_TEMPLATE(BM_eytzinger_aabb_sdf_packet,4)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_eytzinger_aabb_sdf_packet,8)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,69 @@
+#include <bench_common.h>
+#include <igl/fast_winding_number.h>
+
+static void BM_fast_winding_number_precompute(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  for(auto _ : state)
+  {
+    igl::FastWindingNumberBVH fwn_bvh;
+    igl::fast_winding_number(V,F,2,fwn_bvh);
+    benchmark::DoNotOptimize(&fwn_bvh);
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_fast_winding_number_precompute)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,10'000'000)
+  ->Unit(benchmark::kMillisecond);
+
+// Refitting to deformed vertex positions reuses the tree
+static void BM_fast_winding_number_refit(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  igl::FastWindingNumberBVH fwn_bvh;
+  igl::fast_winding_number(V,F,2,fwn_bvh);
+  int step = 0;
+  float quality = 1;
+  for(auto _ : state)
+  {
+    const Eigen::MatrixXd Vt = (1.0+0.1*std::sin(0.1*step++))*V;
+    quality = igl::fast_winding_number_refit(Vt,fwn_bvh);
+    benchmark::DoNotOptimize(quality);
+  }
+  bench_common::report(state,F.rows());
+  state.counters["quality"] = quality;
+}
+BENCHMARK(BM_fast_winding_number_refit)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+static void BM_fast_winding_number(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  igl::FastWindingNumberBVH fwn_bvh;
+  igl::fast_winding_number(V,F,2,fwn_bvh);
+  const Eigen::MatrixXd Q = 1.5*Eigen::MatrixXd::Random(F.rows(),3);
+  Eigen::VectorXd W;
+  for(auto _ : state)
+  {
+    igl::fast_winding_number(fwn_bvh,2.0,Q,W);
+    benchmark::DoNotOptimize(W.data());
+  }
+  bench_common::report(state,Q.rows());
+}
+BENCHMARK(BM_fast_winding_number)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,61 @@
+#include <bench_common.h>
+#include <igl/hausdorff.h>
+#include <cmath>
+
+// Fine sphere against a coarse level of detail of itself with vertices
+// displaced by varying amounts (so that few of them are near the maximum)
+static void sphere_and_lod(
+  const std::int64_t n,
+  Eigen::MatrixXd & VA,
+  Eigen::MatrixXi & FA,
+  Eigen::MatrixXd & VB,
+  Eigen::MatrixXi & FB)
+{
+  bench_common::icosphere(n,VA,FA);
+  bench_common::icosphere(n/16,VB,FB);
+  for(int v = 0;v<VB.rows();v++)
+  {
+    VB.row(v) *= 1.0+0.01*std::pow(std::sin(37.0*v),2);
+  }
+}
+
+// Distances of vertices only
+static void BM_hausdorff_vertices(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  sphere_and_lod(state.range(0),VA,FA,VB,FB);
+  for(auto _ : state)
+  {
+    double d;
+    igl::hausdorff(VA,FA,VB,FB,d);
+    benchmark::DoNotOptimize(d);
+  }
+  bench_common::report(state,FA.rows()+FB.rows());
+}
+BENCHMARK(BM_hausdorff_vertices)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond);
+
+// Branch and bound over the surfaces to 1e-3 of the radius
+static void BM_hausdorff_bounded(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  sphere_and_lod(state.range(0),VA,FA,VB,FB);
+  for(auto _ : state)
+  {
+    double l,u;
+    Eigen::RowVector3d p,q;
+    igl::hausdorff(VA,FA,VB,FB,1e-3,l,u,p,q);
+    benchmark::DoNotOptimize(u);
+  }
+  bench_common::report(state,FA.rows()+FB.rows());
+}
+BENCHMARK(BM_hausdorff_bounded)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond);
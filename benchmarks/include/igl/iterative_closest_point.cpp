@@ -0,0 +1,69 @@
+#include <bench_common.h>
+#include <igl/iterative_closest_point.h>
+#include <Eigen/Geometry>
+#include <cmath>
+
+// Squashed sphere with a bump and a copy of it moved by a small rigid motion
+static void egg_and_moved_copy(
+  const std::int64_t n,
+  Eigen::MatrixXd & VX,
+  Eigen::MatrixXd & VY,
+  Eigen::MatrixXi & F)
+{
+  bench_common::icosphere(n,VY,F);
+  for(int v = 0;v<VY.rows();v++)
+  {
+    const Eigen::RowVector3d b(0.6,0.5,0.6);
+    VY.row(v) *= 1.0+0.4*std::exp(-8.0*(VY.row(v)-b).squaredNorm());
+    VY.row(v) = VY.row(v).cwiseProduct(Eigen::RowVector3d(1.0,0.8,0.6));
+  }
+  const Eigen::Matrix3d R0 = Eigen::AngleAxisd(
+    0.2,Eigen::Vector3d(1,2,3).normalized()).toRotationMatrix();
+  VX = (VY*R0).rowwise()+Eigen::RowVector3d(0.1,-0.05,0.08);
+}
+
+// Fresh random samples and point-to-plane rigid_alignment every iteration
+static void BM_iterative_closest_point_resampled(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VX,VY;
+  Eigen::MatrixXi F;
+  egg_and_moved_copy(state.range(0),VX,VY,F);
+  for(auto _ : state)
+  {
+    Eigen::Matrix3d R;
+    Eigen::RowVector3d t;
+    igl::iterative_closest_point(VX,F,VY,F,F.rows()/2,20,R,t);
+    benchmark::DoNotOptimize(t.data());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_iterative_closest_point_resampled)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond);
+
+// Same number of samples, three levels, Huber weights, stop on convergence
+static void BM_iterative_closest_point_levels(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd VX,VY;
+  Eigen::MatrixXi F;
+  egg_and_moved_copy(state.range(0),VX,VY,F);
+  igl::ICPParams params;
+  params.num_samples = F.rows()/2;
+  params.levels = 3;
+  params.weight = igl::ICP_WEIGHT_HUBER;
+  for(auto _ : state)
+  {
+    Eigen::Matrix3d R;
+    Eigen::RowVector3d t;
+    igl::iterative_closest_point(VX,F,VY,F,params,R,t);
+    benchmark::DoNotOptimize(t.data());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_iterative_closest_point_levels)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond);
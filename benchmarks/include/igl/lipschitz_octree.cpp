@@ -0,0 +1,66 @@
+#include <bench_common.h>
+#include <igl/lipschitz_octree.h>
+#include <functional>
+#include <thread>
+
+namespace
+{
+  void depth_and_thread_args(benchmark::internal::Benchmark * b)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"depth","threads"});
+    for(const std::int64_t depth : {6,8,10})
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({depth,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+}
+
+// Leaf cells near a sphere with a per-corner udf …
+static void BM_lipschitz_octree(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const std::function<double(const Eigen::RowVector3d &)> udf =
+    [](const Eigen::RowVector3d & p)->double { return std::abs(p.norm()-0.6); };
+  const Eigen::RowVector3d origin(-1,-1,-1);
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk;
+  for(auto _ : state)
+  {
+    igl::lipschitz_octree(origin,2.0,state.range(0),udf,ijk);
+    benchmark::DoNotOptimize(ijk.data());
+  }
+  state.counters["cells"] = ijk.rows();
+}
+BENCHMARK(BM_lipschitz_octree)
+  ->Apply(depth_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// … and with a batched udf
+static void BM_lipschitz_octree_batched(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const std::function<Eigen::VectorXd(
+    const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)> udf =
+    [](const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & P)
+  {
+    return (P.rowwise().norm().array()-0.6).abs().matrix().eval();
+  };
+  const Eigen::RowVector3d origin(-1,-1,-1);
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk;
+  for(auto _ : state)
+  {
+    igl::lipschitz_octree<true>(origin,2.0,state.range(0),udf,ijk);
+    benchmark::DoNotOptimize(ijk.data());
+  }
+  state.counters["cells"] = ijk.rows();
+}
+BENCHMARK(BM_lipschitz_octree_batched)
+  ->Apply(depth_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,77 @@
+#include <bench_common.h>
+#include <igl/marching_cubes.h>
+#include <igl/grid.h>
+#include <functional>
+
+static void BM_marching_cubes(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  // Signed distance to a sphere sampled on a side³ ≈ elements grid
+  const int side = std::max(2,int(std::cbrt(double(state.range(0)))));
+  Eigen::MatrixXd GV;
+  igl::grid(Eigen::RowVector3i(side,side,side),GV);
+  const Eigen::VectorXd S =
+    (GV.rowwise()-Eigen::RowVector3d(0.5,0.5,0.5)).rowwise().norm().array()-0.4;
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  for(auto _ : state)
+  {
+    igl::marching_cubes(S,GV,side,side,side,0.0,V,F);
+    benchmark::DoNotOptimize(F.data());
+  }
+  bench_common::report(state,GV.rows());
+}
+BENCHMARK(BM_marching_cubes)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Same surface, but the field is evaluated slice by slice and triangles are
+// only counted, so neither the grid nor the mesh is ever stored whole
+static void BM_marching_cubes_streaming(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int side = std::max(2,int(std::cbrt(double(state.range(0)))));
+  const std::function<void(
+    int,Eigen::Matrix<double,Eigen::Dynamic,3>&,
+    Eigen::Matrix<double,Eigen::Dynamic,1>&)> slice =
+    [side](
+      const int z,
+      Eigen::Matrix<double,Eigen::Dynamic,3> & GVz,
+      Eigen::Matrix<double,Eigen::Dynamic,1> & Sz)
+  {
+    GVz.resize(side*side,3);
+    for(int y = 0;y<side;y++)
+    {
+      for(int x = 0;x<side;x++)
+      {
+        GVz.row(x+side*y) =
+          Eigen::RowVector3d(x,y,z)/double(side-1);
+      }
+    }
+    Sz = (GVz.rowwise()-Eigen::RowVector3d(0.5,0.5,0.5))
+      .rowwise().norm().array()-0.4;
+  };
+  std::int64_t num_faces = 0;
+  const std::function<void(
+    const Eigen::Matrix<double,Eigen::Dynamic,3>&,
+    const Eigen::Matrix<int,Eigen::Dynamic,3>&)> emit =
+    [&num_faces](
+      const Eigen::Matrix<double,Eigen::Dynamic,3> &,
+      const Eigen::Matrix<int,Eigen::Dynamic,3> & F)
+  {
+    num_faces += F.rows();
+  };
+  for(auto _ : state)
+  {
+    igl::marching_cubes(slice,side,side,side,0.0,emit);
+    benchmark::DoNotOptimize(num_faces);
+  }
+  bench_common::report(state,std::int64_t(side)*side*side);
+}
+BENCHMARK(BM_marching_cubes_streaming)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,29 @@
+#include <bench_common.h>
+#include <igl/marching_tets.h>
+#include <igl/tetrahedralized_grid.h>
+
+// Signed distance to a sphere on a tetrahedralized side³ ≈ elements/5 grid
+static void BM_marching_tets(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int side = std::max(2,int(std::cbrt(double(state.range(0))/5.0)));
+  Eigen::MatrixXd TV;
+  Eigen::MatrixXi TT;
+  igl::tetrahedralized_grid(
+    side,side,side,igl::TETRAHEDRALIZED_GRID_TYPE_5,TV,TT);
+  const Eigen::VectorXd S =
+    (TV.rowwise()-Eigen::RowVector3d(0.5,0.5,0.5)).rowwise().norm().array()-0.4;
+  Eigen::MatrixXd SV;
+  Eigen::MatrixXi SF;
+  for(auto _ : state)
+  {
+    igl::marching_tets(TV,TT,S,0.0,SV,SF);
+    benchmark::DoNotOptimize(SF.data());
+  }
+  bench_common::report(state,TT.rows());
+}
+BENCHMARK(BM_marching_tets)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,21 @@
+#include <bench_common.h>
+#include <igl/massmatrix.h>
+#include <Eigen/Sparse>
+
+static void BM_massmatrix(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  Eigen::SparseMatrix<double> M;
+  for(auto _ : state)
+  {
+    igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_VORONOI,M);
+    benchmark::DoNotOptimize(M.valuePtr());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_massmatrix)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,10'000'000)
+  ->Unit(benchmark::kMillisecond);
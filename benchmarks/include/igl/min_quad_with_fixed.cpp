@@ -0,0 +1,35 @@
+#include <bench_common.h>
+#include <igl/min_quad_with_fixed.h>
+#include <igl/cotmatrix.h>
+#include <igl/boundary_loop.h>
+#include <Eigen/Sparse>
+
+static void BM_min_quad_with_fixed_solve(benchmark::State & state)
+{
+  // Harmonic interpolation of boundary values over a grid
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::grid_mesh(state.range(0),V,F);
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  const Eigen::SparseMatrix<double> Q = -L;
+  Eigen::VectorXi b;
+  igl::boundary_loop(F,b);
+  const Eigen::VectorXd bc = V(b,0);
+  igl::min_quad_with_fixed_data<double> data;
+  igl::min_quad_with_fixed_precompute(
+    Q,b,Eigen::SparseMatrix<double>(),true,data);
+  const Eigen::VectorXd B = Eigen::VectorXd::Zero(V.rows());
+  const Eigen::VectorXd Beq;
+  Eigen::VectorXd Z;
+  for(auto _ : state)
+  {
+    igl::min_quad_with_fixed_solve(data,B,bc,Beq,Z);
+    benchmark::DoNotOptimize(Z.data());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_min_quad_with_fixed_solve)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,1'000'000)
+  ->Unit(benchmark::kMillisecond);
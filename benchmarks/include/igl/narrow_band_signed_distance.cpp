@@ -0,0 +1,60 @@
+#include <bench_common.h>
+#include <igl/narrow_band_signed_distance.h>
+#include <igl/signed_distance.h>
+#include <igl/grid.h>
+
+// Signed distance to a ~80K triangle sphere on a side³ ≈ elements grid
+// covering [-1.5,1.5]³, densely with igl::signed_distance …
+static void BM_signed_distance_dense_grid(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(80'000,V,F);
+  const int side = std::max(2,int(std::cbrt(double(state.range(0)))));
+  Eigen::MatrixXd GV;
+  igl::grid(Eigen::RowVector3i(side,side,side),GV);
+  GV = (3.0*GV.array()-1.5).matrix();
+  Eigen::VectorXd S;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C,N;
+  for(auto _ : state)
+  {
+    igl::signed_distance(
+      GV,V,F,igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,S,I,C,N);
+    benchmark::DoNotOptimize(S.data());
+  }
+  bench_common::report(state,GV.rows());
+}
+BENCHMARK(BM_signed_distance_dense_grid)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// … and only within a 2-voxel band
+static void BM_narrow_band_signed_distance(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(80'000,V,F);
+  const int side = std::max(2,int(std::cbrt(double(state.range(0)))));
+  const double h = 3.0/(side-1);
+  igl::SparseBrickGrid<double> G;
+  for(auto _ : state)
+  {
+    igl::narrow_band_signed_distance(
+      V,F,Eigen::RowVector3d(-1.5,-1.5,-1.5),h,
+      Eigen::RowVector3i(side,side,side),2*h,
+      igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,G);
+    benchmark::DoNotOptimize(G.values.data());
+  }
+  bench_common::report(state,std::int64_t(side)*side*side);
+  state.counters["active_bricks"] = G.num_active();
+}
+BENCHMARK(BM_narrow_band_signed_distance)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,100'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
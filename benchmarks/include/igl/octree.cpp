@@ -0,0 +1,166 @@
+#include <bench_common.h>
+#include <igl/octree.h>
+#include <igl/knn.h>
+#include <igl/fast_winding_number.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/PI.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Point cloud scanned from a sphere
+static void cloud(
+  const std::int64_t n,
+  Eigen::MatrixXd & P,
+  Eigen::MatrixXd & N)
+{
+  Eigen::MatrixXi F;
+  bench_common::icosphere(2*n,P,F);
+  igl::per_vertex_normals(P,F,N);
+}
+
+// Per-cell vectors (serial recursive subdivision)
+static void BM_octree_point_indices(benchmark::State & state)
+{
+  Eigen::MatrixXd P,N;
+  cloud(state.range(0),P,N);
+  for(auto _ : state)
+  {
+    std::vector<std::vector<int> > point_indices;
+    Eigen::MatrixXi CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(P,point_indices,CH,CN,W);
+    benchmark::DoNotOptimize(CH.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_octree_point_indices)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,1'000'000)
+  ->Unit(benchmark::kMillisecond);
+
+// Morton sorted ranges (parallel)
+static void BM_octree(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd P,N;
+  cloud(state.range(0),P,N);
+  for(auto _ : state)
+  {
+    Eigen::VectorXi PI;
+    Eigen::MatrixXi CP,CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(P,PI,CP,CH,CN,W);
+    benchmark::DoNotOptimize(CH.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_octree)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+static void BM_octree_knn(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd P,N;
+  cloud(state.range(0),P,N);
+  Eigen::VectorXi PI;
+  Eigen::MatrixXi CP,CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,PI,CP,CH,CN,W);
+  Eigen::MatrixXi I;
+  for(auto _ : state)
+  {
+    igl::knn(P,10,PI,CP,CH,CN,W,I);
+    benchmark::DoNotOptimize(I.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_octree_knn)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Approximate k nearest neighbors (epsilon=0.5)
+static void BM_octree_knn_approximate(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd P,N;
+  cloud(state.range(0),P,N);
+  Eigen::VectorXi PI;
+  Eigen::MatrixXi CP,CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,PI,CP,CH,CN,W);
+  Eigen::MatrixXi I;
+  for(auto _ : state)
+  {
+    igl::knn(
+      P,P,10,std::numeric_limits<double>::infinity(),0.5,PI,CP,CH,CN,W,I);
+    benchmark::DoNotOptimize(I.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_octree_knn_approximate)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// All neighbors within a radius of about three point spacings
+static void BM_octree_knn_radius(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd P,N;
+  cloud(state.range(0),P,N);
+  Eigen::VectorXi PI;
+  Eigen::MatrixXi CP,CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,PI,CP,CH,CN,W);
+  const double radius = 3.0*std::sqrt(4.0*igl::PI/P.rows());
+  Eigen::VectorXi I,NI;
+  for(auto _ : state)
+  {
+    igl::knn_radius(P,P,radius,PI,CP,CH,CN,W,I,NI);
+    benchmark::DoNotOptimize(I.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_octree_knn_radius)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Octree and expansions for the point cloud fast winding number
+static void BM_octree_fast_winding_number_precompute(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd P,N;
+  cloud(state.range(0),P,N);
+  const Eigen::VectorXd A =
+    Eigen::VectorXd::Constant(P.rows(),4.0*igl::PI/P.rows());
+  for(auto _ : state)
+  {
+    Eigen::VectorXi PI;
+    Eigen::MatrixXi CP,CH;
+    Eigen::MatrixXd CN,CM,EC;
+    Eigen::VectorXd W,R;
+    igl::octree(P,PI,CP,CH,CN,W);
+    igl::fast_winding_number(P,N,A,PI,CP,CH,2,CM,R,EC);
+    benchmark::DoNotOptimize(EC.data());
+  }
+  bench_common::report(state,P.rows());
+}
+BENCHMARK(BM_octree_fast_winding_number_precompute)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,1'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,77 @@
+#include <bench_common.h>
+#include <igl/octree_dual_contouring.h>
+#include <functional>
+
+namespace
+{
+  // Bumpy sphere (roughly 1-Lipschitz)
+  const std::function<double(const Eigen::RowVector3d &)> bumpy_sdf =
+    [](const Eigen::RowVector3d & p)->double
+  {
+    return p.norm()-0.6+0.02*std::sin(10*p(0))*std::sin(10*p(1));
+  };
+  const std::function<Eigen::RowVector3d(const Eigen::RowVector3d &)> bumpy_grad =
+    [](const Eigen::RowVector3d & p)->Eigen::RowVector3d
+  {
+    return (p.normalized()+0.2*Eigen::RowVector3d(
+      std::cos(10*p(0))*std::sin(10*p(1)),
+      std::sin(10*p(0))*std::cos(10*p(1)),
+      0)).normalized();
+  };
+  void depth_and_thread_args(benchmark::internal::Benchmark * b)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"depth","threads"});
+    for(const std::int64_t depth : {5,7,8})
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({depth,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+}
+
+// Uniform cells near the surface …
+static void BM_octree_dual_contouring_uniform(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int depth = state.range(0);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  for(auto _ : state)
+  {
+    igl::octree_dual_contouring(
+      Eigen::RowVector3d(-1,-1,-1),2.0,depth,bumpy_sdf,bumpy_grad,0.0,
+      false,true,V,F);
+    benchmark::DoNotOptimize(F.data());
+  }
+  state.counters["faces"] = F.rows();
+}
+BENCHMARK(BM_octree_dual_contouring_uniform)
+  ->Apply(depth_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// … versus collapsing cells with small QEF residual
+static void BM_octree_dual_contouring_adaptive(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int depth = state.range(0);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  for(auto _ : state)
+  {
+    igl::octree_dual_contouring(
+      Eigen::RowVector3d(-1,-1,-1),2.0,depth,bumpy_sdf,bumpy_grad,1e-3,
+      false,true,V,F);
+    benchmark::DoNotOptimize(F.data());
+  }
+  state.counters["faces"] = F.rows();
+}
+BENCHMARK(BM_octree_dual_contouring_adaptive)
+  ->Apply(depth_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
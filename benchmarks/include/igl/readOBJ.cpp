@@ -0,0 +1,32 @@
+#include <bench_common.h>
+#include <igl/readOBJ.h>
+#include <igl/writeOBJ.h>
+#include <cstdio>
+#include <string>
+
+static void BM_readOBJ(benchmark::State & state)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  const std::string path =
+    "bench_readOBJ_" + std::to_string(state.range(0)) + ".obj";
+  if(!igl::writeOBJ(path,V,F))
+  {
+    state.SkipWithError("could not write temporary .obj file");
+    return;
+  }
+  Eigen::MatrixXd RV;
+  Eigen::MatrixXi RF;
+  for(auto _ : state)
+  {
+    igl::readOBJ(path,RV,RF);
+    benchmark::DoNotOptimize(RF.data());
+  }
+  std::remove(path.c_str());
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_readOBJ)
+  ->ArgName("elements")
+  ->RangeMultiplier(10)->Range(10'000,1'000'000)
+  ->Unit(benchmark::kMillisecond);
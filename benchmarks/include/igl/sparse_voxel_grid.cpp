@@ -0,0 +1,72 @@
+#include <bench_common.h>
+#include <igl/sparse_voxel_grid.h>
+#include <functional>
+
+namespace
+{
+  // A bumpy sphere, made artificially expensive like a learned implicit
+  double bumpy_sphere(const Eigen::RowVector3d & x)
+  {
+    double s = x.norm() - 1.0;
+    for(int k = 1;k<=8;k++)
+    {
+      s += 0.001/k*std::sin(k*x(0))*std::cos(k*x(1))*std::sin(k*x(2));
+    }
+    return s;
+  }
+}
+
+// Shell of cubes of side ≈ 1/sqrt(elements/6) around the surface
+static void BM_sparse_voxel_grid(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const double eps = std::sqrt(6.0/double(state.range(0)));
+  const std::function<double(const Eigen::RowVector3d &)> f = bumpy_sphere;
+  const Eigen::RowVector3d p0(0,1,0);
+  Eigen::VectorXd S;
+  Eigen::MatrixXd V;
+  Eigen::Matrix<int,Eigen::Dynamic,8> I;
+  for(auto _ : state)
+  {
+    igl::sparse_voxel_grid(p0,f,eps,state.range(0),S,V,I);
+    benchmark::DoNotOptimize(I.data());
+  }
+  bench_common::report(state,I.rows());
+}
+BENCHMARK(BM_sparse_voxel_grid)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,100'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+static void BM_sparse_voxel_grid_batched(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const double eps = std::sqrt(6.0/double(state.range(0)));
+  const std::function<Eigen::VectorXd(
+    const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)> f =
+    [](const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & X)
+  {
+    Eigen::VectorXd S(X.rows());
+    igl::parallel_for(X.rows(),[&](const int i)
+    {
+      S(i) = bumpy_sphere(X.row(i));
+    },1000);
+    return S;
+  };
+  const Eigen::RowVector3d p0(0,1,0);
+  Eigen::VectorXd S;
+  Eigen::MatrixXd V;
+  Eigen::Matrix<int,Eigen::Dynamic,8> I;
+  for(auto _ : state)
+  {
+    igl::sparse_voxel_grid<true>(p0,f,eps,state.range(0),S,V,I);
+    benchmark::DoNotOptimize(I.data());
+  }
+  bench_common::report(state,I.rows());
+}
+BENCHMARK(BM_sparse_voxel_grid_batched)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,100'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,78 @@
+#include <bench_common.h>
+#include <igl/sparse_voxel_marching_cubes.h>
+#include <igl/lipschitz_octree.h>
+#include <igl/marching_cubes.h>
+#include <igl/grid.h>
+#include <functional>
+
+namespace
+{
+  const std::function<double(const Eigen::RowVector3d &)> sphere_sdf =
+    [](const Eigen::RowVector3d & p)->double { return p.norm()-0.6; };
+  const std::function<double(const Eigen::RowVector3d &)> sphere_udf =
+    [](const Eigen::RowVector3d & p)->double { return std::abs(p.norm()-0.6); };
+  void depth_and_thread_args(benchmark::internal::Benchmark * b)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"depth","threads"});
+    for(const std::int64_t depth : {5,7,9})
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({depth,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+}
+
+// Sphere from lipschitz_octree cells …
+static void BM_sparse_voxel_marching_cubes(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int depth = state.range(0);
+  const Eigen::RowVector3d origin(-1,-1,-1);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  for(auto _ : state)
+  {
+    Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk;
+    igl::lipschitz_octree(origin,2.0,depth,sphere_udf,ijk);
+    igl::sparse_voxel_marching_cubes(origin,2.0,depth,sphere_sdf,ijk,V,F);
+    benchmark::DoNotOptimize(F.data());
+  }
+  state.counters["faces"] = F.rows();
+}
+BENCHMARK(BM_sparse_voxel_marching_cubes)
+  ->Apply(depth_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// … versus evaluating the dense grid
+static void BM_dense_marching_cubes(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  const int depth = state.range(0);
+  const int n = (1<<depth)+1;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> GV;
+  igl::grid(Eigen::RowVector3i(n,n,n),GV);
+  GV = (2.0*GV).array()-1.0;
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  for(auto _ : state)
+  {
+    Eigen::VectorXd S(GV.rows());
+    igl::parallel_for(GV.rows(),[&](const int i)
+    {
+      S(i) = sphere_sdf(GV.row(i));
+    },1000);
+    igl::marching_cubes(S,GV,n,n,n,0.0,V,F);
+    benchmark::DoNotOptimize(F.data());
+  }
+  state.counters["faces"] = F.rows();
+}
+BENCHMARK(BM_dense_marching_cubes)
+  ->Apply(depth_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,62 @@
+#include <bench_common.h>
+#include <igl/swept_volume_signed_distance.h>
+#include <igl/voxel_grid.h>
+#include <igl/PI.h>
+#include <functional>
+
+namespace
+{
+  // Small elongated tool moving along a helix
+  const std::function<Eigen::Affine3d(const double)> helix =
+    [](const double t)
+  {
+    Eigen::Affine3d A = Eigen::Affine3d::Identity();
+    A.translate(Eigen::Vector3d(
+      std::cos(6*igl::PI*t),std::sin(6*igl::PI*t),0.3*t));
+    A.rotate(Eigen::AngleAxisd(4*t,Eigen::Vector3d(1,0,0)));
+    return A;
+  };
+  // steps (0 is adaptive) at 1,2,4,… threads
+  void steps_and_thread_args(benchmark::internal::Benchmark * b)
+  {
+    const std::int64_t hw =
+      std::max<std::int64_t>(1,std::thread::hardware_concurrency());
+    b->ArgNames({"steps","threads"});
+    for(const std::int64_t steps : {0,100,1000})
+    {
+      for(std::int64_t t = 1;;t = std::min(2*t,hw))
+      {
+        b->Args({steps,t});
+        if(t == hw) { break; }
+      }
+    }
+  }
+}
+
+static void BM_swept_volume_signed_distance(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(1'000,V,F);
+  V.col(2) *= 3;
+  V *= 0.1;
+  Eigen::MatrixXd GV;
+  Eigen::RowVector3i res;
+  igl::voxel_grid(
+    Eigen::AlignedBox3d(Eigen::Vector3d(-1.4,-1.4,-0.5),Eigen::Vector3d(1.4,1.4,0.8)),
+    100,0,GV,res);
+  const double h = (GV.row(1)-GV.row(0)).norm();
+  Eigen::VectorXd S;
+  for(auto _ : state)
+  {
+    igl::swept_volume_signed_distance(
+      V,F,helix,state.range(0),GV,res,h,0.0,S);
+    benchmark::DoNotOptimize(S.data());
+  }
+  bench_common::report(state,GV.rows());
+}
+BENCHMARK(BM_swept_volume_signed_distance)
+  ->Apply(steps_and_thread_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
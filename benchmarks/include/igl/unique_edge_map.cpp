@@ -0,0 +1,23 @@
+#include <bench_common.h>
+#include <igl/unique_edge_map.h>
+
+static void BM_unique_edge_map(benchmark::State & state)
+{
+  const bench_common::ScopedNumThreads threads(state);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  bench_common::icosphere(state.range(0),V,F);
+  Eigen::MatrixXi E,uE;
+  Eigen::VectorXi EMAP,uEC,uEE;
+  for(auto _ : state)
+  {
+    igl::unique_edge_map(F,E,uE,EMAP,uEC,uEE);
+    benchmark::DoNotOptimize(uE.data());
+  }
+  bench_common::report(state,F.rows());
+}
+BENCHMARK(BM_unique_edge_map)
+  ->Apply([](benchmark::internal::Benchmark * b)
+    { bench_common::element_and_thread_args(b,10'000,10'000'000); })
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
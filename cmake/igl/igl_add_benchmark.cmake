@@ -0,0 +1,43 @@
+function(igl_add_benchmark module_name)
+    if(NOT LIBIGL_BUILD_BENCHMARKS)
+        return()
+    endif()
+
+    if(NOT TARGET ${module_name})
+        message(FATAL_ERROR "'${module_name}' is not a CMake target")
+    endif()
+
+    # Create benchmark executable
+    add_executable(bench_${module_name}
+        ${libigl_SOURCE_DIR}/benchmarks/bench_common.h
+        ${ARGN}
+    )
+
+    # Include headers
+    target_include_directories(bench_${module_name} PUBLIC ${libigl_SOURCE_DIR}/benchmarks)
+
+    # Dependencies
+    include(benchmark)
+    target_link_libraries(bench_${module_name} PUBLIC
+        ${module_name}
+        benchmark::benchmark_main
+    )
+
+    # IDE Folder
+    set_target_properties(bench_${module_name} PROPERTIES FOLDER Libigl_Benchmarks)
+
+    # Output directory
+    set_target_properties(bench_${module_name} PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/benchmarks")
+
+    # Run the suite and dump results as JSON for regression tracking, e.g.,
+    #     cmake --build . --target run_bench_igl_core
+    add_custom_target(run_bench_${module_name}
+        COMMAND bench_${module_name}
+            --benchmark_out=${CMAKE_BINARY_DIR}/benchmarks/bench_${module_name}.json
+            --benchmark_out_format=json
+        DEPENDS bench_${module_name}
+        WORKING_DIRECTORY ${CMAKE_BINARY_DIR}/benchmarks
+        USES_TERMINAL
+    )
+    set_target_properties(run_bench_${module_name} PROPERTIES FOLDER Libigl_Benchmarks)
+endfunction()
@@ -0,0 +1,21 @@
+if(TARGET benchmark::benchmark)
+    return()
+endif()
+
+message(STATUS "Third-party: creating target 'benchmark::benchmark'")
+
+include(FetchContent)
+FetchContent_Declare(
+    benchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG v1.8.3
+    GIT_SHALLOW TRUE
+)
+
+option(BENCHMARK_ENABLE_TESTING "Enable testing of the benchmark library." OFF)
+option(BENCHMARK_ENABLE_INSTALL "Enable installation of benchmark." OFF)
+option(BENCHMARK_ENABLE_GTEST_TESTS "Enable building the unit tests which depend on gtest" OFF)
+FetchContent_MakeAvailable(benchmark)
+
+set_target_properties(benchmark PROPERTIES FOLDER ThirdParty)
+set_target_properties(benchmark_main PROPERTIES FOLDER ThirdParty)
@@ -20,6 +20,8 @@
 #include "ray_mesh_intersect.h"
 #include "box_surface_area.h"
 #include "pad_box.h"
+#include <functional>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
 #include <limits>
@@ -854,20 +856,20 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
       barycenter(V,Ele,BC);
     }
     Eigen::MatrixXi SI(BC.rows(),BC.cols());
+    // Sort each column concurrently
+    igl::parallel_for(BC.cols(),[&](const int d)
     {
-      MatrixXDIMS _;
-      Eigen::MatrixXi IS;
-      igl::sort(BC,1,true,_,IS);
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+      const VectorXS BCd = BC.col(d);
+      VectorXS _;
+      Eigen::VectorXi IS;
+      igl::sort(BCd,1,true,_,IS);
       // Need SI(i) to tell which place i would be sorted into
-      const int dim = IS.cols();
       for(int i = 0;i<IS.rows();i++)
       {
-        for(int d = 0;d<dim;d++)
-        {
-          SI(IS(i,d),d) = i;
-        }
+        SI(IS(i),d) = i;
       }
-    }
+    },2);
     init(V,Ele,SI,allI);
   }
 }
@@ -901,14 +903,36 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
   assert(DIM == V.cols() && "V.cols() should matched declared dimension");
   //const Scalar inf = numeric_limits<Scalar>::infinity();
   m_box = Eigen::AlignedBox<Scalar,DIM>();
+  // Nodes with at least this many primitives compute their box, median and
+  // partition in parallel and build their two subtrees concurrently. The
+  // resulting tree is identical to the serial build.
+  const int min_parallel = 10000;
   // Compute bounding box
-  for(int i = 0;i<I.rows();i++)
+  if(I.rows() < min_parallel)
   {
-    for(int c = 0;c<Ele.cols();c++)
+    for(int i = 0;i<I.rows();i++)
     {
-      m_box.extend(V.row(Ele(I(i),c)).transpose());
-      m_box.extend(V.row(Ele(I(i),c)).transpose());
+      for(int c = 0;c<Ele.cols();c++)
+      {
+        m_box.extend(V.row(Ele(I(i),c)).transpose());
+      }
     }
+  }else
+  {
+    // Per-thread boxes (min/max reduction is order independent)
+    std::vector<Eigen::AlignedBox<Scalar,DIM>> B;
+    igl::parallel_for(
+      I.rows(),
+      [&B](const size_t nt){ B.resize(nt); },
+      [&](const int i, const size_t t)
+      {
+        for(int c = 0;c<Ele.cols();c++)
+        {
+          B[t].extend(V.row(Ele(I(i),c)).transpose());
+        }
+      },
+      [&](const size_t t){ m_box.extend(B[t]); },
+      min_parallel);
   }
   switch(I.size())
   {
@@ -929,10 +953,10 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
         // Can't use median on BC directly because many may have same value,
         // but can use median on sorted BC indices
         Eigen::VectorXi SIdI(I.rows());
-        for(int i = 0;i<I.rows();i++)
+        igl::parallel_for(I.rows(),[&](const int i)
         {
           SIdI(i) = SI(I(i),max_d);
-        }
+        },min_parallel);
         // Pass by copy to avoid changing input
         const auto median = [](Eigen::VectorXi A)->int
         {
@@ -943,7 +967,8 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
         const int med = median(SIdI);
         Eigen::VectorXi LI((I.rows()+1)/2),RI(I.rows()/2);
         assert(LI.rows()+RI.rows() == I.rows());
-        // Distribute left and right
+        // Distribute left and right, preserving order
+        if(I.rows() < min_parallel)
         {
           int li = 0;
           int ri = 0;
@@ -957,21 +982,67 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
               RI(ri++) = I(i);
             }
           }
+        }else
+        {
+          // Stable parallel partition: count left elements per block, prefix
+          // sum the counts, then scatter each block to its offsets
+          const int block_size = min_parallel/4;
+          const int num_blocks = (I.rows()+block_size-1)/block_size;
+          std::vector<int> block_left(num_blocks+1,0);
+          igl::parallel_for(num_blocks,[&](const int b)
+          {
+            const int end = std::min<int>((b+1)*block_size,I.rows());
+            int count = 0;
+            for(int i = b*block_size;i<end;i++)
+            {
+              count += SIdI(i)<=med;
+            }
+            block_left[b+1] = count;
+          },2);
+          for(int b = 0;b<num_blocks;b++)
+          {
+            block_left[b+1] += block_left[b];
+          }
+          igl::parallel_for(num_blocks,[&](const int b)
+          {
+            const int begin = b*block_size;
+            const int end = std::min<int>(begin+block_size,I.rows());
+            int li = block_left[b];
+            int ri = begin-block_left[b];
+            for(int i = begin;i<end;i++)
+            {
+              if(SIdI(i)<=med)
+              {
+                LI(li++) = I(i);
+              }else
+              {
+                RI(ri++) = I(i);
+              }
+            }
+          },2);
         }
         //m_depth = 0;
-        if(LI.rows()>0)
+        const auto build_child = [&](const int child)
         {
-          m_left = new AABB();
-          m_left->init(V,Ele,SI,LI);
-          m_left->m_parent = this;
-          //m_depth = std::max(m_depth, m_left->m_depth+1);
-        }
-        if(RI.rows()>0)
+          const Eigen::VectorXi & CI = child == 0 ? LI : RI;
+          if(CI.rows() == 0)
+          {
+            return;
+          }
+          AABB * node = new AABB();
+          node->init(V,Ele,SI,CI);
+          node->m_parent = this;
+          (child == 0 ? m_left : m_right) = node;
+        };
+        if(I.rows() < min_parallel)
+        {
+          build_child(0);
+          build_child(1);
+        }else
         {
-          m_right = new AABB();
-          m_right->init(V,Ele,SI,RI);
-          m_right->m_parent = this;
-          //m_depth = std::max(m_depth, m_right->m_depth+1);
+          // Subtrees are independent: build them as two tasks so that idle
+          // threads of igl::default_thread_pool() can help with either
+          igl::parallel_for(2,build_child,2);
         }
       }
   }
@@ -987,7 +1058,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::update_primitive(
 {
   assert(this->is_leaf());
   assert(this->m_primitive >= 0 && this->m_primitive < Ele.rows());
-  Eigen::AlignedBox<double, 3> new_box;
+  Eigen::AlignedBox<Scalar,DIM> new_box;
   for(int c = 0;c<Ele.cols();c++)
   {
     new_box.extend(V.row(Ele(this->m_primitive,c)).transpose());
@@ -995,6 +1066,47 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::update_primitive(
   return this->update(new_box,pad);
 }
 
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::refit(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele)
+{
+  const std::function<void(AABB *,const int)> refit_node =
+    [&](AABB * node, const int depth)
+  {
+    node->m_box.setEmpty();
+    if(node->is_leaf())
+    {
+      if(node->m_primitive >= 0)
+      {
+        for(int c = 0;c<Ele.cols();c++)
+        {
+          node->m_box.extend(V.row(Ele(node->m_primitive,c)).transpose());
+        }
+      }
+      return;
+    }
+    const auto refit_child = [&](const int child)
+    {
+      AABB * c = child == 0 ? node->m_left : node->m_right;
+      if(c) { refit_node(c,depth+1); }
+    };
+    // Refit the top few levels' subtrees as independent tasks
+    if(depth < 8)
+    {
+      igl::parallel_for(2,refit_child,2);
+    }else
+    {
+      refit_child(0);
+      refit_child(1);
+    }
+    if(node->m_left) { node->m_box.extend(node->m_left->m_box); }
+    if(node->m_right) { node->m_box.extend(node->m_right->m_box); }
+  };
+  refit_node(this,0);
+}
+
 template <typename DerivedV, int DIM>
 IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::insert(AABB * other)
 {
@@ -1554,26 +1666,76 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::intersect_ray(
   const Scalar min_t,
   Eigen::PlainObjectBase<DerivedI> & I,
   Eigen::PlainObjectBase<DerivedT> & T,
-  Eigen::PlainObjectBase<DerivedUV> & UV)
+  Eigen::PlainObjectBase<DerivedUV> & UV,
+  const int packet_size)
 {
   assert(origin.rows() == dir.rows());
   I.setConstant(origin.rows(),1,-1);
   T.setConstant(origin.rows(),1,std::numeric_limits<Scalar>::quiet_NaN());
   UV.resize(origin.rows(),2);
 
-  igl::parallel_for(origin.rows(),[&](int i)
+  if(packet_size <= 1 || this->is_leaf())
   {
-    RowVectorDIMS origin_i = origin.row(i);
-    RowVectorDIMS dir_i = dir.row(i);
-    igl::Hit<typename DerivedV::Scalar> hit_i;
-    if(intersect_ray(V,Ele,origin_i,dir_i,min_t,hit_i))
+    igl::parallel_for(origin.rows(),[&](int i)
     {
-      I(i) = hit_i.id;
-      UV.row(i) << hit_i.u, hit_i.v;
-      T(i) = hit_i.t;
-    }
-  },
-  10000);
+      RowVectorDIMS origin_i = origin.row(i);
+      RowVectorDIMS dir_i = dir.row(i);
+      igl::Hit<typename DerivedV::Scalar> hit_i;
+      if(intersect_ray(V,Ele,origin_i,dir_i,min_t,hit_i))
+      {
+        I(i) = hit_i.id;
+        UV.row(i) << hit_i.u, hit_i.v;
+        T(i) = hit_i.t;
+      }
+    },
+    10000);
+    return;
+  }
+
+  const auto trace_packets = [&](auto lanes)
+  {
+    constexpr int N = decltype(lanes)::value;
+    const int num_packets = (origin.rows()+N-1)/N;
+    igl::parallel_for(num_packets,[&](const int p)
+    {
+      const int first = p*N;
+      const int num_rays = std::min<int>(N,origin.rows()-first);
+      // Unused lanes of the last packet repeat its last ray
+      Eigen::Array<Scalar,N,DIM> origin_p,dir_p;
+      for(int l = 0;l<N;l++)
+      {
+        const int i = first+std::min(l,num_rays-1);
+        origin_p.row(l) = origin.row(i).template cast<Scalar>().array();
+        dir_p.row(l) = dir.row(i).template cast<Scalar>().array();
+      }
+      std::array<igl::Hit<Scalar>,N> hits;
+      std::array<bool,N> found;
+      intersect_ray_packet<N>(V,Ele,origin_p,dir_p,num_rays,min_t,hits,found);
+      for(int l = 0;l<num_rays;l++)
+      {
+        if(found[l])
+        {
+          I(first+l) = hits[l].id;
+          UV.row(first+l) << hits[l].u, hits[l].v;
+          T(first+l) = hits[l].t;
+        }
+      }
+    },
+    10000/N);
+  };
+  switch(packet_size)
+  {
+    case 8:
+      trace_packets(std::integral_constant<int,8>());
+      break;
+    case 16:
+      trace_packets(std::integral_constant<int,16>());
+      break;
+    default:
+      assert(packet_size == 4 && "packet_size should be 1, 4, 8 or 16");
+      trace_packets(std::integral_constant<int,4>());
+      break;
+  }
 }
 
 template <typename DerivedV, int DIM>
@@ -1707,6 +1869,194 @@ igl::AABB<DerivedV,DIM>::intersect_ray_opt(
 }
 
 
+template <typename DerivedV, int DIM>
+template <int N, typename DerivedEle>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::intersect_ray_packet(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::Array<Scalar,N,DIM> & origin,
+  const Eigen::Array<Scalar,N,DIM> & dir,
+  const int num_rays,
+  const Scalar min_t,
+  std::array<igl::Hit<Scalar>,N> & hits,
+  std::array<bool,N> & found) const
+{
+  static_assert(N <= 32, "Lane masks are 32 bits");
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  // Lanes are stored structure-of-arrays and processed with plain loops over
+  // lanes (with selects rather than branches) so that the compiler emits SIMD
+  // code for the box and triangle tests.
+  typedef std::array<Scalar,N> LaneS;
+  typedef std::array<double,N> LaneD;
+  typedef uint32_t Mask;
+  // Same reciprocals as single-ray traversal
+  std::array<LaneS,DIM> O,inv_dir,inv_dir_pad;
+  std::array<std::array<bool,N>,DIM> negative;
+  std::array<LaneD,DIM> O_d,D_d;
+  for(int l = 0;l<N;l++)
+  {
+    RowVectorDIMS inv_dir_l = dir.row(l).matrix().cwiseInverse();
+    RowVectorDIMS inv_dir_pad_l = inv_dir_l;
+    igl::increment_ulp(inv_dir_pad_l, 2);
+    for(int d = 0;d<DIM;d++)
+    {
+      O[d][l] = origin(l,d);
+      inv_dir[d][l] = inv_dir_l(d);
+      inv_dir_pad[d][l] = inv_dir_pad_l(d);
+      negative[d][l] = inv_dir_l(d) < 0;
+      // Ray data in double for the triangle test (as ray_triangle_intersect)
+      O_d[d][l] = static_cast<double>(origin(l,d));
+      D_d[d][l] = static_cast<double>(dir(l,d));
+    }
+  }
+  LaneS best_t;
+  best_t.fill(min_t);
+  found.fill(false);
+  const Mask all = num_rays >= 32 ? ~Mask(0) : (Mask(1)<<num_rays)-1;
+
+  // igl::ray_box_intersect for all lanes against [0,best_t]
+  const auto box_mask = [&](const Eigen::AlignedBox<Scalar,DIM> & box)->Mask
+  {
+    LaneS tmin,tmax;
+    std::array<bool,N> miss;
+    miss.fill(false);
+    for(int d = 0;d<DIM;d++)
+    {
+      const Scalar lo = box.min()(d);
+      const Scalar hi = box.max()(d);
+      for(int l = 0;l<N;l++)
+      {
+        const Scalar near_d = negative[d][l] ? hi : lo;
+        const Scalar far_d = negative[d][l] ? lo : hi;
+        const Scalar td_min = (near_d - O[d][l]) * inv_dir[d][l];
+        const Scalar td_max = (far_d - O[d][l]) * inv_dir_pad[d][l];
+        if(d == 0)
+        {
+          tmin[l] = td_min;
+          tmax[l] = td_max;
+        }else
+        {
+          miss[l] = miss[l] || (tmin[l] > td_max) || (td_min > tmax[l]);
+          tmin[l] = (tmin[l] > td_min) ? tmin[l] : td_min;
+          tmax[l] = (tmax[l] < td_max) ? tmax[l] : td_max;
+        }
+      }
+    }
+    Mask mask = 0;
+    for(int l = 0;l<N;l++)
+    {
+      mask |= Mask(!miss[l] && tmin[l] < best_t[l] && tmax[l] > Scalar(0)) << l;
+    }
+    return mask;
+  };
+
+  // Depth-first, left before right, so that each lane sees the same nodes in
+  // the same order as intersect_ray_opt
+  std::vector<std::pair<const AABB*,Mask>> stack;
+  stack.reserve(64);
+  stack.emplace_back(this,all);
+  while(!stack.empty())
+  {
+    const AABB * node = stack.back().first;
+    Mask active = stack.back().second;
+    stack.pop_back();
+    active &= box_mask(node->m_box);
+    if(active == 0)
+    {
+      continue;
+    }
+    if(node->is_leaf())
+    {
+      // Möller–Trumbore (same arithmetic as intersect_triangle1) for all
+      // lanes
+      const int f = node->m_primitive;
+      const Eigen::RowVector3d v0 = V.row(Ele(f,0)).template cast<double>();
+      const Eigen::RowVector3d edge1 =
+        V.row(Ele(f,1)).template cast<double>() - v0;
+      const Eigen::RowVector3d edge2 =
+        V.row(Ele(f,2)).template cast<double>() - v0;
+      const double eps = 0.000001;
+      LaneD t,u,v;
+      std::array<bool,N> inside;
+      for(int l = 0;l<N;l++)
+      {
+        const double px = D_d[1][l]*edge2(2) - D_d[2][l]*edge2(1);
+        const double py = D_d[2][l]*edge2(0) - D_d[0][l]*edge2(2);
+        const double pz = D_d[0][l]*edge2(1) - D_d[1][l]*edge2(0);
+        const double det = edge1(0)*px + edge1(1)*py + edge1(2)*pz;
+        const double tx = O_d[0][l] - v0(0);
+        const double ty = O_d[1][l] - v0(1);
+        const double tz = O_d[2][l] - v0(2);
+        const double u_l = tx*px + ty*py + tz*pz;
+        const double qx = ty*edge1(2) - tz*edge1(1);
+        const double qy = tz*edge1(0) - tx*edge1(2);
+        const double qz = tx*edge1(1) - ty*edge1(0);
+        const double v_l = D_d[0][l]*qx + D_d[1][l]*qy + D_d[2][l]*qz;
+        inside[l] =
+          ((det > eps) && !(u_l < 0.0 || u_l > det) &&
+            !(v_l < 0.0 || u_l + v_l > det)) ||
+          ((det < -eps) && !(u_l > 0.0 || u_l < det) &&
+            !(v_l > 0.0 || u_l + v_l < det));
+        const double inv_det = 1.0 / (inside[l] ? det : 1.0);
+        t[l] = (edge2(0)*qx + edge2(1)*qy + edge2(2)*qz) * inv_det;
+        u[l] = u_l * inv_det;
+        v[l] = v_l * inv_det;
+      }
+      for(int l = 0;l<N;l++)
+      {
+        if(!((active >> l) & 1) || !inside[l] || !(t[l] > 0.0))
+        {
+          continue;
+        }
+        // igl::Hit from ray_triangle_intersect stores single precision
+        const Scalar t_l = static_cast<float>(t[l]);
+        if(t_l < best_t[l])
+        {
+          hits[l] = {f,-1,static_cast<float>(u[l]),static_cast<float>(v[l]),t_l};
+          best_t[l] = t_l;
+          found[l] = true;
+        }
+      }
+      continue;
+    }
+    // Count active lanes
+    int count = 0;
+    for(Mask m = active;m;m &= m-1) { count++; }
+    if(count <= std::max(1,N/4))
+    {
+      // Divergence: finish this subtree with single-ray traversal of each
+      // remaining lane
+      for(int l = 0;l<N;l++)
+      {
+        if(!((active >> l) & 1))
+        {
+          continue;
+        }
+        const RowVectorDIMS origin_l = origin.row(l).matrix();
+        const RowVectorDIMS dir_l = dir.row(l).matrix();
+        RowVectorDIMS inv_dir_l,inv_dir_pad_l;
+        for(int d = 0;d<DIM;d++)
+        {
+          inv_dir_l(d) = inv_dir[d][l];
+          inv_dir_pad_l(d) = inv_dir_pad[d][l];
+        }
+        igl::Hit<Scalar> hit;
+        if(node->intersect_ray_opt(
+          V,Ele,origin_l,dir_l,inv_dir_l,inv_dir_pad_l,best_t[l],hit) &&
+          hit.t < best_t[l])
+        {
+          hits[l] = hit;
+          best_t[l] = hit.t;
+          found[l] = true;
+        }
+      }
+      continue;
+    }
+    stack.emplace_back(node->m_right,active);
+    stack.emplace_back(node->m_left,active);
+  }
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
@@ -1771,8 +2121,45 @@ template void igl::AABB<Eigen::Matrix<float, -1, 3, 0, -1, 3>, 3>::init<Eigen::M
 template void igl::AABB<Eigen::Matrix<float, -1, 3, 1, -1, 3>, 3>::init<Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&);
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<double, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 2, 1, 1, 2> >&) const;
-template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, double, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, double, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, int);
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, std::vector<std::vector<igl::Hit<double>, std::allocator<igl::Hit<double>>>, std::allocator<std::vector<igl::Hit<double>, std::allocator<igl::Hit<double>>>>>&);
+template class igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>;
+template class igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>;
+template igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>* igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::update_primitive<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, float);
+template bool igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, igl::Hit<float>&) const;
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 2, 1, 1, 2> >&) const;
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, float, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> >&) const;
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> >&) const;
+template std::vector<int, std::allocator<int> > igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, -1, 1, 1, -1> > const&, bool) const;
+template std::vector<int, std::allocator<int> > igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Block<Eigen::Matrix<float, -1, -1, 0, -1, -1> const, 1, -1, false> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Block<Eigen::Matrix<float, -1, -1, 0, -1, -1> const, 1, -1, false> > const&, bool) const;
+template std::vector<int, std::allocator<int> > igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, -1, 1, 1, -1> > const&, bool) const;
+template std::vector<int> igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, 2, 1, 1, 2>>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, 2, 1, 1, 2>> const&, bool) const;
+template std::vector<int> igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, 3, 1, 1, 3>>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3>> const&, bool) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, int);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::serialize<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, int) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, int);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::serialize<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, int) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<long, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 2, 3, 0, 2, 3>, Eigen::Matrix<float, 2, 1, 0, 2, 1>, Eigen::Matrix<int, 2, 1, 0, 2, 1>, Eigen::Matrix<float, 2, 3, 0, 2, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 2, 3, 0, 2, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, 2, 1, 0, 2, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, 2, 1, 0, 2, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, 2, 3, 0, 2, 3> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> >&) const;
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<float, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 2, 1, 1, 2> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, float, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>>&, int);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1>> const&, std::vector<std::vector<igl::Hit<float>, std::allocator<igl::Hit<float>>>, std::allocator<std::vector<igl::Hit<float>, std::allocator<igl::Hit<float>>>>>&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::refit<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::refit<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::refit<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 #ifdef WIN32
 template void igl::AABB<class Eigen::Matrix<double,-1,-1,0,-1,-1>,3>::squared_distance<class Eigen::Matrix<int,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1>,class Eigen::Matrix<double,-1,3,0,-1,3> >(class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,3,0,-1,3> > &)const;
 #endif
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <array>
 #include <vector>
 namespace igl
 {
@@ -518,6 +519,18 @@ public:
           const Eigen::MatrixBase<DerivedV> & V,
           const Eigen::MatrixBase<DerivedEle> & Ele,
           const Scalar pad=0);
+      /// Recompute all boxes bottom-up for new vertex positions of the same
+      /// mesh, keeping the tree's topology. This is much cheaper than `init`
+      /// but queries slow down as V drifts far from the positions the tree
+      /// was built for.
+      ///
+      /// @param[in] V  #V by dim list of new mesh vertex positions
+      /// @param[in] Ele  #Ele by dim+1 list of mesh indices into #V. **Should
+      ///   be same as used to construct tree.**
+      template <typename DerivedEle>
+      IGL_INLINE void refit(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele);
 
       /// Find the indices of elements containing given point: this makes sense
       /// when Ele is a co-dimension 0 simplex (tets in 3D, triangles in 2D).
@@ -668,6 +681,14 @@ public:
         igl::Hit<typename DerivedV::Scalar> & hit) const;
       /// Intersect a rays with the mesh return first hit for each
       ///
+      /// Consecutive rays are traced together in packets of `packet_size`
+      /// lanes: each node box and leaf triangle is tested against all rays of
+      /// a packet at once (written so the compiler vectorizes across lanes).
+      /// Subtrees reached by only a few rays of the packet fall back to
+      /// single-ray traversal. Results are the
+      /// same as tracing each ray individually, but coherent rays (e.g., in
+      /// scanline order from a camera) are much faster.
+      ///
       /// @param[in]  V  #V by dim list of vertex positions
       /// @param[in]  Ele  #Ele by dim list of simplex indices
       /// @param[in]  origin #ray by dim+1 list of ray origins
@@ -677,6 +698,8 @@ public:
       ///   (-1 indicates no hit)
       /// @param[out]  T #ray list of t values (nan indicates no hit)
       /// @param[out]  UV #ray by dim list of barycentric coordinates
+      /// @param[in]  packet_size  number of rays per packet: 4, 8 or 16 (1
+      ///   traces every ray individually)
       template <
         typename DerivedEle,
         typename DerivedOrigin,
@@ -692,7 +715,8 @@ public:
         const Scalar min_t,
         Eigen::PlainObjectBase<DerivedI> & I,
         Eigen::PlainObjectBase<DerivedT> & T,
-        Eigen::PlainObjectBase<DerivedUV> & UV);
+        Eigen::PlainObjectBase<DerivedUV> & UV,
+        const int packet_size = 4);
       template <
         typename DerivedEle,
         typename DerivedOrigin,
@@ -842,6 +866,27 @@ private:
         const RowVectorDIMS & inv_dir_pad,
         const Scalar min_t,
         igl::Hit<typename DerivedV::Scalar> & hit) const;
+      /// Intersect a packet of N rays with the mesh return first hit for each
+      ///
+      /// @tparam N  number of lanes
+      /// @param[in]  V  #V by dim list of vertex positions
+      /// @param[in]  Ele  #Ele by dim list of simplex indices
+      /// @param[in]  origin  N by dim list of ray origins
+      /// @param[in]  dir  N by dim list of ray directions
+      /// @param[in]  num_rays  number of valid lanes (≤N)
+      /// @param[in]  min_t  minimum t value to consider
+      /// @param[out]  hits  N list of first hits
+      /// @param[out]  found  N list of whether each ray hit anything
+      template <int N, typename DerivedEle>
+      IGL_INLINE void intersect_ray_packet(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::Array<Scalar,N,DIM> & origin,
+        const Eigen::Array<Scalar,N,DIM> & dir,
+        const int num_rays,
+        const Scalar min_t,
+        std::array<igl::Hit<Scalar>,N> & hits,
+        std::array<bool,N> & found) const;
 public:
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
     };
@@ -6254,6 +6254,16 @@ public:
     /// Frees myTree and myData, and clears the rest.
     inline void clear();
 
+    /// Recompute the bounding boxes and expansion coefficients for new point
+    /// positions (same count and triangles as passed to init), keeping the
+    /// tree topology. Coefficients are accumulated bottom-up in parallel.
+    ///
+    /// Returns the ratio of the tree's current surface area cost (sum of
+    /// node box areas relative to the root) to that right after init. This
+    /// grows as the deformation makes the tree's partition loose, and a full
+    /// init is worthwhile once it exceeds ~1.5.
+    inline T refit(const UT_Vector3T<S> *const positions);
+
     /// Returns true if this is clear
     bool isClear() const
     { return myNTriangles == 0; }
@@ -6265,6 +6275,11 @@ public:
 private:
     struct BoxData;
 
+    /// Bounding box of each triangle at myPositions
+    inline void computeTriangleBoxes(UT_SmallArray<UT::Box<S,3>> &triangle_boxes) const;
+    /// Fill myData bottom-up over myTree, returning the surface area cost
+    inline T precompute(const UT::Box<S,3> *triangle_boxes);
+
     static constexpr uint BVH_N = 4;
     UT_BVH<BVH_N> myTree;
     int myNBoxes;
@@ -6274,6 +6289,7 @@ private:
     const int *myTrianglePoints;
     int myNPoints;
     const UT_Vector3T<S> *myPositions;
+    T myInitCost;
 };
 
 template<typename T>
@@ -6530,6 +6546,7 @@ inline UT_SolidAngle<T,S>::UT_SolidAngle()
     , myTrianglePoints(nullptr)
     , myNPoints(0)
     , myPositions(nullptr)
+    , myInitCost(0)
 {}
 
 template<typename T,typename S>
@@ -6564,6 +6581,40 @@ inline void UT_SolidAngle<T,S>::init(
     timer.start();
 #endif
     UT_SmallArray<UT::Box<S,3>> triangle_boxes;
+    computeTriangleBoxes(triangle_boxes);
+#if SOLID_ANGLE_TIME_PRECOMPUTE
+    double time = timer.stop();
+    UTdebugFormat("{} s to create bounding boxes.", time);
+    timer.start();
+#endif
+    myTree.template init<UT::BVH_Heuristic::BOX_AREA,S,3>(triangle_boxes.array(), ntriangles);
+#if SOLID_ANGLE_TIME_PRECOMPUTE
+    time = timer.stop();
+    UTdebugFormat("{} s to initialize UT_BVH structure.  {} nodes", time, myTree.getNumNodes());
+#endif
+
+    //myTree.debugDump();
+
+    myInitCost = precompute(triangle_boxes.array());
+}
+
+template<typename T,typename S>
+inline T UT_SolidAngle<T,S>::refit(const UT_Vector3T<S> *const positions)
+{
+    myPositions = positions;
+    UT_SmallArray<UT::Box<S,3>> triangle_boxes;
+    computeTriangleBoxes(triangle_boxes);
+    const T cost = precompute(triangle_boxes.array());
+    return myInitCost > 0 ? cost/myInitCost : T(1);
+}
+
+template<typename T,typename S>
+inline void UT_SolidAngle<T,S>::computeTriangleBoxes(
+    UT_SmallArray<UT::Box<S,3>> &triangle_boxes) const
+{
+    const int ntriangles = myNTriangles;
+    const int *const triangle_points = myTrianglePoints;
+    const UT_Vector3T<S> *const positions = myPositions;
     triangle_boxes.setSizeNoInit(ntriangles);
     if (ntriangles < 16*1024)
     {
@@ -6588,24 +6639,23 @@ inline void UT_SolidAngle<T,S>::init(
           box.enlargeBounds(positions[cur_triangle_points[2]]);
         });
     }
-#if SOLID_ANGLE_TIME_PRECOMPUTE
-    double time = timer.stop();
-    UTdebugFormat("{} s to create bounding boxes.", time);
-    timer.start();
-#endif
-    myTree.template init<UT::BVH_Heuristic::BOX_AREA,S,3>(triangle_boxes.array(), ntriangles);
-#if SOLID_ANGLE_TIME_PRECOMPUTE
-    time = timer.stop();
-    UTdebugFormat("{} s to initialize UT_BVH structure.  {} nodes", time, myTree.getNumNodes());
-#endif
-
-    //myTree.debugDump();
+}
 
+template<typename T,typename S>
+inline T UT_SolidAngle<T,S>::precompute(const UT::Box<S,3> *triangle_boxes)
+{
+    const int *const triangle_points = myTrianglePoints;
+    const UT_Vector3T<S> *const positions = myPositions;
+    const int order = myOrder;
     const int nnodes = myTree.getNumNodes();
 
-    myNBoxes = nnodes;
-    BoxData *box_data = new BoxData[nnodes];
-    myData.reset(box_data);
+    // Refitting keeps the same tree, so only (re)allocate when it changed
+    if (!myData || myNBoxes != nnodes)
+    {
+        myNBoxes = nnodes;
+        myData.reset(new BoxData[nnodes]);
+    }
+    BoxData *box_data = myData.get();
 
     // Some data are only needed during initialization.
     struct LocalData
@@ -6621,6 +6671,9 @@ inline void UT_SolidAngle<T,S>::init(
         // Unsigned area is needed for computing the average position.
         T myArea;
 
+        // Sum of half surface areas of node boxes in this subtree
+        T myBoxAreaSum;
+
 #if TAYLOR_SERIES_ORDER >= 1
         // These are needed for computing Nijk.
         UT_Vector3T<T> myNijDiag;
@@ -6693,6 +6746,7 @@ inline void UT_SolidAngle<T,S>::init(
 #endif
 
             data_for_parent.myArea = area;
+            data_for_parent.myBoxAreaSum = 0;
 #if TAYLOR_SERIES_ORDER >= 1
             const int order = myOrder;
             if (order < 1)
@@ -6948,6 +7002,11 @@ inline void UT_SolidAngle<T,S>::init(
 
             data_for_parent->myBox = box;
 
+            T box_area_sum = box.half_surface_area();
+            for (int i = 0; i < nchildren; ++i)
+                box_area_sum += child_data_array[i].myBoxAreaSum;
+            data_for_parent->myBoxAreaSum = box_area_sum;
+
             for (int i = 0; i < nchildren; ++i)
             {
                 const UT::Box<S,3> &local_box(child_data_array[i].myBox);
@@ -7119,17 +7178,24 @@ inline void UT_SolidAngle<T,S>::init(
     };
 
 #if SOLID_ANGLE_TIME_PRECOMPUTE
+    UT_StopWatch timer;
     timer.start();
 #endif
-    const PrecomputeFunctors functors(box_data, triangle_boxes.array(), triangle_points, positions, order);
+    const PrecomputeFunctors functors(box_data, triangle_boxes, triangle_points, positions, order);
     // NOTE: post-functor relies on non-null data_for_parent, so we have to pass one.
     LocalData local_data;
+    local_data.myBoxAreaSum = 0;
     myTree.template traverseParallel<LocalData>(4096, functors, &local_data);
     //myTree.template traverse<LocalData>(functors);
 #if SOLID_ANGLE_TIME_PRECOMPUTE
-    time = timer.stop();
+    const double time = timer.stop();
     UTdebugFormat("{} s to precompute coefficients.", time);
 #endif
+    if (nnodes == 0)
+        return T(0);
+    // Surface area heuristic cost normalized by the root box
+    const T root_area = local_data.myBox.half_surface_area();
+    return root_area > 0 ? local_data.myBoxAreaSum/root_area : T(0);
 }
 
 template<typename T,typename S>
@@ -0,0 +1,795 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "FlatAABB.h"
+#include "EPS.h"
+#include "doublearea.h"
+#include "parallel_for.h"
+#include "point_simplex_squared_distance.h"
+#include "ray_mesh_intersect.h"
+#include "volume.h"
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace
+{
+  // Fixed-capacity traversal stack falling back to the heap for unusually
+  // deep trees
+  template <typename T>
+  class FlatAABB_stack
+  {
+  public:
+    FlatAABB_stack():m_size(0){}
+    void push(const T & t)
+    {
+      if(m_size < m_fixed.size())
+      {
+        m_fixed[m_size] = t;
+      }else
+      {
+        m_overflow.push_back(t);
+      }
+      m_size++;
+    }
+    T pop()
+    {
+      m_size--;
+      if(m_size < m_fixed.size())
+      {
+        return m_fixed[m_size];
+      }
+      const T t = m_overflow.back();
+      m_overflow.pop_back();
+      return t;
+    }
+    bool empty() const { return m_size == 0; }
+  private:
+    std::array<T,64> m_fixed;
+    std::vector<T> m_overflow;
+    size_t m_size;
+  };
+
+  // Surface area heuristic measure (perimeter in 2D, half surface area in
+  // 3D)
+  template <typename Scalar, int DIM>
+  Scalar FlatAABB_sah_measure(const Eigen::AlignedBox<Scalar,DIM> & box)
+  {
+    if(box.isEmpty()) { return 0; }
+    const Eigen::Matrix<Scalar,DIM,1> d = box.diagonal();
+    if(DIM == 2) { return d.sum(); }
+    Scalar a = 0;
+    for(int i = 0;i<DIM;i++)
+    {
+      for(int j = i+1;j<DIM;j++)
+      {
+        a += d(i)*d(j);
+      }
+    }
+    return a;
+  }
+
+  template <typename Scalar>
+  float FlatAABB_round_down(const Scalar x)
+  {
+    float f = static_cast<float>(x);
+    if(static_cast<Scalar>(f) > x)
+    {
+      f = std::nextafter(f,-std::numeric_limits<float>::infinity());
+    }
+    return f;
+  }
+
+  template <typename Scalar>
+  float FlatAABB_round_up(const Scalar x)
+  {
+    float f = static_cast<float>(x);
+    if(static_cast<Scalar>(f) < x)
+    {
+      f = std::nextafter(f,std::numeric_limits<float>::infinity());
+    }
+    return f;
+  }
+
+  // Componentwise 1/dir with 0 marking axes the ray is parallel to (avoids
+  // dividing by zero)
+  template <typename Derived>
+  Derived FlatAABB_safe_inverse(const Derived & dir)
+  {
+    Derived inv_dir;
+    for(int d = 0;d<dir.size();d++)
+    {
+      inv_dir(d) = dir(d) == 0 ? 0 : 1/dir(d);
+    }
+    return inv_dir;
+  }
+
+  // Whether q lies inside the (d+1)-simplex primitive (up to igl::EPS)
+  template <typename DerivedV, typename DerivedEle, typename Derivedq, int DIM>
+  struct FlatAABB_contains_helper;
+
+  template <typename DerivedV, typename DerivedEle, typename Derivedq>
+  struct FlatAABB_contains_helper<DerivedV,DerivedEle,Derivedq,2>
+  {
+    static bool compute(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedEle> & Ele,
+      const int primitive,
+      const Eigen::MatrixBase<Derivedq> & q)
+    {
+      using Scalar = typename DerivedV::Scalar;
+      typedef Eigen::Matrix<Scalar,2,1> Vector2S;
+      const Scalar epsilon = igl::EPS<Scalar>();
+      const Vector2S V1 = V.row(Ele(primitive,0));
+      const Vector2S V2 = V.row(Ele(primitive,1));
+      const Vector2S V3 = V.row(Ele(primitive,2));
+      const Vector2S q2 = q.head(2).template cast<Scalar>();
+      Scalar a1 = igl::doublearea_single(V1,V2,q2);
+      Scalar a2 = igl::doublearea_single(V2,V3,q2);
+      Scalar a3 = igl::doublearea_single(V3,V1,q2);
+      const Scalar sum = a1+a2+a3;
+      a1 /= sum;
+      a2 /= sum;
+      a3 /= sum;
+      return a1>=-epsilon && a2>=-epsilon && a3>=-epsilon;
+    }
+  };
+
+  template <typename DerivedV, typename DerivedEle, typename Derivedq>
+  struct FlatAABB_contains_helper<DerivedV,DerivedEle,Derivedq,3>
+  {
+    static bool compute(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedEle> & Ele,
+      const int primitive,
+      const Eigen::MatrixBase<Derivedq> & q)
+    {
+      using Scalar = typename DerivedV::Scalar;
+      typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+      const Scalar epsilon = igl::EPS<Scalar>();
+      const RowVector3S V1 = V.row(Ele(primitive,0));
+      const RowVector3S V2 = V.row(Ele(primitive,1));
+      const RowVector3S V3 = V.row(Ele(primitive,2));
+      const RowVector3S V4 = V.row(Ele(primitive,3));
+      const RowVector3S q3 = q.template cast<Scalar>();
+      Scalar a1 = igl::volume_single(V2,V4,V3,q3);
+      Scalar a2 = igl::volume_single(V1,V3,V4,q3);
+      Scalar a3 = igl::volume_single(V1,V4,V2,q3);
+      Scalar a4 = igl::volume_single(V1,V2,V3,q3);
+      const Scalar sum = a1+a2+a3+a4;
+      a1 /= sum;
+      a2 /= sum;
+      a3 /= sum;
+      a4 /= sum;
+      return a1>=-epsilon && a2>=-epsilon && a3>=-epsilon && a4>=-epsilon;
+    }
+  };
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::clear()
+{
+  m_nodes.clear();
+  m_primitives.clear();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::FlatAABB<DerivedV,DIM>::empty() const
+{
+  return m_nodes.empty();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE int igl::FlatAABB<DerivedV,DIM>::size() const
+{
+  return static_cast<int>(m_nodes.size());
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE int igl::FlatAABB<DerivedV,DIM>::height() const
+{
+  if(m_nodes.empty()) { return 0; }
+  int h = 0;
+  FlatAABB_stack<std::pair<int,int>> stack;
+  stack.push({0,1});
+  while(!stack.empty())
+  {
+    const auto nd = stack.pop();
+    h = std::max(h,nd.second);
+    const Node & node = m_nodes[nd.first];
+    if(!node.is_leaf())
+    {
+      stack.push({nd.first+1,nd.second+1});
+      stack.push({node.offset,nd.second+1});
+    }
+  }
+  return h;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::init(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const int max_leaf_size,
+  const int num_bins)
+{
+  typedef Eigen::AlignedBox<Scalar,DIM> Box;
+  clear();
+  const int m = Ele.rows();
+  if(V.size() == 0 || m == 0)
+  {
+    return;
+  }
+  assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+  assert(max_leaf_size >= 1);
+  assert(num_bins >= 2);
+  // Per-primitive boxes and centroids
+  std::vector<Box> PB(m);
+  std::vector<Eigen::Matrix<Scalar,DIM,1>> PC(m);
+  igl::parallel_for(m,[&](const int e)
+  {
+    PB[e].setEmpty();
+    for(int c = 0;c<Ele.cols();c++)
+    {
+      PB[e].extend(V.row(Ele(e,c)).transpose());
+    }
+    PC[e] = PB[e].center();
+  },10000);
+  m_primitives.resize(m);
+  std::iota(m_primitives.begin(),m_primitives.end(),0);
+  m_nodes.reserve(2*((m+max_leaf_size-1)/max_leaf_size));
+
+  struct Bin
+  {
+    Box box;
+    int count;
+  };
+  std::vector<Bin> bins(num_bins);
+  std::vector<Scalar> right_measure(num_bins);
+  std::vector<int> right_count(num_bins);
+
+  // Tasks are processed depth first so that the left child of a node is
+  // always the next node. `parent` is the node whose right child index must
+  // be patched (or -1).
+  struct Task
+  {
+    int begin;
+    int end;
+    int parent;
+  };
+  FlatAABB_stack<Task> tasks;
+  tasks.push({0,m,-1});
+  while(!tasks.empty())
+  {
+    const Task task = tasks.pop();
+    const int ni = static_cast<int>(m_nodes.size());
+    if(task.parent >= 0) { m_nodes[task.parent].offset = ni; }
+    m_nodes.emplace_back();
+    Box box,cbox;
+    box.setEmpty();
+    cbox.setEmpty();
+    for(int i = task.begin;i<task.end;i++)
+    {
+      box.extend(PB[m_primitives[i]]);
+      cbox.extend(PC[m_primitives[i]]);
+    }
+    {
+      Node & node = m_nodes[ni];
+      for(int d = 0;d<DIM;d++)
+      {
+        node.min[d] = FlatAABB_round_down(box.min()(d));
+        node.max[d] = FlatAABB_round_up(box.max()(d));
+      }
+    }
+    const int n = task.end-task.begin;
+    const auto make_leaf = [&]()
+    {
+      m_nodes[ni].offset = task.begin;
+      m_nodes[ni].count = n;
+    };
+    if(n == 1)
+    {
+      make_leaf();
+      continue;
+    }
+
+    // Binned SAH: find the axis and bin boundary minimizing
+    //   nL·A(L) + nR·A(R)
+    Scalar best_cost = std::numeric_limits<Scalar>::infinity();
+    int best_axis = -1;
+    int best_split = -1;
+    int best_imbalance = n;
+    for(int d = 0;d<DIM;d++)
+    {
+      const Scalar lo = cbox.min()(d);
+      const Scalar extent = cbox.max()(d)-lo;
+      if(!(extent > 0)) { continue; }
+      const Scalar scale = Scalar(num_bins)/extent;
+      for(auto & bin : bins) { bin.box.setEmpty(); bin.count = 0; }
+      for(int i = task.begin;i<task.end;i++)
+      {
+        const int e = m_primitives[i];
+        const int b = std::min(num_bins-1,int((PC[e](d)-lo)*scale));
+        bins[b].box.extend(PB[e]);
+        bins[b].count++;
+      }
+      {
+        Box acc;
+        acc.setEmpty();
+        int count = 0;
+        for(int b = num_bins-1;b>0;b--)
+        {
+          acc.extend(bins[b].box);
+          count += bins[b].count;
+          right_measure[b] = FlatAABB_sah_measure(acc);
+          right_count[b] = count;
+        }
+      }
+      Box acc;
+      acc.setEmpty();
+      int count = 0;
+      for(int s = 1;s<num_bins;s++)
+      {
+        acc.extend(bins[s-1].box);
+        count += bins[s-1].count;
+        if(count == 0 || right_count[s] == 0) { continue; }
+        const Scalar cost =
+          count*FlatAABB_sah_measure(acc) + right_count[s]*right_measure[s];
+        const int imbalance = std::abs(count-right_count[s]);
+        if(cost < best_cost || (cost == best_cost && imbalance < best_imbalance))
+        {
+          best_cost = cost;
+          best_axis = d;
+          best_split = s;
+          best_imbalance = imbalance;
+        }
+      }
+    }
+
+    if(n <= max_leaf_size &&
+      (best_axis < 0 || n*FlatAABB_sah_measure(box) <= best_cost))
+    {
+      make_leaf();
+      continue;
+    }
+
+    int mid;
+    if(best_axis >= 0)
+    {
+      const Scalar lo = cbox.min()(best_axis);
+      const Scalar scale =
+        Scalar(num_bins)/(cbox.max()(best_axis)-lo);
+      mid = static_cast<int>(std::partition(
+        m_primitives.begin()+task.begin,
+        m_primitives.begin()+task.end,
+        [&](const int e)
+        {
+          return std::min(num_bins-1,int((PC[e](best_axis)-lo)*scale))
+            < best_split;
+        }) - m_primitives.begin());
+    }else
+    {
+      // All centroids coincide: any split is as good as another
+      mid = task.begin + n/2;
+    }
+    assert(mid > task.begin && mid < task.end);
+    m_nodes[ni].count = 0;
+    // Right is processed after the entire left subtree
+    tasks.push({mid,task.end,ni});
+    tasks.push({task.begin,mid,-1});
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE typename igl::FlatAABB<DerivedV,DIM>::Scalar
+igl::FlatAABB<DerivedV,DIM>::box_squared_distance(
+  const Node & n,
+  const RowVectorDIMS & p) const
+{
+  Scalar sqr_d = 0;
+  for(int d = 0;d<DIM;d++)
+  {
+    const Scalar lo = n.min[d];
+    const Scalar hi = n.max[d];
+    if(p(d) < lo)
+    {
+      sqr_d += (lo-p(d))*(lo-p(d));
+    }else if(p(d) > hi)
+    {
+      sqr_d += (p(d)-hi)*(p(d)-hi);
+    }
+  }
+  return sqr_d;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::FlatAABB<DerivedV,DIM>::ray_box(
+  const Node & n,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & inv_dir,
+  const Scalar t1,
+  Scalar & tmin) const
+{
+  // Pad far distances by a few ulps to stay conservative
+  const Scalar pad = 1+4*std::numeric_limits<Scalar>::epsilon();
+  tmin = 0;
+  Scalar tmax = t1;
+  for(int d = 0;d<DIM;d++)
+  {
+    if(inv_dir(d) == 0)
+    {
+      // Ray parallel to slab
+      if(origin(d) < Scalar(n.min[d]) || origin(d) > Scalar(n.max[d]))
+      {
+        return false;
+      }
+      continue;
+    }
+    Scalar ta = (Scalar(n.min[d])-origin(d))*inv_dir(d);
+    Scalar tb = (Scalar(n.max[d])-origin(d))*inv_dir(d);
+    if(ta > tb) { std::swap(ta,tb); }
+    tb *= pad;
+    if(ta > tmin) { tmin = ta; }
+    if(tb < tmax) { tmax = tb; }
+    if(tmin > tmax) { return false; }
+  }
+  return true;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle, typename Derivedq>
+IGL_INLINE std::vector<int> igl::FlatAABB<DerivedV,DIM>::find(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<Derivedq> & q,
+  const bool first) const
+{
+  assert(q.size() == DIM &&
+      "Query dimension should match aabb dimension");
+  assert(Ele.cols() == V.cols()+1 &&
+      "FlatAABB::find only makes sense for (d+1)-simplices");
+  std::vector<int> found;
+  if(m_nodes.empty()) { return found; }
+  const auto inside = [&q](const Node & n)
+  {
+    for(int d = 0;d<DIM;d++)
+    {
+      if(q(d) < Scalar(n.min[d]) || q(d) > Scalar(n.max[d])) { return false; }
+    }
+    return true;
+  };
+  FlatAABB_stack<int> stack;
+  stack.push(0);
+  while(!stack.empty())
+  {
+    const int ni = stack.pop();
+    const Node & node = m_nodes[ni];
+    if(!inside(node)) { continue; }
+    if(node.is_leaf())
+    {
+      for(int k = node.offset;k<node.offset+node.count;k++)
+      {
+        const int e = m_primitives[k];
+        if(FlatAABB_contains_helper<DerivedV,DerivedEle,Derivedq,DIM>::
+            compute(V,Ele,e,q))
+        {
+          found.push_back(e);
+          if(first) { return found; }
+        }
+      }
+      continue;
+    }
+    stack.push(node.offset);
+    stack.push(ni+1);
+  }
+  return found;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::FlatAABB<DerivedV,DIM>::Scalar
+igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  const Scalar up_sqr_d,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  Scalar sqr_d = up_sqr_d;
+  i = -1;
+  if(m_nodes.empty()) { return sqr_d; }
+  assert((Ele.cols() == 3 || Ele.cols() == 2 || Ele.cols() == 1)
+    && "Code has only been tested for simplex sizes 3,2,1");
+  // (node, lower bound on squared distance)
+  FlatAABB_stack<std::pair<int,Scalar>> stack;
+  stack.push({0,box_squared_distance(m_nodes[0],p)});
+  RowVectorDIMS c_candidate;
+  while(!stack.empty())
+  {
+    const auto nd = stack.pop();
+    if(nd.second >= sqr_d) { continue; }
+    const Node & node = m_nodes[nd.first];
+    if(node.is_leaf())
+    {
+      for(int k = node.offset;k<node.offset+node.count;k++)
+      {
+        const int e = m_primitives[k];
+        Scalar sqr_d_candidate;
+        igl::point_simplex_squared_distance<DIM>(
+          p,V,Ele,e,sqr_d_candidate,c_candidate);
+        if(sqr_d_candidate < sqr_d)
+        {
+          sqr_d = sqr_d_candidate;
+          i = e;
+          c = c_candidate;
+        }
+      }
+      continue;
+    }
+    const int l = nd.first+1;
+    const int r = node.offset;
+    const Scalar dl = box_squared_distance(m_nodes[l],p);
+    const Scalar dr = box_squared_distance(m_nodes[r],p);
+    // Visit nearer child first
+    if(dl < dr)
+    {
+      if(dr < sqr_d) { stack.push({r,dr}); }
+      if(dl < sqr_d) { stack.push({l,dl}); }
+    }else
+    {
+      if(dl < sqr_d) { stack.push({l,dl}); }
+      if(dr < sqr_d) { stack.push({r,dr}); }
+    }
+  }
+  return sqr_d;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::FlatAABB<DerivedV,DIM>::Scalar
+igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  return squared_distance(V,Ele,p,std::numeric_limits<Scalar>::infinity(),i,c);
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename DerivedP,
+  typename DerivedsqrD,
+  typename DerivedI,
+  typename DerivedC>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C) const
+{
+  assert(P.cols() == V.cols() && "cols in P should match dim of cols in V");
+  sqrD.resize(P.rows(),1);
+  I.resize(P.rows(),1);
+  C.resizeLike(P);
+  igl::parallel_for(P.rows(),[&](int p)
+  {
+    RowVectorDIMS Pp = P.row(p).template cast<Scalar>(), c;
+    int Ip;
+    sqrD(p) = squared_distance(V,Ele,Pp,Ip,c);
+    I(p) = Ip;
+    C.row(p) = c.template cast<typename DerivedC::Scalar>();
+  },
+  10000);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  std::vector<igl::Hit<Scalar>> & hits) const
+{
+  hits.clear();
+  if(m_nodes.empty()) { return false; }
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  const RowVectorDIMS inv_dir = FlatAABB_safe_inverse(dir);
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  FlatAABB_stack<int> stack;
+  stack.push(0);
+  while(!stack.empty())
+  {
+    const int ni = stack.pop();
+    const Node & node = m_nodes[ni];
+    Scalar tmin;
+    if(!ray_box(node,origin,inv_dir,inf,tmin)) { continue; }
+    if(node.is_leaf())
+    {
+      for(int k = node.offset;k<node.offset+node.count;k++)
+      {
+        igl::Hit<Scalar> hit;
+        if(igl::ray_triangle_intersect(origin,dir,V,Ele,m_primitives[k],hit))
+        {
+          hits.push_back(hit);
+        }
+      }
+      continue;
+    }
+    stack.push(node.offset);
+    stack.push(ni+1);
+  }
+  std::sort(hits.begin(),hits.end(),
+    [](const igl::Hit<Scalar> & a, const igl::Hit<Scalar> & b)
+    { return a.t < b.t; });
+  return !hits.empty();
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  igl::Hit<Scalar> & hit) const
+{
+  return intersect_ray(
+    V,Ele,origin,dir,std::numeric_limits<Scalar>::infinity(),hit);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  const Scalar min_t,
+  igl::Hit<Scalar> & hit) const
+{
+  if(m_nodes.empty()) { return false; }
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  const RowVectorDIMS inv_dir = FlatAABB_safe_inverse(dir);
+  Scalar best_t = min_t;
+  bool any = false;
+  // (node, entry t)
+  FlatAABB_stack<std::pair<int,Scalar>> stack;
+  {
+    Scalar tmin;
+    if(!ray_box(m_nodes[0],origin,inv_dir,best_t,tmin)) { return false; }
+    stack.push({0,tmin});
+  }
+  while(!stack.empty())
+  {
+    const auto nt = stack.pop();
+    if(nt.second > best_t) { continue; }
+    const Node & node = m_nodes[nt.first];
+    if(node.is_leaf())
+    {
+      for(int k = node.offset;k<node.offset+node.count;k++)
+      {
+        igl::Hit<Scalar> leaf_hit;
+        if(igl::ray_triangle_intersect(
+            origin,dir,V,Ele,m_primitives[k],leaf_hit) &&
+          leaf_hit.t < best_t)
+        {
+          best_t = leaf_hit.t;
+          hit = leaf_hit;
+          any = true;
+        }
+      }
+      continue;
+    }
+    const int l = nt.first+1;
+    const int r = node.offset;
+    Scalar tl,tr;
+    const bool hl = ray_box(m_nodes[l],origin,inv_dir,best_t,tl);
+    const bool hr = ray_box(m_nodes[r],origin,inv_dir,best_t,tr);
+    // Visit nearer child first
+    if(hl && hr)
+    {
+      if(tl < tr)
+      {
+        stack.push({r,tr});
+        stack.push({l,tl});
+      }else
+      {
+        stack.push({l,tl});
+        stack.push({r,tr});
+      }
+    }else if(hl)
+    {
+      stack.push({l,tl});
+    }else if(hr)
+    {
+      stack.push({r,tr});
+    }
+  }
+  return any;
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename DerivedOrigin,
+  typename DerivedDir,
+  typename DerivedI,
+  typename DerivedT,
+  typename DerivedUV>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<DerivedOrigin> & origin,
+  const Eigen::MatrixBase<DerivedDir> & dir,
+  const Scalar min_t,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedT> & T,
+  Eigen::PlainObjectBase<DerivedUV> & UV) const
+{
+  assert(origin.rows() == dir.rows());
+  I.setConstant(origin.rows(),1,-1);
+  T.setConstant(origin.rows(),1,std::numeric_limits<Scalar>::quiet_NaN());
+  UV.resize(origin.rows(),2);
+  igl::parallel_for(origin.rows(),[&](int i)
+  {
+    const RowVectorDIMS origin_i = origin.row(i).template cast<Scalar>();
+    const RowVectorDIMS dir_i = dir.row(i).template cast<Scalar>();
+    igl::Hit<Scalar> hit_i;
+    if(intersect_ray(V,Ele,origin_i,dir_i,min_t,hit_i))
+    {
+      I(i) = hit_i.id;
+      UV.row(i) << hit_i.u, hit_i.v;
+      T(i) = hit_i.t;
+    }
+  },
+  10000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>;
+template class igl::FlatAABB<Eigen::Matrix<double, -1, 3, 0, -1, 3>, 3>;
+template class igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, int);
+template void igl::FlatAABB<Eigen::Matrix<double, -1, 3, 0, -1, 3>, 3>::init<Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, int, int);
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, int);
+template double igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
+template double igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template bool igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, igl::Hit<double>&) const;
+template bool igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit<double>, std::allocator<igl::Hit<double> > >&) const;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template std::vector<int> igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, -1, 1, 1, -1> > const&, bool) const;
+template std::vector<int> igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, -1, 1, 1, -1> > const&, bool) const;
+template class igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>;
+template class igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>;
+template void igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, int);
+template void igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, int);
+template float igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, float, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> >&) const;
+template float igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> >&) const;
+template void igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template bool igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, igl::Hit<float>&) const;
+template bool igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit<float>, std::allocator<igl::Hit<float> > >&) const;
+template void igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, float, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template std::vector<int> igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, -1, 1, 1, -1> > const&, bool) const;
+template std::vector<int> igl::FlatAABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, -1, 1, 1, -1> > const&, bool) const;
+#endif
@@ -0,0 +1,246 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_FLAT_AABB_H
+#define IGL_FLAT_AABB_H
+
+#include "Hit.h"
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  /// Static axis-aligned bounding box hierarchy stored in a single contiguous
+  /// array of nodes. This is a drop-in alternative to igl::AABB for meshes
+  /// that do not change after construction: it supports the same
+  /// `squared_distance`, `intersect_ray` and `find` queries but is built with
+  /// a binned surface area heuristic (SAH) and its nodes are laid out in
+  /// depth-first order (the left child of node i is node i+1) with
+  /// single-precision bounds, so that traversal streams through memory rather
+  /// than chasing pointers across the heap.
+  ///
+  /// Node bounds are rounded outward when converted to float so all queries
+  /// remain exact with respect to the (e.g., double precision) input mesh.
+  ///
+  /// The mesh (V,Ele) is stored and managed by the caller and each routine
+  /// here simply takes it as references (it better not change between calls).
+  ///
+  /// @tparam DerivedV  Matrix type of vertex positions (e.g., `Eigen::MatrixXd`)
+  /// @tparam DIM Dimension of mesh vertex positions (2 or 3)
+  ///
+  /// \see AABB
+  template <typename DerivedV, int DIM>
+    class FlatAABB
+    {
+public:
+      /// Scalar type of vertex positions (e.g., `double`)
+      typedef typename DerivedV::Scalar Scalar;
+      /// Fixed-size (`DIM`) RowVector type using `Scalar`
+      typedef Eigen::Matrix<Scalar,1,DIM> RowVectorDIMS;
+      /// Single node of the hierarchy (32 bytes in 3D)
+      struct Node
+      {
+        /// Minimum corner (rounded down to float)
+        float min[DIM];
+        /// Maximum corner (rounded up to float)
+        float max[DIM];
+        /// Internal node: index of right child (left child is implicitly the
+        /// next node). Leaf: offset into m_primitives.
+        int offset;
+        /// Number of primitives in leaf, 0 for internal nodes
+        int count;
+        /// @return whether this node is a leaf
+        bool is_leaf() const { return count > 0; }
+      };
+      /// Nodes in depth-first order, m_nodes[0] is the root
+      std::vector<Node> m_nodes;
+      /// Indices into Ele referenced by leaves in contiguous runs
+      std::vector<int> m_primitives;
+      /// Build the hierarchy for a given mesh using a binned SAH.
+      ///
+      /// @param[in] V  #V by dim list of mesh vertex positions.
+      /// @param[in] Ele  #Ele by dim+1 list of mesh indices into #V (or #Ele
+      ///   by 1 list of point indices)
+      /// @param[in] max_leaf_size  maximum number of primitives per leaf
+      /// @param[in] num_bins  number of SAH bins per axis
+      template <typename DerivedEle>
+      IGL_INLINE void init(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const int max_leaf_size = 4,
+        const int num_bins = 16);
+      /// Remove all nodes
+      IGL_INLINE void clear();
+      /// @return whether there are no nodes
+      IGL_INLINE bool empty() const;
+      /// @return total number of nodes
+      IGL_INLINE int size() const;
+      /// @return height of the tree (a singleton root has height 1)
+      IGL_INLINE int height() const;
+      /// Find the indices of elements containing given point: this makes sense
+      /// when Ele is a co-dimension 0 simplex (tets in 3D, triangles in 2D).
+      ///
+      /// @param[in]  V  #V by dim list of mesh vertex positions. **Should be
+      ///   same as used to construct mesh.**
+      /// @param[in]  Ele  #Ele by dim+1 list of mesh indices into #V. **Should
+      ///   be same as used to construct mesh.**
+      /// @param[in]  q  dim row-vector query position
+      /// @param[in]  first  whether to only return first element containing q
+      /// @return  list of indices of elements containing q
+      template <typename DerivedEle, typename Derivedq>
+      IGL_INLINE std::vector<int> find(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::MatrixBase<Derivedq> & q,
+        const bool first=false) const;
+      /// Compute squared distance to a query point if within `up_sqr_d`
+      ///
+      /// @param[in] V  #V by dim list of vertex positions
+      /// @param[in] Ele  #Ele by dim list of simplex indices
+      /// @param[in] p  dim-long query point
+      /// @param[in] up_sqr_d  upper bound on squared distance, beyond which
+      ///   primitives are not considered
+      /// @param[out] i  facet index corresponding to smallest distances (-1
+      ///   if nothing within up_sqr_d)
+      /// @param[out] c  closest point
+      /// @return squared distance
+      template <typename DerivedEle>
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & p,
+        const Scalar up_sqr_d,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      /// \overload
+      template <typename DerivedEle>
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & p,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      /// Compute the squared distance from all query points in P to the
+      /// _closest_ points on the primitives stored in the hierarchy for the
+      /// mesh (V,Ele).
+      ///
+      /// @param[in] V  #V by dim list of vertex positions
+      /// @param[in] Ele  #Ele by dim list of simplex indices
+      /// @param[in] P  #P by dim list of query points
+      /// @param[out] sqrD  #P list of squared distances
+      /// @param[out] I  #P list of indices into Ele of closest primitives
+      /// @param[out] C  #P by dim list of closest points
+      template <
+        typename DerivedEle,
+        typename DerivedP,
+        typename DerivedsqrD,
+        typename DerivedI,
+        typename DerivedC>
+      IGL_INLINE void squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::MatrixBase<DerivedP> & P,
+        Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedC> & C) const;
+      /// Intersect a ray with the mesh return all hits
+      ///
+      /// @param[in]  V  #V by 3 list of vertex positions
+      /// @param[in]  Ele  #Ele by 3 list of triangle indices
+      /// @param[in]  origin  3-long ray origin
+      /// @param[in]  dir  3-long ray direction
+      /// @param[out]  hits  list of hits sorted by t
+      /// @return  true if any hits
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        std::vector<igl::Hit<Scalar>> & hits) const;
+      /// Intersect a ray with the mesh return first hit
+      ///
+      /// @param[in]  V  #V by 3 list of vertex positions
+      /// @param[in]  Ele  #Ele by 3 list of triangle indices
+      /// @param[in]  origin  3-long ray origin
+      /// @param[in]  dir  3-long ray direction
+      /// @param[out]  hit  first hit
+      /// @return  true if any hit
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        igl::Hit<Scalar> & hit) const;
+      /// Intersect a ray with the mesh return first hit closer than `min_t`
+      /// (same convention as AABB::intersect_ray)
+      ///
+      /// @param[in]  V  #V by 3 list of vertex positions
+      /// @param[in]  Ele  #Ele by 3 list of triangle indices
+      /// @param[in]  origin  3-long ray origin
+      /// @param[in]  dir  3-long ray direction
+      /// @param[in]  min_t  current closest t value
+      /// @param[out]  hit  first hit
+      /// @return  true if any hit
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        const Scalar min_t,
+        igl::Hit<Scalar> & hit) const;
+      /// Intersect rays with the mesh return first hit for each
+      ///
+      /// @param[in]  V  #V by 3 list of vertex positions
+      /// @param[in]  Ele  #Ele by 3 list of triangle indices
+      /// @param[in]  origin #ray by 3 list of ray origins
+      /// @param[in]  dir #ray by 3 list of ray directions
+      /// @param[in]  min_t  current closest t value
+      /// @param[out]  I #ray list of indices into Ele of closest primitives
+      ///   (-1 indicates no hit)
+      /// @param[out]  T #ray list of t values (nan indicates no hit)
+      /// @param[out]  UV #ray by 2 list of barycentric coordinates
+      template <
+        typename DerivedEle,
+        typename DerivedOrigin,
+        typename DerivedDir,
+        typename DerivedI,
+        typename DerivedT,
+        typename DerivedUV>
+      IGL_INLINE void intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::MatrixBase<DerivedOrigin> & origin,
+        const Eigen::MatrixBase<DerivedDir> & dir,
+        const Scalar min_t,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedT> & T,
+        Eigen::PlainObjectBase<DerivedUV> & UV) const;
+private:
+      // Squared distance from p to the box of node n
+      IGL_INLINE Scalar box_squared_distance(
+        const Node & n,
+        const RowVectorDIMS & p) const;
+      // Parametric interval [tmin,tmax] ∩ [0,t1] of the ray inside the box of
+      // node n, returns false if empty. inv_dir(d)==0 marks a ray parallel
+      // to axis d.
+      IGL_INLINE bool ray_box(
+        const Node & n,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & inv_dir,
+        const Scalar t1,
+        Scalar & tmin) const;
+    };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "FlatAABB.cpp"
+#endif
+
+#endif
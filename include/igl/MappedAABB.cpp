@@ -0,0 +1,268 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "MappedAABB.h"
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+IGL_INLINE void igl::AABBFileHeader::init(
+  const std::uint32_t _scalar_size,
+  const std::uint32_t _index_size,
+  const std::uint32_t _dim,
+  const std::uint32_t _simplex_size,
+  const std::uint64_t _num_V,
+  const std::uint64_t _num_F,
+  const std::uint64_t _num_B)
+{
+  std::memset(this,0,sizeof(AABBFileHeader));
+  std::memcpy(magic,"IGLAABB",8);
+  version = current_version;
+  byte_order = 0x01020304;
+  scalar_size = _scalar_size;
+  index_size = _index_size;
+  dim = _dim;
+  simplex_size = _simplex_size;
+  num_V = _num_V;
+  num_F = _num_F;
+  num_B = _num_B;
+  // Each array starts on a 64-byte boundary
+  const auto align = [](const std::uint64_t x){ return (x+63)/64*64; };
+  offset_V = sizeof(AABBFileHeader);
+  offset_F = align(offset_V + num_V*dim*scalar_size);
+  offset_B1 = align(offset_F + num_F*simplex_size*index_size);
+  offset_B2 = align(offset_B1 + num_B*dim*scalar_size);
+  offset_leaf = align(offset_B2 + num_B*dim*scalar_size);
+  file_size = align(offset_leaf + num_B*index_size);
+}
+
+IGL_INLINE bool igl::AABBFileHeader::valid(
+  const std::uint64_t actual_file_size) const
+{
+  if(std::memcmp(magic,"IGLAABB",8) != 0) { return false; }
+  if(version != current_version) { return false; }
+  if(byte_order != 0x01020304) { return false; }
+  if(scalar_size != 4 && scalar_size != 8) { return false; }
+  if(index_size != 4 && index_size != 8) { return false; }
+  // Widths are small, and only zero for empty arrays
+  if(dim > 4 || (dim == 0 && (num_V > 0 || num_B > 0))) { return false; }
+  if(simplex_size > 4 || (simplex_size == 0 && num_F > 0)) { return false; }
+  // Each array fits in the file on its own, so that the layout computed by
+  // init cannot overflow (and wrap around to the actual size)
+  const auto fits = [actual_file_size](
+    const std::uint64_t rows,const std::uint64_t row_bytes)
+  {
+    return row_bytes == 0 || rows <= actual_file_size/row_bytes;
+  };
+  if(
+    !fits(num_V,std::uint64_t(dim)*scalar_size) ||
+    !fits(num_F,std::uint64_t(simplex_size)*index_size) ||
+    !fits(num_B,std::uint64_t(dim)*scalar_size) ||
+    !fits(num_B,index_size))
+  {
+    return false;
+  }
+  // Recompute the layout from the sizes and compare
+  AABBFileHeader expected;
+  expected.init(
+    scalar_size,index_size,dim,simplex_size,num_V,num_F,num_B);
+  return
+    offset_V == expected.offset_V &&
+    offset_F == expected.offset_F &&
+    offset_B1 == expected.offset_B1 &&
+    offset_B2 == expected.offset_B2 &&
+    offset_leaf == expected.offset_leaf &&
+    file_size == expected.file_size &&
+    file_size == actual_file_size;
+}
+
+IGL_INLINE std::uint64_t igl::AABBFileHeader::compute_checksum(
+  const void * data,
+  const std::size_t size)
+{
+  const unsigned char * bytes = static_cast<const unsigned char *>(data);
+  std::uint64_t h = 0x9e3779b97f4a7c15ull ^ size;
+  for(std::size_t i = 0;i+8 <= size;i += 8)
+  {
+    std::uint64_t w;
+    std::memcpy(&w,bytes+i,8);
+    h ^= w*0xff51afd7ed558ccdull;
+    h = ((h<<27) | (h>>37))*0xc4ceb9fe1a85ec53ull;
+  }
+  return h;
+}
+
+template <typename Scalar, typename Index>
+igl::MappedAABB<Scalar,Index>::~MappedAABB()
+{
+  close();
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE bool igl::MappedAABB<Scalar,Index>::open(
+  const std::string & filename,
+  const bool verify_checksum)
+{
+  close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA(
+    filename.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL,NULL);
+  if(file == INVALID_HANDLE_VALUE)
+  {
+    fprintf(stderr,"IOError: MappedAABB::open() could not open %s\n",filename.c_str());
+    return false;
+  }
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(file,&size) || size.QuadPart < (LONGLONG)sizeof(AABBFileHeader))
+  {
+    CloseHandle(file);
+    fprintf(stderr,"Error: MappedAABB::open() %s is too small\n",filename.c_str());
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL);
+  if(mapping == NULL)
+  {
+    CloseHandle(file);
+    fprintf(stderr,"IOError: MappedAABB::open() could not map %s\n",filename.c_str());
+    return false;
+  }
+  m_data = static_cast<const unsigned char *>(
+    MapViewOfFile(mapping,FILE_MAP_READ,0,0,0));
+  m_file = file;
+  m_mapping = mapping;
+  m_size = static_cast<std::size_t>(size.QuadPart);
+  if(m_data == nullptr)
+  {
+    close();
+    fprintf(stderr,"IOError: MappedAABB::open() could not map %s\n",filename.c_str());
+    return false;
+  }
+#else
+  const int fd = ::open(filename.c_str(),O_RDONLY);
+  if(fd < 0)
+  {
+    fprintf(stderr,"IOError: MappedAABB::open() could not open %s\n",filename.c_str());
+    return false;
+  }
+  struct stat st;
+  if(fstat(fd,&st) != 0 || st.st_size < (off_t)sizeof(AABBFileHeader))
+  {
+    ::close(fd);
+    fprintf(stderr,"Error: MappedAABB::open() %s is too small\n",filename.c_str());
+    return false;
+  }
+  void * data = mmap(nullptr,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+  if(data == MAP_FAILED)
+  {
+    fprintf(stderr,"IOError: MappedAABB::open() could not map %s\n",filename.c_str());
+    return false;
+  }
+  m_data = static_cast<const unsigned char *>(data);
+  m_size = static_cast<std::size_t>(st.st_size);
+#endif
+  const AABBFileHeader & h = header();
+  if(!h.valid(m_size))
+  {
+    close();
+    fprintf(stderr,"Error: MappedAABB::open() %s is not a valid .aabb file\n",filename.c_str());
+    return false;
+  }
+  if(h.scalar_size != sizeof(Scalar) || h.index_size != sizeof(Index))
+  {
+    fprintf(stderr,"Error: MappedAABB::open() %s has %d-byte scalars and %d-byte indices\n",
+      filename.c_str(),(int)h.scalar_size,(int)h.index_size);
+    close();
+    return false;
+  }
+  if(verify_checksum && h.checksum != AABBFileHeader::compute_checksum(
+    m_data+sizeof(AABBFileHeader),m_size-sizeof(AABBFileHeader)))
+  {
+    close();
+    fprintf(stderr,"Error: MappedAABB::open() %s checksum mismatch\n",filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE void igl::MappedAABB<Scalar,Index>::close()
+{
+#ifdef _WIN32
+  if(m_data) { UnmapViewOfFile(m_data); }
+  if(m_mapping) { CloseHandle(static_cast<HANDLE>(m_mapping)); }
+  if(m_file) { CloseHandle(static_cast<HANDLE>(m_file)); }
+  m_mapping = nullptr;
+  m_file = nullptr;
+#else
+  if(m_data) { munmap(const_cast<unsigned char *>(m_data),m_size); }
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE Eigen::Map<const typename igl::MappedAABB<Scalar,Index>::MatrixXS>
+igl::MappedAABB<Scalar,Index>::V() const
+{
+  const AABBFileHeader & h = header();
+  return Eigen::Map<const MatrixXS>(
+    reinterpret_cast<const Scalar *>(m_data+h.offset_V),h.num_V,h.dim);
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE Eigen::Map<const typename igl::MappedAABB<Scalar,Index>::MatrixXI>
+igl::MappedAABB<Scalar,Index>::F() const
+{
+  const AABBFileHeader & h = header();
+  return Eigen::Map<const MatrixXI>(
+    reinterpret_cast<const Index *>(m_data+h.offset_F),h.num_F,h.simplex_size);
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE Eigen::Map<const typename igl::MappedAABB<Scalar,Index>::MatrixXS>
+igl::MappedAABB<Scalar,Index>::B1() const
+{
+  const AABBFileHeader & h = header();
+  return Eigen::Map<const MatrixXS>(
+    reinterpret_cast<const Scalar *>(m_data+h.offset_B1),h.num_B,h.dim);
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE Eigen::Map<const typename igl::MappedAABB<Scalar,Index>::MatrixXS>
+igl::MappedAABB<Scalar,Index>::B2() const
+{
+  const AABBFileHeader & h = header();
+  return Eigen::Map<const MatrixXS>(
+    reinterpret_cast<const Scalar *>(m_data+h.offset_B2),h.num_B,h.dim);
+}
+
+template <typename Scalar, typename Index>
+IGL_INLINE Eigen::Map<const typename igl::MappedAABB<Scalar,Index>::VectorXI>
+igl::MappedAABB<Scalar,Index>::leaf() const
+{
+  const AABBFileHeader & h = header();
+  return Eigen::Map<const VectorXI>(
+    reinterpret_cast<const Index *>(m_data+h.offset_leaf),h.num_B);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::MappedAABB<double, int>;
+template class igl::MappedAABB<float, int>;
+template class igl::MappedAABB<double, std::int64_t>;
+template class igl::MappedAABB<float, std::int64_t>;
+#endif
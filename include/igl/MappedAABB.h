@@ -0,0 +1,179 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MAPPED_AABB_H
+#define IGL_MAPPED_AABB_H
+#include "igl_inline.h"
+/// @file MappedAABB.h
+///
+/// .aabb - prebuilt bounding volume hierarchies
+/// ============================================
+///
+/// An .aabb file stores a mesh (V,F) together with a bounding box hierarchy
+/// in the implicit Eytzinger layout produced by igl::eytzinger_aabb and
+/// igl::AABB::serialize (children of node i are nodes 2i+1 and 2i+2). It is
+/// meant to be memory mapped so that a process can start querying a large
+/// static asset without rebuilding (or even copying) its tree.
+///
+/// All values are in the native byte order of the machine that wrote the
+/// file. Readers check it via AABBFileHeader::byte_order and reject files
+/// written with a different byte order rather than swapping.
+///
+/// The file starts with a 128-byte header (igl::AABBFileHeader) followed by
+/// five row-major arrays, each starting at a 64-byte aligned offset recorded
+/// in the header:
+///
+///     V     #V by dim scalars           vertex positions
+///     F     #F by ss indices            simplex indices into V
+///     B1    #B by dim scalars           node box minimum corners
+///     B2    #B by dim scalars           node box maximum corners
+///     leaf  #B indices                  primitive index into F for leaves,
+///                                       -1 for internal, -2 for empty nodes
+///
+/// Scalars are 4 or 8 byte IEEE floats and indices are 4 or 8 byte signed
+/// integers as recorded in the header. The header also stores a 64-bit
+/// checksum of everything after the header.
+#include <Eigen/Core>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace igl
+{
+  /// Fixed-size header at the start of an .aabb file
+  struct AABBFileHeader
+  {
+    /// "IGLAABB" followed by a zero byte
+    char magic[8];
+    /// Format version, currently 1
+    std::uint32_t version;
+    /// 0x01020304 as written by the producing machine
+    std::uint32_t byte_order;
+    /// Bytes per scalar (4 or 8)
+    std::uint32_t scalar_size;
+    /// Bytes per index (4 or 8)
+    std::uint32_t index_size;
+    /// Number of columns of V, B1 and B2
+    std::uint32_t dim;
+    /// Number of columns of F
+    std::uint32_t simplex_size;
+    /// Number of rows of V, F and B1/B2/leaf
+    std::uint64_t num_V, num_F, num_B;
+    /// Byte offsets of each array from the start of the file
+    std::uint64_t offset_V, offset_F, offset_B1, offset_B2, offset_leaf;
+    /// Total size of the file in bytes
+    std::uint64_t file_size;
+    /// Checksum of bytes [sizeof(AABBFileHeader),file_size)
+    std::uint64_t checksum;
+    std::uint8_t reserved[16];
+    /// Current format version
+    static constexpr std::uint32_t current_version = 1;
+    /// Fill in the magic, version, sizes and offsets (but not the checksum)
+    /// for the given array sizes.
+    IGL_INLINE void init(
+      const std::uint32_t scalar_size,
+      const std::uint32_t index_size,
+      const std::uint32_t dim,
+      const std::uint32_t simplex_size,
+      const std::uint64_t num_V,
+      const std::uint64_t num_F,
+      const std::uint64_t num_B);
+    /// Check magic, version, byte order, widths (dim and simplex_size at
+    /// most 4) and that all arrays lie within a file of the given size.
+    ///
+    /// @param[in] actual_file_size  size of the file in bytes
+    /// @return true iff header is valid
+    IGL_INLINE bool valid(const std::uint64_t actual_file_size) const;
+    /// Checksum used by the format
+    ///
+    /// @param[in] data  pointer to bytes
+    /// @param[in] size  number of bytes (multiple of 8)
+    /// @return 64-bit checksum
+    static IGL_INLINE std::uint64_t compute_checksum(
+      const void * data,
+      const std::size_t size);
+  };
+  static_assert(sizeof(AABBFileHeader) == 128,"AABBFileHeader must be 128 bytes");
+
+  /// Read-only, zero-copy view of an .aabb file mapped into memory. The
+  /// arrays are exposed as Eigen::Map's directly into the mapped pages, so
+  /// they can be handed to, e.g., igl::eytzinger_aabb_sdf or
+  /// igl::AABB::init without copying. Opening only faults in the pages that
+  /// queries actually touch.
+  ///
+  /// @tparam Scalar  expected scalar type (float or double)
+  /// @tparam Index  expected index type (e.g., int or std::int64_t)
+  ///
+  /// #### Example
+  ///
+  /// \code{cpp}
+  ///   igl::MappedAABB<double,int> file;
+  ///   if(!file.open("bunny.aabb")) { return; }
+  ///   igl::AABB<Eigen::MatrixXd,3> tree;
+  ///   Eigen::MatrixXd V = file.V();
+  ///   tree.init(V,file.F(),file.B1(),file.B2(),file.leaf());
+  /// \endcode
+  ///
+  /// \see writeAABB, readAABB
+  template <typename Scalar, typename Index>
+  class MappedAABB
+  {
+  public:
+    /// Row-major matrix of scalars
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>
+      MatrixXS;
+    /// Row-major matrix of indices
+    typedef Eigen::Matrix<Index,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>
+      MatrixXI;
+    /// Column vector of indices
+    typedef Eigen::Matrix<Index,Eigen::Dynamic,1> VectorXI;
+    MappedAABB() = default;
+    ~MappedAABB();
+    MappedAABB(const MappedAABB &) = delete;
+    MappedAABB & operator=(const MappedAABB &) = delete;
+    /// Map a file into memory
+    ///
+    /// @param[in] filename  path to .aabb file
+    /// @param[in] verify_checksum  whether to read the whole file once to
+    ///   check its checksum (otherwise only the header is validated)
+    /// @return true iff the file was mapped and its header (and optionally
+    ///   checksum) is valid and matches Scalar and Index
+    IGL_INLINE bool open(
+      const std::string & filename,
+      const bool verify_checksum = true);
+    /// Unmap the file (invalidates all maps returned by this object)
+    IGL_INLINE void close();
+    /// @return whether a file is currently mapped
+    bool is_open() const { return m_data != nullptr; }
+    /// @return header of the mapped file
+    const AABBFileHeader & header() const
+    { return *reinterpret_cast<const AABBFileHeader *>(m_data); }
+    /// @return #V by dim vertex positions
+    IGL_INLINE Eigen::Map<const MatrixXS> V() const;
+    /// @return #F by simplex_size simplex indices
+    IGL_INLINE Eigen::Map<const MatrixXI> F() const;
+    /// @return #B by dim node minimum corners
+    IGL_INLINE Eigen::Map<const MatrixXS> B1() const;
+    /// @return #B by dim node maximum corners
+    IGL_INLINE Eigen::Map<const MatrixXS> B2() const;
+    /// @return #B leaf flags/indices
+    IGL_INLINE Eigen::Map<const VectorXI> leaf() const;
+  private:
+    const unsigned char * m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    void * m_file = nullptr;
+    void * m_mapping = nullptr;
+#endif
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "MappedAABB.cpp"
+#endif
+
+#endif
@@ -0,0 +1,27 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PARALLELFORSCHEDULE_H
+#define IGL_PARALLELFORSCHEDULE_H
+namespace igl
+{
+  /// How iterations of a parallel loop are handed out to threads (in the
+  /// spirit of OpenMP's schedule clause)
+  enum ParallelForSchedule
+  {
+    /// Loop is cut into one contiguous block per thread
+    PARALLEL_FOR_SCHEDULE_STATIC = 0,
+    /// Threads repeatedly grab chunks of a fixed grain size
+    PARALLEL_FOR_SCHEDULE_DYNAMIC = 1,
+    /// Threads grab chunks proportional to the remaining work, shrinking
+    /// down to the grain size
+    PARALLEL_FOR_SCHEDULE_GUIDED = 2,
+    /// Number of schedules
+    NUM_PARALLEL_FOR_SCHEDULES = 3
+  };
+}
+#endif
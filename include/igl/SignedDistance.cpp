@@ -0,0 +1,226 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "SignedDistance.h"
+#include "parallel_for.h"
+#include "per_edge_normals.h"
+#include "per_face_normals.h"
+#include "per_vertex_normals.h"
+#include "pseudonormal_test.h"
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::init(
+  const Eigen::MatrixBase<DerivedV> & _V,
+  const Eigen::MatrixBase<DerivedF> & _F,
+  const SignedDistanceType _sign_type)
+{
+  assert(_F.cols() == 3 && "F should contain triangles");
+  V = _V;
+  F = _F;
+  sign_type = _sign_type;
+  tree.init(V,F);
+  precompute(true);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::refit(
+  const Eigen::MatrixBase<DerivedV> & _V)
+{
+  assert(_V.rows() == V.rows() && "refit expects the same number of vertices");
+  V = _V;
+  tree.refit(V,F);
+  precompute(false);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::precompute(
+  const bool topology_changed)
+{
+  switch(sign_type)
+  {
+    default:
+      assert(false && "Unknown SignedDistanceType");
+    case SIGNED_DISTANCE_TYPE_UNSIGNED:
+      break;
+    case SIGNED_DISTANCE_TYPE_DEFAULT:
+    case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
+      hier.set_mesh(V,F);
+      hier.grow();
+      break;
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+    {
+      const Eigen::MatrixXf Vf = V.template cast<float>();
+      // Rebuild once refitting has made the tree too loose
+      if(topology_changed || igl::fast_winding_number_refit(Vf,fwn_bvh) > 1.5)
+      {
+        igl::fast_winding_number(Vf,F,2,fwn_bvh);
+      }
+      break;
+    }
+    case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
+      // "Signed Distance Computation Using the Angle Weighted Pseudonormal"
+      // [Bærentzen & Aanæs 2005]
+      igl::per_face_normals(V,F,FN);
+      igl::per_vertex_normals(
+        V,F,PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE,FN,VN);
+      if(topology_changed)
+      {
+        igl::per_edge_normals(
+          V,F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,FN,EN,E,EMAP);
+      }else
+      {
+        // Same accumulation as per_edge_normals reusing E and EMAP
+        const int m = F.rows();
+        EN.setZero(E.rows(),3);
+        for(int f = 0;f<m;f++)
+        {
+          for(int c = 0;c<3;c++)
+          {
+            EN.row(EMAP(f+c*m)) += FN.row(f);
+          }
+        }
+        EN.rowwise().normalize();
+      }
+      break;
+  }
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE typename igl::SignedDistance<DerivedV,DerivedF>::Scalar
+igl::SignedDistance<DerivedV,DerivedF>::sign(
+  const RowVector3S & q,
+  const int i,
+  const RowVector3S & c,
+  RowVector3S & n) const
+{
+  switch(sign_type)
+  {
+    default:
+    case SIGNED_DISTANCE_TYPE_UNSIGNED:
+      return 1;
+    case SIGNED_DISTANCE_TYPE_DEFAULT:
+    case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
+      return 1.-2.*hier.winding_number(q);
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+      return 1.-2.*std::abs(
+        igl::fast_winding_number(fwn_bvh,2,q.template cast<float>().eval()));
+    case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
+    {
+      Scalar s;
+      RowVector3S cc = c;
+      igl::pseudonormal_test(V,F,FN,VN,EN,EMAP,q,i,cc,s,n);
+      return s;
+    }
+  }
+}
+
+template <typename DerivedV, typename DerivedF>
+template <
+  typename DerivedP,
+  typename DerivedS,
+  typename DerivedI,
+  typename DerivedC,
+  typename DerivedN>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::query(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const Scalar lower_bound,
+  const Scalar upper_bound,
+  Eigen::PlainObjectBase<DerivedS> & S,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedN> & N) const
+{
+  assert(P.cols() == 3 && "P should be 3D");
+  // convert to bounds on (unsigned) squared distances
+  const Scalar max_abs = std::max(std::abs(lower_bound),std::abs(upper_bound));
+  const Scalar up_sqr_d =
+    max_abs < std::sqrt(std::numeric_limits<Scalar>::max()) ?
+    max_abs*max_abs : std::numeric_limits<Scalar>::infinity();
+  const Scalar low_sqr_d =
+    std::pow(std::max(max_abs-(upper_bound-lower_bound),(Scalar)0.0),2.0);
+  S.resize(P.rows(),1);
+  I.resize(P.rows(),1);
+  C.resize(P.rows(),3);
+  if(sign_type == SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+  {
+    N.resize(P.rows(),3);
+  }
+  igl::parallel_for(P.rows(),[&](const int p)
+  {
+    const RowVector3S q = P.row(p).template cast<Scalar>();
+    RowVector3S c,n;
+    int i = -1;
+    const Scalar sqrd = tree.squared_distance(V,F,q,low_sqr_d,up_sqr_d,i,c);
+    if(sqrd >= up_sqr_d || sqrd < low_sqr_d)
+    {
+      // Out of bounds gets a nan (nans on grids can be flood filled later
+      // using igl::flood_fill)
+      S(p) = std::numeric_limits<typename DerivedS::Scalar>::quiet_NaN();
+      I(p) = F.rows()+1;
+      C.row(p).setConstant(0);
+      return;
+    }
+    const Scalar s = sign(q,i,c,n);
+    if(sign_type == SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+    {
+      N.row(p) = n.template cast<typename DerivedN::Scalar>();
+    }
+    I(p) = i;
+    S(p) = s*std::sqrt(sqrd);
+    C.row(p) = c.template cast<typename DerivedC::Scalar>();
+  },10000);
+}
+
+template <typename DerivedV, typename DerivedF>
+template <
+  typename DerivedP,
+  typename DerivedS,
+  typename DerivedI,
+  typename DerivedC,
+  typename DerivedN>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::query(
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedS> & S,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedN> & N) const
+{
+  return query(
+    P,
+    std::numeric_limits<Scalar>::min(),
+    std::numeric_limits<Scalar>::max(),
+    S,I,C,N);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE typename igl::SignedDistance<DerivedV,DerivedF>::Scalar
+igl::SignedDistance<DerivedV,DerivedF>::query(
+  const RowVector3S & q,
+  int & i,
+  RowVector3S & c) const
+{
+  i = -1;
+  const Scalar sqrd = tree.squared_distance(V,F,q,i,c);
+  if(i < 0)
+  {
+    return std::numeric_limits<Scalar>::quiet_NaN();
+  }
+  RowVector3S n;
+  return sign(q,i,c,n)*std::sqrt(sqrd);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::SignedDistance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >;
+template class igl::SignedDistance<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >;
+template void igl::SignedDistance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >::query<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::SignedDistance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >::query<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::SignedDistance<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >::query<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+#endif
@@ -0,0 +1,152 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SIGNED_DISTANCE_CONTEXT_H
+#define IGL_SIGNED_DISTANCE_CONTEXT_H
+#include "igl_inline.h"
+#include "signed_distance.h"
+#include "AABB.h"
+#include "WindingNumberAABB.h"
+#include "fast_winding_number.h"
+#include <Eigen/Core>
+namespace igl
+{
+  /// Precomputed state for repeatedly querying the signed distance to the
+  /// same triangle mesh. `igl::signed_distance` rebuilds the AABB and the
+  /// sign precomputation (pseudonormals, winding number hierarchy or fast
+  /// winding number BVH) on every call. This object builds them once in
+  /// `init`, answers any number of `query` calls (which are const and safe to
+  /// call concurrently), and can `refit` to new vertex positions of a mesh
+  /// with fixed connectivity (e.g., a deforming collider in a simulation).
+  ///
+  /// @tparam DerivedV  Matrix type of vertex positions (e.g., `Eigen::MatrixXd`)
+  /// @tparam DerivedF  Matrix type of triangle indices (e.g., `Eigen::MatrixXi`)
+  ///
+  /// #### Example
+  ///
+  /// \code{cpp}
+  ///   igl::SignedDistance<Eigen::MatrixXd,Eigen::MatrixXi> sdf;
+  ///   sdf.init(V,F,igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL);
+  ///   for(int step = 0;step<num_steps;step++)
+  ///   {
+  ///     sdf.refit(V_at_step);
+  ///     sdf.query(P,S,I,C,N);
+  ///   }
+  /// \endcode
+  ///
+  /// \see signed_distance
+  template <typename DerivedV, typename DerivedF>
+  class SignedDistance
+  {
+  public:
+    typedef typename DerivedV::Scalar Scalar;
+    typedef typename DerivedF::Scalar Index;
+    typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+    /// #V by 3 list of mesh vertex positions (copy)
+    DerivedV V;
+    /// #F by 3 list of triangle indices into V (copy)
+    DerivedF F;
+    /// Method used for signing distances
+    SignedDistanceType sign_type = SIGNED_DISTANCE_TYPE_DEFAULT;
+    /// Hierarchy used for closest point queries
+    AABB<DerivedV,3> tree;
+    /// Pseudonormal precomputation (SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+    Eigen::Matrix<Scalar,Eigen::Dynamic,3> FN,VN,EN;
+    Eigen::Matrix<Index,Eigen::Dynamic,2> E;
+    Eigen::Matrix<Index,Eigen::Dynamic,1> EMAP;
+    /// Winding number hierarchy (SIGNED_DISTANCE_TYPE_WINDING_NUMBER and
+    /// SIGNED_DISTANCE_TYPE_DEFAULT)
+    WindingNumberAABB<Scalar,Index> hier;
+    /// Fast winding number BVH (SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER)
+    FastWindingNumberBVH fwn_bvh;
+    SignedDistance() = default;
+    // The winding number hierarchy owns raw pointers
+    SignedDistance(const SignedDistance &) = delete;
+    SignedDistance & operator=(const SignedDistance &) = delete;
+    /// Copy the mesh and build all precomputation needed by `sign_type`
+    ///
+    /// @param[in] V  #V by 3 list of mesh vertex positions
+    /// @param[in] F  #F by 3 list of triangle indices into V
+    /// @param[in] sign_type  method for computing distance _sign_
+    IGL_INLINE void init(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedF> & F,
+      const SignedDistanceType sign_type = SIGNED_DISTANCE_TYPE_DEFAULT);
+    /// Update to new vertex positions keeping the connectivity F. The AABB
+    /// is refit (not rebuilt) and normals are recomputed without recomputing
+    /// edge topology. The fast winding number BVH is refit too (and only
+    /// rebuilt once it has become too loose, see fast_winding_number_refit);
+    /// the exact winding number hierarchy is rebuilt.
+    ///
+    /// @param[in] V  #V by 3 list of new mesh vertex positions
+    IGL_INLINE void refit(const Eigen::MatrixBase<DerivedV> & V);
+    /// Signed distance from query points, same conventions as
+    /// igl::signed_distance
+    ///
+    /// @param[in] P  #P by 3 list of query point positions
+    /// @param[in] lower_bound  lower bound of distances needed {std::numeric_limits::min}
+    /// @param[in] upper_bound  upper bound of distances needed {std::numeric_limits::max}
+    /// @param[out] S  #P list of smallest signed distances
+    /// @param[out] I  #P list of facet indices corresponding to smallest distances
+    /// @param[out] C  #P by 3 list of closest points
+    /// @param[out] N  #P by 3 list of closest normals (only set if
+    ///   sign_type=SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+    template <
+      typename DerivedP,
+      typename DerivedS,
+      typename DerivedI,
+      typename DerivedC,
+      typename DerivedN>
+    IGL_INLINE void query(
+      const Eigen::MatrixBase<DerivedP> & P,
+      const Scalar lower_bound,
+      const Scalar upper_bound,
+      Eigen::PlainObjectBase<DerivedS> & S,
+      Eigen::PlainObjectBase<DerivedI> & I,
+      Eigen::PlainObjectBase<DerivedC> & C,
+      Eigen::PlainObjectBase<DerivedN> & N) const;
+    /// \overload
+    template <
+      typename DerivedP,
+      typename DerivedS,
+      typename DerivedI,
+      typename DerivedC,
+      typename DerivedN>
+    IGL_INLINE void query(
+      const Eigen::MatrixBase<DerivedP> & P,
+      Eigen::PlainObjectBase<DerivedS> & S,
+      Eigen::PlainObjectBase<DerivedI> & I,
+      Eigen::PlainObjectBase<DerivedC> & C,
+      Eigen::PlainObjectBase<DerivedN> & N) const;
+    /// Signed distance from a single query point
+    ///
+    /// @param[in] q  3-long query point
+    /// @param[out] i  index of closest facet
+    /// @param[out] c  closest point
+    /// @return signed distance
+    IGL_INLINE Scalar query(
+      const RowVector3S & q,
+      int & i,
+      RowVector3S & c) const;
+  private:
+    // Build (or rebuild) everything depending on V but not the topology
+    IGL_INLINE void precompute(const bool topology_changed);
+    // Sign of q with closest point c on facet i (and normal n if
+    // pseudonormal)
+    IGL_INLINE Scalar sign(
+      const RowVector3S & q,
+      const int i,
+      const RowVector3S & c,
+      RowVector3S & n) const;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SignedDistance.cpp"
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "SparseBrickGrid.h"
+#include "parallel_for.h"
+
+template <typename Scalar>
+template <typename Derivedorigin, typename Derivedres>
+IGL_INLINE void igl::SparseBrickGrid<Scalar>::init(
+  const Eigen::MatrixBase<Derivedorigin> & _origin,
+  const Scalar _h,
+  const Eigen::MatrixBase<Derivedres> & _res,
+  const Scalar _background)
+{
+  origin = _origin.template cast<Scalar>();
+  h = _h;
+  res = _res.template cast<int>();
+  background = _background;
+  for(int d = 0;d<3;d++)
+  {
+    brick_res(d) = (res(d)+brick_size-1)/brick_size;
+  }
+  const int num_bricks = brick_res.prod();
+  brick_index.setConstant(num_bricks,-1);
+  brick_sign.setConstant(num_bricks,1);
+  brick_coords.resize(0,3);
+  values.resize(0,brick_volume);
+}
+
+template <typename Scalar>
+IGL_INLINE Scalar igl::SparseBrickGrid<Scalar>::operator()(
+  const int i, const int j, const int k) const
+{
+  const int b = brick(i/brick_size,j/brick_size,k/brick_size);
+  const int a = brick_index(b);
+  if(a < 0)
+  {
+    return brick_sign(b)*background;
+  }
+  return values(a,
+    i%brick_size + brick_size*(j%brick_size + brick_size*(k%brick_size)));
+}
+
+template <typename Scalar>
+template <typename DerivedS>
+IGL_INLINE void igl::SparseBrickGrid<Scalar>::dense(
+  Eigen::PlainObjectBase<DerivedS> & S) const
+{
+  S.resize(res.prod(),1);
+  igl::parallel_for(res(2),[&](const int k)
+  {
+    for(int j = 0;j<res(1);j++)
+    {
+      for(int i = 0;i<res(0);i++)
+      {
+        S(i+res(0)*(j+res(1)*k)) = (*this)(i,j,k);
+      }
+    }
+  },8);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::SparseBrickGrid<double>;
+template class igl::SparseBrickGrid<float>;
+template void igl::SparseBrickGrid<double>::init<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<int, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, double, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, double);
+template void igl::SparseBrickGrid<float>::init<Eigen::Matrix<float, 1, 3, 1, 1, 3>, Eigen::Matrix<int, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> > const&, float, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, float);
+template void igl::SparseBrickGrid<double>::dense<Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&) const;
+template void igl::SparseBrickGrid<float>::dense<Eigen::Matrix<float, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&) const;
+#endif
@@ -0,0 +1,97 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_BRICK_GRID_H
+#define IGL_SPARSE_BRICK_GRID_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  /// Scalar field sampled at the vertices of a regular 3D grid, stored
+  /// sparsely as 8³ bricks. Only "active" bricks store per-vertex values;
+  /// every other brick is implicitly filled with ±background (e.g., outside
+  /// the narrow band of a signed distance field). Memory is proportional to
+  /// the number of active bricks plus one int and one byte per brick.
+  ///
+  /// Grid vertex (i,j,k) for 0≤i<res(0), 0≤j<res(1), 0≤k<res(2) lies at
+  /// origin + h*(i,j,k), matching the x-fastest ordering of igl::voxel_grid
+  /// and igl::flood_fill when converted with `dense`.
+  ///
+  /// @tparam Scalar  scalar type of values and positions
+  ///
+  /// \see narrow_band_signed_distance
+  template <typename Scalar>
+  class SparseBrickGrid
+  {
+  public:
+    /// Number of grid vertices along each side of a brick
+    static constexpr int brick_size = 8;
+    /// Number of grid vertices in a brick
+    static constexpr int brick_volume = brick_size*brick_size*brick_size;
+    /// #active by brick_volume matrix of brick values
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,brick_volume,Eigen::RowMajor>
+      BrickMatrix;
+    /// Position of grid vertex (0,0,0)
+    Eigen::Matrix<Scalar,1,3> origin;
+    /// Grid spacing
+    Scalar h;
+    /// Number of grid vertices along each axis
+    Eigen::RowVector3i res;
+    /// Number of bricks along each axis (ceil(res/brick_size))
+    Eigen::RowVector3i brick_res;
+    /// Magnitude of values in inactive bricks
+    Scalar background;
+    /// brick_res.prod() list of row indices into values for active bricks
+    /// and -1 for inactive bricks, brick (bi,bj,bk) is at
+    /// bi+brick_res(0)*(bj+brick_res(1)*bk)
+    Eigen::VectorXi brick_index;
+    /// brick_res.prod() list of signs (-1 or 1) of inactive bricks (0 for
+    /// active bricks)
+    Eigen::Matrix<signed char,Eigen::Dynamic,1> brick_sign;
+    /// #active by 3 list of brick coordinates of active bricks
+    Eigen::MatrixXi brick_coords;
+    /// #active by brick_volume list of values of active bricks, local vertex
+    /// (x,y,z) is at column x+brick_size*(y+brick_size*z). Vertices beyond
+    /// res in boundary bricks are stored but meaningless.
+    BrickMatrix values;
+    /// Set up an empty grid (all bricks inactive and positive)
+    ///
+    /// @param[in] origin  3-long position of grid vertex (0,0,0)
+    /// @param[in] h  grid spacing
+    /// @param[in] res  3-long number of grid vertices along each axis
+    /// @param[in] background  magnitude of values in inactive bricks
+    template <typename Derivedorigin, typename Derivedres>
+    IGL_INLINE void init(
+      const Eigen::MatrixBase<Derivedorigin> & origin,
+      const Scalar h,
+      const Eigen::MatrixBase<Derivedres> & res,
+      const Scalar background);
+    /// @return number of active bricks
+    int num_active() const { return static_cast<int>(values.rows()); }
+    /// @param[in] bi,bj,bk  brick coordinates
+    /// @return linear index of brick into brick_index and brick_sign
+    int brick(const int bi, const int bj, const int bk) const
+    { return bi + brick_res(0)*(bj + brick_res(1)*bk); }
+    /// Value at a grid vertex
+    ///
+    /// @param[in] i,j,k  grid vertex coordinates
+    /// @return value at grid vertex (i,j,k)
+    IGL_INLINE Scalar operator()(const int i, const int j, const int k) const;
+    /// Expand to a dense grid
+    ///
+    /// @param[out] S  res.prod() list of values, vertex (i,j,k) at
+    ///   i+res(0)*(j+res(1)*k)
+    template <typename DerivedS>
+    IGL_INLINE void dense(Eigen::PlainObjectBase<DerivedS> & S) const;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SparseBrickGrid.cpp"
+#endif
+
+#endif
@@ -0,0 +1,200 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "ThreadPool.h"
+#include "default_num_threads.h"
+#include <algorithm>
+#include <cassert>
+
+IGL_INLINE igl::ThreadPool::ThreadPool(const unsigned int num_threads):
+  m_stop(false)
+{
+  start(num_threads);
+}
+
+IGL_INLINE igl::ThreadPool::~ThreadPool()
+{
+  stop();
+}
+
+IGL_INLINE unsigned int igl::ThreadPool::num_threads() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<unsigned int>(m_workers.size()) + 1;
+}
+
+IGL_INLINE void igl::ThreadPool::resize(const unsigned int num_threads)
+{
+  stop();
+  start(num_threads);
+}
+
+IGL_INLINE void igl::ThreadPool::start(const unsigned int num_threads)
+{
+  const unsigned int n =
+    num_threads ? num_threads : igl::default_num_threads();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  assert(m_workers.empty());
+  m_stop = false;
+  m_workers.reserve(n-1);
+  for(unsigned int w = 0;w+1<n;w++)
+  {
+    m_workers.emplace_back([this](){ worker_loop(); });
+  }
+}
+
+IGL_INLINE void igl::ThreadPool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_jobs.empty() && "ThreadPool stopped while running a loop");
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+  for(auto & worker : m_workers)
+  {
+    if(worker.joinable()) worker.join();
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_workers.clear();
+}
+
+IGL_INLINE bool & igl::ThreadPool::worker_flag()
+{
+  static thread_local bool flag = false;
+  return flag;
+}
+
+IGL_INLINE bool igl::ThreadPool::is_worker_thread()
+{
+  return worker_flag();
+}
+
+IGL_INLINE void igl::ThreadPool::work(Job & job, const size_t t)
+{
+  if(job.schedule == PARALLEL_FOR_SCHEDULE_GUIDED)
+  {
+    size_t begin = job.next.load();
+    while(begin < job.loop_size)
+    {
+      const size_t chunk = std::max(
+        job.grain,(job.loop_size-begin)/(2*job.max_concurrency));
+      if(job.next.compare_exchange_weak(begin,begin+chunk))
+      {
+        (*job.range)(begin,std::min(begin+chunk,job.loop_size),t);
+        begin = job.next.load();
+      }
+    }
+    return;
+  }
+  // Static and dynamic schedules only differ in their grain (see run())
+  while(true)
+  {
+    const size_t begin = job.next.fetch_add(job.grain);
+    if(begin >= job.loop_size) { break; }
+    const size_t end = std::min(begin+job.grain,job.loop_size);
+    (*job.range)(begin,end,t);
+  }
+}
+
+IGL_INLINE void igl::ThreadPool::remove_job(Job * job)
+{
+  // Caller must hold m_mutex
+  const auto it = std::find(m_jobs.begin(),m_jobs.end(),job);
+  if(it != m_jobs.end()) { m_jobs.erase(it); }
+}
+
+IGL_INLINE void igl::ThreadPool::worker_loop()
+{
+  worker_flag() = true;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(true)
+  {
+    m_work_cv.wait(lock,[this](){ return m_stop || !m_jobs.empty(); });
+    if(m_stop) { return; }
+    // Steal from the oldest published loop. Loops are unpublished as soon as
+    // they are saturated, so there is always room.
+    Job * job = m_jobs.front();
+    const size_t t = job->num_participants++;
+    job->num_workers++;
+    if(job->num_participants >= job->max_concurrency) { remove_job(job); }
+    lock.unlock();
+    try
+    {
+      work(*job,t);
+    }catch(...)
+    {
+      job->next = job->loop_size;
+      lock.lock();
+      if(!job->exception) { job->exception = std::current_exception(); }
+      lock.unlock();
+    }
+    lock.lock();
+    // No chunks left: make sure no other worker picks this loop up again
+    remove_job(job);
+    if(--job->num_workers == 0) { m_done_cv.notify_all(); }
+  }
+}
+
+IGL_INLINE void igl::ThreadPool::run(
+  const size_t loop_size,
+  const size_t grain,
+  const size_t max_concurrency,
+  const RangeFunction & range,
+  const ParallelForSchedule schedule)
+{
+  assert(grain > 0);
+  if(loop_size == 0) { return; }
+  Job job;
+  job.loop_size = loop_size;
+  job.max_concurrency = std::max(max_concurrency,(size_t)1);
+  job.schedule = schedule;
+  job.grain = std::max(grain,(size_t)1);
+  if(schedule == PARALLEL_FOR_SCHEDULE_STATIC)
+  {
+    job.grain = std::max(
+      job.grain,(loop_size+job.max_concurrency-1)/job.max_concurrency);
+  }
+  job.range = &range;
+  job.next = 0;
+  // Calling thread is always participant 0
+  job.num_participants = 1;
+  job.num_workers = 0;
+  // A single chunk is never worth waking workers for
+  const bool publish =
+    job.max_concurrency > 1 && loop_size > job.grain;
+  if(publish)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(!m_workers.empty()) { m_jobs.push_back(&job); }
+    }
+    m_work_cv.notify_all();
+  }
+  try
+  {
+    work(job,0);
+  }catch(...)
+  {
+    job.next = job.loop_size;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!job.exception) { job.exception = std::current_exception(); }
+  }
+  if(publish)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    remove_job(&job);
+    m_done_cv.wait(lock,[&job](){ return job.num_workers == 0; });
+  }
+  if(job.exception) { std::rethrow_exception(job.exception); }
+}
+
+IGL_INLINE igl::ThreadPool & igl::default_thread_pool()
+{
+  static ThreadPool pool;
+  return pool;
+}
@@ -0,0 +1,117 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_THREAD_POOL_H
+#define IGL_THREAD_POOL_H
+#include "igl_inline.h"
+#include "ParallelForSchedule.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace igl
+{
+  /// Persistent pool of worker threads used by igl::parallel_for.
+  ///
+  /// A pool of size n keeps n-1 worker threads alive for the lifetime of the
+  /// pool; the thread calling run() always participates as the n-th thread.
+  /// Each call to run() publishes a loop over [0,loop_size) which is cut into
+  /// chunks. Idle workers steal chunks from any published loop, so calls
+  /// issued from inside a running loop (nested parallel_for) never spawn new
+  /// threads: they are either helped by idle workers or simply run to
+  /// completion on the calling thread.
+  ///
+  /// \see default_thread_pool, parallel_for
+  class ThreadPool
+  {
+  public:
+    /// Function handle computing iterations [begin,end) as participant t
+    using RangeFunction = std::function<void(size_t,size_t,size_t)>;
+    /// @param[in] num_threads  total number of threads including the caller
+    ///   of run() (0 means igl::default_num_threads())
+    IGL_INLINE explicit ThreadPool(const unsigned int num_threads = 0);
+    IGL_INLINE ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+    /// @return total number of threads including the caller of run()
+    IGL_INLINE unsigned int num_threads() const;
+    /// Tear down current workers and start num_threads-1 new ones. Must not
+    /// be called while a loop is running on this pool.
+    ///
+    /// @param[in] num_threads  total number of threads including the caller
+    ///   of run() (0 means igl::default_num_threads())
+    IGL_INLINE void resize(const unsigned int num_threads);
+    /// Run a loop over [0,loop_size) cut into chunks according to schedule.
+    /// Blocks until every chunk has been computed. Exceptions thrown by range
+    /// are rethrown on the calling thread (remaining chunks are skipped).
+    ///
+    /// @param[in] loop_size  number of iterations
+    /// @param[in] grain  (minimum) number of iterations per chunk (>0)
+    /// @param[in] max_concurrency  maximum number of threads (including the
+    ///   caller) working on this loop, participant ids t are in
+    ///   [0,max_concurrency)
+    /// @param[in] range  function handle computing a chunk
+    /// @param[in] schedule  how chunks are sized:
+    ///   PARALLEL_FOR_SCHEDULE_STATIC  one block of
+    ///     max(grain,ceil(loop_size/max_concurrency)) per participant
+    ///   PARALLEL_FOR_SCHEDULE_DYNAMIC  chunks of grain iterations
+    ///   PARALLEL_FOR_SCHEDULE_GUIDED  chunks of
+    ///     max(grain,remaining/(2*max_concurrency)) iterations
+    IGL_INLINE void run(
+      const size_t loop_size,
+      const size_t grain,
+      const size_t max_concurrency,
+      const RangeFunction & range,
+      const ParallelForSchedule schedule = PARALLEL_FOR_SCHEDULE_DYNAMIC);
+    /// @return true iff the calling thread is a worker of some ThreadPool
+    IGL_INLINE static bool is_worker_thread();
+  private:
+    struct Job
+    {
+      size_t loop_size;
+      size_t grain;
+      size_t max_concurrency;
+      ParallelForSchedule schedule;
+      const RangeFunction * range;
+      std::atomic<size_t> next;
+      // guarded by m_mutex
+      size_t num_participants;
+      size_t num_workers;
+      std::exception_ptr exception;
+    };
+    IGL_INLINE void start(const unsigned int num_threads);
+    IGL_INLINE void stop();
+    IGL_INLINE void worker_loop();
+    IGL_INLINE void remove_job(Job * job);
+    IGL_INLINE static void work(Job & job, const size_t t);
+    IGL_INLINE static bool & worker_flag();
+    std::vector<std::thread> m_workers;
+    std::vector<Job *> m_jobs;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    bool m_stop;
+  };
+  /// Process-wide thread pool used by igl::parallel_for. Initially sized by
+  /// igl::default_num_threads(); use `default_thread_pool().resize(n)` to
+  /// change the number of threads at runtime and
+  /// `default_thread_pool().num_threads()` to query it.
+  ///
+  /// @return reference to the process-wide pool
+  IGL_INLINE ThreadPool & default_thread_pool();
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "ThreadPool.cpp"
+#endif
+
+#endif
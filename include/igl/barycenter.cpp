@@ -6,6 +6,7 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "barycenter.h"
+#include "parallel_for.h"
 
 template <
   typename DerivedV,
@@ -18,7 +19,7 @@ IGL_INLINE void igl::barycenter(
 {
   BC.setZero(F.rows(),V.cols());
   // Loop over faces
-  for(int i = 0;i<F.rows();i++)
+  igl::parallel_for(F.rows(),[&](const int i)
   {
     // loop around face
     for(int j = 0;j<F.cols();j++)
@@ -28,7 +29,7 @@ IGL_INLINE void igl::barycenter(
     }
     // average
     BC.row(i) /= double(F.cols());
-  }
+  },10000);
 }
 
 #ifdef IGL_STATIC_LIBRARY
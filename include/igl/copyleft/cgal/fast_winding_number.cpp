@@ -22,15 +22,16 @@ IGL_INLINE void igl::copyleft::cgal::fast_winding_number(
 {
   typedef typename DerivedWN::Scalar real;
         
-  std::vector<std::vector<int> > point_indices;
+  Eigen::VectorXi PI;
+  Eigen::Matrix<int,Eigen::Dynamic,2> CP;
   Eigen::Matrix<int,Eigen::Dynamic,8> CH;
   Eigen::Matrix<real,Eigen::Dynamic,3> CN;
   Eigen::Matrix<real,Eigen::Dynamic,1> W;
   Eigen::MatrixXi I;
   Eigen::Matrix<real,Eigen::Dynamic,1> A;
   
-  octree(P,point_indices,CH,CN,W);
-  knn(P,21,point_indices,CH,CN,W,I);
+  octree(P,PI,CP,CH,CN,W);
+  knn(P,21,PI,CP,CH,CN,W,I);
   point_areas(P,I,N,A);
   
   Eigen::Matrix<real,Eigen::Dynamic,Eigen::Dynamic> EC;
@@ -38,9 +39,9 @@ IGL_INLINE void igl::copyleft::cgal::fast_winding_number(
   Eigen::Matrix<real,Eigen::Dynamic,1> R;
   
   igl::fast_winding_number(
-    P,N,A,point_indices,CH,expansion_order,CM,R,EC);
+    P,N,A,PI,CP,CH,expansion_order,CM,R,EC);
   igl::fast_winding_number(
-    P,N,A,point_indices,CH,CM,R,EC,Q,beta,WN);
+    P,N,A,PI,CP,CH,CM,R,EC,Q,beta,WN);
 }
       
 template <
@@ -2,6 +2,7 @@
 #define IGL_CYCODEBASE_SPLINE_EYTZINGER_AABB_H
 
 #include "../igl_inline.h"
+#include "../eytzinger_aabb.h"
 #include <Eigen/Core>
 
 namespace igl {
@@ -15,6 +16,7 @@ namespace igl {
     /// @param[out] B1  #B by dim matrix of AABB min box corners
     /// @param[out] B2  #B by dim matrix of AABB max box corners
     /// @param[out] leaf  #B by 1 matrix of AABB leaf node indices/flags
+    /// @param[in] type  splitting strategy passed to igl::eytzinger_aabb
     ///
     /// \see igl::cycodebase::box_cubic, igl::eytzinger_aabb
     ///
@@ -28,7 +30,8 @@ namespace igl {
       const Eigen::MatrixBase<DerivedC>& C,
       Eigen::PlainObjectBase<DerivedB>& B1,
       Eigen::PlainObjectBase<DerivedB>& B2,
-      Eigen::PlainObjectBase<Derivedleaf>& leaf);
+      Eigen::PlainObjectBase<Derivedleaf>& leaf,
+      const igl::EytzingerAABBType type = igl::EYTZINGER_AABB_TYPE_MEDIAN);
   }
 }
 
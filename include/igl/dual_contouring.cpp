@@ -1,12 +1,14 @@
 #include "dual_contouring.h"
 #include "quadprog.h"
 #include "parallel_for.h"
+#include "ThreadPool.h"
 #include <thread>
 #include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <iostream>
 #include <cstdint>
+#include <algorithm>
 
 namespace igl
 {
@@ -142,6 +144,87 @@ namespace igl
           ((x-min_corner).array()/step.array()).round().template cast<int>();
       }
       // Inputs:
+      //   e0  position of first edge endpoint
+      //   f0  value at e0
+      //   e1  position of second edge endpoint
+      //   f1  value at e1 (with opposite sign of f0)
+      // Returns position of crossing point along edge
+      RowVector3S crossing(
+        const RowVector3S & e0,
+        const Scalar & f0,
+        const RowVector3S & e1,
+        const Scalar & f1) const
+      {
+        const Scalar isovalue = 0;
+        RowVector3S p;
+        Scalar t = -1;
+        if(root_finding)
+        {
+          Scalar tl = 0;
+          bool gl = f0>0;
+          Scalar tu = 1;
+          bool gu = f1>0;
+          assert(gu ^ gl);
+          int riter = 0;
+          const int max_riter = 7;
+          while(true)
+          {
+            t = 0.5*(tu + tl);
+            p = e0+t*(e1-e0);
+            riter++;
+            if(riter > max_riter) { break;}
+            const Scalar ft = f(p);
+            if( (ft>0) == gu) { tu = t; }
+            else if( (ft>0) == gl){ tl = t; }
+            else { break; }
+          }
+        }else
+        {
+          // inverse lerp
+          const Scalar delta = f1-f0;
+          if(delta == 0) { t = 0.5; }
+          t = (isovalue - f0)/delta;
+          p = e0+t*(e1-e0);
+        }
+        return p;
+      }
+      // Write quad face of dual vertices around an edge into row q of Q
+      void emit_quad(
+        const Eigen::Index q,
+        const Eigen::RowVector4i & face,
+        const bool flip)
+      {
+        if(flip)
+        {
+          Q.row(q)<< face(2),face(3),face(1),face(0);
+        }else
+        {
+          Q.row(q)<< face(0),face(1),face(3),face(2);
+        }
+      }
+      // Write four triangles fanning around the edge vertex ev into rows q to
+      // q+3 of Q
+      void emit_triangles(
+        const Eigen::Index q,
+        const Eigen::Index ev,
+        const Eigen::RowVector4i & face,
+        const bool flip)
+      {
+        if(flip)
+        {
+          Q.row(q+0)<<      ev,face(3),face(1)        ;
+          Q.row(q+1)<<              ev,face(1),face(0);
+          Q.row(q+2)<< face(2),             ev,face(0);
+          Q.row(q+3)<< face(2),face(3),             ev;
+        }else
+        {
+          Q.row(q+0)<<      ev,face(1),face(3)        ;
+          Q.row(q+1)<<              ev,face(3),face(2);
+          Q.row(q+2)<< face(0),             ev,face(2);
+          Q.row(q+3)<< face(0),face(1),             ev;
+        }
+      }
+      // Inputs:
       //   x  x-index of vertex on primal grid
       //   y  y-index of vertex on primal grid
       //   z  z-index of vertex on primal grid
@@ -185,36 +268,7 @@ namespace igl
         const Scalar isovalue = 0;
         if((f0>isovalue) == (f1>isovalue)) { return false; }
         // Position of crossing point along edge
-        RowVector3S p;
-        Scalar t = -1;
-        if(root_finding)
-        {
-          Scalar tl = 0;
-          bool gl = f0>0;
-          Scalar tu = 1;
-          bool gu = f1>0;
-          assert(gu ^ gl);
-          int riter = 0;
-          const int max_riter = 7;
-          while(true)
-          {
-            t = 0.5*(tu + tl);
-            p = e0+t*(e1-e0);
-            riter++;
-            if(riter > max_riter) { break;}
-            const Scalar ft = f(p);
-            if( (ft>0) == gu) { tu = t; }
-            else if( (ft>0) == gl){ tl = t; }
-            else { break; }
-          }
-        }else
-        {
-          // inverse lerp
-          const Scalar delta = f1-f0;
-          if(delta == 0) { t = 0.5; }
-          t = (isovalue - f0)/delta;
-          p = e0+t*(e1-e0);
-        }
+        const RowVector3S p = crossing(e0,f0,e1,f1);
         typename decltype(V)::Index ev;
 
         {
@@ -259,30 +313,12 @@ namespace igl
           if(triangles)
           {
             if(m+4 >= Q.rows()){ Q.conservativeResize(2*m+4,Q.cols()); }
-            if(f0>f1)
-            {
-              Q.row(m+0)<<      ev,face(3),face(1)        ;
-              Q.row(m+1)<<              ev,face(1),face(0);
-              Q.row(m+2)<< face(2),             ev,face(0);
-              Q.row(m+3)<< face(2),face(3),             ev;
-            }else
-            {
-              Q.row(m+0)<<      ev,face(1),face(3)        ;
-              Q.row(m+1)<<              ev,face(3),face(2);
-              Q.row(m+2)<< face(0),             ev,face(2);
-              Q.row(m+3)<< face(0),face(1),             ev;
-            }
+            emit_triangles(m,ev,face,f0>f1);
             m+=4;
           }else
           {
             if(m+1 >= Q.rows()){ Q.conservativeResize(2*m+1,Q.cols()); }
-            if(f0>f1)
-            {
-              Q.row(m)<< face(2),face(3),face(1),face(0);
-            }else
-            {
-              Q.row(m)<< face(0),face(1),face(3),face(2);
-            }
+            emit_quad(m,face,f0>f1);
             m++;
           }
         }
@@ -319,6 +355,249 @@ namespace igl
           V.row(v) = p0+x;
         },1000ul);
       }
+      // Lock-free contouring of a dense grid: find crossing edges, then
+      // accumulate each cell's quadric from its own edges and emit one face
+      // per crossing edge, each step in parallel. Output order does not
+      // depend on the number of threads. Apart from two planes of function
+      // values per thread, memory grows with the number of crossing edges
+      // rather than with the size of the grid.
+      //
+      // Inputs:
+      //   nx  number of primal grid vertices along x-axis
+      //   ny  number of primal grid vertices along y-axis
+      //   nz  number of primal grid vertices along z-axis
+      //   pos  pos(x,y,z) returns position of primal grid vertex
+      //   plane  plane(z,Gz) sets Gz to the nx*ny list of function values at
+      //     primal grid vertices with z-index z
+      // Side effects: prepares vV,vI,vH,vcount, Q for vertex_positions()
+      template <typename PosFunc, typename PlaneFunc>
+      void dense_edges(
+        const int nx,
+        const int ny,
+        const int nz,
+        const PosFunc & pos,
+        const PlaneFunc & plane)
+      {
+        const Eigen::Index nxy = Eigen::Index(nx)*ny;
+        // Crossing edges "going back" from each grid vertex k along each axis
+        // o have key 3*k+o. They are found in slabs of z-planes, each
+        // visiting two planes at a time, and gathered in order of key along
+        // with the function values at both ends.
+        const int threads =
+          std::max<int>(1,igl::default_thread_pool().num_threads());
+        const int thickness =
+          std::max(1,std::min(32,(nz+4*threads-1)/(4*threads)));
+        const int num_slabs = nz>0 ? (nz+thickness-1)/thickness : 0;
+        std::vector<std::vector<Eigen::Index>> slab_key(num_slabs);
+        std::vector<std::vector<Scalar>> slab_f(num_slabs);
+        igl::parallel_for(num_slabs,[&](const int s)
+        {
+          std::vector<Eigen::Index> & key = slab_key[s];
+          std::vector<Scalar> & fe = slab_f[s];
+          const int z0 = s*thickness;
+          const int z1 = std::min(nz,z0+thickness);
+          Eigen::Matrix<Scalar,Eigen::Dynamic,1> below,here;
+          if(z0>0) { plane(z0-1,below); }
+          for(int z = z0;z<z1;z++)
+          {
+            plane(z,here);
+            for(int y = 0;y<ny;y++)
+            {
+              for(int x = 0;x<nx;x++)
+              {
+                const Eigen::Index i = x+Eigen::Index(nx)*y;
+                const Scalar f0 = here(i);
+                const auto back = [&](const int o, const Scalar f1)
+                {
+                  if((f1>0) == (f0>0)) { return; }
+                  key.push_back(3*(i+nxy*z)+o);
+                  fe.push_back(f0);
+                  fe.push_back(f1);
+                };
+                if(x>0) { back(0,here(i-1)); }
+                if(y>0) { back(1,here(i-nx)); }
+                if(z>0) { back(2,below(i)); }
+              }
+            }
+            std::swap(below,here);
+          }
+        },1ul);
+        std::vector<Eigen::Index> slab_offset(num_slabs+1,0);
+        for(int s = 0;s<num_slabs;s++)
+        {
+          slab_offset[s+1] = slab_offset[s] + slab_key[s].size();
+        }
+        const Eigen::Index num_edges = slab_offset[num_slabs];
+        std::vector<Eigen::Index> edge_key(num_edges);
+        // Function values at both ends of each crossing edge
+        std::vector<Scalar> edge_f(2*num_edges);
+        igl::parallel_for(num_slabs,[&](const int s)
+        {
+          std::copy(slab_key[s].begin(),slab_key[s].end(),
+            edge_key.begin()+slab_offset[s]);
+          std::copy(slab_f[s].begin(),slab_f[s].end(),
+            edge_f.begin()+2*slab_offset[s]);
+          std::vector<Eigen::Index>().swap(slab_key[s]);
+          std::vector<Scalar>().swap(slab_f[s]);
+        },1ul);
+        const auto key2xyzo = [&nx,&ny](const Eigen::Index key, Eigen::RowVector3i & ic, int & o)
+        {
+          o = int(key%3);
+          const Eigen::Index k = key/3;
+          ic(0) = int(k%nx);
+          ic(1) = int((k/nx)%ny);
+          ic(2) = int(k/(Eigen::Index(nx)*ny));
+        };
+        // Index of crossing edge with given key (-1 if none)
+        const auto find_edge = [&edge_key](const Eigen::Index key)->Eigen::Index
+        {
+          const auto it =
+            std::lower_bound(edge_key.begin(),edge_key.end(),key);
+          return it != edge_key.end() && *it == key ? it-edge_key.begin() : -1;
+        };
+
+        // Crossing point and plane of each edge
+        std::vector<RowVector3S,Eigen::aligned_allocator<RowVector3S>> P(num_edges);
+        std::vector<Matrix4S,Eigen::aligned_allocator<Matrix4S>> H(num_edges);
+        igl::parallel_for(num_edges,[&](const Eigen::Index e)
+        {
+          Eigen::RowVector3i ic;
+          int o;
+          key2xyzo(edge_key[e],ic,o);
+          Eigen::RowVector3i jc = ic;
+          jc(o) -= 1;
+          const RowVector3S e0 = pos(ic(0),ic(1),ic(2));
+          const RowVector3S e1 = pos(jc(0),jc(1),jc(2));
+          P[e] = crossing(e0,edge_f[2*e+0],e1,edge_f[2*e+1]);
+          // edge normal from function handle (could use grid finite
+          // differences/interpolation gradients)
+          const RowVector3S dfdx = f_grad(P[e]);
+          // homogenous plane equation
+          const RowVector4S plane = (RowVector4S()<<dfdx,-dfdx.dot(P[e])).finished();
+          // quadric contribution
+          H[e] = plane.transpose() * plane;
+        },1000ul);
+
+        // Cells (including the layer just outside the grid) with a crossing
+        // edge get a dual vertex. Cell (cx,cy,cz) has key
+        // (cx+1)+(nx+1)*((cy+1)+(ny+1)*(cz+1)).
+        const auto cell2i = [&nx,&ny](const Eigen::RowVector3i & kc)->Eigen::Index
+        {
+          return (kc(0)+1)+Eigen::Index(nx+1)*((kc(1)+1)+Eigen::Index(ny+1)*(kc(2)+1));
+        };
+        const auto i2cell = [&nx,&ny](const Eigen::Index i)->Eigen::RowVector3i
+        {
+          return Eigen::RowVector3i(
+            int(i%(nx+1))-1,
+            int((i/(nx+1))%(ny+1))-1,
+            int(i/(Eigen::Index(nx+1)*(ny+1)))-1);
+        };
+        // Calls func(kc) for each of the four cells around crossing edge e
+        const auto for_each_edge_cell = [&](const Eigen::Index e, const auto & func)
+        {
+          Eigen::RowVector3i ic;
+          int o;
+          key2xyzo(edge_key[e],ic,o);
+          ic(o) -= 1;
+          for(int i = -1;i<=0;i++)
+          {
+            for(int j = -1;j<=0;j++)
+            {
+              Eigen::RowVector3i kc = ic;
+              kc((o+1)%3)+=i;
+              kc((o+2)%3)+=j;
+              func(kc);
+            }
+          }
+        };
+        // Calls func(e) for each crossing edge e on the boundary of cell kc
+        const auto for_each_cell_edge = [&](const Eigen::RowVector3i & kc, const auto & func)
+        {
+          const int n[3] = {nx,ny,nz};
+          for(int o = 0;o<3;o++)
+          {
+            for(int i = 0;i<=1;i++)
+            {
+              for(int j = 0;j<=1;j++)
+              {
+                Eigen::RowVector3i ic = kc;
+                ic(o) += 1;
+                ic((o+1)%3) += i;
+                ic((o+2)%3) += j;
+                if((ic.array()<0).any() || ic(0)>=n[0] || ic(1)>=n[1] || ic(2)>=n[2]){ continue; }
+                if(ic(o) == 0) { continue; }
+                const Eigen::Index e = find_edge(
+                  3*(ic(0)+nx*(ic(1)+Eigen::Index(ny)*ic(2)))+o);
+                if(e >= 0) { func(e); }
+              }
+            }
+          }
+        };
+        // Keys of cells with a dual vertex, in order of dual vertex index
+        std::vector<Eigen::Index> cell_key(4*num_edges);
+        igl::parallel_for(num_edges,[&](const Eigen::Index e)
+        {
+          int k = 0;
+          for_each_edge_cell(e,[&](const Eigen::RowVector3i & kc)
+          {
+            cell_key[4*e+k++] = cell2i(kc);
+          });
+        },1000ul);
+        std::sort(cell_key.begin(),cell_key.end());
+        cell_key.erase(
+          std::unique(cell_key.begin(),cell_key.end()),cell_key.end());
+        const Eigen::Index num_dual = cell_key.size();
+        n = num_dual;
+        // Extra vertex at each crossing point to triangulate its quad
+        n += triangles ? num_edges : 0;
+        vV.resize(n);
+        vI.resize(n);
+        vH.resize(n);
+        vcount.resize(n);
+        igl::parallel_for(num_dual,[&](const Eigen::Index v)
+        {
+          vI[v] = i2cell(cell_key[v]);
+          vV[v].setZero();
+          vH[v].setZero();
+          vcount[v] = 0;
+          for_each_cell_edge(vI[v],[&](const Eigen::Index e)
+          {
+            vV[v] += P[e];
+            vH[v] += H[e];
+            vcount[v]++;
+          });
+        },1000ul);
+
+        // One quad (or four triangles) per crossing edge
+        m = (triangles?4:1)*num_edges;
+        Q.resize(m,triangles?3:4);
+        igl::parallel_for(num_edges,[&](const Eigen::Index e)
+        {
+          const bool flip = edge_f[2*e+0] > edge_f[2*e+1];
+          Eigen::RowVector4i face;
+          int k = 0;
+          for_each_edge_cell(e,[&](const Eigen::RowVector3i & kc)
+          {
+            const auto it = std::lower_bound(
+              cell_key.begin(),cell_key.end(),cell2i(kc));
+            assert(it != cell_key.end() && *it == cell2i(kc));
+            face(k++) = int(it-cell_key.begin());
+          });
+          if(triangles)
+          {
+            const Eigen::Index ev = num_dual + e;
+            vV[ev] = P[e];
+            vcount[ev] = 1;
+            vI[ev] = Eigen::RowVector3i(-1, -1, -1);
+            vH[ev].setZero();
+            emit_triangles(4*e,ev,face,flip);
+          }else
+          {
+            emit_quad(e,face,flip);
+          }
+        },1000ul);
+        dual_vertex_positions();
+      }
       // Inputs:
       //   _min_corner  minimum (bottomLeftBack) corner of primal grid
       //   max_corner  maximum (topRightFront) corner of primal grid
@@ -336,28 +615,23 @@ namespace igl
         min_corner = _min_corner;
         step =
           (max_corner-min_corner).array()/(RowVector3S(nx,ny,nz).array()-1);
-        // Should do some reasonable reserves for C2V,vV,vI,vH,vcount
-        Q.resize(std::pow(nx*ny*nz,2./3.),triangles?3:4);
-        // loop over grid
-        igl::parallel_for(nx,[&](const int x)
-        {
-          for(int y = 0;y<ny;y++)
+        // Evaluate f once per grid vertex, one plane at a time
+        dense_edges(nx,ny,nz,
+          [this](const int x, const int y, const int z)
+          {
+            return primal(Eigen::RowVector3i(x,y,z));
+          },
+          [this,&nx,&ny](const int z, Eigen::Matrix<Scalar,Eigen::Dynamic,1> & Gz)
           {
-            for(int z = 0;z<nz;z++)
+            Gz.resize(Eigen::Index(nx)*ny);
+            for(int y = 0;y<ny;y++)
             {
-              const RowVector3S e0 = primal(Eigen::RowVector3i(x,y,z));
-              const Scalar f0 = f(e0);
-              // we'll consider the edges going "back" from this vertex
-              for(int o = 0;o<3;o++)
+              for(int x = 0;x<nx;x++)
               {
-                // off-by-one boundary cases
-                if(((o==0)&&x==0)||((o==1)&&y==0)||((o==2)&&z==0)){ continue;}
-                single_edge(x,y,z,o,e0,f0);
+                Gz(x+Eigen::Index(nx)*y) = f(primal(Eigen::RowVector3i(x,y,z)));
               }
             }
-          }
-        },10ul);
-        dual_vertex_positions();
+          });
       }
       template <typename DerivedGf, typename DerivedGV>
       void dense(
@@ -371,42 +645,16 @@ namespace igl
         const RowVector3S max_corner = GV.colwise().maxCoeff();
         step =
           (max_corner-min_corner).array()/(RowVector3S(nx,ny,nz).array()-1);
-
-        // Should do some reasonable reserves for C2V,vV,vI,vH,vcount
-        Q.resize(std::pow(nx*ny*nz,2./3.),triangles?3:4);
-
-        const auto xyz2i = [&nx,&ny]
-          (const int & x, const int & y, const int & z)->Eigen::Index
-        {
-          return x+nx*(y+ny*(z));
-        };
-
-        // loop over grid
-        igl::parallel_for(nz,[&](const int z)
-        {
-          for(int y = 0;y<ny;y++)
+        const Eigen::Index nxy = Eigen::Index(nx)*ny;
+        dense_edges(nx,ny,nz,
+          [&GV,&nx,&ny](const int x, const int y, const int z)->RowVector3S
           {
-            for(int x = 0;x<nx;x++)
-            {
-              //const Scalar f0 = f(e0);
-              const Eigen::Index k0 = xyz2i(x,y,z);
-              const RowVector3S e0 = GV.row(k0);
-              const Scalar f0 = Gf(k0);
-              // we'll consider the edges going "back" from this vertex
-              for(int o = 0;o<3;o++)
-              {
-                Eigen::RowVector3i jc(x,y,z);
-                jc(o) -= 1;
-                if(jc(o)<0) { continue;} // off-by-one boundary cases
-                const int k1 = xyz2i(jc(0),jc(1),jc(2));
-                const RowVector3S e1 = GV.row(k1);
-                const Scalar f1 = Gf(k1);
-                single_edge(x,y,z,o,e0,f0,e1,f1);
-              }
-            }
-          }
-        },10ul);
-        dual_vertex_positions();
+            return GV.row(x+nx*(y+Eigen::Index(ny)*z));
+          },
+          [&Gf,&nxy](const int z, Eigen::Matrix<Scalar,Eigen::Dynamic,1> & Gz)
+          {
+            Gz = Gf.derived().segment(nxy*z,nxy).template cast<Scalar>();
+          });
       }
       void sparse(
         const RowVector3S & _step,
@@ -7,7 +7,9 @@
 namespace igl
 {
   /// Dual contouring to extract a pure quad mesh from differentiable implicit
-  /// function using a dense grid.
+  /// function using a dense grid. Grid values, crossing points, dual vertices
+  /// and faces are each computed in parallel; the output does not depend on
+  /// the number of threads.
   ///
   /// @param[in] f  function returning >0 outside, <0 inside and =0 on the surface
   /// @param[in] f_grad  function returning ∇f/‖∇f‖
@@ -26,6 +28,8 @@ namespace igl
   ///     use linear interpolation.
   /// @param[out] V  #V by 3 list of outputs vertex positions
   /// @param[out] Q  #Q by 4 (or 3 if triangles=true) face indices into rows of V
+  ///
+  /// \see octree_dual_contouring
   template <
     typename DerivedV,
     typename DerivedQ>
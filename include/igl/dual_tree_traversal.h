@@ -0,0 +1,239 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_DUAL_TREE_TRAVERSAL_H
+#define IGL_DUAL_TREE_TRAVERSAL_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  template <typename DerivedV, int DIM> class AABB;
+  /// Traverse two AABB hierarchies simultaneously, visiting pairs of nodes
+  /// (one from each tree) and descending only into pairs accepted by
+  /// `descend`. Of each accepted pair, the node with the larger box is split
+  /// (the closer of its two children first), so the cost is proportional to
+  /// the number of overlapping (or nearby) regions rather than to the size of
+  /// either mesh. Pairs near the roots are expanded breadth first until there
+  /// is enough independent work, and then the subtrees below each of them are
+  /// traversed in parallel.
+  ///
+  /// @param[in] treeA  AABB hierarchy of the first set of primitives
+  /// @param[in] treeB  AABB hierarchy of the second set of primitives
+  /// @param[in] prep_func  function handle taking n ≥ number of threads, called
+  ///   once before any call of leaf_func (e.g., to allocate per-thread
+  ///   output)
+  /// @param[in] descend  function handle taking the boxes of a node of treeA
+  ///   and of a node of treeB and returning whether the pair may contain
+  ///   pairs of interest `descend(box_a,box_b)`. May be called concurrently.
+  /// @param[in] leaf_func  function handle called for each accepted pair of
+  ///   leaves with their primitive indices and the current thread index
+  ///   `leaf_func(a,b,t)`. Called concurrently for different t.
+  ///
+  /// #### Example
+  ///
+  /// \code{cpp}
+  ///   // Pairs of triangles with overlapping boxes
+  ///   std::vector<std::vector<std::pair<int,int> > > pairs;
+  ///   igl::dual_tree_traversal(treeA,treeB,
+  ///     [&](const size_t n){ pairs.resize(n); },
+  ///     [](const auto & a,const auto & b){ return a.intersects(b); },
+  ///     [&](const int a,const int b,const size_t t)
+  ///       { pairs[t].emplace_back(a,b); });
+  /// \endcode
+  ///
+  /// \see AABB, parallel_for
+  template <
+    typename DerivedVA,
+    typename DerivedVB,
+    int DIM,
+    typename PrepFunc,
+    typename DescendFunc,
+    typename LeafFunc>
+  inline void dual_tree_traversal(
+    const AABB<DerivedVA,DIM> & treeA,
+    const AABB<DerivedVB,DIM> & treeB,
+    const PrepFunc & prep_func,
+    const DescendFunc & descend,
+    const LeafFunc & leaf_func);
+}
+
+// Implementation
+
+#include "AABB.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+template <
+  typename DerivedVA,
+  typename DerivedVB,
+  int DIM,
+  typename PrepFunc,
+  typename DescendFunc,
+  typename LeafFunc>
+inline void igl::dual_tree_traversal(
+  const AABB<DerivedVA,DIM> & treeA,
+  const AABB<DerivedVB,DIM> & treeB,
+  const PrepFunc & prep_func,
+  const DescendFunc & descend,
+  const LeafFunc & leaf_func)
+{
+  typedef AABB<DerivedVA,DIM> NodeA;
+  typedef AABB<DerivedVB,DIM> NodeB;
+  typedef typename NodeA::Scalar Scalar;
+  typedef std::pair<const NodeA *,const NodeB *> Pair;
+  const auto is_leaf_pair = [](const Pair & p)
+  {
+    return p.first->is_leaf() && p.second->is_leaf();
+  };
+  // Split the node of p with the larger box and call push on the resulting
+  // child pairs that pass descend, farther child first
+  const auto split = [&descend](const Pair & p, std::vector<Pair> & push)
+  {
+    const NodeA * a = p.first;
+    const NodeB * b = p.second;
+    const auto center_a = a->m_box.center().eval();
+    const auto center_b = b->m_box.center().template cast<Scalar>().eval();
+    const bool split_a = !a->is_leaf() && (b->is_leaf() ||
+      a->m_box.diagonal().squaredNorm() >=
+      Scalar(b->m_box.diagonal().squaredNorm()));
+    if(split_a)
+    {
+      const NodeA * l = a->m_left;
+      const NodeA * r = a->m_right;
+      if(l && r &&
+        (l->m_box.center()-center_b).squaredNorm() <
+        (r->m_box.center()-center_b).squaredNorm())
+      {
+        std::swap(l,r);
+      }
+      for(const NodeA * c : {l,r})
+      {
+        if(c && descend(c->m_box,b->m_box)) { push.emplace_back(c,b); }
+      }
+    }else
+    {
+      const NodeB * l = b->m_left;
+      const NodeB * r = b->m_right;
+      if(l && r &&
+        (l->m_box.center().template cast<Scalar>()-center_a).squaredNorm() <
+        (r->m_box.center().template cast<Scalar>()-center_a).squaredNorm())
+      {
+        std::swap(l,r);
+      }
+      for(const NodeB * c : {l,r})
+      {
+        if(c && descend(a->m_box,c->m_box)) { push.emplace_back(a,c); }
+      }
+    }
+  };
+
+  // Expand pairs near the roots breadth first until there are enough
+  // independent subtraversals to keep all threads busy
+  std::vector<Pair> frontier,next;
+  const auto is_empty = [](const Pair & p)
+  {
+    return
+      (p.first->is_leaf() && p.first->m_primitive < 0) ||
+      (p.second->is_leaf() && p.second->m_primitive < 0);
+  };
+  const Pair root(&treeA,&treeB);
+  if(!is_empty(root) && descend(treeA.m_box,treeB.m_box))
+  {
+    frontier.push_back(root);
+  }
+  const size_t target =
+    16*std::max<size_t>(1,igl::default_thread_pool().num_threads());
+  while(!frontier.empty() && frontier.size() < target)
+  {
+    next.clear();
+    bool any_split = false;
+    for(const Pair & p : frontier)
+    {
+      if(is_leaf_pair(p))
+      {
+        next.push_back(p);
+        continue;
+      }
+      any_split = true;
+      split(p,next);
+    }
+    std::swap(frontier,next);
+    if(!any_split)
+    {
+      break;
+    }
+  }
+  if(frontier.empty())
+  {
+    prep_func(1);
+    return;
+  }
+  // Closest pairs first: queries that tighten a bound as they go (e.g.,
+  // minimum distance) then prune most of the later pairs
+  {
+    const auto sqr_gap = [](const Pair & p)->Scalar
+    {
+      Scalar sqr_d = 0;
+      for(int d = 0;d<DIM;d++)
+      {
+        const Scalar gap = std::max(
+          p.first->m_box.min()(d)-Scalar(p.second->m_box.max()(d)),
+          Scalar(p.second->m_box.min()(d))-p.first->m_box.max()(d));
+        sqr_d += gap > 0 ? gap*gap : Scalar(0);
+      }
+      return sqr_d;
+    };
+    std::vector<std::pair<Scalar,size_t> > order(frontier.size());
+    for(size_t i = 0;i<frontier.size();i++)
+    {
+      order[i] = {sqr_gap(frontier[i]),i};
+    }
+    std::sort(order.begin(),order.end());
+    next.resize(frontier.size());
+    for(size_t i = 0;i<frontier.size();i++)
+    {
+      next[i] = frontier[order[i].second];
+    }
+    std::swap(frontier,next);
+  }
+
+  // Depth first below each frontier pair, reusing a stack per thread
+  std::vector<std::vector<Pair> > stacks;
+  igl::ParallelForPolicy policy;
+  policy.grain_size = 1;
+  igl::parallel_for(
+    frontier.size(),
+    [&](const size_t n)
+    {
+      stacks.resize(n);
+      prep_func(n);
+    },
+    [&](const size_t i,const size_t t)
+    {
+      std::vector<Pair> & stack = stacks[t];
+      stack.clear();
+      stack.push_back(frontier[i]);
+      while(!stack.empty())
+      {
+        const Pair p = stack.back();
+        stack.pop_back();
+        if(is_leaf_pair(p))
+        {
+          leaf_func(p.first->m_primitive,p.second->m_primitive,t);
+          continue;
+        }
+        split(p,stack);
+      }
+    },
+    [](const size_t){},
+    policy);
+}
+
+#endif
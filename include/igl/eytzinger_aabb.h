@@ -12,6 +12,18 @@
 
 namespace igl
 {
+  /// Strategy used to split primitives when building an Eytzinger AABB
+  enum EytzingerAABBType
+  {
+    /// Recursively split at the median box center along the longest axis
+    EYTZINGER_AABB_TYPE_MEDIAN = 0,
+    /// Sort box centers along a Morton curve (parallel radix sort) and split
+    /// the sorted list in half at every level, filling each level of the
+    /// tree in parallel (LBVH-style). Much faster to build, slightly looser
+    /// boxes.
+    EYTZINGER_AABB_TYPE_MORTON = 1,
+    NUM_EYTZINGER_AABB_TYPES = 2
+  };
   /// Compute the Eytzinger AABB for a given mesh
   /// 
   /// @param[in] PB1  #P by dim list of minimum corners of the AABBs
@@ -20,6 +32,7 @@ namespace igl
   /// @param[out] B2  #B by dim list of maximum corners of the Eytzinger AABBs
   /// @param[out] leaf #B list of leaf indices, -1 indicates internal node, -2
   /// indicates empty node
+  /// @param[in] type  splitting strategy (Morton requires dim ≤ 3)
   ///
   template <
     typename DerivedPB,
@@ -31,7 +44,8 @@ namespace igl
     const Eigen::MatrixBase<DerivedPB> & PB2,
     Eigen::PlainObjectBase<DerivedB> & B1,
     Eigen::PlainObjectBase<DerivedB> & B2,
-    Eigen::PlainObjectBase<Derivedleaf> & leaf);
+    Eigen::PlainObjectBase<Derivedleaf> & leaf,
+    const EytzingerAABBType type = EYTZINGER_AABB_TYPE_MEDIAN);
 }
 
 #ifndef IGL_STATIC_LIBRARY
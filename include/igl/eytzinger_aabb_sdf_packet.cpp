@@ -0,0 +1,130 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "eytzinger_aabb_sdf_packet.h"
+#include "morton_codes.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+template <
+  bool Squared,
+  int N,
+  typename DerivedP,
+  typename Func,
+  typename DerivedB,
+  typename Derivedleaf,
+  typename DerivedS
+>
+IGL_INLINE void igl::eytzinger_aabb_sdf_packet(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const Func & primitive,
+  const Eigen::MatrixBase<DerivedB> & B1,
+  const Eigen::MatrixBase<DerivedB> & B2,
+  const Eigen::MatrixBase<Derivedleaf> & leaf,
+  Eigen::PlainObjectBase<DerivedS> & S)
+{
+  using Scalar = typename DerivedS::Scalar;
+  constexpr int DIM = DerivedP::ColsAtCompileTime;
+  using ArrayNS = Eigen::Array<Scalar,N,1>;
+  using ArrayNDIM = Eigen::Array<Scalar,N,DIM>;
+  const int dim = P.cols();
+  S.resize(P.rows());
+  if(P.rows() == 0) { return; }
+  if(leaf.size() == 0)
+  {
+    S.setConstant(std::numeric_limits<Scalar>::infinity());
+    return;
+  }
+  // Visit queries along a space filling curve
+  Eigen::VectorXi order;
+  igl::morton_order(P,order);
+
+  const int num_packets = (P.rows()+N-1)/N;
+  igl::parallel_for(num_packets,[&](const int k)
+  {
+    const int first = k*N;
+    const int num_queries = std::min<int>(N,P.rows()-first);
+    ArrayNDIM Q(N,dim);
+    for(int l = 0;l<N;l++)
+    {
+      Q.row(l) =
+        P.row(order(first+std::min(l,num_queries-1))).template cast<Scalar>().array();
+    }
+    // https://iquilezles.org/articles/distfunctions/ for all lanes
+    const auto box_sdf = [&](const int i)->ArrayNS
+    {
+      ArrayNS outside = ArrayNS::Zero();
+      ArrayNS inside = ArrayNS::Constant(-std::numeric_limits<Scalar>::infinity());
+      for(int d = 0;d<dim;d++)
+      {
+        const Scalar b = Scalar(0.5)*(Scalar(B2(i,d)) - Scalar(B1(i,d)));
+        const Scalar c = Scalar(0.5)*(Scalar(B1(i,d)) + Scalar(B2(i,d)));
+        const ArrayNS q = (Q.col(d) - c).abs() - b;
+        outside += q.max(Scalar(0)).square();
+        if constexpr (!Squared)
+        {
+          inside = inside.max(q);
+        }
+      }
+      if constexpr (Squared)
+      {
+        return outside;
+      }else
+      {
+        return outside.sqrt() + inside.min(Scalar(0));
+      }
+    };
+
+    ArrayNS f = ArrayNS::Constant(std::numeric_limits<Scalar>::infinity());
+    // Nodes still to visit with their per-lane lower bounds
+    std::vector<std::pair<int,ArrayNS>> active;
+    active.reserve(50);
+    active.emplace_back(0,box_sdf(0));
+    while(!active.empty())
+    {
+      const int i = active.back().first;
+      const ArrayNS box_f = active.back().second;
+      active.pop_back();
+      // Skip unless some lane could still improve
+      if((box_f >= f).all()){ continue; }
+      if(leaf(i) >= 0)
+      {
+        f = f.min(ArrayNS(primitive(Q,leaf(i))));
+      }else
+      {
+        const int left_i = 2*i + 1;
+        const int right_i = 2*i + 2;
+        const ArrayNS left_f = box_sdf(left_i);
+        const ArrayNS right_f = box_sdf(right_i);
+        // Visit the child closer to most lanes first
+        if(left_f.sum() < right_f.sum())
+        {
+          active.emplace_back(right_i, right_f);
+          active.emplace_back(left_i, left_f);
+        }else
+        {
+          active.emplace_back(left_i, left_f);
+          active.emplace_back(right_i, right_f);
+        }
+      }
+    }
+    for(int l = 0;l<num_queries;l++)
+    {
+      S(order(first+l)) = f(l);
+    }
+  },1000/N);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+#include <functional>
+template void igl::eytzinger_aabb_sdf_packet<false, 8, Eigen::Matrix<double, -1, 3, 1, -1, 3>, std::function<Eigen::Array<double, 8, 1, 0, 8, 1> (Eigen::Array<double, 8, 3, 0, 8, 3> const&, int)>, Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, std::function<Eigen::Array<double, 8, 1, 0, 8, 1> (Eigen::Array<double, 8, 3, 0, 8, 3> const&, int)> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>>&);
+template void igl::eytzinger_aabb_sdf_packet<true, 8, Eigen::Matrix<double, -1, 3, 1, -1, 3>, std::function<Eigen::Array<double, 8, 1, 0, 8, 1> (Eigen::Array<double, 8, 3, 0, 8, 3> const&, int)>, Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, std::function<Eigen::Array<double, 8, 1, 0, 8, 1> (Eigen::Array<double, 8, 3, 0, 8, 3> const&, int)> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>>&);
+#endif
@@ -0,0 +1,59 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_EYTZINGER_AABB_SDF_PACKET_H
+#define IGL_EYTZINGER_AABB_SDF_PACKET_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  /// Batched version of eytzinger_aabb_sdf which traverses the tree for
+  /// packets of N query points at once. Queries are first sorted along a
+  /// Morton curve so that each packet contains nearby points (e.g.,
+  /// neighboring grid cells) that visit mostly the same nodes. Box distances
+  /// are computed for all N points of a packet together (laid out so the
+  /// compiler can vectorize them) and the primitive callback is asked for all
+  /// N distances to a primitive at once.
+  ///
+  /// @tparam Squared  see eytzinger_aabb_sdf
+  /// @tparam N  number of query points per packet (e.g., 4 or 8)
+  /// @param[in] P  #P by dim list of query points
+  /// @param[in] primitive  function handle that takes as input an N by dim
+  ///   array of query points and a primitive id and returns the N-long array
+  ///   of SDF values (or squared distances) to that primitive:
+  ///   `Eigen::Array<Scalar,N,1> primitive(const Eigen::Array<Scalar,N,dim> & Q, const int i)`
+  ///   Unused rows of the last packet repeat its last query point.
+  /// @param[in] B1  #B by dim list of minimum corners of the Eytzinger AABBs
+  /// @param[in] B2  #B by dim list of maximum corners of the Eytzinger AABBs
+  /// @param[in] leaf #B list of leaf indices, -1 indicates internal node, -2
+  /// indicates empty node
+  /// @param[out] S  #P list of SDF values at query points P
+  ///
+  /// \see eytzinger_aabb, eytzinger_aabb_sdf, morton_order
+  template <
+    bool Squared,
+    int N,
+    typename DerivedP,
+    typename Func,
+    typename DerivedB,
+    typename Derivedleaf,
+    typename DerivedS
+  >
+  IGL_INLINE void eytzinger_aabb_sdf_packet(
+    const Eigen::MatrixBase<DerivedP> & P,
+    const Func & primitive,
+    const Eigen::MatrixBase<DerivedB> & B1,
+    const Eigen::MatrixBase<DerivedB> & B2,
+    const Eigen::MatrixBase<Derivedleaf> & leaf,
+    Eigen::PlainObjectBase<DerivedS> & S);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "eytzinger_aabb_sdf_packet.cpp"
+#endif
+#endif 
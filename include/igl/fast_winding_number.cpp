@@ -5,6 +5,318 @@
 #include <vector>
 #include <cassert>
 
+namespace
+{
+  // Both octree layouts share these, the ith cell's points are
+  // cell_point(i,j) for j<cell_size(i)
+  template <
+    typename DerivedP, 
+    typename DerivedA, 
+    typename DerivedN,
+    typename CellSize,
+    typename CellPoint,
+    typename DerivedCH, 
+    typename DerivedCM, 
+    typename DerivedR,
+    typename DerivedEC>
+  void fast_winding_number_precompute(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedN>& N,
+    const Eigen::MatrixBase<DerivedA>& A,
+    const CellSize & cell_size,
+    const CellPoint & cell_point,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const int expansion_order,
+    Eigen::PlainObjectBase<DerivedCM>& CM,
+    Eigen::PlainObjectBase<DerivedR>& R,
+    Eigen::PlainObjectBase<DerivedEC>& EC)
+  {
+    typedef typename DerivedP::Scalar real_p;
+    typedef typename DerivedCM::Scalar real_cm;
+    typedef typename DerivedR::Scalar real_r;
+    typedef typename DerivedEC::Scalar real_ec;
+
+
+    int m = CH.rows();
+    int num_terms = -1;
+
+    assert(expansion_order < 3 && expansion_order >= 0 && "m must be less than n");
+    if(expansion_order == 0){
+        num_terms = 3;
+    } else if(expansion_order ==1){
+        num_terms = 3 + 9;
+    } else if(expansion_order == 2){
+        num_terms = 3 + 9 + 27;
+    }
+    assert(num_terms > 0);
+
+    R.resize(m);
+    CM.resize(m,3);
+    EC.resize(m,num_terms);
+    EC.setZero(m,num_terms);
+    // Every cell only depends on its own points, so cells are independent.
+    // Work per cell is proportional to its number of points (the root holds
+    // all of them), hence dynamic scheduling. Calling this again with new P,N,A
+    // but the same octree refits the expansions to moved points.
+    const auto cell = [&](const int index)
+    {
+        Eigen::Matrix<real_cm,1,3> masscenter;
+        masscenter << 0,0,0;
+        Eigen::Matrix<real_ec,1,3> zeroth_expansion;
+        zeroth_expansion << 0,0,0;
+        real_p areatotal = 0.0;
+        const int num_points = cell_size(index);
+        for(int j = 0; j < num_points; j++){
+            int curr_point_index = cell_point(index,j);
+        
+            areatotal += A(curr_point_index);
+            masscenter += A(curr_point_index)*P.row(curr_point_index);
+            zeroth_expansion += A(curr_point_index)*N.row(curr_point_index);
+        }
+        // Avoid divide by zero
+        if(num_points > 0)
+        {
+          masscenter = masscenter/areatotal;
+        }else
+        {
+          masscenter.setConstant(std::numeric_limits<real_cm>::quiet_NaN());
+        }
+        CM.row(index) = masscenter;
+        EC.block(index,0,1,3) = zeroth_expansion;
+    
+        real_r max_norm = 0;
+        real_r curr_norm;
+    
+        for(int i = 0; i < num_points; i++){
+            //Get max distance from center of mass:
+            int curr_point_index = cell_point(index,i);
+            Eigen::Matrix<real_r,1,3> point =
+                P.row(curr_point_index)-masscenter;
+            curr_norm = point.norm();
+            if(curr_norm > max_norm){
+                max_norm = curr_norm;
+            }
+        
+            //Calculate higher order terms if necessary
+            Eigen::Matrix<real_ec,3,3> TempCoeffs;
+            if(EC.cols() >= (3+9)){
+                TempCoeffs = A(curr_point_index)*point.transpose()*
+                                N.row(curr_point_index);
+                EC.block(index,3,1,9) +=
+                Eigen::Map<Eigen::Matrix<real_ec,1,9> >(TempCoeffs.data(),
+                                                        TempCoeffs.size());
+            }
+        
+            if(EC.cols() == (3+9+27)){
+                for(int k = 0; k < 3; k++){
+                    TempCoeffs = 0.5 * point(k) * (A(curr_point_index)*
+                                  point.transpose()*N.row(curr_point_index));
+                    EC.block(index,12+9*k,1,9) += Eigen::Map<
+                      Eigen::Matrix<real_ec,1,9> >(TempCoeffs.data(),
+                                                   TempCoeffs.size());
+                }
+            }
+        }
+    
+        R(index) = max_norm;
+    };
+    igl::ParallelForPolicy policy;
+    policy.schedule = igl::PARALLEL_FOR_SCHEDULE_DYNAMIC;
+    policy.grain_size = 8;
+    policy.min_parallel = 64;
+    igl::parallel_for(CH.rows(),cell,policy);
+  }
+
+  template <
+    typename DerivedP, 
+    typename DerivedA, 
+    typename DerivedN,
+    typename CellSize,
+    typename CellPoint,
+    typename DerivedCH, 
+    typename DerivedCM, 
+    typename DerivedR,
+    typename DerivedEC, 
+    typename DerivedQ, 
+    typename BetaType,
+    typename DerivedWN>
+  void fast_winding_number_eval(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedN>& N,
+    const Eigen::MatrixBase<DerivedA>& A,
+    const CellSize & cell_size,
+    const CellPoint & cell_point,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCM>& CM,
+    const Eigen::MatrixBase<DerivedR>& R,
+    const Eigen::MatrixBase<DerivedEC>& EC,
+    const Eigen::MatrixBase<DerivedQ>& Q,
+    const BetaType beta,
+    Eigen::PlainObjectBase<DerivedWN>& WN)
+  {
+
+    typedef typename DerivedEC::Scalar real_ec;
+    typedef typename DerivedQ::Scalar real_q;
+    typedef typename DerivedWN::Scalar real_wn;
+    const real_wn PI_4 = 4.0*igl::PI;
+
+    typedef Eigen::Matrix<real_q,1,3> RowVec;
+
+    auto direct_eval = [&PI_4](
+      const RowVec & loc,
+      const Eigen::Matrix<real_ec,1,3> & anorm)->real_wn
+    {
+      const typename RowVec::Scalar loc_norm = loc.norm();
+      if(loc_norm == 0)
+      {
+        return 0.5;
+      }else
+      {
+        return (loc(0)*anorm(0)+loc(1)*anorm(1)+loc(2)*anorm(2))
+                                    /(PI_4*(loc_norm*loc_norm*loc_norm));
+      }
+    };
+
+    auto expansion_eval = 
+      [&direct_eval,&EC,&PI_4](
+        const RowVec & loc,
+        const int & child_index)->real_wn
+    {
+      real_wn wn;
+      wn = direct_eval(loc,EC.row(child_index).template head<3>());
+      real_wn r = loc.norm();
+      real_wn PI_4_r3;
+      real_wn PI_4_r5;
+      real_wn PI_4_r7;
+      if(EC.row(child_index).size()>3)
+      {
+        PI_4_r3 = PI_4*r*r*r;
+        PI_4_r5 = PI_4_r3*r*r;
+        const real_ec d = 1.0/(PI_4_r3);
+        Eigen::Matrix<real_ec,3,3> SecondDerivative = 
+          loc.transpose()*loc*(-3.0/(PI_4_r5));
+        SecondDerivative(0,0) += d;
+        SecondDerivative(1,1) += d;
+        SecondDerivative(2,2) += d;
+        wn += 
+          Eigen::Map<Eigen::Matrix<real_ec,1,9> >(
+            SecondDerivative.data(),
+            SecondDerivative.size()).dot(
+              EC.row(child_index).template segment<9>(3));
+      }
+      if(EC.row(child_index).size()>3+9)
+      {
+        PI_4_r7 = PI_4_r5*r*r;
+        const Eigen::Matrix<real_ec,3,3> locTloc = loc.transpose()*(loc/(PI_4_r7));
+        for(int i = 0; i < 3; i++)
+        {
+          Eigen::Matrix<real_ec,3,3> RowCol_Diagonal = 
+            Eigen::Matrix<real_ec,3,3>::Zero(3,3);
+          for(int u = 0;u<3;u++)
+          {
+            for(int v = 0;v<3;v++)
+            {
+              if(u==v) RowCol_Diagonal(u,v) += loc(i);
+              if(u==i) RowCol_Diagonal(u,v) += loc(v);
+              if(v==i) RowCol_Diagonal(u,v) += loc(u);
+            }
+          }
+          Eigen::Matrix<real_ec,3,3> ThirdDerivative = 
+            15.0*loc(i)*locTloc + (-3.0/(PI_4_r5))*(RowCol_Diagonal);
+
+          wn += Eigen::Map<Eigen::Matrix<real_ec,1,9> >(
+                  ThirdDerivative.data(),
+                  ThirdDerivative.size()).dot(
+              EC.row(child_index).template segment<9>(12 + i*9));
+        }
+      }
+      return wn;
+    };
+
+    int m = Q.rows();
+    WN.resize(m,1);
+
+    std::function< real_wn(const RowVec & , const std::vector<int> &) > helper;
+    helper = [&helper,
+              &P,&N,&A,
+              &cell_size,&cell_point,&CH,
+              &CM,&R,&beta,
+              &direct_eval,&expansion_eval]
+    (const RowVec & query, const std::vector<int> & near_indices)-> real_wn
+    {
+      real_wn wn = 0;
+      std::vector<int> new_near_indices;
+      new_near_indices.reserve(8);
+      for(int i = 0; i < near_indices.size(); i++)
+      {
+        int index = near_indices[i];
+        //Leaf Case, Brute force
+        if(CH(index,0) == -1)
+        {
+          for(int j = 0; j < cell_size(index); j++)
+          {
+            int curr_row = cell_point(index,j);
+            wn += direct_eval(P.row(curr_row)-query,
+                              N.row(curr_row)*A(curr_row));
+          }
+        }
+        //Non-Leaf Case
+        else 
+        {
+          for(int child = 0; child < 8; child++)
+          {
+            int child_index = CH(index,child);
+            if(cell_size(child_index) > 0)
+            {
+              const RowVec CMciq = (CM.row(child_index)-query);
+              if(CMciq.norm() > beta*R(child_index))
+              {
+                if(CH(child_index,0) == -1)
+                {
+                  for(int j=0;j<cell_size(child_index);j++)
+                  {
+                    int curr_row = cell_point(child_index,j);
+                    wn += direct_eval(P.row(curr_row)-query,
+                                      N.row(curr_row)*A(curr_row));
+                  }
+                }else{
+                  wn += expansion_eval(CMciq,child_index);
+                }
+              }else 
+              {
+                new_near_indices.emplace_back(child_index);
+              }
+            }
+          }
+        }
+      }
+      if(new_near_indices.size() > 0)
+      {
+        wn += helper(query,new_near_indices);
+      }
+      return wn;
+    };
+
+    if(beta > 0)
+    {
+      const std::vector<int> near_indices_start = {0};
+      igl::parallel_for(m,[&](int iter){
+        WN(iter) = helper(Q.row(iter).eval(),near_indices_start);
+      },1000);
+    } else 
+    {
+      igl::parallel_for(m,[&](int iter){
+        double wn = 0;
+        for(int j = 0; j <P.rows(); j++)
+        {
+          wn += direct_eval(P.row(j)-Q.row(iter),N.row(j)*A(j));
+        }
+        WN(iter) = wn;
+      },1000);
+    }
+  }
+}
+
 template <
   typename DerivedP, 
   typename DerivedA, 
@@ -25,102 +337,38 @@ IGL_INLINE void igl::fast_winding_number(
   Eigen::PlainObjectBase<DerivedR>& R,
   Eigen::PlainObjectBase<DerivedEC>& EC)
 {
-  typedef typename DerivedP::Scalar real_p;
-  typedef typename DerivedCM::Scalar real_cm;
-  typedef typename DerivedR::Scalar real_r;
-  typedef typename DerivedEC::Scalar real_ec;
-
-
-  int m = CH.size();
-  int num_terms = -1;
-
-  assert(expansion_order < 3 && expansion_order >= 0 && "m must be less than n");
-  if(expansion_order == 0){
-      num_terms = 3;
-  } else if(expansion_order ==1){
-      num_terms = 3 + 9;
-  } else if(expansion_order == 2){
-      num_terms = 3 + 9 + 27;
-  }
-  assert(num_terms > 0);
-
-  R.resize(m);
-  CM.resize(m,3);
-  EC.resize(m,num_terms);
-  EC.setZero(m,num_terms);
-  std::function< void(const int) > helper;
-  helper = [&helper,
-            &P,&N,&A,&point_indices,&CH,&EC,&R,&CM]
-  (const int index)-> void
-  {
-      Eigen::Matrix<real_cm,1,3> masscenter;
-      masscenter << 0,0,0;
-      Eigen::Matrix<real_ec,1,3> zeroth_expansion;
-      zeroth_expansion << 0,0,0;
-      real_p areatotal = 0.0;
-      const int num_points = point_indices[index].size();
-      for(int j = 0; j < num_points; j++){
-          int curr_point_index = point_indices[index][j];
-        
-          areatotal += A(curr_point_index);
-          masscenter += A(curr_point_index)*P.row(curr_point_index);
-          zeroth_expansion += A(curr_point_index)*N.row(curr_point_index);
-      }
-      // Avoid divide by zero
-      if(num_points > 0)
-      {
-        masscenter = masscenter/areatotal;
-      }else
-      {
-        masscenter.setConstant(std::numeric_limits<real_cm>::quiet_NaN());
-      }
-      CM.row(index) = masscenter;
-      EC.block(index,0,1,3) = zeroth_expansion;
-    
-      real_r max_norm = 0;
-      real_r curr_norm;
-    
-      for(int i = 0; i < point_indices[index].size(); i++){
-          //Get max distance from center of mass:
-          int curr_point_index = point_indices[index][i];
-          Eigen::Matrix<real_r,1,3> point =
-              P.row(curr_point_index)-masscenter;
-          curr_norm = point.norm();
-          if(curr_norm > max_norm){
-              max_norm = curr_norm;
-          }
-        
-          //Calculate higher order terms if necessary
-          Eigen::Matrix<real_ec,3,3> TempCoeffs;
-          if(EC.cols() >= (3+9)){
-              TempCoeffs = A(curr_point_index)*point.transpose()*
-                              N.row(curr_point_index);
-              EC.block(index,3,1,9) +=
-              Eigen::Map<Eigen::Matrix<real_ec,1,9> >(TempCoeffs.data(),
-                                                      TempCoeffs.size());
-          }
-        
-          if(EC.cols() == (3+9+27)){
-              for(int k = 0; k < 3; k++){
-                  TempCoeffs = 0.5 * point(k) * (A(curr_point_index)*
-                                point.transpose()*N.row(curr_point_index));
-                  EC.block(index,12+9*k,1,9) += Eigen::Map<
-                    Eigen::Matrix<real_ec,1,9> >(TempCoeffs.data(),
-                                                 TempCoeffs.size());
-              }
-          }
-      }
-    
-      R(index) = max_norm;
-      if(CH(index,0) != -1)
-      {
-          for(int i = 0; i < 8; i++){
-              int child = CH(index,i);
-              helper(child);
-          }
-      }
-  };
-  helper(0);
+  fast_winding_number_precompute(P,N,A,
+    [&point_indices](const int c)->int{ return point_indices[c].size(); },
+    [&point_indices](const int c,const int j)->int{ return point_indices[c][j]; },
+    CH,expansion_order,CM,R,EC);
+}
+
+template <
+  typename DerivedP, 
+  typename DerivedA, 
+  typename DerivedN,
+  typename DerivedPI, 
+  typename DerivedCP, 
+  typename DerivedCH, 
+  typename DerivedCM, 
+  typename DerivedR,
+  typename DerivedEC>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedN>& N,
+  const Eigen::MatrixBase<DerivedA>& A,
+  const Eigen::MatrixBase<DerivedPI>& PI,
+  const Eigen::MatrixBase<DerivedCP>& CP,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const int expansion_order,
+  Eigen::PlainObjectBase<DerivedCM>& CM,
+  Eigen::PlainObjectBase<DerivedR>& R,
+  Eigen::PlainObjectBase<DerivedEC>& EC)
+{
+  fast_winding_number_precompute(P,N,A,
+    [&CP](const int c)->int{ return CP(c,1); },
+    [&PI,&CP](const int c,const int j)->int{ return PI(CP(c,0)+j); },
+    CH,expansion_order,CM,R,EC);
 }
 
 template <
@@ -148,166 +396,43 @@ IGL_INLINE void igl::fast_winding_number(
   const BetaType beta,
   Eigen::PlainObjectBase<DerivedWN>& WN)
 {
+  fast_winding_number_eval(P,N,A,
+    [&point_indices](const int c)->int{ return point_indices[c].size(); },
+    [&point_indices](const int c,const int j)->int{ return point_indices[c][j]; },
+    CH,CM,R,EC,Q,beta,WN);
+}
 
-  typedef typename DerivedEC::Scalar real_ec;
-  typedef typename DerivedQ::Scalar real_q;
-  typedef typename DerivedWN::Scalar real_wn;
-  const real_wn PI_4 = 4.0*igl::PI;
-
-  typedef Eigen::Matrix<real_q,1,3> RowVec;
-
-  auto direct_eval = [&PI_4](
-    const RowVec & loc,
-    const Eigen::Matrix<real_ec,1,3> & anorm)->real_wn
-  {
-    const typename RowVec::Scalar loc_norm = loc.norm();
-    if(loc_norm == 0)
-    {
-      return 0.5;
-    }else
-    {
-      return (loc(0)*anorm(0)+loc(1)*anorm(1)+loc(2)*anorm(2))
-                                  /(PI_4*(loc_norm*loc_norm*loc_norm));
-    }
-  };
-
-  auto expansion_eval = 
-    [&direct_eval,&EC,&PI_4](
-      const RowVec & loc,
-      const int & child_index)->real_wn
-  {
-    real_wn wn;
-    wn = direct_eval(loc,EC.row(child_index).template head<3>());
-    real_wn r = loc.norm();
-    real_wn PI_4_r3;
-    real_wn PI_4_r5;
-    real_wn PI_4_r7;
-    if(EC.row(child_index).size()>3)
-    {
-      PI_4_r3 = PI_4*r*r*r;
-      PI_4_r5 = PI_4_r3*r*r;
-      const real_ec d = 1.0/(PI_4_r3);
-      Eigen::Matrix<real_ec,3,3> SecondDerivative = 
-        loc.transpose()*loc*(-3.0/(PI_4_r5));
-      SecondDerivative(0,0) += d;
-      SecondDerivative(1,1) += d;
-      SecondDerivative(2,2) += d;
-      wn += 
-        Eigen::Map<Eigen::Matrix<real_ec,1,9> >(
-          SecondDerivative.data(),
-          SecondDerivative.size()).dot(
-            EC.row(child_index).template segment<9>(3));
-    }
-    if(EC.row(child_index).size()>3+9)
-    {
-      PI_4_r7 = PI_4_r5*r*r;
-      const Eigen::Matrix<real_ec,3,3> locTloc = loc.transpose()*(loc/(PI_4_r7));
-      for(int i = 0; i < 3; i++)
-      {
-        Eigen::Matrix<real_ec,3,3> RowCol_Diagonal = 
-          Eigen::Matrix<real_ec,3,3>::Zero(3,3);
-        for(int u = 0;u<3;u++)
-        {
-          for(int v = 0;v<3;v++)
-          {
-            if(u==v) RowCol_Diagonal(u,v) += loc(i);
-            if(u==i) RowCol_Diagonal(u,v) += loc(v);
-            if(v==i) RowCol_Diagonal(u,v) += loc(u);
-          }
-        }
-        Eigen::Matrix<real_ec,3,3> ThirdDerivative = 
-          15.0*loc(i)*locTloc + (-3.0/(PI_4_r5))*(RowCol_Diagonal);
-
-        wn += Eigen::Map<Eigen::Matrix<real_ec,1,9> >(
-                ThirdDerivative.data(),
-                ThirdDerivative.size()).dot(
-            EC.row(child_index).template segment<9>(12 + i*9));
-      }
-    }
-    return wn;
-  };
-
-  int m = Q.rows();
-  WN.resize(m,1);
-
-  std::function< real_wn(const RowVec & , const std::vector<int> &) > helper;
-  helper = [&helper,
-            &P,&N,&A,
-            &point_indices,&CH,
-            &CM,&R,&beta,
-            &direct_eval,&expansion_eval]
-  (const RowVec & query, const std::vector<int> & near_indices)-> real_wn
-  {
-    real_wn wn = 0;
-    std::vector<int> new_near_indices;
-    new_near_indices.reserve(8);
-    for(int i = 0; i < near_indices.size(); i++)
-    {
-      int index = near_indices[i];
-      //Leaf Case, Brute force
-      if(CH(index,0) == -1)
-      {
-        for(int j = 0; j < point_indices[index].size(); j++)
-        {
-          int curr_row = point_indices[index][j];
-          wn += direct_eval(P.row(curr_row)-query,
-                            N.row(curr_row)*A(curr_row));
-        }
-      }
-      //Non-Leaf Case
-      else 
-      {
-        for(int child = 0; child < 8; child++)
-        {
-          int child_index = CH(index,child);
-          if(point_indices[child_index].size() > 0)
-          {
-            const RowVec CMciq = (CM.row(child_index)-query);
-            if(CMciq.norm() > beta*R(child_index))
-            {
-              if(CH(child_index,0) == -1)
-              {
-                for(int j=0;j<point_indices[child_index].size();j++)
-                {
-                  int curr_row = point_indices[child_index][j];
-                  wn += direct_eval(P.row(curr_row)-query,
-                                    N.row(curr_row)*A(curr_row));
-                }
-              }else{
-                wn += expansion_eval(CMciq,child_index);
-              }
-            }else 
-            {
-              new_near_indices.emplace_back(child_index);
-            }
-          }
-        }
-      }
-    }
-    if(new_near_indices.size() > 0)
-    {
-      wn += helper(query,new_near_indices);
-    }
-    return wn;
-  };
-
-  if(beta > 0)
-  {
-    const std::vector<int> near_indices_start = {0};
-    igl::parallel_for(m,[&](int iter){
-      WN(iter) = helper(Q.row(iter).eval(),near_indices_start);
-    },1000);
-  } else 
-  {
-    igl::parallel_for(m,[&](int iter){
-      double wn = 0;
-      for(int j = 0; j <P.rows(); j++)
-      {
-        wn += direct_eval(P.row(j)-Q.row(iter),N.row(j)*A(j));
-      }
-      WN(iter) = wn;
-    },1000);
-  }
+template <
+  typename DerivedP, 
+  typename DerivedA, 
+  typename DerivedN,
+  typename DerivedPI, 
+  typename DerivedCP, 
+  typename DerivedCH, 
+  typename DerivedCM, 
+  typename DerivedR,
+  typename DerivedEC, 
+  typename DerivedQ, 
+  typename BetaType,
+  typename DerivedWN>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedN>& N,
+  const Eigen::MatrixBase<DerivedA>& A,
+  const Eigen::MatrixBase<DerivedPI>& PI,
+  const Eigen::MatrixBase<DerivedCP>& CP,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const Eigen::MatrixBase<DerivedCM>& CM,
+  const Eigen::MatrixBase<DerivedR>& R,
+  const Eigen::MatrixBase<DerivedEC>& EC,
+  const Eigen::MatrixBase<DerivedQ>& Q,
+  const BetaType beta,
+  Eigen::PlainObjectBase<DerivedWN>& WN)
+{
+  fast_winding_number_eval(P,N,A,
+    [&CP](const int c)->int{ return CP(c,1); },
+    [&PI,&CP](const int c,const int j)->int{ return PI(CP(c,0)+j); },
+    CH,CM,R,EC,Q,beta,WN);
 }
 
 template <
@@ -328,19 +453,20 @@ IGL_INLINE void igl::fast_winding_number(
 {
   typedef typename DerivedWN::Scalar real;
   
-  std::vector<std::vector<int> > point_indices;
+  Eigen::VectorXi PI;
+  Eigen::Matrix<int,Eigen::Dynamic,2> CP;
   Eigen::Matrix<int,Eigen::Dynamic,8> CH;
   Eigen::Matrix<real,Eigen::Dynamic,3> CN;
   Eigen::Matrix<real,Eigen::Dynamic,1> W;
 
-  octree(P,point_indices,CH,CN,W);
+  octree(P,PI,CP,CH,CN,W);
 
   Eigen::Matrix<real,Eigen::Dynamic,Eigen::Dynamic> EC;
   Eigen::Matrix<real,Eigen::Dynamic,3> CM;
   Eigen::Matrix<real,Eigen::Dynamic,1> R;
 
-  fast_winding_number(P,N,A,point_indices,CH,expansion_order,CM,R,EC);
-  fast_winding_number(P,N,A,point_indices,CH,CM,R,EC,Q,beta,WN);
+  fast_winding_number(P,N,A,PI,CP,CH,expansion_order,CM,R,EC);
+  fast_winding_number(P,N,A,PI,CP,CH,CM,R,EC,Q,beta,WN);
 }
 
 template <
@@ -415,6 +541,28 @@ IGL_INLINE void igl::fast_winding_number(
     order);
 }
 
+template <typename DerivedV>
+IGL_INLINE float igl::fast_winding_number_refit(
+  const Eigen::MatrixBase<DerivedV> & V,
+  FastWindingNumberBVH & fwn_bvh)
+{
+  assert(V.cols() == 3 && "V should be 3D");
+  assert((size_t)V.rows() == fwn_bvh.U.size() && "V should match the precomputation");
+  // U keeps its storage so the pointer held by ut_solid_angle stays valid
+  igl::parallel_for(V.rows(),[&](const int i)
+  {
+    for(int j = 0;j<3;j++)
+    {
+      fwn_bvh.U[i][j] = V(i,j);
+    }
+  },10000);
+  if(fwn_bvh.U.empty())
+  {
+    return 1;
+  }
+  return fwn_bvh.ut_solid_angle.refit(&fwn_bvh.U[0]);
+}
+
 template <
   typename DerivedQ,
   typename DerivedW>
@@ -473,4 +621,8 @@ template void igl::fast_winding_number<Eigen::Matrix<float, -1, -1, 0, -1, -1>,
 template Eigen::Matrix<float, 1, 3, 1, 1, 3>::Scalar igl::fast_winding_number<Eigen::Matrix<float, 1, 3, 1, 1, 3> >(igl::FastWindingNumberBVH const&, float, Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> > const&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, int, igl::FastWindingNumberBVH&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, int, igl::FastWindingNumberBVH&);
+template float igl::fast_winding_number_refit<Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::FastWindingNumberBVH&);
+template float igl::fast_winding_number_refit<Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, igl::FastWindingNumberBVH&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
@@ -17,6 +17,14 @@ namespace igl
   /// obtained at scan time), may be calculated using
   /// igl::copyleft::cgal::point_areas.
   ///
+  /// Cells are processed in parallel. The expansions only depend on which
+  /// points belong to which cell (not on the cells' bounds), so when the
+  /// points move the same point_indices and CH can be passed again to refit
+  /// CM, R and EC without rebuilding the octree; queries stay correct but
+  /// slow down once the cells become loose. For large point clouds prefer
+  /// the compact octree layout (overload below), which is much faster to
+  /// build.
+  ///
   /// @param[in] P  #P by 3 list of point locations
   /// @param[in] N  #P by 3 list of point normals
   /// @param[in] A  #P by 1 list of point areas
@@ -51,6 +59,36 @@ namespace igl
     Eigen::PlainObjectBase<DerivedCM>& CM,
     Eigen::PlainObjectBase<DerivedR>& R,
     Eigen::PlainObjectBase<DerivedEC>& EC);
+  /// \overload
+  /// \brief using the compact octree layout output from the
+  /// igl::octree overload with PI and CP (cells' points as contiguous ranges
+  /// of a single permutation)
+  ///
+  /// @param[in] PI  #P list of indices into P sorted so that the points of
+  ///   each octree cell are contiguous
+  /// @param[in] CP  #OctreeCells by 2, where the ith row is the offset into
+  ///   PI of the ith cell's first point and the ith cell's number of points
+  template <
+    typename DerivedP, 
+    typename DerivedA, 
+    typename DerivedN,
+    typename DerivedPI, 
+    typename DerivedCP, 
+    typename DerivedCH, 
+    typename DerivedCM, 
+    typename DerivedR,
+    typename DerivedEC>
+  IGL_INLINE void fast_winding_number(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedN>& N,
+    const Eigen::MatrixBase<DerivedA>& A,
+    const Eigen::MatrixBase<DerivedPI>& PI,
+    const Eigen::MatrixBase<DerivedCP>& CP,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const int expansion_order,
+    Eigen::PlainObjectBase<DerivedCM>& CM,
+    Eigen::PlainObjectBase<DerivedR>& R,
+    Eigen::PlainObjectBase<DerivedEC>& EC);
   /// Evaluate the fast winding number for point data, having already done the
   /// the precomputation
   ///
@@ -98,6 +136,34 @@ namespace igl
     const BetaType beta,
     Eigen::PlainObjectBase<DerivedWN>& WN);
   /// \overload
+  /// \brief using the compact octree layout (see above)
+  template <
+    typename DerivedP, 
+    typename DerivedA, 
+    typename DerivedN,
+    typename DerivedPI, 
+    typename DerivedCP, 
+    typename DerivedCH, 
+    typename DerivedCM, 
+    typename DerivedR,
+    typename DerivedEC, 
+    typename DerivedQ, 
+    typename BetaType,
+    typename DerivedWN>
+  IGL_INLINE void fast_winding_number(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedN>& N,
+    const Eigen::MatrixBase<DerivedA>& A,
+    const Eigen::MatrixBase<DerivedPI>& PI,
+    const Eigen::MatrixBase<DerivedCP>& CP,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCM>& CM,
+    const Eigen::MatrixBase<DerivedR>& R,
+    const Eigen::MatrixBase<DerivedEC>& EC,
+    const Eigen::MatrixBase<DerivedQ>& Q,
+    const BetaType beta,
+    Eigen::PlainObjectBase<DerivedWN>& WN);
+  /// \overload
   ///
   /// \brief Evaluate the fast winding number for point data without caching the
   /// precomputation.
@@ -178,6 +244,26 @@ namespace igl
     const Eigen::MatrixBase<DerivedF> & F,
     const int order,
     FastWindingNumberBVH & fwn_bvh);
+  /// Update the precomputation for new vertex positions of the same mesh
+  /// (e.g., a deforming character) without rebuilding the tree: bounding
+  /// boxes, centroids, radii and the Taylor coefficients are recomputed
+  /// bottom-up in parallel over the existing hierarchy.
+  ///
+  /// Refitting keeps the results exact for the given accuracy_scale, but the
+  /// tree can become loose under large deformations making queries slower.
+  /// The returned quality measures this so the caller can decide when to
+  /// call the full precomputation again instead.
+  ///
+  /// @param[in] V  #V by 3 list of new mesh vertex positions (same #V as used
+  ///   to build fwn_bvh)
+  /// @param[in,out] fwn_bvh  Precomputed bounding volume hierarchy
+  /// @return ratio of the hierarchy's current surface area cost to its cost
+  ///   when built: 1 means as good as a rebuild would be (roughly), values
+  ///   above ~1.5 suggest rebuilding.
+  template <typename DerivedV>
+  IGL_INLINE float fast_winding_number_refit(
+    const Eigen::MatrixBase<DerivedV> & V,
+    FastWindingNumberBVH & fwn_bvh);
   /// After precomputation, compute winding number at a each of many points in a
   /// list.
   ///
@@ -6,8 +6,128 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "hausdorff.h"
+#include "AABB.h"
+#include "parallel_for.h"
 #include "point_mesh_squared_distance.h"
+#include "point_simplex_squared_distance.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  // Lower and upper bounds on the largest distance to B of a point on the
+  // triangle with corners V, given the distances d of its corners to B
+  template <typename DerivedV, typename Derivedd>
+  void hausdorff_triangle_bounds(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<Derivedd> & d,
+    typename Derivedd::Scalar & l,
+    typename Derivedd::Scalar & u)
+  {
+    typedef typename Derivedd::Scalar Scalar;
+    // e  3-long vector of opposite edge lengths
+    Eigen::Matrix<Scalar,1,3> e;
+    // Maximum edge length
+    Scalar e_max = 0;
+    for(int i=0;i<3;i++)
+    {
+      e(i) = (V.row((i+1)%3)-V.row((i+2)%3)).template cast<Scalar>().norm();
+      e_max = std::max(e_max,e(i));
+    }
+    // Semiperimeter
+    const Scalar s = (e(0)+e(1)+e(2))*0.5;
+    // Area
+    const Scalar A = sqrt(std::max(Scalar(0),s*(s-e(0))*(s-e(1))*(s-e(2))));
+    // Lower bound is simply the max over corner distances
+    l = 0;
+    Scalar u1 = std::numeric_limits<Scalar>::infinity();
+    Scalar u2 = 0;
+    for(int i=0;i<3;i++)
+    {
+      l = std::max(d(i),l);
+      // u1 is the minimum of corner distances + maximum adjacent edge
+      u1 = std::min(u1,d(i) + std::max(e((i+1)%3),e((i+2)%3)));
+      // u2 first takes the maximum over corner distances
+      u2 = std::max(u2,d(i));
+    }
+    // u2 is the distance from the circumcenter/midpoint of obtuse edge plus
+    // the largest corner distance (degenerate triangles count as obtuse)
+    bool acute = false;
+    // Circumradius
+    Scalar R = 0;
+    if(A > 0)
+    {
+      R = e(0)*e(1)*e(2)/(4.*A);
+      // inradius
+      const Scalar r = A/s;
+      acute = s-r>2.*R;
+    }
+    u2 += (acute ? R : 0.5*e_max);
+    u = std::min(u1,u2);
+  }
+
+  // Closest-point queries against one of the two meshes
+  template <typename DerivedV, typename DerivedF>
+  struct HausdorffTarget
+  {
+    typedef typename DerivedV::Scalar TScalar;
+    typedef Eigen::Matrix<TScalar,1,3> RowVector3T;
+    const igl::AABB<DerivedV,3> & tree;
+    const Eigen::MatrixBase<DerivedV> & V;
+    const Eigen::MatrixBase<DerivedF> & F;
+    // Squared distance from x to triangle F(f,:) and closest point c
+    template <typename RowVector3S>
+    typename RowVector3S::Scalar to_triangle(
+      const RowVector3S & x,
+      const int f,
+      RowVector3S & c) const
+    {
+      const RowVector3T xt = x.template cast<TScalar>();
+      TScalar sqr_d;
+      RowVector3T ct;
+      igl::point_simplex_squared_distance<3>(xt,V,F,f,sqr_d,ct);
+      c = ct.template cast<typename RowVector3S::Scalar>();
+      return sqr_d;
+    }
+    // Squared distance from x to the mesh if less than up_sqr_d, otherwise
+    // i is left at -1
+    template <typename RowVector3S>
+    typename RowVector3S::Scalar closest(
+      const RowVector3S & x,
+      const typename RowVector3S::Scalar up_sqr_d,
+      int & i,
+      RowVector3S & c) const
+    {
+      const RowVector3T xt = x.template cast<TScalar>();
+      RowVector3T ct;
+      i = -1;
+      const TScalar sqr_d = tree.squared_distance(V,F,xt,up_sqr_d,i,ct);
+      if(i >= 0)
+      {
+        c = ct.template cast<typename RowVector3S::Scalar>();
+      }
+      return sqr_d;
+    }
+  };
+
+  template <typename Scalar>
+  struct HausdorffRegion
+  {
+    // Corners (rows), their distances to the other mesh and the indices of
+    // their closest triangles on it
+    Eigen::Matrix<Scalar,3,3> V;
+    Eigen::Matrix<Scalar,1,3> d;
+    int I[3];
+    // Upper bound on the distance to the other mesh of any point in the
+    // region
+    Scalar u;
+    // 0 if the region is part of A (measured against B), 1 if part of B
+    int side;
+  };
+}
 
 template <
   typename DerivedVA,
@@ -45,46 +165,343 @@ IGL_INLINE void igl::hausdorff(
   Scalar & l,
   Scalar & u)
 {
-  // e  3-long vector of opposite edge lengths
-  Eigen::Matrix<typename DerivedV::Scalar,1,3> e;
-  // Maximum edge length
-  Scalar e_max = 0;
-  for(int i=0;i<3;i++)
-  {
-    e(i) = (V.row((i+1)%3)-V.row((i+2)%3)).norm();
-    e_max = std::max(e_max,e(i));
-  }
-  // Semiperimeter
-  const Scalar s = (e(0)+e(1)+e(2))*0.5;
-  // Area
-  const Scalar A = sqrt(s*(s-e(0))*(s-e(1))*(s-e(2)));
-  // Circumradius
-  const Scalar R = e(0)*e(1)*e(2)/(4.*A);
-  // inradius
-  const Scalar r = A/s;
-  // Initialize lower bound to ∞
-  l = std::numeric_limits<Scalar>::infinity();
   // d  3-long vector of distance from each corner to B
-  Eigen::Matrix<typename DerivedV::Scalar,1,3> d;
-  Scalar u1 = std::numeric_limits<Scalar>::infinity();
-  Scalar u2 = 0;
+  Eigen::Matrix<Scalar,1,3> d;
   for(int i=0;i<3;i++)
   {
     d(i) = dist_to_B(V(i,0),V(i,1),V(i,2));
-    // Lower bound is simply the max over vertex distances
-    l = std::max(d(i),l);
-    // u1 is the minimum of corner distances + maximum adjacent edge
-    u1 = std::min(u1,d(i) + std::max(e((i+1)%3),e((i+2)%3)));
-    // u2 first takes the maximum over corner distances
-    u2 = std::max(u2,d(i));
   }
-  // u2 is the distance from the circumcenter/midpoint of obtuse edge plus the
-  // largest corner distance
-  u2 += (s-r>2.*R ? R : 0.5*e_max);
-  u = std::min(u1,u2);
+  hausdorff_triangle_bounds(V,d,l,u);
+}
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar,
+  typename Derivedp,
+  typename Derivedq>
+IGL_INLINE void igl::hausdorff(
+  const AABB<DerivedVA,3> & treeA,
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const AABB<DerivedVB,3> & treeB,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  const Scalar tolerance,
+  Scalar & l,
+  Scalar & u,
+  Eigen::PlainObjectBase<Derivedp> & p,
+  Eigen::PlainObjectBase<Derivedq> & q)
+{
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  typedef HausdorffRegion<Scalar> Region;
+  assert(VA.cols() == 3 && "VA should contain 3d points");
+  assert(FA.cols() == 3 && "FA should contain triangles");
+  assert(VB.cols() == 3 && "VB should contain 3d points");
+  assert(FB.cols() == 3 && "FB should contain triangles");
+  assert(tolerance > 0 && "tolerance should be positive");
+  if(FA.rows() == 0 || FB.rows() == 0)
+  {
+    l = std::numeric_limits<Scalar>::infinity();
+    u = std::numeric_limits<Scalar>::infinity();
+    p.setConstant(1,3,std::numeric_limits<typename Derivedp::Scalar>::quiet_NaN());
+    q.setConstant(1,3,std::numeric_limits<typename Derivedq::Scalar>::quiet_NaN());
+    return;
+  }
+  const HausdorffTarget<DerivedVB,DerivedFB> to_B{treeB,VB,FB};
+  const HausdorffTarget<DerivedVA,DerivedFA> to_A{treeA,VA,FA};
+  const auto vertex = [&](const int side,const int v)->RowVector3S
+  {
+    if(side == 0)
+    {
+      return VA.row(v).template cast<Scalar>();
+    }
+    return VB.row(v).template cast<Scalar>();
+  };
+  const auto closest = [&](
+    const int side,
+    const RowVector3S & x,
+    const Scalar up_sqr_d,
+    int & i,
+    RowVector3S & c)->Scalar
+  {
+    return side == 0 ?
+      to_B.closest(x,up_sqr_d,i,c) : to_A.closest(x,up_sqr_d,i,c);
+  };
+  const auto to_triangle = [&](
+    const int side,
+    const RowVector3S & x,
+    const int f,
+    RowVector3S & c)->Scalar
+  {
+    return side == 0 ? to_B.to_triangle(x,f,c) : to_A.to_triangle(x,f,c);
+  };
+
+  // Distance of every vertex to the other mesh
+  const Eigen::Index nv[2] = {VA.rows(),VB.rows()};
+  Eigen::Matrix<Scalar,Eigen::Dynamic,1> D[2];
+  Eigen::VectorXi I[2];
+  Eigen::Matrix<Scalar,Eigen::Dynamic,3> C[2];
+  for(int side = 0;side<2;side++)
+  {
+    D[side].resize(nv[side]);
+    I[side].resize(nv[side]);
+    C[side].resize(nv[side],3);
+    igl::parallel_for(nv[side],[&](const int v)
+    {
+      RowVector3S c = RowVector3S::Zero();
+      int i;
+      D[side](v) = sqrt(closest(
+        side,vertex(side,v),std::numeric_limits<Scalar>::infinity(),i,c));
+      I[side](v) = i;
+      C[side].row(v) = c;
+    },1000);
+  }
+
+  // Farthest point found so far and its closest point on the other mesh
+  Scalar L = -1;
+  RowVector3S P = RowVector3S::Zero();
+  RowVector3S Q = RowVector3S::Zero();
+  const auto witness = [&](
+    const Scalar d,const RowVector3S & x,const RowVector3S & c)
+  {
+    if(d > L)
+    {
+      L = d;
+      P = x;
+      Q = c;
+    }
+  };
+  const Eigen::Index nf[2] = {FA.rows(),FB.rows()};
+  for(int side = 0;side<2;side++)
+  {
+    for(Eigen::Index f = 0;f<nf[side];f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        const int v = side == 0 ? FA(f,c) : FB(f,c);
+        witness(D[side](v),vertex(side,v),C[side].row(v));
+      }
+    }
+  }
+
+  // Tighten the geometric bound with the triangles closest to the corners
+  // unless it already shows that the region cannot matter (L is only
+  // updated between parallel passes)
+  const auto bound = [&](Region & R)
+  {
+    Scalar lR;
+    hausdorff_triangle_bounds(R.V,R.d,lR,R.u);
+    for(int j = 0;j<3 && R.u > L+tolerance;j++)
+    {
+      if((j > 0 && R.I[j] == R.I[0]) || (j > 1 && R.I[j] == R.I[1]))
+      {
+        continue;
+      }
+      Scalar u_j = R.d(j);
+      for(int k = 0;k<3 && u_j < R.u;k++)
+      {
+        if(k != j)
+        {
+          RowVector3S c;
+          u_j = std::max(u_j,
+            sqrt(to_triangle(R.side,RowVector3S(R.V.row(k)),R.I[j],c)));
+        }
+      }
+      R.u = std::min(R.u,u_j);
+    }
+  };
+
+  // Regions that may still contain a farther point (max-heap on u). Those
+  // that cannot exceed L by more than the tolerance are dropped, keeping
+  // only their largest upper bound.
+  std::vector<Region> heap;
+  Scalar settled = 0;
+  const auto by_u = [](const Region & a,const Region & b){ return a.u < b.u; };
+  const auto keep = [&](const Region & R)->bool
+  {
+    if(R.u > L+tolerance)
+    {
+      return true;
+    }
+    settled = std::max(settled,R.u);
+    return false;
+  };
+  {
+    std::vector<Region> regions(nf[0]+nf[1]);
+    igl::parallel_for(regions.size(),[&](const size_t r)
+    {
+      Region & R = regions[r];
+      R.side = Eigen::Index(r) < nf[0] ? 0 : 1;
+      const Eigen::Index f = R.side == 0 ? r : r-nf[0];
+      for(int c = 0;c<3;c++)
+      {
+        const int v = R.side == 0 ? FA(f,c) : FB(f,c);
+        R.V.row(c) = vertex(R.side,v);
+        R.d(c) = D[R.side](v);
+        R.I[c] = I[R.side](v);
+      }
+      bound(R);
+    },1000);
+    for(const Region & R : regions)
+    {
+      if(keep(R))
+      {
+        heap.push_back(R);
+      }
+    }
+    std::make_heap(heap.begin(),heap.end(),by_u);
+  }
+
+  // Split regions with the largest upper bounds into four at their edge
+  // midpoints. Batches have a fixed size so that the result does not depend
+  // on the number of threads.
+  struct Split
+  {
+    // Corner children and the middle child, whose corners are the midpoints
+    Region child[4];
+    // Closest points to the midpoints
+    RowVector3S C[3];
+  };
+  const size_t batch = 1024;
+  std::vector<Region> work;
+  std::vector<Split> splits;
+  while(!heap.empty() && heap.front().u > L+tolerance)
+  {
+    work.clear();
+    while(
+      work.size() < batch && !heap.empty() && heap.front().u > L+tolerance)
+    {
+      std::pop_heap(heap.begin(),heap.end(),by_u);
+      work.push_back(heap.back());
+      heap.pop_back();
+    }
+    splits.resize(work.size());
+    igl::parallel_for(work.size(),[&](const size_t w)
+    {
+      const Region & R = work[w];
+      Split & S = splits[w];
+      Region & M = S.child[3];
+      M.side = R.side;
+      for(int j = 0;j<3;j++)
+      {
+        const int a = (j+1)%3;
+        const int b = (j+2)%3;
+        const RowVector3S x = 0.5*(R.V.row(a)+R.V.row(b));
+        M.V.row(j) = x;
+        // The nearer of the endpoints' closest triangles bounds the search
+        RowVector3S c,c_b;
+        int f = R.I[a];
+        Scalar sqr_d = to_triangle(R.side,x,f,c);
+        if(R.I[b] != R.I[a])
+        {
+          const Scalar sqr_d_b = to_triangle(R.side,x,R.I[b],c_b);
+          if(sqr_d_b < sqr_d)
+          {
+            sqr_d = sqr_d_b;
+            c = c_b;
+            f = R.I[b];
+          }
+        }
+        // If even that is no farther than L, the midpoint cannot raise the
+        // lower bound and the upper bounds only need an overestimate of its
+        // distance
+        if(sqrt(sqr_d) > L)
+        {
+          int i;
+          RowVector3S c_i;
+          const Scalar sqr_d_i = closest(R.side,x,sqr_d,i,c_i);
+          if(i >= 0)
+          {
+            sqr_d = sqr_d_i;
+            c = c_i;
+            f = i;
+          }
+        }
+        M.d(j) = sqrt(sqr_d);
+        M.I[j] = f;
+        S.C[j] = c;
+      }
+      // Corner child j keeps corner j; its other corners are the midpoints
+      // of the edges to corner k, opposite corner 3-j-k
+      for(int j = 0;j<3;j++)
+      {
+        Region & Cj = S.child[j];
+        Cj.side = R.side;
+        for(int k = 0;k<3;k++)
+        {
+          const Region & from = k == j ? R : M;
+          const int m = k == j ? k : 3-j-k;
+          Cj.V.row(k) = from.V.row(m);
+          Cj.d(k) = from.d(m);
+          Cj.I[k] = from.I[m];
+        }
+      }
+      for(Region & child : S.child)
+      {
+        bound(child);
+      }
+    },64);
+    for(const Split & S : splits)
+    {
+      for(int j = 0;j<3;j++)
+      {
+        witness(S.child[3].d(j),S.child[3].V.row(j),S.C[j]);
+      }
+    }
+    for(const Split & S : splits)
+    {
+      for(const Region & child : S.child)
+      {
+        if(keep(child))
+        {
+          heap.push_back(child);
+          std::push_heap(heap.begin(),heap.end(),by_u);
+        }
+      }
+    }
+  }
+  l = L;
+  u = std::max(L,settled);
+  if(!heap.empty())
+  {
+    u = std::max(u,heap.front().u);
+  }
+  p = P.template cast<typename Derivedp::Scalar>();
+  q = Q.template cast<typename Derivedq::Scalar>();
+}
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar,
+  typename Derivedp,
+  typename Derivedq>
+IGL_INLINE void igl::hausdorff(
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  const Scalar tolerance,
+  Scalar & l,
+  Scalar & u,
+  Eigen::PlainObjectBase<Derivedp> & p,
+  Eigen::PlainObjectBase<Derivedq> & q)
+{
+  igl::AABB<DerivedVA,3> treeA;
+  treeA.init(VA,FA);
+  igl::AABB<DerivedVB,3> treeB;
+  treeB.init(VB,FB);
+  hausdorff(treeA,VA,FA,treeB,VB,FB,tolerance,l,u,p,q);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double&);
+template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double&, double&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double&, double&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::function<double (double const&, double const&, double const&)> const&, double&, double&);
 #endif
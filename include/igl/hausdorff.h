@@ -14,6 +14,7 @@
 
 namespace igl
 {
+  template <typename DerivedV, int DIM> class AABB;
   /// Compute the Hausdorff distance between mesh (VA,FA) and mesh
   /// (VB,FB). This is the
   ///
@@ -30,7 +31,8 @@ namespace igl
   /// non-vertex point _on the edge_ of the V.
   /// Known issue: due to the issue above, this also means that unreferenced
   /// vertices can give unexpected results. Therefore, we assume the inputs have
-  /// no unreferenced vertices.
+  /// no unreferenced vertices. The overload taking a tolerance below does not
+  /// have these issues.
   ///
   /// @param[in] VA  #VA by 3 list of vertex positions
   /// @param[in] FA  #FA by 3 list of face indices into VA
@@ -69,6 +71,78 @@ namespace igl
       Scalar(const Scalar &,const Scalar &, const Scalar &)> & dist_to_B,
     Scalar & l,
     Scalar & u);
+  /// Compute the Hausdorff distance between mesh (VA,FA) and mesh (VB,FB) up
+  /// to a given absolute tolerance, including points of the surfaces (not
+  /// just vertices). Triangles of both meshes are refined adaptively by
+  /// midpoint subdivision. Each region keeps the distances of its corners to
+  /// the other mesh (a lower bound) and an upper bound on the distance of any
+  /// of its points: the smaller of the geometric bound above and the largest
+  /// distance from its corners to any triangle that is closest to one of them
+  /// (distance to a fixed triangle is convex, so it peaks at a corner).
+  /// Regions whose upper bound cannot exceed the largest distance found so
+  /// far are pruned; the rest are refined in parallel, largest upper bound
+  /// first, until the bounds are within tolerance. Closest-point queries use
+  /// the AABB hierarchies, bounded by the distance to the closest triangle of
+  /// a neighboring corner (and skipped if that cannot raise the lower bound).
+  /// The result does not depend on the number of threads.
+  ///
+  /// @param[in] treeA  AABB hierarchy of (VA,FA)
+  /// @param[in] VA  #VA by 3 list of vertex positions
+  /// @param[in] FA  #FA by 3 list of face indices into VA
+  /// @param[in] treeB  AABB hierarchy of (VB,FB)
+  /// @param[in] VB  #VB by 3 list of vertex positions
+  /// @param[in] FB  #FB by 3 list of face indices into VB
+  /// @param[in] tolerance  positive absolute tolerance so that on output
+  ///   u-l ≤ tolerance
+  /// @param[out] l  lower bound on Hausdorff distance, the distance between
+  ///   p and q (infinity if either mesh is empty)
+  /// @param[out] u  upper bound on Hausdorff distance
+  /// @param[out] p  3-long point on A or B whose distance to the other mesh
+  ///   is l (NaN if either mesh is empty)
+  /// @param[out] q  3-long closest point to p on the other mesh (NaN if
+  ///   either mesh is empty)
+  ///
+  /// \see AABB, mesh_mesh_squared_distance
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar,
+    typename Derivedp,
+    typename Derivedq>
+  IGL_INLINE void hausdorff(
+    const AABB<DerivedVA,3> & treeA,
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const AABB<DerivedVB,3> & treeB,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    const Scalar tolerance,
+    Scalar & l,
+    Scalar & u,
+    Eigen::PlainObjectBase<Derivedp> & p,
+    Eigen::PlainObjectBase<Derivedq> & q);
+  /// \overload
+  /// \brief Trees built internally.
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar,
+    typename Derivedp,
+    typename Derivedq>
+  IGL_INLINE void hausdorff(
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    const Scalar tolerance,
+    Scalar & l,
+    Scalar & u,
+    Eigen::PlainObjectBase<Derivedp> & p,
+    Eigen::PlainObjectBase<Derivedq> & q);
 }
 
 #ifndef IGL_STATIC_LIBRARY
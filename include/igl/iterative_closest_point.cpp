@@ -11,8 +11,14 @@
 #include "random_points_on_mesh.h"
 #include "placeholders.h"
 #include "rigid_alignment.h"
+#include "parallel_for.h"
+#include <Eigen/Geometry>
+#include <Eigen/QR>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 template <
   typename DerivedVX,
@@ -111,7 +117,266 @@ IGL_INLINE void igl::iterative_closest_point(
   }
 }
 
+template <
+  typename DerivedVX,
+  typename DerivedFX,
+  typename DerivedVY,
+  typename DerivedFY,
+  typename DerivedNY,
+  typename DerivedR,
+  typename Derivedt
+  >
+IGL_INLINE int igl::iterative_closest_point(
+  const Eigen::MatrixBase<DerivedVX> & VX,
+  const Eigen::MatrixBase<DerivedFX> & FX,
+  const Eigen::MatrixBase<DerivedVY> & VY,
+  const Eigen::MatrixBase<DerivedFY> & FY,
+  const igl::AABB<DerivedVY,3> & Ytree,
+  const Eigen::MatrixBase<DerivedNY> & NY,
+  const ICPParams & params,
+  Eigen::PlainObjectBase<DerivedR> & R,
+  Eigen::PlainObjectBase<Derivedt> & t)
+{
+  assert(VX.cols() == 3 && "X should be a mesh in 3D");
+  assert(VY.cols() == 3 && "Y should be a mesh in 3D");
+  typedef typename DerivedVX::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3> MatrixX3S;
+  typedef Eigen::Matrix<Scalar,3,3> Matrix3S;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  typedef Eigen::Matrix<Scalar,6,6> Matrix6S;
+  typedef Eigen::Matrix<Scalar,6,1> Vector6S;
+  typedef typename igl::AABB<DerivedVY,3>::RowVectorDIMS RowVector3Y;
+  Matrix3S R_ = Matrix3S::Identity();
+  RowVector3S t_ = RowVector3S::Zero();
+  int iters = 0;
+  if(FX.rows() == 0 || FY.rows() == 0 || params.num_samples <= 0)
+  {
+    R = R_;
+    t = t_;
+    return iters;
+  }
+
+  // Samples of X (in its own frame). They are independent, so every prefix
+  // is itself a uniform random sample: the coarse levels use prefixes
+  MatrixXS XS;
+  Eigen::VectorXi XI;
+  {
+    MatrixX3S B;
+    random_points_on_mesh(params.num_samples,VX,FX,B,XI,XS);
+  }
+  MatrixXS NX;
+  if(params.objective == ICP_OBJECTIVE_SYMMETRIC)
+  {
+    per_face_normals(VX,FX,NX);
+  }
+  const Scalar diag = (VY.colwise().maxCoeff()-VY.colwise().minCoeff())
+    .template cast<Scalar>().norm();
+
+  // Per sample: transformed position, residual vector (x-y) and normal of
+  // the objective (unused for point-to-point)
+  MatrixX3S X(params.num_samples,3);
+  MatrixX3S E(params.num_samples,3);
+  MatrixX3S N(params.num_samples,3);
+  VectorXS r(params.num_samples);
+  std::vector<Scalar> abs_r;
+  // Normal equations are accumulated per chunk (in parallel) and the chunks
+  // summed in order
+  const int chunk = 1024;
+  std::vector<Matrix6S> A_chunk;
+  std::vector<Vector6S> b_chunk;
+  const auto skew = [](const RowVector3S & x)->Matrix3S
+  {
+    Matrix3S K;
+    K<<
+          0,-x(2), x(1),
+       x(2),    0,-x(0),
+      -x(1), x(0),    0;
+    return K;
+  };
+  for(int level = 0;level<params.levels;level++)
+  {
+    const int n = std::max(1,
+      params.num_samples >> (2*std::min(30,params.levels-1-level)));
+    const RowVector3S mean_XS = XS.topRows(n).colwise().mean();
+    for(int iter = 0;iter<params.max_iters;iter++)
+    {
+      iters++;
+      // Closest points and residuals
+      igl::parallel_for(n,[&](const int i)
+      {
+        const RowVector3S x = XS.row(i)*R_+t_;
+        const RowVector3Y xy = x.template cast<typename RowVector3Y::Scalar>();
+        int fi;
+        RowVector3Y c;
+        Ytree.squared_distance(VY,FY,xy,fi,c);
+        const RowVector3S e = x-c.template cast<Scalar>();
+        X.row(i) = x;
+        E.row(i) = e;
+        if(params.objective == ICP_OBJECTIVE_POINT_TO_POINT)
+        {
+          r(i) = e.norm();
+          return;
+        }
+        RowVector3S nr = NY.row(fi).template cast<Scalar>();
+        if(params.objective == ICP_OBJECTIVE_SYMMETRIC)
+        {
+          // Orient consistently in case X and Y do not agree
+          const RowVector3S nx = NX.row(XI(i))*R_;
+          if(nx.dot(nr) < 0)
+          {
+            nr -= nx;
+          }else
+          {
+            nr += nx;
+          }
+        }
+        N.row(i) = nr;
+        r(i) = e.dot(nr);
+      },1000);
+
+      // Robust weights
+      Scalar scale = params.robust_scale;
+      if(params.weight != ICP_WEIGHT_NONE && scale <= 0)
+      {
+        abs_r.resize(n);
+        for(int i = 0;i<n;i++)
+        {
+          abs_r[i] = std::abs(r(i));
+        }
+        std::nth_element(abs_r.begin(),abs_r.begin()+n/2,abs_r.end());
+        scale = 1.4826*abs_r[n/2];
+      }
+      const auto weight = [&](const Scalar ri)->Scalar
+      {
+        if(scale <= 0)
+        {
+          return 1;
+        }
+        const Scalar a = std::abs(ri);
+        switch(params.weight)
+        {
+          case ICP_WEIGHT_HUBER:
+          {
+            const Scalar k = 1.345*scale;
+            return a <= k ? Scalar(1) : k/a;
+          }
+          case ICP_WEIGHT_TUKEY:
+          {
+            const Scalar c = 4.685*scale;
+            if(a >= c)
+            {
+              return 0;
+            }
+            const Scalar s = 1-(a/c)*(a/c);
+            return s*s;
+          }
+          default:
+            return 1;
+        }
+      };
+
+      // Linearize the update about the centroid c of the samples,
+      //   x ↦ c + (x-c) + ω×(x-c) + τ,
+      // and accumulate JᵀWJ u = -JᵀWe for u = (ω,τ)
+      const RowVector3S c = mean_XS*R_+t_;
+      const int num_chunks = (n+chunk-1)/chunk;
+      A_chunk.resize(num_chunks);
+      b_chunk.resize(num_chunks);
+      igl::parallel_for(num_chunks,[&](const int k)
+      {
+        Matrix6S A = Matrix6S::Zero();
+        Vector6S b = Vector6S::Zero();
+        for(int i = k*chunk;i<std::min(n,(k+1)*chunk);i++)
+        {
+          const Scalar w = weight(r(i));
+          if(w == 0)
+          {
+            continue;
+          }
+          const RowVector3S x = X.row(i)-c;
+          if(params.objective == ICP_OBJECTIVE_POINT_TO_POINT)
+          {
+            Eigen::Matrix<Scalar,3,6> J;
+            J<<-skew(x),Matrix3S::Identity();
+            A += w*J.transpose()*J;
+            b += w*J.transpose()*E.row(i).transpose();
+          }else
+          {
+            const RowVector3S nr = N.row(i);
+            Vector6S j;
+            j<<x.cross(nr).transpose(),nr.transpose();
+            A += w*j*j.transpose();
+            b += (w*r(i))*j;
+          }
+        }
+        A_chunk[k] = A;
+        b_chunk[k] = b;
+      },1);
+      Matrix6S A = Matrix6S::Zero();
+      Vector6S b = Vector6S::Zero();
+      for(int k = 0;k<num_chunks;k++)
+      {
+        A += A_chunk[k];
+        b += b_chunk[k];
+      }
+      // Rank revealing: sliding along symmetric directions (e.g., planes
+      // under point-to-plane) is left at zero
+      const Vector6S u =
+        Eigen::CompleteOrthogonalDecomposition<Matrix6S>(A).solve(-b);
+      const Eigen::Matrix<Scalar,3,1> omega = u.head(3);
+      const RowVector3S tau = u.tail(3).transpose();
+      const Scalar theta = omega.norm();
+      Matrix3S Rup = Matrix3S::Identity();
+      if(theta > 0)
+      {
+        // Row vectors: x ↦ x*Rup rotates by ω
+        Rup = Eigen::AngleAxis<Scalar>(theta,omega/theta)
+          .toRotationMatrix().transpose();
+      }
+      R_ = (R_*Rup).eval();
+      t_ = ((t_-c)*Rup+c+tau).eval();
+      if(theta < params.tolerance && tau.norm() < params.tolerance*diag)
+      {
+        break;
+      }
+    }
+  }
+  R = R_;
+  t = t_;
+  return iters;
+}
+
+template <
+  typename DerivedVX,
+  typename DerivedFX,
+  typename DerivedVY,
+  typename DerivedFY,
+  typename DerivedR,
+  typename Derivedt
+  >
+IGL_INLINE int igl::iterative_closest_point(
+  const Eigen::MatrixBase<DerivedVX> & VX,
+  const Eigen::MatrixBase<DerivedFX> & FX,
+  const Eigen::MatrixBase<DerivedVY> & VY,
+  const Eigen::MatrixBase<DerivedFY> & FY,
+  const ICPParams & params,
+  Eigen::PlainObjectBase<DerivedR> & R,
+  Eigen::PlainObjectBase<Derivedt> & t)
+{
+  typedef typename DerivedVX::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  AABB<DerivedVY,3> Ytree;
+  Ytree.init(VY,FY);
+  MatrixXS NY;
+  per_face_normals(VY,FY,NY);
+  return iterative_closest_point(VX,FX,VY,FY,Ytree,NY,params,R,t);
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::iterative_closest_point<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, int, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+template int igl::iterative_closest_point<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::ICPParams const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+template int igl::iterative_closest_point<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::ICPParams const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
 #endif
@@ -13,6 +13,52 @@
 
 namespace igl
 {
+  /// Objective minimized at each iteration of iterative_closest_point, where
+  /// y is the point of Y closest to a sample x of X
+  enum ICPObjective
+  {
+    /// ‖x-y‖²
+    ICP_OBJECTIVE_POINT_TO_POINT = 0,
+    /// ((x-y)·n_y)², with n_y the normal of Y at y
+    ICP_OBJECTIVE_POINT_TO_PLANE = 1,
+    /// ((x-y)·(n_x+n_y))², with n_x the normal of X at x ("A Symmetric
+    /// Objective Function for ICP" [Rusinkiewicz 2019])
+    ICP_OBJECTIVE_SYMMETRIC = 2,
+    NUM_ICP_OBJECTIVES = 3
+  };
+  /// Robust reweighting of iterative_closest_point residuals
+  enum ICPWeight
+  {
+    /// Least squares
+    ICP_WEIGHT_NONE = 0,
+    /// Huber: residuals beyond 1.345·scale are weighted down linearly
+    ICP_WEIGHT_HUBER = 1,
+    /// Tukey's biweight: residuals beyond 4.685·scale are ignored
+    ICP_WEIGHT_TUKEY = 2,
+    NUM_ICP_WEIGHTS = 3
+  };
+  /// Parameters of iterative_closest_point
+  struct ICPParams
+  {
+    /// Objective minimized at each iteration
+    ICPObjective objective = ICP_OBJECTIVE_POINT_TO_PLANE;
+    /// Robust weights of residuals
+    ICPWeight weight = ICP_WEIGHT_NONE;
+    /// Residual scale of the robust weights, 0 means estimate it at each
+    /// iteration as 1.4826·median(|residual|)
+    double robust_scale = 0;
+    /// Number of random samples on X at the finest level
+    int num_samples = 1000;
+    /// Number of coarse-to-fine levels, each using a quarter of the samples
+    /// of the next (finer) one
+    int levels = 1;
+    /// Maximum number of iterations per level
+    int max_iters = 100;
+    /// A level ends once an iteration rotates by less than this (radians)
+    /// and translates by less than this times the bounding box diagonal of
+    /// Y
+    double tolerance = 1e-6;
+  };
   /// Solve for the rigid transformation that places mesh X onto mesh Y using the
   /// iterative closest point method. In particular, optimize:
   ///
@@ -72,6 +118,62 @@ namespace igl
     const int max_iters,
     Eigen::PlainObjectBase<DerivedR> & R,
     Eigen::PlainObjectBase<Derivedt> & t);
+  /// Solve for the rigid transformation that places mesh X onto mesh Y by
+  /// Gauss-Newton iterations on a fixed set of samples of X. Closest points
+  /// and the (robustly weighted) 6×6 normal equations of each iteration are
+  /// computed in parallel; the normal equations are summed over fixed-size
+  /// chunks of samples so that the result does not depend on the number of
+  /// threads. With params.levels > 1 the first levels use nested subsets of
+  /// the samples, so that most iterations are spent on few of them.
+  ///
+  /// @param[in] VX  #VX by 3 list of mesh X vertices
+  /// @param[in] FX  #FX by 3 list of mesh X triangle indices into rows of VX
+  /// @param[in] VY  #VY by 3 list of mesh Y vertices
+  /// @param[in] FY  #FY by 3 list of mesh Y triangle indices into rows of VY
+  /// @param[in] Ytree  precomputed AABB tree for accelerating closest point
+  ///   queries
+  /// @param[in] NY  #FY by 3 list of precomputed unit face normals
+  /// @param[in] params  objective, weights, sampling and termination
+  /// @param[out] R  3x3 rotation matrix so that (VX*R+t,FX) ~~ (VY,FY)
+  /// @param[out] t  1x3 translation row vector
+  /// @return total number of iterations
+  template <
+    typename DerivedVX,
+    typename DerivedFX,
+    typename DerivedVY,
+    typename DerivedFY,
+    typename DerivedNY,
+    typename DerivedR,
+    typename Derivedt
+    >
+  IGL_INLINE int iterative_closest_point(
+    const Eigen::MatrixBase<DerivedVX> & VX,
+    const Eigen::MatrixBase<DerivedFX> & FX,
+    const Eigen::MatrixBase<DerivedVY> & VY,
+    const Eigen::MatrixBase<DerivedFY> & FY,
+    const igl::AABB<DerivedVY,3> & Ytree,
+    const Eigen::MatrixBase<DerivedNY> & NY,
+    const ICPParams & params,
+    Eigen::PlainObjectBase<DerivedR> & R,
+    Eigen::PlainObjectBase<Derivedt> & t);
+  /// \overload
+  /// \brief Tree and normals of Y computed internally.
+  template <
+    typename DerivedVX,
+    typename DerivedFX,
+    typename DerivedVY,
+    typename DerivedFY,
+    typename DerivedR,
+    typename Derivedt
+    >
+  IGL_INLINE int iterative_closest_point(
+    const Eigen::MatrixBase<DerivedVX> & VX,
+    const Eigen::MatrixBase<DerivedFX> & FX,
+    const Eigen::MatrixBase<DerivedVY> & VY,
+    const Eigen::MatrixBase<DerivedFY> & FY,
+    const ICPParams & params,
+    Eigen::PlainObjectBase<DerivedR> & R,
+    Eigen::PlainObjectBase<Derivedt> & t);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -1,12 +1,196 @@
 #include "knn.h"
-#include "sort.h"
 #include "parallel_for.h"
 
+#include <cassert>
 #include <cmath>
-#include <queue>
-#include <set>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
 #include <algorithm>
 
+namespace
+{
+  // Reused across the queries handled by one thread
+  template <typename Scalar>
+  struct KnnScratch
+  {
+    typedef std::pair<Scalar,std::ptrdiff_t> Entry;
+    // Min-heap of cells left to visit
+    std::vector<Entry> cells;
+    // Max-heap of the best points found so far
+    std::vector<Entry> best;
+    // Neighbors found by this thread (knn_radius)
+    std::vector<std::ptrdiff_t> found;
+  };
+
+  // Best-first search of an octree on V for the (at most) k nearest
+  // neighbors of q within a squared radius, output in scratch.best sorted by
+  // distance (ties go to the smaller index). Cells are only visited while
+  // they could improve the current kth neighbor by more than a factor of
+  // one_plus_eps. The ith cell's points are cell_point(i,j) for
+  // j<cell_size(i), so both octree layouts share this search.
+  template <typename Scalar, typename DerivedV,
+  typename CellSize, typename CellPoint,
+  typename DerivedCH, typename DerivedCN, typename DerivedW>
+  void knn_search(
+    const Eigen::Matrix<Scalar,1,3> & q,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const size_t k,
+    const Scalar sqr_radius,
+    const Scalar sqr_one_plus_eps,
+    const CellSize & cell_size,
+    const CellPoint & cell_point,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    KnnScratch<Scalar> & scratch)
+  {
+    typedef typename KnnScratch<Scalar>::Entry Entry;
+    std::vector<Entry> & cells = scratch.cells;
+    std::vector<Entry> & best = scratch.best;
+    cells.clear();
+    best.clear();
+    if(k == 0)
+    {
+      return;
+    }
+    const std::greater<Entry> farther;
+
+    // Squared distance from q to (the closed box of) a cell
+    const auto sqr_distance_to_cell = [&](const std::ptrdiff_t cell)->Scalar
+    {
+      const Scalar half_width = Scalar(W(cell))/2;
+      Scalar sqr_d = 0;
+      for(int d = 0;d<3;d++)
+      {
+        const Scalar t = std::max<Scalar>(
+          std::abs(q(d)-Scalar(CN(cell,d)))-half_width,0.0);
+        sqr_d += t*t;
+      }
+      return sqr_d;
+    };
+    // Cells further than this cannot (sufficiently) improve the result
+    const auto bound = [&]()->Scalar
+    {
+      return best.size() == k ? best.front().first/sqr_one_plus_eps : sqr_radius;
+    };
+
+    if(cell_size(0) > 0)
+    {
+      const Scalar sqr_d = sqr_distance_to_cell(0);
+      if(sqr_d <= sqr_radius)
+      {
+        cells.emplace_back(sqr_d,0);
+      }
+    }
+    while(!cells.empty())
+    {
+      std::pop_heap(cells.begin(),cells.end(),farther);
+      const Entry cell = cells.back();
+      cells.pop_back();
+      if(cell.first > bound())
+      {
+        // All remaining cells are further
+        break;
+      }
+      const std::ptrdiff_t c = cell.second;
+      if(CH(c,0) == -1)
+      {
+        const std::ptrdiff_t num_points = cell_size(c);
+        for(std::ptrdiff_t j = 0;j<num_points;j++)
+        {
+          const std::ptrdiff_t v = cell_point(c,j);
+          const Entry e(
+            (V.row(v).template cast<Scalar>()-q).squaredNorm(),v);
+          if(e.first > sqr_radius)
+          {
+            continue;
+          }
+          if(best.size() < k)
+          {
+            best.push_back(e);
+            std::push_heap(best.begin(),best.end());
+          }else if(e < best.front())
+          {
+            std::pop_heap(best.begin(),best.end());
+            best.back() = e;
+            std::push_heap(best.begin(),best.end());
+          }
+        }
+      }else
+      {
+        const Scalar b = bound();
+        for(int j = 0;j<8;j++)
+        {
+          const std::ptrdiff_t child = CH(c,j);
+          if(cell_size(child) == 0)
+          {
+            continue;
+          }
+          const Scalar sqr_d = sqr_distance_to_cell(child);
+          if(sqr_d <= b)
+          {
+            cells.emplace_back(sqr_d,child);
+            std::push_heap(cells.begin(),cells.end(),farther);
+          }
+        }
+      }
+    }
+    std::sort_heap(best.begin(),best.end());
+  }
+
+  // k nearest neighbors in V (within radius, up to a factor of 1+epsilon)
+  // of each point in P, rows of I are padded with -1
+  template <typename DerivedP, typename DerivedV,
+  typename CellSize, typename CellPoint,
+  typename DerivedCH, typename DerivedCN, typename DerivedW,
+  typename DerivedI>
+  void knn_octree(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const size_t k,
+    const typename DerivedP::Scalar radius,
+    const typename DerivedP::Scalar epsilon,
+    const CellSize & cell_size,
+    const CellPoint & cell_point,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I)
+  {
+    using Scalar = typename DerivedP::Scalar;
+    const size_t Psize = P.rows();
+    const size_t Vsize = V.rows();
+    const size_t num_neighbors = std::min(k,Vsize);
+    I.setConstant(Psize,num_neighbors,-1);
+    if(Vsize == 0)
+    {
+      return;
+    }
+    const Scalar sqr_radius = radius*radius;
+    const Scalar sqr_one_plus_eps = (1+epsilon)*(1+epsilon);
+    std::vector<KnnScratch<Scalar> > scratch;
+    igl::parallel_for(
+      Psize,
+      [&](const size_t nt){ scratch.resize(nt); },
+      [&](const size_t i,const size_t t)
+      {
+        const Eigen::Matrix<Scalar,1,3> q = P.row(i);
+        knn_search(q,V,num_neighbors,sqr_radius,sqr_one_plus_eps,
+          cell_size,cell_point,CH,CN,W,scratch[t]);
+        const auto & best = scratch[t].best;
+        for(size_t j = 0;j<best.size();j++)
+        {
+          I(i,j) = best[j].second;
+        }
+      },
+      [](const size_t){},
+      1000);
+  }
+}
+
 namespace igl {
   template <typename DerivedP, typename IndexType,
   typename DerivedCH, typename DerivedCN, typename DerivedW,
@@ -33,100 +217,140 @@ namespace igl {
               const Eigen::MatrixBase<DerivedCN>& CN,
               const Eigen::MatrixBase<DerivedW>& W,
               Eigen::PlainObjectBase<DerivedI> & I) {
-    typedef typename DerivedCN::Scalar CentersType;
-    typedef typename DerivedW::Scalar WidthsType;
+    knn_octree(P,V,k,
+      std::numeric_limits<typename DerivedP::Scalar>::infinity(),0,
+      [&point_indices](const std::ptrdiff_t c)->std::ptrdiff_t
+        { return point_indices[c].size(); },
+      [&point_indices](const std::ptrdiff_t c,const std::ptrdiff_t j)->std::ptrdiff_t
+        { return point_indices[c][j]; },
+      CH,CN,W,I);
+  }
 
-    using Scalar = typename DerivedP::Scalar;
-    typedef Eigen::Matrix<Scalar, 1, 3> RowVector3PType;
+  template <typename DerivedP, typename DerivedV,
+  typename DerivedPI, typename DerivedCP,
+  typename DerivedCH, typename DerivedCN, typename DerivedW,
+  typename DerivedI>
+      IGL_INLINE void knn(
+              const Eigen::MatrixBase<DerivedP>& P,
+              const Eigen::MatrixBase<DerivedV>& V,
+              size_t k,
+              const Eigen::MatrixBase<DerivedPI>& PI,
+              const Eigen::MatrixBase<DerivedCP>& CP,
+              const Eigen::MatrixBase<DerivedCH>& CH,
+              const Eigen::MatrixBase<DerivedCN>& CN,
+              const Eigen::MatrixBase<DerivedW>& W,
+              Eigen::PlainObjectBase<DerivedI> & I) {
+    knn_octree(P,V,k,
+      std::numeric_limits<typename DerivedP::Scalar>::infinity(),0,
+      [&CP](const std::ptrdiff_t c)->std::ptrdiff_t
+        { return CP(c,1); },
+      [&PI,&CP](const std::ptrdiff_t c,const std::ptrdiff_t j)->std::ptrdiff_t
+        { return PI(CP(c,0)+j); },
+      CH,CN,W,I);
+  }
+
+  template <typename DerivedP,
+  typename DerivedPI, typename DerivedCP,
+  typename DerivedCH, typename DerivedCN, typename DerivedW,
+  typename DerivedI>
+  IGL_INLINE void knn(const Eigen::MatrixBase<DerivedP>& P,
+                      size_t k,
+                      const Eigen::MatrixBase<DerivedPI>& PI,
+                      const Eigen::MatrixBase<DerivedCP>& CP,
+                      const Eigen::MatrixBase<DerivedCH>& CH,
+                      const Eigen::MatrixBase<DerivedCN>& CN,
+                      const Eigen::MatrixBase<DerivedW>& W,
+                      Eigen::PlainObjectBase<DerivedI> & I) {
+      knn(P,P,k,PI,CP,CH,CN,W,I);
+  }
 
+  template <typename DerivedP, typename DerivedV,
+  typename DerivedPI, typename DerivedCP,
+  typename DerivedCH, typename DerivedCN, typename DerivedW,
+  typename DerivedI>
+      IGL_INLINE void knn(
+              const Eigen::MatrixBase<DerivedP>& P,
+              const Eigen::MatrixBase<DerivedV>& V,
+              size_t k,
+              const typename DerivedP::Scalar radius,
+              const typename DerivedP::Scalar epsilon,
+              const Eigen::MatrixBase<DerivedPI>& PI,
+              const Eigen::MatrixBase<DerivedCP>& CP,
+              const Eigen::MatrixBase<DerivedCH>& CH,
+              const Eigen::MatrixBase<DerivedCN>& CN,
+              const Eigen::MatrixBase<DerivedW>& W,
+              Eigen::PlainObjectBase<DerivedI> & I) {
+    assert(epsilon >= 0 && "epsilon should be non-negative");
+    knn_octree(P,V,k,radius,epsilon,
+      [&CP](const std::ptrdiff_t c)->std::ptrdiff_t
+        { return CP(c,1); },
+      [&PI,&CP](const std::ptrdiff_t c,const std::ptrdiff_t j)->std::ptrdiff_t
+        { return PI(CP(c,0)+j); },
+      CH,CN,W,I);
+  }
 
+  template <typename DerivedP, typename DerivedV,
+  typename DerivedPI, typename DerivedCP,
+  typename DerivedCH, typename DerivedCN, typename DerivedW,
+  typename DerivedN, typename DerivedNI>
+      IGL_INLINE void knn_radius(
+              const Eigen::MatrixBase<DerivedP>& P,
+              const Eigen::MatrixBase<DerivedV>& V,
+              const typename DerivedP::Scalar radius,
+              const Eigen::MatrixBase<DerivedPI>& PI,
+              const Eigen::MatrixBase<DerivedCP>& CP,
+              const Eigen::MatrixBase<DerivedCH>& CH,
+              const Eigen::MatrixBase<DerivedCN>& CN,
+              const Eigen::MatrixBase<DerivedW>& W,
+              Eigen::PlainObjectBase<DerivedN> & N,
+              Eigen::PlainObjectBase<DerivedNI> & NI) {
+    using Scalar = typename DerivedP::Scalar;
     const size_t Psize = P.rows();
-    const size_t Vsize = V.rows();
-    if(Vsize <= k) {
-        I.resize(Psize,Vsize);
-        for(size_t i = 0; i < Psize; ++i) {
-            Eigen::Matrix<Scalar,Eigen::Dynamic,1> D = (V.rowwise() - P.row(i)).rowwise().norm();
-            Eigen::Matrix<Scalar,Eigen::Dynamic,1> S;
-            Eigen::Vector<typename DerivedI::Scalar,Eigen::Dynamic> R;
-            igl::sort(D,1,true,S,R);
-            I.row(i) = R.transpose();
+    NI.setZero(Psize+1,1);
+    if(V.rows() == 0)
+    {
+      N.resize(0,1);
+      return;
+    }
+    // Each thread appends its queries' neighbors to its own list, then the
+    // lists are gathered in query order
+    std::vector<KnnScratch<Scalar> > scratch;
+    std::vector<size_t> thread(Psize), start(Psize);
+    igl::parallel_for(
+      Psize,
+      [&](const size_t nt){ scratch.resize(nt); },
+      [&](const size_t i,const size_t t)
+      {
+        const Eigen::Matrix<Scalar,1,3> q = P.row(i);
+        knn_search(q,V,std::numeric_limits<size_t>::max(),radius*radius,
+          Scalar(1),
+          [&CP](const std::ptrdiff_t c)->std::ptrdiff_t
+            { return CP(c,1); },
+          [&PI,&CP](const std::ptrdiff_t c,const std::ptrdiff_t j)->std::ptrdiff_t
+            { return PI(CP(c,0)+j); },
+          CH,CN,W,scratch[t]);
+        std::vector<std::ptrdiff_t> & found = scratch[t].found;
+        thread[i] = t;
+        start[i] = found.size();
+        NI(i+1) = scratch[t].best.size();
+        for(const auto & e : scratch[t].best)
+        {
+          found.push_back(e.second);
         }
-        return;
+      },
+      [](const size_t){},
+      1000);
+    for(size_t i = 0;i<Psize;i++)
+    {
+      NI(i+1) += NI(i);
     }
-
-    I.resize(Psize,k);
-
-
-    auto distance_to_width_one_cube = [](const RowVector3PType& point) -> Scalar {
-      return std::sqrt(std::pow<Scalar>(std::max<Scalar>(std::abs(point(0))-1,0.0),2)
-                       + std::pow<Scalar>(std::max<Scalar>(std::abs(point(1))-1,0.0),2)
-                       + std::pow<Scalar>(std::max<Scalar>(std::abs(point(2))-1,0.0),2));
-    };
-
-    auto distance_to_cube = [&distance_to_width_one_cube]
-              (const RowVector3PType& point,
-               Eigen::Matrix<CentersType,1,3> cube_center,
-               WidthsType cube_width) -> Scalar {
-      RowVector3PType transformed_point = (point-cube_center)/cube_width;
-      return cube_width*distance_to_width_one_cube(transformed_point);
-    };
-
-
-    igl::parallel_for(Psize,[&](size_t i)
+    N.resize(NI(Psize),1);
+    igl::parallel_for(Psize,[&](const size_t i)
     {
-      int points_found = 0;
-      RowVector3PType point_of_interest = P.row(i);
-
-      //To make my priority queue take both points and octree cells,
-      //I use the indices 0 to n-1 for the n points,
-      // and the indices n to n+m-1 for the m octree cells
-
-      // Using lambda to compare elements.
-      auto cmp = [&point_of_interest, &V, &CN, &W,
-                  Vsize, &distance_to_cube](int left, int right) {
-        Scalar leftdistance, rightdistance;
-        if(left < Vsize){ //left is a point index
-          leftdistance = (V.row(left) - point_of_interest).norm();
-        } else { //left is an octree cell
-          leftdistance = distance_to_cube(point_of_interest,
-                                            CN.row(left-Vsize),
-                                            W(left-Vsize));
-        }
-
-        if(right < Vsize){ //left is a point index
-          rightdistance = (V.row(right) - point_of_interest).norm();
-        } else { //left is an octree cell
-          rightdistance = distance_to_cube(point_of_interest,
-                                             CN.row(right-Vsize),
-                                             W(right-Vsize));
-        }
-        return leftdistance > rightdistance;
-      };
-
-      std::priority_queue<IndexType, std::vector<IndexType>,
-        decltype(cmp)> queue(cmp);
-
-      queue.push(Vsize); //This is the 0th octree cell (ie the root)
-      while(points_found < k){
-        IndexType curr_cell_or_point = queue.top();
-        queue.pop();
-        if(curr_cell_or_point < Vsize){ //current index is for is a point
-          I(i,points_found) = curr_cell_or_point;
-          points_found++;
-        } else {
-          IndexType curr_cell = curr_cell_or_point - Vsize;
-          if(CH(curr_cell,0) == -1){ //In the case of a leaf
-            if(point_indices.at(curr_cell).size() > 0){
-              //Assumption: Leaves either have one point, or none
-              queue.push(point_indices.at(curr_cell).at(0));
-            }
-          } else { //Not a leaf
-            for(int j = 0; j < 8; j++){
-              //+n to adjust for the octree cells
-              queue.push(CH(curr_cell,j)+Vsize);
-            }
-          }
-        }
+      const std::ptrdiff_t * found = scratch[thread[i]].found.data()+start[i];
+      for(std::ptrdiff_t j = NI(i);j<NI(i+1);j++)
+      {
+        N(j) = *found++;
       }
     },1000);
   }
@@ -140,6 +364,11 @@ namespace igl {
 
 template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, double, double, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::knn_radius<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #ifdef WIN32
 template void igl::knn<Eigen::Matrix<double,-1,-1,0,-1,-1>,int,Eigen::Matrix<int,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,1,0,-1,1>,Eigen::Matrix<int,-1,-1,0,-1,-1> >(Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,unsigned __int64,std::vector<std::vector<int,std::allocator<int> >,std::allocator<std::vector<int,std::allocator<int> > > > const &,Eigen::MatrixBase<Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,1,0,-1,1> > const &,Eigen::PlainObjectBase<Eigen::Matrix<int,-1,-1,0,-1,-1> > &);
 template void igl::knn<Eigen::Matrix<double,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,-1,0,-1,-1>,int,Eigen::Matrix<int,-1,8,0,-1,8>,Eigen::Matrix<double,-1,3,0,-1,3>,Eigen::Matrix<double,-1,1,0,-1,1>,Eigen::Matrix<int,-1,-1,0,-1,-1> >(Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,unsigned __int64,std::vector<std::vector<int,std::allocator<int> >,std::allocator<std::vector<int,std::allocator<int> > > > const &,Eigen::MatrixBase<Eigen::Matrix<int,-1,8,0,-1,8> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,3,0,-1,3> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,1,0,-1,1> > const &,Eigen::PlainObjectBase<Eigen::Matrix<int,-1,-1,0,-1,-1> > &);
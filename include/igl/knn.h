@@ -19,7 +19,8 @@ namespace igl
   /// Note that each point is its own neighbor.
   ///
   /// The octree data structures used in this function are intended to be the
-  /// same ones output from igl::octree
+  /// same ones output from igl::octree. Queries run in parallel, each thread
+  /// reusing its own search heaps across its queries.
   ///
   /// @param[in] P  #P by 3 list of point locations
   /// @param[in] k  number of neighbors to find
@@ -68,6 +69,129 @@ namespace igl
     const Eigen::MatrixBase<DerivedCN>& CN,
     const Eigen::MatrixBase<DerivedW>& W,
     Eigen::PlainObjectBase<DerivedI> & I);
+  /// \overload
+  /// \brief using the compact octree layout output from the
+  /// igl::octree overload with PI and CP (cells' points as contiguous ranges
+  /// of a single permutation)
+  ///
+  /// @param[in] PI  #V list of indices into V sorted so that the points of
+  ///   each octree cell are contiguous
+  /// @param[in] CP  #OctreeCells by 2, where the ith row is the offset into
+  ///   PI of the ith cell's first point and the ith cell's number of points
+  template <
+    typename DerivedP, 
+    typename DerivedV,
+    typename DerivedPI,
+    typename DerivedCP,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    size_t k,
+    const Eigen::MatrixBase<DerivedPI>& PI,
+    const Eigen::MatrixBase<DerivedCP>& CP,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I);
+  /// \overload
+  template <
+    typename DerivedP, 
+    typename DerivedPI,
+    typename DerivedCP,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    size_t k,
+    const Eigen::MatrixBase<DerivedPI>& PI,
+    const Eigen::MatrixBase<DerivedCP>& CP,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I);
+  /// \overload
+  /// \brief k nearest neighbors within a radius, optionally approximate
+  ///
+  /// The search visits octree cells closest first and stops as soon as no
+  /// remaining cell can be closer than the current kth neighbor divided by
+  /// (1+epsilon). For 1 ≤ i ≤ k the ith neighbor found is at most (1+epsilon)
+  /// times further from the query than the true ith nearest neighbor.
+  ///
+  /// @param[in] radius  only neighbors at distance ≤ radius are found (use
+  ///   infinity for plain knn)
+  /// @param[in] epsilon  allowed relative error in distances (0 for exact)
+  /// @param[out] I  #P by min(k,#V) list of neighbor indices into V sorted
+  ///   by distance, padded with -1 where fewer neighbors are within radius
+  template <
+    typename DerivedP, 
+    typename DerivedV,
+    typename DerivedPI,
+    typename DerivedCP,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    size_t k,
+    const typename DerivedP::Scalar radius,
+    const typename DerivedP::Scalar epsilon,
+    const Eigen::MatrixBase<DerivedPI>& PI,
+    const Eigen::MatrixBase<DerivedCP>& CP,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I);
+  /// Given a 3D set of points P, a radius, and an octree on points V, find
+  /// all points in V within the radius of each point in P.
+  ///
+  /// @param[in] P  #P by 3 list of query point locations
+  /// @param[in] V  #V by 3 list of point locations for which may be neighbors 
+  /// @param[in] radius  find neighbors at distance ≤ radius
+  /// @param[in] PI  #V list of indices into V sorted so that the points of
+  ///   each octree cell are contiguous
+  /// @param[in] CP  #OctreeCells by 2, where the ith row is the offset into
+  ///   PI of the ith cell's first point and the ith cell's number of points
+  /// @param[in] CH     #OctreeCells by 8, where the ith row is the indices of
+  ///                   the ith octree cell's children
+  /// @param[in] CN     #OctreeCells by 3, where the ith row is a 3d row vector
+  ///                   representing the position of the ith cell's center
+  /// @param[in] W      #OctreeCells, a vector where the ith entry is the width
+  ///          of the ith octree cell
+  /// @param[out] N  #N list of neighbor indices into V, so that N(NI(i)+j)
+  ///   is the jth closest neighbor of P(i) among N(NI(i):NI(i+1)-1)
+  /// @param[out] NI  #P+1 list cumulative sum of numbers of neighbors with a
+  ///   preceding zero
+  ///
+  /// \see octree, knn
+  template <
+    typename DerivedP, 
+    typename DerivedV,
+    typename DerivedPI,
+    typename DerivedCP,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedN,
+    typename DerivedNI>
+  IGL_INLINE void knn_radius(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const typename DerivedP::Scalar radius,
+    const Eigen::MatrixBase<DerivedPI>& PI,
+    const Eigen::MatrixBase<DerivedCP>& CP,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedN> & N,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "knn.cpp"
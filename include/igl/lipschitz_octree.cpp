@@ -7,10 +7,10 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "lipschitz_octree.h"
 #include "lipschitz_octree_prune.h"
-#include "find.h"
-#include "matlab_format.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <cassert>
-#include <iostream>
+#include <vector>
 
 template <
   bool batched,
@@ -23,11 +23,9 @@ IGL_INLINE void igl::lipschitz_octree(
   const typename Derivedorigin::Scalar h0,
   const int max_depth,
   const Func & udf,
+  const int max_batch_size,
   Eigen::PlainObjectBase<Derivedijk> & ijk_out)
 {
-  using Scalar = typename Derivedorigin::Scalar;
-  using RowVectorS3 = Eigen::Matrix<Scalar,1,3>;
-  using MatrixSX8R = Eigen::Matrix<Scalar,Eigen::Dynamic,8,Eigen::RowMajor>;
   using MatrixiX3R = Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor>;
 
   // static assert to ensure that Derivedorigin is a vector and the
@@ -43,55 +41,100 @@ IGL_INLINE void igl::lipschitz_octree(
   // dynamic assert that the origin is a 3D vector
   assert((origin.rows() == 3 || origin.cols() == 3) && origin.size() == 3 &&
     "origin must be a 3D vector");
+  assert(max_batch_size > 0 && "max_batch_size must be positive");
 
-  MatrixiX3R ijk(1,3);
-  ijk<<0,0,0;
-
+  // Cells at the previous depth that survived pruning
+  MatrixiX3R parents;
   for(int depth = 0;depth<=max_depth;depth++)
   {
-    if(ijk.rows() == 0)
-    {
-      // no more cells to refine
-      break;
-    }
-    const Scalar h = h0 / (1 << depth);
-    MatrixiX3R ijk_next;
     MatrixiX3R ijk_maybe;
-    igl::lipschitz_octree_prune<batched>(origin,h0,depth,udf,ijk,ijk_maybe);
-    if(depth == max_depth)
+    if(depth == 0)
     {
-      // sad copy
-      ijk_out = ijk_maybe.template cast<typename Derivedijk::Scalar>();
-      return;
+      MatrixiX3R ijk(1,3);
+      ijk<<0,0,0;
+      igl::lipschitz_octree_prune<batched>(origin,h0,depth,udf,ijk,ijk_maybe);
     }else
     {
-      const MatrixiX3R ijk_maybe_2 = ijk_maybe * 2;
-
-      ijk_next.resize(ijk_maybe_2.rows()*8,3);
-      for(int c = 0;c<ijk_maybe_2.rows();c++)
+      if(parents.rows() == 0)
       {
-        for(int i = 0;i<8;i++)
+        // no more cells to refine
+        break;
+      }
+      // Split the parents into their 8 children and prune them one batch
+      // at a time so that the (8 times larger) frontier is never stored in
+      // full and corner lists (and batched udf calls) stay bounded. Corners
+      // on the boundary between batches are evaluated twice.
+      const Eigen::Index parents_per_batch =
+        std::max<Eigen::Index>(1,max_batch_size/8);
+      std::vector<MatrixiX3R> maybes;
+      Eigen::Index num_maybe = 0;
+      for(Eigen::Index start = 0;start<parents.rows();start+=parents_per_batch)
+      {
+        const Eigen::Index num_parents =
+          std::min<Eigen::Index>(parents_per_batch,parents.rows()-start);
+        MatrixiX3R ijk(num_parents*8,3);
+        igl::parallel_for(num_parents,[&](const Eigen::Index c)
+        {
+          for(int i = 0;i<8;i++)
+          {
+            ijk.row(c*8+i) =
+              2*parents.row(start+c) +
+              // This order shouldn't really matter, though it seems nice if
+              // it matches above.
+              Eigen::RowVector3i((i&2) ? 1 : 0, (i&4) ? 1 : 0, (i&1) ? 1 : 0);
+          }
+        },1000);
+        maybes.emplace_back();
+        igl::lipschitz_octree_prune<batched>(
+          origin,h0,depth,udf,ijk,maybes.back());
+        num_maybe += maybes.back().rows();
+      }
+      if(maybes.size() == 1)
+      {
+        ijk_maybe = std::move(maybes.front());
+      }else
+      {
+        ijk_maybe.resize(num_maybe,3);
+        num_maybe = 0;
+        for(auto & maybe : maybes)
         {
-          const int k = i;
-          ijk_next.row(c*8+k) =
-            ijk_maybe_2.row(c) +
-            // This order shouldn't really matter, though it seems nice if it
-            // matches above.
-            Eigen::RowVector3i((i&2) ? 1 : 0, (i&4) ? 1 : 0, (i&1) ? 1 : 0);
+          ijk_maybe.middleRows(num_maybe,maybe.rows()) = maybe;
+          num_maybe += maybe.rows();
+          maybe.resize(0,3);
         }
       }
     }
     if(depth == max_depth)
     {
-      break;
+      // sad copy
+      ijk_out = ijk_maybe.template cast<typename Derivedijk::Scalar>();
+      return;
     }
-    ijk = ijk_next;
+    parents = std::move(ijk_maybe);
   }
-  assert(false && "Should never reach here");
+  ijk_out.resize(0,3);
+}
+
+template <
+  bool batched,
+  typename Derivedorigin,
+  typename Func,
+  typename Derivedijk
+    >
+IGL_INLINE void igl::lipschitz_octree(
+  const Eigen::MatrixBase<Derivedorigin> & origin,
+  const typename Derivedorigin::Scalar h0,
+  const int max_depth,
+  const Func & udf,
+  Eigen::PlainObjectBase<Derivedijk> & ijk_out)
+{
+  return lipschitz_octree<batched>(origin,h0,max_depth,udf,1<<20,ijk_out);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::lipschitz_octree<false,Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>>&);
 template void igl::lipschitz_octree<true, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>>&);
+template void igl::lipschitz_octree<false,Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>>&);
+template void igl::lipschitz_octree<true, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>>&);
 #endif
@@ -22,6 +22,8 @@ namespace igl
   ///   @param[in] h0   side length of root cell
   ///   @param[in] max_depth  maximum depth of octree (root is depth=0)
   ///   @param[in] udf  1-Lipschitz function of (unsigned) distance to level set
+  ///     (called in parallel on each corner, or, if batched, on a #P by 3
+  ///     matrix of corners returning a #P vector)
   ///   @param[out] ijk #ijk by 3 list of octree leaf cell minimum corner
   ///     subscripts
   template <
@@ -36,6 +38,27 @@ namespace igl
     const int max_depth,
     const Func & udf,
     Eigen::PlainObjectBase<Derivedijk> & ijk);
+  /// \overload
+  ///
+  ///   @param[in] max_batch_size  maximum number of cells pruned at once
+  ///     (rounded down to a multiple of 8, but at least 8). Children of the
+  ///     surviving cells are generated and pruned in batches of this size,
+  ///     so besides the surviving cells of two consecutive depths only one
+  ///     batch of cells, its corners and one batched udf call are held at a
+  ///     time. The default is 2²⁰.
+  template <
+    bool batched=false,
+    typename Derivedorigin,
+    typename Func,
+    typename Derivedijk
+      >
+  IGL_INLINE void lipschitz_octree(
+    const Eigen::MatrixBase<Derivedorigin> & origin,
+    const typename Derivedorigin::Scalar h0,
+    const int max_depth,
+    const Func & udf,
+    const int max_batch_size,
+    Eigen::PlainObjectBase<Derivedijk> & ijk);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -83,22 +83,29 @@ IGL_INLINE void igl::lipschitz_octree_prune(
       1000);
   }
 
-  ijk_maybe.resize(ijk.rows(),3);
+  // Keep cells with no corner far enough to prove the cell empty
+  Eigen::Array<bool,Eigen::Dynamic,1> maybe(ijk.rows());
+  igl::parallel_for(
+    ijk.rows(),
+    [&](const int c)
+    {
+      bool empty = false;
+      for(int i = 0;i<8;i++)
+      {
+        empty = empty || big(J(c,i));
+      }
+      maybe(c) = !empty;
+    },
+    1000);
+  ijk_maybe.resize(maybe.count(),3);
   int k = 0;
   for(int c = 0;c<ijk.rows();c++)
   {
-    bool empty = false;
-    for(int i = 0;i<8;i++)
-    {
-      empty = empty || big(J(c,i));
-    }
-    bool maybe = !empty;
-    if(maybe)
+    if(maybe(c))
     {
       ijk_maybe.row(k++) = ijk.row(c);
     }
   }
-  ijk_maybe.conservativeResize(k,3);
 }
 
 #ifdef IGL_STATIC_LIBRARY
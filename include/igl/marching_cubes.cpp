@@ -7,14 +7,262 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "marching_cubes.h"
 #include "march_cube.h"
+#include "parallel_for.h"
+#include "ThreadPool.h"
 
 // Adapted from public domain code at
 // http://paulbourke.net/geometry/polygonise/marchingsource.cpp
 
 #include <unordered_map>
 #include <iostream>
+#include <algorithm>
 #include <cstdint>
 #include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Result of marching a slab of cube layers [z0,z1) of a regular grid
+  template <typename Scalar>
+  struct marching_cubes_slab
+  {
+    // New vertices (3 coordinates each) on edges owned by this slab: x- and
+    // y-edges on planes (z0,z1] (and z0 for the first slab) and z-edges
+    // between
+    std::vector<Scalar> V;
+    // Triangle corners (3 each): ≥0 indexes V, ≤-2 is -(2+slot) of an edge
+    // on plane z0, owned by the slab below
+    std::vector<int> F;
+    // Sorted (slot,index into V) of edges on plane z1 with a vertex
+    std::vector<std::pair<int,int> > top;
+  };
+
+  // Slot of an edge within its plane: x-edges at x+(nx-1)*y, followed by
+  // y-edges at x+nx*y; z-edges (between planes) are at x+nx*y.
+  //
+  // Vertices (and triangles) are created in the same order as by the
+  // serial, hashing implementation (cubes in x-fastest order and edges of
+  // each cube in table order) so that the final mesh does not depend on
+  // how the grid is cut into slabs.
+  template <typename Scalar, typename SliceFunc>
+  void marching_cubes_march_slab(
+    const SliceFunc & slice,
+    const int nx,
+    const int ny,
+    const int z0,
+    const int z1,
+    const Scalar isovalue,
+    marching_cubes_slab<Scalar> & out)
+  {
+#include "marching_cubes_tables.h"
+    // Corner positions in the same order as a2fVertexOffset
+    const int corner[8][3] =
+      {{0,0,0},{1,0,0},{1,1,0},{0,1,0},{0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+    const int nxy = nx*ny;
+    const int nX = (nx-1)*ny;
+    const int nY = nx*(ny-1);
+    // For each cube edge: axis, plane (0 or 1) and in-plane offset of its
+    // first corner
+    int edge_axis[12], edge_dz[12], edge_offset[12];
+    for(int e = 0;e<12;e++)
+    {
+      const int * a = corner[a2eConnection[e][0]];
+      const int * b = corner[a2eConnection[e][1]];
+      edge_axis[e] = a[0]!=b[0] ? 0 : (a[1]!=b[1] ? 1 : 2);
+      const int dx = std::min(a[0],b[0]);
+      const int dy = std::min(a[1],b[1]);
+      edge_dz[e] = std::min(a[2],b[2]);
+      switch(edge_axis[e])
+      {
+        case 0: edge_offset[e] = dx+(nx-1)*dy; break;
+        case 1: edge_offset[e] = nX+dx+nx*dy; break;
+        default: edge_offset[e] = dx+nx*dy; break;
+      }
+    }
+
+    Eigen::Matrix<Scalar,Eigen::Dynamic,3> GV0,GV1;
+    Eigen::Matrix<Scalar,Eigen::Dynamic,1> S0,S1;
+    slice(z0,GV0,S0);
+    assert(GV0.rows() == nxy && S0.size() == nxy);
+    // Vertex indices of edges on the current bottom (E0) and top (E1)
+    // planes and z-edges in between, -1 if not yet created
+    std::vector<int> E0(nX+nY,-1),E1(nX+nY,-1),EZ(nxy,-1);
+    const bool owns_bottom = z0 == 0;
+
+    for(int z = z0;z<z1;z++)
+    {
+      slice(z+1,GV1,S1);
+      assert(GV1.rows() == nxy && S1.size() == nxy);
+      const bool foreign_bottom = z == z0 && !owns_bottom;
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,3> * GVp[2] = {&GV0,&GV1};
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,1> * Sp[2] = {&S0,&S1};
+      for(int y = 0;y<ny-1;y++)
+      {
+        for(int x = 0;x<nx-1;x++)
+        {
+          const int i = x+nx*y;
+          const int cI[8] = {i,i+1,i+1+nx,i+nx,i,i+1,i+1+nx,i+nx};
+          Scalar cS[8];
+          int c_flags = 0;
+          for(int c = 0;c<8;c++)
+          {
+            cS[c] = (*Sp[corner[c][2]])(cI[c]);
+            if(cS[c] > isovalue){ c_flags |= 1<<c; }
+          }
+          const int e_flags = aiCubeEdgeFlags[c_flags];
+          if(e_flags == 0) { continue; }
+          int edge_vertices[12];
+          for(int e = 0;e<12;e++)
+          {
+            if(!(e_flags & (1<<e))) { continue; }
+            int slot;
+            int * ev;
+            if(edge_axis[e] == 2)
+            {
+              slot = i + edge_offset[e];
+              ev = &EZ[slot];
+            }else
+            {
+              slot =
+                (edge_axis[e] == 0 ? x+(nx-1)*y : x+nx*y) + edge_offset[e];
+              if(edge_dz[e] == 0 && foreign_bottom)
+              {
+                edge_vertices[e] = -(2+slot);
+                continue;
+              }
+              ev = edge_dz[e] == 0 ? &E0[slot] : &E1[slot];
+            }
+            if(*ev < 0)
+            {
+              const int a = a2eConnection[e][0];
+              const int b = a2eConnection[e][1];
+              const Scalar t = (isovalue - cS[a])/(cS[b]-cS[a]);
+              const auto pa = GVp[corner[a][2]]->row(cI[a]);
+              const auto pb = GVp[corner[b][2]]->row(cI[b]);
+              *ev = static_cast<int>(out.V.size()/3);
+              for(int d = 0;d<3;d++)
+              {
+                out.V.push_back(pa(d) + t*(pb(d)-pa(d)));
+              }
+            }
+            edge_vertices[e] = *ev;
+          }
+          for(int f = 0;f<5;f++)
+          {
+            if(a2fConnectionTable[c_flags][3*f] < 0) break;
+            for(int c = 0;c<3;c++)
+            {
+              out.F.push_back(
+                edge_vertices[a2fConnectionTable[c_flags][3*f+c]]);
+            }
+          }
+        }
+      }
+      // Move up one plane
+      std::swap(GV0,GV1);
+      std::swap(S0,S1);
+      if(z+1 < z1)
+      {
+        std::swap(E0,E1);
+        std::fill(E1.begin(),E1.end(),-1);
+        std::fill(EZ.begin(),EZ.end(),-1);
+      }
+    }
+    // Plane z1 is now in E1
+    for(int slot = 0;slot<nX+nY;slot++)
+    {
+      if(E1[slot] >= 0)
+      {
+        out.top.emplace_back(slot,E1[slot]);
+      }
+    }
+  }
+
+  // Cut the grid into slabs of z-layers of cubes marched in parallel waves.
+  // Each wave is stitched and handed to emit in order before the next one
+  // starts, so only one wave of output is held at a time.
+  template <typename Scalar, typename SliceFunc, typename EmitFunc>
+  void marching_cubes_slabs(
+    const SliceFunc & slice,
+    const int nx,
+    const int ny,
+    const int nz,
+    const Scalar isovalue,
+    const EmitFunc & emit)
+  {
+    if(nx < 2 || ny < 2 || nz < 2)
+    {
+      return;
+    }
+    const int layers = nz-1;
+    const int threads =
+      std::max<int>(1,igl::default_thread_pool().num_threads());
+    // Thin enough for a few slabs per thread, thick enough that re-reading
+    // the planes shared by neighboring slabs is negligible
+    const int thickness =
+      std::max(1,std::min(32,(layers+4*threads-1)/(4*threads)));
+    const int num_slabs = (layers+thickness-1)/thickness;
+    const int wave = 4*threads;
+    // Top of the last slab of the previous wave
+    std::vector<std::pair<int,int> > prev_top;
+    int prev_offset = 0;
+    int offset = 0;
+    for(int w0 = 0;w0<num_slabs;w0+=wave)
+    {
+      const int w1 = std::min(num_slabs,w0+wave);
+      std::vector<marching_cubes_slab<Scalar> > slabs(w1-w0);
+      igl::parallel_for(w1-w0,[&](const int s)
+      {
+        const int z0 = (w0+s)*thickness;
+        const int z1 = std::min(layers,z0+thickness);
+        marching_cubes_march_slab(slice,nx,ny,z0,z1,isovalue,slabs[s]);
+      },2);
+      // Global index of each slab's first vertex
+      std::vector<int> offsets(w1-w0+1);
+      offsets[0] = offset;
+      for(int s = 0;s<w1-w0;s++)
+      {
+        offsets[s+1] = offsets[s] + static_cast<int>(slabs[s].V.size()/3);
+      }
+      // Stitch references to the plane below
+      igl::parallel_for(w1-w0,[&](const int s)
+      {
+        const std::vector<std::pair<int,int> > & below =
+          s == 0 ? prev_top : slabs[s-1].top;
+        const int below_offset = s == 0 ? prev_offset : offsets[s-1];
+        for(int & f : slabs[s].F)
+        {
+          if(f >= 0)
+          {
+            f += offsets[s];
+          }else
+          {
+            const int slot = -(f+2);
+            const auto it = std::lower_bound(
+              below.begin(),below.end(),std::make_pair(slot,-1));
+            assert(it != below.end() && it->first == slot);
+            f = below_offset + it->second;
+          }
+        }
+      },2);
+      for(int s = 0;s<w1-w0;s++)
+      {
+        const Eigen::Matrix<Scalar,Eigen::Dynamic,3> V =
+          Eigen::Map<const Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> >(
+            slabs[s].V.data(),slabs[s].V.size()/3,3);
+        const Eigen::Matrix<int,Eigen::Dynamic,3> F =
+          Eigen::Map<const Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> >(
+            slabs[s].F.data(),slabs[s].F.size()/3,3);
+        emit(V,F);
+      }
+      prev_top = std::move(slabs.back().top);
+      prev_offset = offsets[w1-w0-1];
+      offset = offsets[w1-w0];
+    }
+  }
+}
 
 template <typename DerivedS, typename DerivedGV, typename DerivedV, typename DerivedF>
 IGL_INLINE void igl::marching_cubes(
@@ -27,8 +275,56 @@ IGL_INLINE void igl::marching_cubes(
     Eigen::PlainObjectBase<DerivedV> &V,
     Eigen::PlainObjectBase<DerivedF> &F)
 {
-  std::unordered_map<std::int64_t,int> E2V;
-  return marching_cubes(S,GV,nx,ny,nz,isovalue,V,F,E2V);
+  typedef typename DerivedS::Scalar Scalar;
+  assert(S.size() == GV.rows() && "S and GV should match");
+  assert(S.size() == (Eigen::Index)nx*ny*nz && "S should be nx*ny*nz");
+  const int nxy = nx*ny;
+  const auto slice = [&](
+    const int z,
+    Eigen::Matrix<Scalar,Eigen::Dynamic,3> & GVz,
+    Eigen::Matrix<Scalar,Eigen::Dynamic,1> & Sz)
+  {
+    GVz = GV.middleRows(Eigen::Index(z)*nxy,nxy).template cast<Scalar>();
+    Sz = S.derived().segment(Eigen::Index(z)*nxy,nxy);
+  };
+  // Gather chunks, then copy into V,F once their sizes are known
+  std::vector<Eigen::Matrix<Scalar,Eigen::Dynamic,3> > Vs;
+  std::vector<Eigen::Matrix<int,Eigen::Dynamic,3> > Fs;
+  Eigen::Index n = 0, m = 0;
+  marching_cubes_slabs<Scalar>(slice,nx,ny,nz,isovalue,[&](
+    const Eigen::Matrix<Scalar,Eigen::Dynamic,3> & Vc,
+    const Eigen::Matrix<int,Eigen::Dynamic,3> & Fc)
+  {
+    Vs.push_back(Vc);
+    Fs.push_back(Fc);
+    n += Vc.rows();
+    m += Fc.rows();
+  });
+  V.resize(n,3);
+  F.resize(m,3);
+  n = 0;
+  m = 0;
+  for(size_t c = 0;c<Vs.size();c++)
+  {
+    V.middleRows(n,Vs[c].rows()) =
+      Vs[c].template cast<typename DerivedV::Scalar>();
+    F.middleRows(m,Fs[c].rows()) =
+      Fs[c].template cast<typename DerivedF::Scalar>();
+    n += Vs[c].rows();
+    m += Fs[c].rows();
+  }
+}
+
+template <typename Scalar, typename SliceFunc, typename EmitFunc>
+IGL_INLINE void igl::marching_cubes(
+  const SliceFunc & slice,
+  const unsigned nx,
+  const unsigned ny,
+  const unsigned nz,
+  const Scalar isovalue,
+  const EmitFunc & emit)
+{
+  marching_cubes_slabs<Scalar>(slice,nx,ny,nz,isovalue,emit);
 }
 
 template <
@@ -89,10 +385,8 @@ IGL_INLINE void igl::marching_cubes(
 
   // march over all cubes (loop order chosen to match memory)
   //
-  // Should be possible to parallelize safely if threads are "well separated".
-  // Like red-black Gauss Seidel. Probably each thread need's their own E2V,V,F,
-  // and then merge at the end. Annoying part are the edges lying on the
-  // interface between chunks.
+  // This stays serial to fill E2V. The overload without E2V marches slabs in
+  // parallel with dense per-plane edge tables instead.
   for(int z=0;z<nz-1;z++)
   {
     for(int y=0;y<ny-1;y++)
@@ -162,4 +456,6 @@ template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen:
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned int, unsigned int, unsigned int, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::marching_cubes<double, std::function<void(int, Eigen::Matrix<double, -1, 3, 0, -1, 3>&, Eigen::Matrix<double, -1, 1, 0, -1, 1>&)>, std::function<void(Eigen::Matrix<double, -1, 3, 0, -1, 3> const&, Eigen::Matrix<int, -1, 3, 0, -1, 3> const&)> >(std::function<void(int, Eigen::Matrix<double, -1, 3, 0, -1, 3>&, Eigen::Matrix<double, -1, 1, 0, -1, 1>&)> const&, unsigned int, unsigned int, unsigned int, double, std::function<void(Eigen::Matrix<double, -1, 3, 0, -1, 3> const&, Eigen::Matrix<int, -1, 3, 0, -1, 3> const&)> const&);
+template void igl::marching_cubes<float, std::function<void(int, Eigen::Matrix<float, -1, 3, 0, -1, 3>&, Eigen::Matrix<float, -1, 1, 0, -1, 1>&)>, std::function<void(Eigen::Matrix<float, -1, 3, 0, -1, 3> const&, Eigen::Matrix<int, -1, 3, 0, -1, 3> const&)> >(std::function<void(int, Eigen::Matrix<float, -1, 3, 0, -1, 3>&, Eigen::Matrix<float, -1, 1, 0, -1, 1>&)> const&, unsigned int, unsigned int, unsigned int, float, std::function<void(Eigen::Matrix<float, -1, 3, 0, -1, 3> const&, Eigen::Matrix<int, -1, 3, 0, -1, 3> const&)> const&);
 #endif
@@ -63,6 +63,36 @@ namespace igl
     std::unordered_map<std::int64_t,int> &E2V);
   /// \overload
   ///
+  /// \brief Streaming version that never holds the whole grid nor the whole
+  /// output mesh. The grid is cut into slabs of z-slices marched in parallel
+  /// and values are requested one z-slice at a time; the mesh is handed back
+  /// in chunks, in slab order, as soon as a batch of slabs is done.
+  ///
+  /// @param[in] slice  function `slice(z,GVz,Sz)` filling
+  ///   `Eigen::Matrix<Scalar,Eigen::Dynamic,3> & GVz` (nx*ny by 3 grid corner
+  ///   positions) and `Eigen::Matrix<Scalar,Eigen::Dynamic,1> & Sz` (nx*ny
+  ///   values) for corners (x,y,z) at x + y*nx. Called concurrently, out of
+  ///   order and up to twice per z.
+  /// @param[in] nx  resolutions of the grid in x dimension
+  /// @param[in] ny  resolutions of the grid in y dimension
+  /// @param[in] nz  resolutions of the grid in z dimension
+  /// @param[in] isovalue  the isovalue of the surface to reconstruct
+  /// @param[in] emit  function `emit(V,F)` called from the calling thread
+  ///   with `const Eigen::Matrix<Scalar,Eigen::Dynamic,3> & V` new vertices
+  ///   (appended to those of previous calls) and `const
+  ///   Eigen::Matrix<int,Eigen::Dynamic,3> & F` new triangles indexing into
+  ///   all vertices emitted so far. Concatenating all chunks gives exactly
+  ///   the output of the dense version.
+  template <typename Scalar, typename SliceFunc, typename EmitFunc>
+  IGL_INLINE void marching_cubes(
+    const SliceFunc & slice,
+    const unsigned nx,
+    const unsigned ny,
+    const unsigned nz,
+    const Scalar isovalue,
+    const EmitFunc & emit);
+  /// \overload
+  ///
   /// \brief Sparse voxel version
   ///
   /// @param[in] S #S list of scalar field values
@@ -7,14 +7,12 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "marching_tets.h"
+#include "parallel_for.h"
 
-#include <unordered_map>
 #include <vector>
 #include <utility>
 #include <cstdint>
-#include <iostream>
 #include <algorithm>
-#include <utility>
 #include <cmath>
 #include <cassert>
 
@@ -35,19 +33,6 @@ void igl::marching_tets(
     Eigen::PlainObjectBase<DerivedJ>& J,
     Eigen::SparseMatrix<BCType>& BC)
 {
-
-  // We're hashing edges to deduplicate using 64 bit ints. The upper and lower
-  // 32 bits of a key are the indices of vertices in the mesh. The implication is
-  // that you can only have 2^32 vertices which I have deemed sufficient for
-  // anything reasonable.
-  const auto make_edge_key = [](const std::pair<int32_t, int32_t>& p) -> std::int64_t
-  {
-    std::int64_t ret = 0;
-    ret |= p.first;
-    ret |= static_cast<std::int64_t>(p.second) << 32;
-    return ret;
-  };
-
   const int mt_cell_lookup[16][4] =
   {
     { -1, -1, -1, -1 },
@@ -78,117 +63,197 @@ void igl::marching_tets(
     {2, 3},
   };
 
-  // Store the faces and the tet they are in
-  std::vector<std::pair<Eigen::RowVector3i, int>> faces;
-
-  // Store the edges in the tet mesh which we add vertices on
-  // so we can deduplicate
-  std::vector<std::pair<int, int>> edge_table;
-
+  // Corners (into mt_cell_lookup[key]) of the one or two faces of a tet
+  const int mt_face_lookup[2][3] = { {0, 1, 3}, {1, 2, 3} };
+  // Crossing edges of a tet in the order its faces first use them
+  const int mt_first_use[2][4] = { {0, 1, 2, -1}, {0, 1, 3, 2} };
 
   assert(TT.cols() == 4 && TT.rows() >= 1);
   assert(TV.cols() == 3 && TV.rows() >= 4);
   assert(isovals.cols() == 1);
+  const Eigen::Index m = TT.rows();
 
-  // For each tet
-  for (int i = 0; i < TT.rows(); i++)
+  // Case of each tet and the number of crossing edges and faces of each
+  // block of tets
+  const Eigen::Index block_size = 1024;
+  const Eigen::Index num_blocks = (m+block_size-1)/block_size;
+  const auto num_crossing = [&mt_cell_lookup](const std::uint8_t key)->int
+  {
+    return (mt_cell_lookup[key][0] == -1) ? 0 :
+      ((mt_cell_lookup[key][3] == -1) ? 3 : 4);
+  };
+  std::vector<std::uint8_t> keys(m);
+  std::vector<Eigen::Index> slot_offset(num_blocks+1,0);
+  std::vector<Eigen::Index> face_offset(num_blocks+1,0);
+  igl::parallel_for(num_blocks,[&](const Eigen::Index block)
   {
-    uint8_t key = 0;
-    for (int v = 0; v < 4; v++)
+    Eigen::Index num_slots = 0;
+    Eigen::Index num_faces = 0;
+    const Eigen::Index end = std::min(m,(block+1)*block_size);
+    for(Eigen::Index i = block*block_size;i<end;i++)
     {
-      const int vid = TT(i, v);
-      const uint8_t flag = isovals(vid, 0) > isovalue;
-      key |= flag << v;
+      std::uint8_t key = 0;
+      for (int v = 0; v < 4; v++)
+      {
+        const std::uint8_t flag = isovals(TT(i, v), 0) > isovalue;
+        key |= flag << v;
+      }
+      keys[i] = key;
+      const int num_edges = num_crossing(key);
+      num_slots += num_edges;
+      num_faces += num_edges == 0 ? 0 : num_edges-2;
     }
+    slot_offset[block+1] = num_slots;
+    face_offset[block+1] = num_faces;
+  },1);
+  for(Eigen::Index block = 0;block<num_blocks;block++)
+  {
+    slot_offset[block+1] += slot_offset[block];
+    face_offset[block+1] += face_offset[block];
+  }
+  const Eigen::Index num_slots = slot_offset[num_blocks];
+  const Eigen::Index num_faces = face_offset[num_blocks];
+  // Calls func(i,num_edges,slot,face) for each tet i with a crossing and its
+  // first slot and face, one block of tets per task
+  const auto for_each_crossing_tet = [&](const auto & func)
+  {
+    igl::parallel_for(num_blocks,[&](const Eigen::Index block)
+    {
+      Eigen::Index slot = slot_offset[block];
+      Eigen::Index face = face_offset[block];
+      const Eigen::Index end = std::min(m,(block+1)*block_size);
+      for(Eigen::Index i = block*block_size;i<end;i++)
+      {
+        const int num_edges = num_crossing(keys[i]);
+        if(num_edges == 0) { continue; }
+        func(i,num_edges,slot,face);
+        slot += num_edges;
+        face += num_edges-2;
+      }
+    },1);
+  };
 
-    // This will contain the index in TV of each vertex in the tet
-    int v_ids[4] = {-1, -1, -1, -1};
-
-    // Insert any vertices if the tet intersects the level surface
-    for (int e = 0; e < 4 && mt_cell_lookup[key][e] != -1; e++)
+  // Each crossing edge of each tet gets a slot, ordered as the serial
+  // algorithm would first reference it
+  std::vector<std::pair<int,int>> slot_edge(num_slots);
+  for_each_crossing_tet([&](
+    const Eigen::Index i, const int num_edges, const Eigen::Index slot, const Eigen::Index)
+  {
+    const int key = keys[i];
+    for(int r = 0;r<num_edges;r++)
     {
-      const int tv1_idx = TT(i, mt_edge_lookup[mt_cell_lookup[key][e]][0]);
-      const int tv2_idx = TT(i, mt_edge_lookup[mt_cell_lookup[key][e]][1]);
-      const int vertex_id = edge_table.size();
-      edge_table.push_back(std::make_pair(std::min(tv1_idx, tv2_idx), std::max(tv1_idx, tv2_idx)));
-      v_ids[e] = vertex_id;
+      const int e = mt_cell_lookup[key][mt_first_use[num_edges-3][r]];
+      const int tv1_idx = TT(i, mt_edge_lookup[e][0]);
+      const int tv2_idx = TT(i, mt_edge_lookup[e][1]);
+      slot_edge[slot+r] =
+        std::make_pair(std::min(tv1_idx, tv2_idx), std::max(tv1_idx, tv2_idx));
     }
+  });
 
-    // Insert the corresponding faces
-    if (v_ids[0] != -1)
+  // Deduplicate slots sharing an edge without hashing: bucket slots by the
+  // edge's smaller vertex, then sort each (small) bucket
+  const Eigen::Index n = TV.rows();
+  std::vector<Eigen::Index> bucket_offset;
+  std::vector<Eigen::Index> bucket;
+  {
+    // Counting sort (a single pass over the slots, which is cheap next to
+    // the pass over all tets)
+    std::vector<Eigen::Index> cursor(n+1,0);
+    for(Eigen::Index s = 0;s<num_slots;s++) { cursor[slot_edge[s].first+1]++; }
+    for(Eigen::Index v = 0;v<n;v++) { cursor[v+1] += cursor[v]; }
+    bucket_offset = cursor;
+    bucket.resize(num_slots);
+    for(Eigen::Index s = 0;s<num_slots;s++)
     {
-      bool is_quad = mt_cell_lookup[key][3] != -1;
-      if (is_quad)
-      {
-        const Eigen::RowVector3i f1(v_ids[0], v_ids[1], v_ids[3]);
-        const Eigen::RowVector3i f2(v_ids[1], v_ids[2], v_ids[3]);
-        faces.push_back(std::make_pair(f1, i));
-        faces.push_back(std::make_pair(f2, i));
-      }
-      else
-      {
-        const Eigen::RowVector3i f(v_ids[0], v_ids[1], v_ids[2]);
-        faces.push_back(std::make_pair(f, i));
-      }
-
+      bucket[cursor[slot_edge[s].first]++] = s;
     }
   }
-
+  // First slot referencing the same edge as each slot
+  std::vector<Eigen::Index> first_slot(num_slots);
+  igl::parallel_for(n,[&](const Eigen::Index v)
+  {
+    const auto begin = bucket.begin()+bucket_offset[v];
+    const auto end = bucket.begin()+bucket_offset[v+1];
+    std::sort(begin,end,[&](const Eigen::Index a, const Eigen::Index b)
+    {
+      return std::make_pair(slot_edge[a].second,a) <
+        std::make_pair(slot_edge[b].second,b);
+    });
+    for(auto it = begin;it != end;it++)
+    {
+      first_slot[*it] = (it != begin && 
+        slot_edge[*(it-1)].second == slot_edge[*it].second) ?
+        first_slot[*(it-1)] : *it;
+    }
+  },1000);
+  // Output vertices numbered in order of their first slot
+  std::vector<int> slot_vertex(num_slots);
   int num_unique = 0;
-  outV.resize(edge_table.size(), 3);
-  outF.resize(faces.size(), 3);
-  J.resize(faces.size());
+  for(Eigen::Index s = 0;s<num_slots;s++)
+  {
+    if(first_slot[s] == s) { slot_vertex[s] = num_unique++; }
+  }
 
+  outV.resize(num_unique, 3);
+  outF.resize(num_faces, 3);
+  J.resize(num_faces);
   // Sparse matrix triplets for BC
-  std::vector<Eigen::Triplet<BCType>> bc_triplets;
-  bc_triplets.reserve(edge_table.size());
-
-  // Deduplicate vertices
-  std::unordered_map<std::int64_t, int> emap;
-  emap.max_load_factor(0.5);
-  emap.reserve(edge_table.size());
-
-  for (int f = 0; f < faces.size(); f++)
+  std::vector<Eigen::Triplet<BCType>> bc_triplets(2*num_unique);
+  igl::parallel_for(num_slots,[&](const Eigen::Index s)
   {
-    const int ti = faces[f].second;
-    assert(ti>=0);
-    assert(ti<TT.rows());
-    J(f) = ti;
-    for (int v = 0; v < 3; v++)
+    if(first_slot[s] != s)
     {
-      const int vi = faces[f].first[v];
-      const std::pair<int32_t, int32_t> edge = edge_table[vi];
-      const std::int64_t key = make_edge_key(edge);
-      auto it = emap.find(key);
-      if (it == emap.end()) // New unique vertex, insert it
-      {
-        // Typedef to make sure we handle floats properly
-        typedef Eigen::Matrix<typename DerivedTV::Scalar, 1, 3, Eigen::RowMajor, 1, 3> RowVector;
-        using Scalar = typename DerivedS::Scalar;
-        const RowVector v1 =  TV.row(edge.first).template cast<Scalar>();
-        const RowVector v2 = TV.row(edge.second).template cast<Scalar>();
-        const Scalar a = abs(isovals(edge.first, 0) - isovalue);
-        const Scalar b = abs(isovals(edge.second, 0) - isovalue);
-        const Scalar w = a / (a+b);
+      slot_vertex[s] = slot_vertex[first_slot[s]];
+      return;
+    }
+    const int vi = slot_vertex[s];
+    const std::pair<int, int> edge = slot_edge[s];
+    // Typedef to make sure we handle floats properly
+    typedef Eigen::Matrix<typename DerivedTV::Scalar, 1, 3, Eigen::RowMajor, 1, 3> RowVector;
+    using Scalar = typename DerivedS::Scalar;
+    const RowVector v1 =  TV.row(edge.first).template cast<Scalar>();
+    const RowVector v2 = TV.row(edge.second).template cast<Scalar>();
+    const Scalar a = std::abs(isovals(edge.first, 0) - isovalue);
+    const Scalar b = std::abs(isovals(edge.second, 0) - isovalue);
+    const Scalar w = a / (a+b);
 
-        // Create a casted copy in case BCType is a float and we need to downcast
-        const BCType bc_w = static_cast<BCType>(w);
-        bc_triplets.push_back(Eigen::Triplet<BCType>(num_unique, edge.first, 1-bc_w));
-        bc_triplets.push_back(Eigen::Triplet<BCType>(num_unique, edge.second, bc_w));
+    // Create a casted copy in case BCType is a float and we need to downcast
+    const BCType bc_w = static_cast<BCType>(w);
+    bc_triplets[2*vi+0] = Eigen::Triplet<BCType>(vi, edge.first, 1-bc_w);
+    bc_triplets[2*vi+1] = Eigen::Triplet<BCType>(vi, edge.second, bc_w);
 
-        // Create a casted copy in case DerivedTV::Scalar is a float and we need to downcast
-        const typename DerivedTV::Scalar v_w = static_cast<typename DerivedTV::Scalar>(w);
-        outV.row(num_unique) = (1-v_w)*v1 + v_w*v2;
-        outF(f, v) = num_unique;
+    // Create a casted copy in case DerivedTV::Scalar is a float and we need to downcast
+    const typename DerivedTV::Scalar v_w = static_cast<typename DerivedTV::Scalar>(w);
+    outV.row(vi) = (1-v_w)*v1 + v_w*v2;
+  },1000);
 
-        emap.emplace(key, num_unique);
-        num_unique += 1;
-      } else {
-        outF(f, v) = it->second;
+  // Insert the corresponding faces
+  for_each_crossing_tet([&](
+    const Eigen::Index i, const int num_edges, const Eigen::Index slot, const Eigen::Index face)
+  {
+    // Vertex of each crossing edge in mt_cell_lookup order
+    int v_ids[4] = {-1, -1, -1, -1};
+    for(int r = 0;r<num_edges;r++)
+    {
+      v_ids[mt_first_use[num_edges-3][r]] = slot_vertex[slot+r];
+    }
+    if (num_edges == 4)
+    {
+      for(int f = 0;f<2;f++)
+      {
+        for(int c = 0;c<3;c++)
+        {
+          outF(face+f, c) = v_ids[mt_face_lookup[f][c]];
+        }
+        J(face+f) = i;
       }
     }
-  }
-  outV.conservativeResize(num_unique, 3);
+    else
+    {
+      outF.row(face) << v_ids[0], v_ids[1], v_ids[2];
+      J(face) = i;
+    }
+  });
   BC.resize(num_unique, TV.rows());
   BC.setFromTriplets(bc_triplets.begin(), bc_triplets.end());
 }
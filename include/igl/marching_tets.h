@@ -19,6 +19,11 @@ namespace igl {
   /// triangle mesh approximating the isosurface coresponding to the value
   /// isovalue.
   ///
+  /// Tets are processed in parallel blocks. Crossing edges are deduplicated
+  /// by bucketing on their smaller vertex index (no hashing), and the output
+  /// is the same for any number of threads: faces in tet order and vertices
+  /// in order of first use.
+  ///
   /// @param[in] TV  #tet_vertices x 3 array -- The vertices of the tetrahedral mesh
   /// @param[in] TT  #tets x 4 array --  The indexes of each tet in the tetrahedral mesh
   /// @param[in] S  #tet_vertices x 1 array -- The values defined on each tet vertex
@@ -0,0 +1,145 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "mesh_mesh_squared_distance.h"
+#include "AABB.h"
+#include "dual_tree_traversal.h"
+#include "triangle_triangle_squared_distance.h"
+#include <Eigen/Geometry>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Derivedca,
+  typename Derivedcb>
+IGL_INLINE typename DerivedVA::Scalar igl::mesh_mesh_squared_distance(
+  const AABB<DerivedVA,3> & treeA,
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const AABB<DerivedVB,3> & treeB,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  int & fa,
+  int & fb,
+  Eigen::PlainObjectBase<Derivedca> & ca,
+  Eigen::PlainObjectBase<Derivedcb> & cb)
+{
+  typedef typename DerivedVA::Scalar Scalar;
+  typedef typename DerivedVB::Scalar ScalarB;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  assert(FA.cols() == 3 && "FA should contain triangles");
+  assert(FB.cols() == 3 && "FB should contain triangles");
+  struct Closest
+  {
+    Scalar sqr_d = std::numeric_limits<Scalar>::infinity();
+    int fa = -1;
+    int fb = -1;
+    RowVector3S ca = RowVector3S::Zero();
+    RowVector3S cb = RowVector3S::Zero();
+  };
+  std::vector<Closest> closest;
+  // Smallest squared distance found so far by any thread
+  std::atomic<Scalar> bound(std::numeric_limits<Scalar>::infinity());
+  igl::dual_tree_traversal(
+    treeA,treeB,
+    [&](const size_t n){ closest.resize(n); },
+    [&](
+      const Eigen::AlignedBox<Scalar,3> & a,
+      const Eigen::AlignedBox<ScalarB,3> & b)->bool
+    {
+      Scalar sqr_d = 0;
+      for(int d = 0;d<3;d++)
+      {
+        const Scalar gap = std::max(
+          a.min()(d)-Scalar(b.max()(d)),Scalar(b.min()(d))-a.max()(d));
+        if(gap > 0)
+        {
+          sqr_d += gap*gap;
+        }
+      }
+      // Ties are kept so that the closest pair does not depend on the order
+      // of traversal
+      return sqr_d <= bound.load(std::memory_order_relaxed);
+    },
+    [&](const int a,const int b,const size_t t)
+    {
+      RowVector3S T[6];
+      for(int c = 0;c<3;c++)
+      {
+        T[c] = VA.row(FA(a,c)).template cast<Scalar>();
+        T[3+c] = VB.row(FB(b,c)).template cast<Scalar>();
+      }
+      RowVector3S c1,c2;
+      const Scalar sqr_d = igl::triangle_triangle_squared_distance(
+        T[0],T[1],T[2],T[3],T[4],T[5],c1,c2);
+      Closest & c = closest[t];
+      if(std::make_tuple(sqr_d,a,b) < std::make_tuple(c.sqr_d,c.fa,c.fb))
+      {
+        c.sqr_d = sqr_d;
+        c.fa = a;
+        c.fb = b;
+        c.ca = c1;
+        c.cb = c2;
+      }
+      Scalar prev = bound.load(std::memory_order_relaxed);
+      while(sqr_d < prev && !bound.compare_exchange_weak(prev,sqr_d)) {}
+    });
+  Closest best;
+  for(const Closest & c : closest)
+  {
+    if(std::make_tuple(c.sqr_d,c.fa,c.fb) <
+        std::make_tuple(best.sqr_d,best.fa,best.fb))
+    {
+      best = c;
+    }
+  }
+  fa = best.fa;
+  fb = best.fb;
+  if(fa >= 0)
+  {
+    ca = best.ca.template cast<typename Derivedca::Scalar>();
+    cb = best.cb.template cast<typename Derivedcb::Scalar>();
+  }
+  return best.sqr_d;
+}
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Derivedca,
+  typename Derivedcb>
+IGL_INLINE typename DerivedVA::Scalar igl::mesh_mesh_squared_distance(
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  int & fa,
+  int & fb,
+  Eigen::PlainObjectBase<Derivedca> & ca,
+  Eigen::PlainObjectBase<Derivedcb> & cb)
+{
+  igl::AABB<DerivedVA,3> treeA;
+  treeA.init(VA,FA);
+  igl::AABB<DerivedVB,3> treeB;
+  treeB.init(VB,FB);
+  return mesh_mesh_squared_distance(treeA,VA,FA,treeB,VB,FB,fa,fb,ca,cb);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template double igl::mesh_mesh_squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+template double igl::mesh_mesh_squared_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+#endif
@@ -0,0 +1,77 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MESH_MESH_SQUARED_DISTANCE_H
+#define IGL_MESH_MESH_SQUARED_DISTANCE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  template <typename DerivedV, int DIM> class AABB;
+  /// Compute the minimum separation (squared distance) between two triangle
+  /// meshes in 3D and a pair of closest points. Both AABB hierarchies are
+  /// traversed simultaneously (see dual_tree_traversal) and pairs of nodes
+  /// whose boxes are further apart than the closest pair found so far (by
+  /// any thread) are pruned.
+  ///
+  /// @param[in] treeA  AABB hierarchy of (VA,FA)
+  /// @param[in] VA  #VA by 3 list of vertex positions of first mesh
+  /// @param[in] FA  #FA by 3 list of triangle indices into VA
+  /// @param[in] treeB  AABB hierarchy of (VB,FB)
+  /// @param[in] VB  #VB by 3 list of vertex positions of second mesh
+  /// @param[in] FB  #FB by 3 list of triangle indices into VB
+  /// @param[out] fa  index into FA of closest triangle (-1 if either mesh is
+  ///   empty)
+  /// @param[out] fb  index into FB of closest triangle
+  /// @param[out] ca  3-long closest point on FA(fa,:)
+  /// @param[out] cb  3-long closest point on FB(fb,:)
+  /// @return squared distance between ca and cb (0 if the meshes intersect,
+  ///   infinity if either is empty)
+  ///
+  /// \see triangle_triangle_squared_distance, point_mesh_squared_distance,
+  ///   hausdorff
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Derivedca,
+    typename Derivedcb>
+  IGL_INLINE typename DerivedVA::Scalar mesh_mesh_squared_distance(
+    const AABB<DerivedVA,3> & treeA,
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const AABB<DerivedVB,3> & treeB,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    int & fa,
+    int & fb,
+    Eigen::PlainObjectBase<Derivedca> & ca,
+    Eigen::PlainObjectBase<Derivedcb> & cb);
+  /// \overload
+  /// \brief Trees built internally.
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Derivedca,
+    typename Derivedcb>
+  IGL_INLINE typename DerivedVA::Scalar mesh_mesh_squared_distance(
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    int & fa,
+    int & fb,
+    Eigen::PlainObjectBase<Derivedca> & ca,
+    Eigen::PlainObjectBase<Derivedcb> & cb);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "mesh_mesh_squared_distance.cpp"
+#endif
+#endif
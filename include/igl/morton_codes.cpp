@@ -0,0 +1,203 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "morton_codes.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  // Spread the lower 21 bits of x so that there are two zero bits between
+  // each
+  std::uint64_t morton_codes_split3(std::uint64_t x)
+  {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffull;
+    x = (x | x << 16) & 0x1f0000ff0000ffull;
+    x = (x | x << 8) & 0x100f00f00f00f00full;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+    x = (x | x << 2) & 0x1249249249249249ull;
+    return x;
+  }
+  // Spread the lower 32 bits of x so that there is a zero bit between each
+  std::uint64_t morton_codes_split2(std::uint64_t x)
+  {
+    x &= 0xffffffffull;
+    x = (x | x << 16) & 0x0000ffff0000ffffull;
+    x = (x | x << 8) & 0x00ff00ff00ff00ffull;
+    x = (x | x << 4) & 0x0f0f0f0f0f0f0f0full;
+    x = (x | x << 2) & 0x3333333333333333ull;
+    x = (x | x << 1) & 0x5555555555555555ull;
+    return x;
+  }
+  std::uint64_t morton_codes_interleave(const std::uint64_t q[3],const int dim)
+  {
+    switch(dim)
+    {
+      case 3:
+        return morton_codes_split3(q[0]) |
+          morton_codes_split3(q[1])<<1 |
+          morton_codes_split3(q[2])<<2;
+      case 2:
+        return morton_codes_split2(q[0]) | morton_codes_split2(q[1])<<1;
+      default:
+        return q[0];
+    }
+  }
+}
+
+template <typename DerivedP, typename DerivedC>
+IGL_INLINE void igl::morton_codes(
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedC> & C)
+{
+  using Scalar = typename DerivedP::Scalar;
+  const int dim = P.cols();
+  assert(dim >= 1 && dim <= 3 && "P should be 1D, 2D or 3D");
+  C.resize(P.rows(),1);
+  if(P.rows() == 0) { return; }
+  const Eigen::Matrix<Scalar,1,Eigen::Dynamic> min_P = P.colwise().minCoeff();
+  const Eigen::Matrix<Scalar,1,Eigen::Dynamic> max_P = P.colwise().maxCoeff();
+  const int bits = dim == 3 ? 21 : (dim == 2 ? 32 : 63);
+  const double max_q = double((std::uint64_t(1)<<bits)-1);
+  Eigen::Matrix<double,1,Eigen::Dynamic> scale(dim);
+  for(int d = 0;d<dim;d++)
+  {
+    const double extent = double(max_P(d)-min_P(d));
+    scale(d) = extent > 0 ? max_q/extent : 0;
+  }
+  igl::parallel_for(P.rows(),[&](const int i)
+  {
+    std::uint64_t q[3] = {0,0,0};
+    for(int d = 0;d<dim;d++)
+    {
+      const double x = double(P(i,d)-min_P(d))*scale(d);
+      q[d] = std::uint64_t(std::min(std::max(x,0.0),max_q));
+    }
+    C(i) = static_cast<typename DerivedC::Scalar>(
+      morton_codes_interleave(q,dim));
+  },10000);
+}
+
+template <typename DerivedP, typename Derivedorigin, typename DerivedC>
+IGL_INLINE void igl::morton_codes(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const Eigen::MatrixBase<Derivedorigin> & origin,
+  const typename DerivedP::Scalar h,
+  Eigen::PlainObjectBase<DerivedC> & C)
+{
+  const int dim = P.cols();
+  assert(dim >= 1 && dim <= 3 && "P should be 1D, 2D or 3D");
+  assert(origin.size() == dim && "origin should match P");
+  C.resize(P.rows(),1);
+  const int bits = dim == 3 ? 21 : (dim == 2 ? 32 : 63);
+  // Scale so that cells of the cube at every level have dyadic boundaries
+  const double max_q = double((std::uint64_t(1)<<bits)-1);
+  const double scale = h > 0 ? double(std::uint64_t(1)<<bits)/double(h) : 0;
+  igl::parallel_for(P.rows(),[&](const int i)
+  {
+    std::uint64_t q[3] = {0,0,0};
+    for(int d = 0;d<dim;d++)
+    {
+      const double x = std::floor(double(P(i,d)-origin(d))*scale);
+      q[d] = std::uint64_t(std::min(std::max(x,0.0),max_q));
+    }
+    C(i) = static_cast<typename DerivedC::Scalar>(
+      morton_codes_interleave(q,dim));
+  },10000);
+}
+
+template <typename DerivedP, typename DerivedI>
+IGL_INLINE void igl::morton_order(
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedI> & I)
+{
+  Eigen::Matrix<std::uint64_t,Eigen::Dynamic,1> C;
+  igl::morton_codes(P,C);
+  igl::sort_morton_codes(C,I);
+}
+
+template <typename DerivedC, typename DerivedI>
+IGL_INLINE void igl::sort_morton_codes(
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedI> & I)
+{
+  using Index = typename DerivedI::Scalar;
+  const size_t n = C.size();
+  // Stable LSD radix sort of (code,index) pairs, 11 bits at a time. Each pass
+  // histograms fixed blocks in parallel, prefix sums the counts serially
+  // (digit-major, block-minor) and then scatters each block in parallel so
+  // the result does not depend on the number of threads.
+  std::vector<std::uint64_t> key(C.data(),C.data()+n), key_tmp(n);
+  std::vector<Index> J(n), J_tmp(n);
+  std::iota(J.begin(),J.end(),Index(0));
+  const size_t block_size = 1<<14;
+  const size_t num_blocks = (n+block_size-1)/block_size;
+  std::vector<size_t> H(2048*num_blocks);
+  for(int shift = 0;shift < 64;shift += 11)
+  {
+    igl::parallel_for(num_blocks,[&](const size_t b)
+    {
+      size_t * h = H.data()+2048*b;
+      std::fill(h,h+2048,size_t(0));
+      const size_t end = std::min(n,(b+1)*block_size);
+      for(size_t i = b*block_size;i<end;i++) { h[(key[i]>>shift)&0x7ff]++; }
+    },2);
+    // Skip passes where every key has the same digit
+    bool trivial = false;
+    size_t offset = 0;
+    for(int d = 0;d<2048;d++)
+    {
+      const size_t offset_d = offset;
+      for(size_t b = 0;b<num_blocks;b++)
+      {
+        const size_t c = H[2048*b+d];
+        H[2048*b+d] = offset;
+        offset += c;
+      }
+      if(offset-offset_d == n) { trivial = true; break; }
+    }
+    if(trivial) { continue; }
+    igl::parallel_for(num_blocks,[&](const size_t b)
+    {
+      size_t * h = H.data()+2048*b;
+      const size_t end = std::min(n,(b+1)*block_size);
+      for(size_t i = b*block_size;i<end;i++)
+      {
+        const size_t j = h[(key[i]>>shift)&0x7ff]++;
+        key_tmp[j] = key[i];
+        J_tmp[j] = J[i];
+      }
+    },2);
+    key.swap(key_tmp);
+    J.swap(J_tmp);
+  }
+  for(size_t i = 0;i<n;i++)
+  {
+    C(i) = static_cast<typename DerivedC::Scalar>(key[i]);
+  }
+  I = Eigen::Map<const Eigen::Matrix<Index,Eigen::Dynamic,1>>(J.data(),n);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::morton_codes<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::PlainObjectBase<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>&);
+template void igl::morton_codes<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>&);
+template void igl::morton_codes<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>&);
+template void igl::morton_order<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template void igl::morton_order<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template void igl::morton_order<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template void igl::morton_order<Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 1, -1, -1>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template void igl::morton_order<Eigen::Matrix<double, -1, 2, 1, -1, 2>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 2, 1, -1, 2>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template void igl::morton_codes<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, double, Eigen::PlainObjectBase<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>&);
+template void igl::morton_codes<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3>> const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, double, Eigen::PlainObjectBase<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>&);
+template void igl::sort_morton_codes<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(Eigen::PlainObjectBase<Eigen::Matrix<std::uint64_t, -1, 1, 0, -1, 1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+#endif
@@ -0,0 +1,65 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MORTON_CODES_H
+#define IGL_MORTON_CODES_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cstdint>
+
+namespace igl
+{
+  /// Compute Morton (Z-order) codes of points by quantizing them onto a
+  /// regular grid spanning their bounding box and interleaving the bits of
+  /// the integer coordinates. Sorting points by their codes places points
+  /// that are close in space close together in memory.
+  ///
+  /// @param[in] P  #P by dim list of points (dim ∈ {1,2,3})
+  /// @param[out] C  #P list of codes (21 bits per axis in 3D, 32 in 2D)
+  ///
+  /// \see morton_order
+  template <typename DerivedP, typename DerivedC>
+  IGL_INLINE void morton_codes(
+    const Eigen::MatrixBase<DerivedP> & P,
+    Eigen::PlainObjectBase<DerivedC> & C);
+  /// \overload
+  /// \brief Quantize onto a given cube instead of the bounding box, so that
+  /// the codes of points in the same cell of an octree on that cube share
+  /// their leading bits (3 per level in 3D).
+  ///
+  /// @param[in] origin  dim-vector of the cube's minimum corner
+  /// @param[in] h  side length of the cube (points outside are clamped)
+  template <typename DerivedP, typename Derivedorigin, typename DerivedC>
+  IGL_INLINE void morton_codes(
+    const Eigen::MatrixBase<DerivedP> & P,
+    const Eigen::MatrixBase<Derivedorigin> & origin,
+    const typename DerivedP::Scalar h,
+    Eigen::PlainObjectBase<DerivedC> & C);
+  /// Stable sort of Morton codes (parallel radix sort, the result does not
+  /// depend on the number of threads).
+  ///
+  /// @param[in,out] C  #C list of codes, sorted on output
+  /// @param[out] I  #C list of indices so that output C is input C(I)
+  template <typename DerivedC, typename DerivedI>
+  IGL_INLINE void sort_morton_codes(
+    Eigen::PlainObjectBase<DerivedC> & C,
+    Eigen::PlainObjectBase<DerivedI> & I);
+  /// Compute the permutation sorting points by their Morton codes.
+  ///
+  /// @param[in] P  #P by dim list of points (dim ∈ {1,2,3})
+  /// @param[out] I  #P list of indices into rows of P so that P(I,:) is in
+  ///   Morton order (ties keep input order)
+  template <typename DerivedP, typename DerivedI>
+  IGL_INLINE void morton_order(
+    const Eigen::MatrixBase<DerivedP> & P,
+    Eigen::PlainObjectBase<DerivedI> & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "morton_codes.cpp"
+#endif
+#endif
@@ -0,0 +1,351 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "narrow_band_signed_distance.h"
+#include "AABB.h"
+#include "WindingNumberAABB.h"
+#include "fast_winding_number.h"
+#include "parallel_for.h"
+#include "per_edge_normals.h"
+#include "per_face_normals.h"
+#include "per_vertex_normals.h"
+#include "pseudonormal_test.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename Derivedorigin,
+  typename Derivedres>
+IGL_INLINE void igl::narrow_band_signed_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<Derivedorigin> & origin,
+  const typename DerivedV::Scalar h,
+  const Eigen::MatrixBase<Derivedres> & res,
+  const typename DerivedV::Scalar band,
+  const SignedDistanceType sign_type,
+  SparseBrickGrid<typename DerivedV::Scalar> & G)
+{
+  typedef typename DerivedV::Scalar Scalar;
+  typedef typename DerivedF::Scalar Index;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  constexpr int bs = SparseBrickGrid<Scalar>::brick_size;
+  constexpr int bv = SparseBrickGrid<Scalar>::brick_volume;
+  G.init(origin,h,res,band);
+
+  igl::AABB<DerivedV,3> tree;
+  tree.init(V,F);
+  Eigen::Matrix<Scalar,Eigen::Dynamic,3> FN,VN,EN;
+  Eigen::Matrix<Index,Eigen::Dynamic,2> E;
+  Eigen::Matrix<Index,Eigen::Dynamic,1> EMAP;
+  igl::WindingNumberAABB<Scalar,Index> hier;
+  igl::FastWindingNumberBVH fwn_bvh;
+  switch(sign_type)
+  {
+    default:
+      assert(false && "Unknown SignedDistanceType");
+    case SIGNED_DISTANCE_TYPE_UNSIGNED:
+      break;
+    case SIGNED_DISTANCE_TYPE_DEFAULT:
+    case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
+      hier.set_mesh(V,F);
+      hier.grow();
+      break;
+    case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+      igl::fast_winding_number(V.template cast<float>().eval(),F,2,fwn_bvh);
+      break;
+    case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
+      igl::per_face_normals(V,F,FN);
+      igl::per_vertex_normals(
+        V,F,PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE,FN,VN);
+      igl::per_edge_normals(
+        V,F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,FN,EN,E,EMAP);
+      break;
+  }
+  // Sign at q whose closest point is c on triangle i (same conventions as
+  // signed_distance)
+  const auto sign = [&](const RowVector3S & q, const int i, const RowVector3S & c)
+    -> Scalar
+  {
+    switch(sign_type)
+    {
+      default:
+      case SIGNED_DISTANCE_TYPE_UNSIGNED:
+        return 1;
+      case SIGNED_DISTANCE_TYPE_DEFAULT:
+      case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
+        return 1.-2.*hier.winding_number(q.transpose());
+      case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
+        return 1.-2.*std::abs(
+          igl::fast_winding_number(fwn_bvh,2,q.template cast<float>().eval()));
+      case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
+      {
+        Scalar s;
+        RowVector3S cc = c,n;
+        igl::pseudonormal_test(V,F,FN,VN,EN,EMAP,q,i,cc,s,n);
+        return s;
+      }
+    }
+  };
+  const auto position = [&](const Eigen::RowVector3i & g)->RowVector3S
+  {
+    return G.origin + h*g.template cast<Scalar>();
+  };
+
+  // Cull cells of an implicit octree over bricks: a cell is kept if any
+  // triangle is within band of the ball bounding its grid vertices
+  struct Cell { Eigen::RowVector3i corner; int side; };
+  int side = 1;
+  while(side < G.brick_res.maxCoeff()) { side *= 2; }
+  std::vector<Cell> cells;
+  if(G.brick_res.minCoeff() > 0 && F.rows() > 0)
+  {
+    cells.push_back({Eigen::RowVector3i::Zero(),side});
+  }
+  std::vector<Eigen::RowVector3i> active;
+  while(!cells.empty())
+  {
+    std::vector<char> keep(cells.size());
+    igl::parallel_for(cells.size(),[&](const int ci)
+    {
+      const Cell & cell = cells[ci];
+      const RowVector3S lo = position(bs*cell.corner);
+      const RowVector3S hi = position(
+        (bs*(cell.corner.array()+cell.side).min(G.brick_res.array())-1)
+        .matrix());
+      const RowVector3S center = 0.5*(lo+hi);
+      const Scalar r = 0.5*(hi-lo).norm() + band;
+      int i = -1;
+      RowVector3S c;
+      tree.squared_distance(V,F,center,r*r,i,c);
+      keep[ci] = i >= 0;
+    },64);
+    std::vector<Cell> next;
+    for(int ci = 0;ci<(int)cells.size();ci++)
+    {
+      if(!keep[ci]) { continue; }
+      const Cell & cell = cells[ci];
+      if(cell.side == 1)
+      {
+        active.push_back(cell.corner);
+        continue;
+      }
+      const int half = cell.side/2;
+      for(int k = 0;k<8;k++)
+      {
+        const Eigen::RowVector3i corner =
+          cell.corner + half*Eigen::RowVector3i(k&1,(k>>1)&1,(k>>2)&1);
+        if((corner.array() < G.brick_res.array()).all())
+        {
+          next.push_back({corner,half});
+        }
+      }
+    }
+    cells.swap(next);
+  }
+
+  // Evaluate vertices of candidate bricks, NaN marks outside the band
+  const Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+  typename SparseBrickGrid<Scalar>::BrickMatrix values(active.size(),bv);
+  std::vector<char> in_band(active.size(),false);
+  igl::parallel_for(active.size(),[&](const int a)
+  {
+    for(int l = 0;l<bv;l++)
+    {
+      const Eigen::RowVector3i g =
+        bs*active[a] + Eigen::RowVector3i(l%bs,(l/bs)%bs,l/(bs*bs));
+      const RowVector3S q = position(g);
+      int i = -1;
+      RowVector3S c;
+      const Scalar sqrd = tree.squared_distance(V,F,q,band*band,i,c);
+      if(i < 0)
+      {
+        values(a,l) = nan;
+      }else
+      {
+        values(a,l) = sign(q,i,c)*std::sqrt(sqrd);
+        in_band[a] = true;
+      }
+    }
+  },1);
+  // Only keep bricks with some vertex in the band
+  int num_active = 0;
+  for(int a = 0;a<(int)active.size();a++) { num_active += in_band[a]; }
+  G.brick_coords.resize(num_active,3);
+  G.values.resize(num_active,bv);
+  for(int a = 0,b = 0;a<(int)active.size();a++)
+  {
+    if(!in_band[a]) { continue; }
+    G.brick_coords.row(b) = active[a];
+    G.values.row(b) = values.row(a);
+    G.brick_index(G.brick(active[a](0),active[a](1),active[a](2))) = b;
+    b++;
+  }
+  values.resize(0,bv);
+
+  // Flood fill signs over a graph whose nodes are the vertices of active
+  // bricks followed by the inactive bricks. When band ≥ h no grid edge
+  // between two vertices outside the band crosses the surface, so signs
+  // propagate from in-band vertices to their neighbors outside the band.
+  const std::int64_t num_vertex_nodes = std::int64_t(num_active)*bv;
+  std::vector<signed char> node_sign(num_vertex_nodes + G.brick_index.size(),0);
+  std::vector<std::int64_t> stack;
+  const auto visit = [&](const std::int64_t n, const signed char s)
+  {
+    if(node_sign[n] == 0)
+    {
+      node_sign[n] = s;
+      stack.push_back(n);
+    }
+  };
+  const auto brick_coord = [&](const int b)->Eigen::RowVector3i
+  {
+    return Eigen::RowVector3i(
+      b%G.brick_res(0),
+      (b/G.brick_res(0))%G.brick_res(1),
+      b/(G.brick_res(0)*G.brick_res(1)));
+  };
+  const auto expand = [&](const std::int64_t n)
+  {
+    const signed char s = node_sign[n];
+    if(n < num_vertex_nodes)
+    {
+      // Vertex of an active brick: visit its 6 grid neighbors
+      const int a = int(n/bv);
+      const int l = int(n%bv);
+      const Eigen::RowVector3i g =
+        bs*G.brick_coords.row(a) + Eigen::RowVector3i(l%bs,(l/bs)%bs,l/(bs*bs));
+      for(int d = 0;d<3;d++)
+      {
+        for(const int o : {-1,1})
+        {
+          Eigen::RowVector3i gn = g;
+          gn(d) += o;
+          if(gn(d) < 0 || gn(d) >= bs*G.brick_res(d)) { continue; }
+          const int b = G.brick(gn(0)/bs,gn(1)/bs,gn(2)/bs);
+          const int an = G.brick_index(b);
+          if(an < 0)
+          {
+            visit(num_vertex_nodes+b,s);
+          }else
+          {
+            visit(std::int64_t(an)*bv +
+              gn(0)%bs + bs*(gn(1)%bs + bs*(gn(2)%bs)),s);
+          }
+        }
+      }
+    }else
+    {
+      // Inactive brick: visit neighboring bricks or the vertices on the
+      // facing side of neighboring active bricks
+      const int b = int(n-num_vertex_nodes);
+      const Eigen::RowVector3i bc = brick_coord(b);
+      for(int d = 0;d<3;d++)
+      {
+        for(const int o : {-1,1})
+        {
+          Eigen::RowVector3i bn = bc;
+          bn(d) += o;
+          if(bn(d) < 0 || bn(d) >= G.brick_res(d)) { continue; }
+          const int b2 = G.brick(bn(0),bn(1),bn(2));
+          const int an = G.brick_index(b2);
+          if(an < 0)
+          {
+            visit(num_vertex_nodes+b2,s);
+            continue;
+          }
+          const int face = o < 0 ? bs-1 : 0;
+          const int d1 = (d+1)%3;
+          const int d2 = (d+2)%3;
+          for(int u = 0;u<bs;u++)
+          {
+            for(int v = 0;v<bs;v++)
+            {
+              Eigen::RowVector3i x;
+              x(d) = face;
+              x(d1) = u;
+              x(d2) = v;
+              visit(std::int64_t(an)*bv + x(0) + bs*(x(1) + bs*x(2)),s);
+            }
+          }
+        }
+      }
+    }
+  };
+  const auto drain = [&]()
+  {
+    while(!stack.empty())
+    {
+      const std::int64_t n = stack.back();
+      stack.pop_back();
+      expand(n);
+    }
+  };
+  // Assign all in-band signs before propagating any of them
+  for(std::int64_t n = 0;n<num_vertex_nodes;n++)
+  {
+    const Scalar v = G.values(n/bv,n%bv);
+    if(v == v)
+    {
+      node_sign[n] = v < 0 ? -1 : 1;
+    }
+  }
+  for(std::int64_t n = 0;n<num_vertex_nodes;n++)
+  {
+    const Scalar v = G.values(n/bv,n%bv);
+    if(v == v)
+    {
+      expand(n);
+      drain();
+    }
+  }
+  // Anything not reached is a region far from the surface: sign it directly
+  for(std::int64_t n = 0;n<std::int64_t(node_sign.size());n++)
+  {
+    if(node_sign[n] != 0) { continue; }
+    const Eigen::RowVector3i g = n < num_vertex_nodes ?
+      Eigen::RowVector3i(bs*G.brick_coords.row(n/bv) + Eigen::RowVector3i(
+        (n%bv)%bs,((n%bv)/bs)%bs,(n%bv)/(bs*bs))) :
+      Eigen::RowVector3i(bs*brick_coord(int(n-num_vertex_nodes)));
+    const RowVector3S q = position(g);
+    int i = -1;
+    RowVector3S c;
+    if(F.rows() > 0)
+    {
+      tree.squared_distance(V,F,q,i,c);
+    }
+    node_sign[n] = (i < 0 || sign(q,i,c) >= 0) ? 1 : -1;
+    stack.push_back(n);
+    drain();
+  }
+
+  // Write signs outside the band
+  igl::parallel_for(num_active,[&](const int a)
+  {
+    for(int l = 0;l<bv;l++)
+    {
+      if(G.values(a,l) != G.values(a,l))
+      {
+        G.values(a,l) = node_sign[std::int64_t(a)*bv+l]*band;
+      }
+    }
+  },64);
+  for(int b = 0;b<G.brick_index.size();b++)
+  {
+    G.brick_sign(b) = G.brick_index(b) < 0 ? node_sign[num_vertex_nodes+b] : 0;
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::narrow_band_signed_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<int, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, double, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, double, igl::SignedDistanceType, igl::SparseBrickGrid<double>&);
+template void igl::narrow_band_signed_distance<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, 1, 3, 1, 1, 3>, Eigen::Matrix<int, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> > const&, float, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, float, igl::SignedDistanceType, igl::SparseBrickGrid<float>&);
+#endif
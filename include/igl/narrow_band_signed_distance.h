@@ -0,0 +1,58 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_NARROW_BAND_SIGNED_DISTANCE_H
+#define IGL_NARROW_BAND_SIGNED_DISTANCE_H
+#include "igl_inline.h"
+#include "signed_distance.h"
+#include "SparseBrickGrid.h"
+#include <Eigen/Core>
+namespace igl
+{
+  /// Compute the signed distance to a triangle mesh at the vertices of a
+  /// regular grid, but only within a narrow band around the surface.
+  ///
+  /// Bricks of the grid are culled hierarchically (an implicit octree over
+  /// bricks) against an igl::AABB of the mesh, so only bricks within the band
+  /// are ever visited. Within those bricks exact distances (and signs
+  /// according to `sign_type`) are computed for vertices within the band.
+  /// All other vertices and bricks are set to ±band, with signs flood filled
+  /// from the band. Far-away regions not touching the band (e.g., when the
+  /// mesh lies outside the grid) are signed with a single query each.
+  ///
+  /// @param[in] V  #V by 3 list of mesh vertex positions
+  /// @param[in] F  #F by 3 list of triangle indices into V
+  /// @param[in] origin  3-long position of grid vertex (0,0,0)
+  /// @param[in] h  grid spacing
+  /// @param[in] res  3-long number of grid vertices along each axis
+  /// @param[in] band  half-width of narrow band. For the flood fill to be
+  ///   correct this should be at least h.
+  /// @param[in] sign_type  method for computing distance _sign_
+  /// @param[out] G  sparse grid of signed distances, clamped to ±band
+  ///
+  /// \see signed_distance, SparseBrickGrid, flood_fill
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename Derivedorigin,
+    typename Derivedres>
+  IGL_INLINE void narrow_band_signed_distance(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<Derivedorigin> & origin,
+    const typename DerivedV::Scalar h,
+    const Eigen::MatrixBase<Derivedres> & res,
+    const typename DerivedV::Scalar band,
+    const SignedDistanceType sign_type,
+    SparseBrickGrid<typename DerivedV::Scalar> & G);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "narrow_band_signed_distance.cpp"
+#endif
+
+#endif
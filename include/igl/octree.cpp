@@ -1,4 +1,8 @@
 #include "octree.h"
+#include "morton_codes.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 namespace igl {
@@ -167,6 +171,147 @@ namespace igl {
       W(i) = widths.at(i);
     }
   }
+
+  template <typename DerivedP, typename DerivedPI, typename DerivedCP,
+    typename DerivedCH, typename DerivedCN, typename DerivedW>
+  IGL_INLINE void octree(const Eigen::MatrixBase<DerivedP>& P,
+                         Eigen::PlainObjectBase<DerivedPI> & PI,
+                         Eigen::PlainObjectBase<DerivedCP> & CP,
+                         Eigen::PlainObjectBase<DerivedCH>& CH,
+                         Eigen::PlainObjectBase<DerivedCN>& CN,
+                         Eigen::PlainObjectBase<DerivedW>& W)
+  {
+    // Morton codes have 21 bits per axis
+    const int MAX_DEPTH = 21;
+
+    typedef typename DerivedCH::Scalar ChildrenType;
+    typedef typename DerivedCN::Scalar CentersType;
+    typedef typename DerivedW::Scalar WidthsType;
+    typedef typename DerivedP::Scalar PointScalar;
+    typedef Eigen::Matrix<PointScalar, 1, 3> RowVector3PType;
+    typedef Eigen::Matrix<CentersType, 1, 3> RowVector3CentersType;
+
+    const size_t n = P.rows();
+
+    // Same root cell as above: the minimum AABB grown to a cube
+    RowVector3CentersType aabb_center(0,0,0);
+    WidthsType aabb_width = 0;
+    Eigen::Matrix<std::uint64_t,Eigen::Dynamic,1> C;
+    if(n > 0)
+    {
+      const RowVector3PType backleftbottom = P.colwise().minCoeff();
+      const RowVector3PType frontrighttop = P.colwise().maxCoeff();
+      aabb_center = ((backleftbottom+frontrighttop)/PointScalar(2.0)).
+        template cast<CentersType>();
+      aabb_width = (frontrighttop - backleftbottom).maxCoeff();
+    }
+    const RowVector3PType origin =
+      aabb_center.template cast<PointScalar>().array() -
+      PointScalar(aabb_width)/PointScalar(2.0);
+    igl::morton_codes(P,origin,PointScalar(aabb_width),C);
+    // The points of any cell at depth d share the leading 3d bits of their
+    // codes, so after sorting each cell is a contiguous range of PI and its
+    // children are consecutive subranges in octant order.
+    igl::sort_morton_codes(C,PI);
+
+    // Ranges of the cells at each depth and the index of each cell's first
+    // child (or -1), cells at depth d+1 are numbered after those at depth d
+    std::vector<std::vector<size_t> > offsets(1,{0}), counts(1,{n});
+    std::vector<std::vector<ChildrenType> > first_child;
+    std::vector<size_t> level_begin(1,0);
+    // Keep references to levels valid while appending
+    offsets.reserve(MAX_DEPTH+1);
+    counts.reserve(MAX_DEPTH+1);
+    first_child.reserve(MAX_DEPTH+1);
+    for(int depth = 0;;depth++)
+    {
+      const std::vector<size_t> & off = offsets[depth];
+      const std::vector<size_t> & cnt = counts[depth];
+      const size_t num_level = off.size();
+      level_begin.push_back(level_begin[depth]+num_level);
+      // Split cells containing more than one distinct code, then number
+      // their children in order
+      first_child.emplace_back(num_level);
+      std::vector<ChildrenType> & fc = first_child[depth];
+      std::vector<size_t> num_children(num_level+1,0);
+      igl::parallel_for(num_level,[&](const size_t i)
+      {
+        num_children[i+1] = depth < MAX_DEPTH && cnt[i] > 1 &&
+          C(off[i]) != C(off[i]+cnt[i]-1) ? 8 : 0;
+      },10000);
+      for(size_t i = 0;i<num_level;i++)
+      {
+        fc[i] = num_children[i+1] ?
+          ChildrenType(level_begin[depth+1]+num_children[i]) : -1;
+        num_children[i+1] += num_children[i];
+      }
+      if(num_children[num_level] == 0)
+      {
+        break;
+      }
+      offsets.emplace_back(num_children[num_level]);
+      counts.emplace_back(num_children[num_level]);
+      std::vector<size_t> & child_off = offsets[depth+1];
+      std::vector<size_t> & child_cnt = counts[depth+1];
+      // Octant of a code at this depth
+      const int shift = 3*(MAX_DEPTH-1-depth);
+      igl::parallel_for(num_level,[&](const size_t i)
+      {
+        if(fc[i] < 0)
+        {
+          return;
+        }
+        const std::uint64_t * first = C.data()+off[i];
+        const std::uint64_t * end = first+cnt[i];
+        for(int j = 0;j<8;j++)
+        {
+          const std::uint64_t * last = std::partition_point(first,end,
+            [&](const std::uint64_t code){ return int((code>>shift)&7) <= j; });
+          const size_t d = num_children[i]+j;
+          child_off[d] = first-C.data();
+          child_cnt[d] = last-first;
+          first = last;
+        }
+      },1000);
+    }
+
+    //Now convert to Eigen matricies, top down so that children can be placed
+    //relative to their parents
+    const size_t m = level_begin.back();
+    CP.resize(m,2);
+    CH.resize(m,8);
+    CN.resize(m,3);
+    W.resize(m,1);
+    CN.row(0) = aabb_center;
+    W(0) = aabb_width;
+    for(size_t depth = 0;depth<offsets.size();depth++)
+    {
+      const size_t begin = level_begin[depth];
+      igl::parallel_for(offsets[depth].size(),[&](const size_t i)
+      {
+        const size_t c = begin+i;
+        CP(c,0) = offsets[depth][i];
+        CP(c,1) = counts[depth][i];
+        const ChildrenType d = first_child[depth][i];
+        for(int j = 0;j<8;j++)
+        {
+          CH(c,j) = d < 0 ? -1 : d+j;
+        }
+        if(d < 0)
+        {
+          return;
+        }
+        // Same numbering of octants as above
+        const CentersType h = W(c)/2;
+        for(int j = 0;j<8;j++)
+        {
+          CN.row(d+j) = CN.row(c) + h/2*RowVector3CentersType(
+            (j&1)?1:-1, (j&2)?1:-1, (j&4)?1:-1);
+          W(d+j) = h;
+        }
+      },10000);
+    }
+  }
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -174,4 +319,6 @@ namespace igl {
 // generated by autoexplicit.sh
 template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
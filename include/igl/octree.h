@@ -48,6 +48,52 @@ namespace igl
     Eigen::PlainObjectBase<DerivedCH>& CH,
     Eigen::PlainObjectBase<DerivedCN>& CN,
     Eigen::PlainObjectBase<DerivedW>& W);
+  /// Given a set of 3D points P, generate the same kind of pointerless octree
+  /// but store each cell's points as a contiguous range of one permutation of
+  /// the points instead of as a vector per cell. The points are sorted by
+  /// their Morton codes on the root cell (in parallel), so the points of
+  /// every cell are contiguous in that order, and cells are then split level
+  /// by level in parallel. This avoids the per-cell allocations of the
+  /// overload above and is much faster on large point clouds; knn and
+  /// fast_winding_number have overloads consuming this layout directly.
+  ///
+  /// The root cell and the octant numbering are the same as above. Cells are
+  /// numbered level by level (so CH differs from the overload above) and a
+  /// cell is split if it contains more than one distinct point at the
+  /// resolution of the codes (2^-21 of the root width), so leaves may
+  /// contain multiple (near) duplicate points.
+  ///
+  /// @param[in] P  #P by 3 list of point locations
+  /// @param[out] PI  #P list of indices into P sorted so that the points of
+  ///   each octree cell are contiguous
+  /// @param[out] CP  #OctreeCells by 2, where the ith row is the offset into
+  ///   PI of the ith cell's first point and the ith cell's number of points
+  /// @param[out] CH  #OctreeCells by 8, where the ith row is the indices of the
+  ///   ith octree cell's children
+  /// @param[out] CN  #OctreeCells by 3, where the ith row is a 3d row vector
+  ///   representing the position of the ith cell's center
+  /// @param[out] W  #OctreeCells, a vector where the ith entry is the width of
+  ///   the ith octree cell
+  ///
+  /// #### Example
+  ///
+  /// \code{cpp}
+  ///   Eigen::VectorXi PI;
+  ///   Eigen::MatrixXi CP,CH;
+  ///   Eigen::MatrixXd CN;
+  ///   Eigen::VectorXd W;
+  ///   igl::octree(P,PI,CP,CH,CN,W);
+  ///   // points of cell c
+  ///   const auto Pc = PI.segment(CP(c,0),CP(c,1));
+  /// \endcode
+  template <typename DerivedP, typename DerivedPI, typename DerivedCP,
+  typename DerivedCH, typename DerivedCN, typename DerivedW>
+  IGL_INLINE void octree(const Eigen::MatrixBase<DerivedP>& P,
+    Eigen::PlainObjectBase<DerivedPI> & PI,
+    Eigen::PlainObjectBase<DerivedCP> & CP,
+    Eigen::PlainObjectBase<DerivedCH>& CH,
+    Eigen::PlainObjectBase<DerivedCN>& CN,
+    Eigen::PlainObjectBase<DerivedW>& W);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -0,0 +1,525 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "octree_dual_contouring.h"
+#include "lipschitz_octree.h"
+#include "unique_sparse_voxel_corners.h"
+#include "quadprog.h"
+#include "parallel_for.h"
+#include <Eigen/Cholesky>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Cells of one level of the octree with the accumulated hermite data of
+  // the leaves below them
+  template <typename Scalar>
+  struct octree_dual_contouring_level
+  {
+    using RowVector3S = Eigen::Matrix<Scalar,1,3>;
+    using Matrix4S = Eigen::Matrix<Scalar,4,4>;
+    // #C by 3 list of cell minimum corner subscripts (x,y,z)
+    Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> C;
+    // sum of quadrics of crossing points
+    std::vector<Matrix4S,Eigen::aligned_allocator<Matrix4S>> H;
+    // sum of crossing points
+    std::vector<RowVector3S,Eigen::aligned_allocator<RowVector3S>> mass;
+    // number of crossing points
+    std::vector<int> count;
+    // #C by 3 list of dual vertex positions
+    Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> P;
+    // whether all leaves below this cell share its dual vertex
+    std::vector<char> collapsed;
+    void resize(const int n)
+    {
+      C.resize(n,3);
+      H.resize(n);
+      mass.resize(n);
+      count.resize(n);
+      P.resize(n,3);
+      collapsed.resize(n);
+    }
+  };
+
+  // Dual vertex minimizing the quadric H (regularized toward the mass point
+  // as in igl::DualContouring::dual_vertex_positions) in the cell with
+  // minimum corner p0 and side length h. Returns the squared residual in err.
+  template <typename Scalar>
+  Eigen::Matrix<Scalar,1,3> octree_dual_contouring_solve(
+    const Eigen::Matrix<Scalar,4,4> & H,
+    const Eigen::Matrix<Scalar,1,3> & mass,
+    const int count,
+    const Eigen::Matrix<Scalar,1,3> & p0,
+    const Scalar h,
+    const bool constrained,
+    Scalar & err)
+  {
+    using RowVector3S = Eigen::Matrix<Scalar,1,3>;
+    using Vector3S = Eigen::Matrix<Scalar,3,1>;
+    using Matrix3S = Eigen::Matrix<Scalar,3,3>;
+    const RowVector3S mid = mass / Scalar(count);
+    const Scalar w = 1e-2*(0.01+count);
+    const Matrix3S A = H.template block<3,3>(0,0) + w*Matrix3S::Identity();
+    const RowVector3S b = -H.template block<1,3>(3,0) + w*mid;
+    RowVector3S x;
+    if(constrained)
+    {
+      x = igl::quadprog<Scalar,3>(
+        A,(p0*A-b).transpose(),Vector3S(0,0,0),Vector3S(h,h,h)).transpose();
+    }else
+    {
+      x = Eigen::LLT<Matrix3S>(A).solve(-(p0*A-b).transpose()).transpose();
+    }
+    const RowVector3S p = p0+x;
+    const Eigen::Matrix<Scalar,1,4> q(p(0),p(1),p(2),1);
+    err = std::max(Scalar(0),Scalar(q*H*q.transpose()));
+    return p;
+  }
+}
+
+template <
+  bool batched,
+  typename Derivedorigin,
+  typename Func,
+  typename GradFunc,
+  typename DerivedV,
+  typename DerivedF
+    >
+IGL_INLINE void igl::octree_dual_contouring(
+  const Eigen::MatrixBase<Derivedorigin> & origin,
+  const typename Derivedorigin::Scalar h0,
+  const int max_depth,
+  const Func & f,
+  const GradFunc & f_grad,
+  const typename Derivedorigin::Scalar tolerance,
+  const bool constrained,
+  const bool root_finding,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F)
+{
+  assert((origin.rows() == 3 || origin.cols() == 3) && origin.size() == 3 &&
+    "origin must be a 3D vector");
+  using Scalar = typename Derivedorigin::Scalar;
+  using RowVector3S = Eigen::Matrix<Scalar,1,3>;
+  using RowVector4S = Eigen::Matrix<Scalar,1,4>;
+  using Matrix4S = Eigen::Matrix<Scalar,4,4>;
+  using MatrixSX3R = Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor>;
+  using MatrixiX3R = Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor>;
+  using MatrixiX8R = Eigen::Matrix<int,Eigen::Dynamic,8,Eigen::RowMajor>;
+  using VectorS = Eigen::Matrix<Scalar,Eigen::Dynamic,1>;
+  using Level = octree_dual_contouring_level<Scalar>;
+
+  // f and f_grad at each row of P
+  const auto eval = [&](const MatrixSX3R & P)->VectorS
+  {
+    // Requires C++17
+    if constexpr (batched)
+    {
+      VectorS S = f(P);
+      assert(S.size() == P.rows());
+      return S;
+    }else
+    {
+      VectorS S(P.rows());
+      igl::parallel_for(P.rows(),[&](const int i)
+      {
+        const RowVector3S p = P.row(i);
+        S(i) = f(p);
+      },1000);
+      return S;
+    }
+  };
+  const auto eval_grad = [&](const MatrixSX3R & P)->MatrixSX3R
+  {
+    if constexpr (batched)
+    {
+      MatrixSX3R G = f_grad(P);
+      assert(G.rows() == P.rows());
+      return G;
+    }else
+    {
+      MatrixSX3R G(P.rows(),3);
+      igl::parallel_for(P.rows(),[&](const int i)
+      {
+        const RowVector3S p = P.row(i);
+        G.row(i) = f_grad(p);
+      },1000);
+      return G;
+    }
+  };
+
+  // Leaf cells near the surface
+  const RowVector3S origin_row(origin(0),origin(1),origin(2));
+  MatrixiX3R ijk;
+  if constexpr (batched)
+  {
+    const std::function<VectorS(const MatrixSX3R &)> udf =
+      [&](const MatrixSX3R & P)->VectorS { return eval(P).array().abs(); };
+    igl::lipschitz_octree<true>(origin_row,h0,max_depth,udf,ijk);
+  }else
+  {
+    const std::function<Scalar(const RowVector3S &)> udf =
+      [&](const RowVector3S & p)->Scalar { return std::abs(f(p)); };
+    igl::lipschitz_octree<false>(origin_row,h0,max_depth,udf,ijk);
+  }
+  const int m = ijk.rows();
+  if(m == 0)
+  {
+    V.resize(0,3);
+    F.resize(0,3);
+    return;
+  }
+
+  // Evaluate the function once per shared corner
+  MatrixiX3R unique_ijk;
+  MatrixiX8R J;
+  MatrixSX3R corners;
+  igl::unique_sparse_voxel_corners(
+    origin_row,h0,max_depth,ijk,unique_ijk,J,corners);
+  const VectorS S = eval(corners);
+
+  // ijk subscripts are (y,x,z)
+  const auto xyz = [](const auto & s)->Eigen::RowVector3i
+  {
+    return Eigen::RowVector3i(s(1),s(0),s(2));
+  };
+  // Column of J for each corner offset of a cell
+  int corner_col[2][2][2];
+  for(int c = 0;c<8;c++)
+  {
+    const Eigen::RowVector3i d = xyz(unique_ijk.row(J(0,c))) - xyz(ijk.row(0));
+    corner_col[d(0)][d(1)][d(2)] = c;
+  }
+  // Lower and upper corner columns of the 12 edges of a cell and their axes
+  int edge_lo[12], edge_hi[12], edge_axis[12];
+  for(int o = 0, e = 0;o<3;o++)
+  {
+    for(int i = 0;i<=1;i++)
+    {
+      for(int j = 0;j<=1;j++,e++)
+      {
+        Eigen::RowVector3i d(0,0,0);
+        d((o+1)%3) = i;
+        d((o+2)%3) = j;
+        edge_lo[e] = corner_col[d(0)][d(1)][d(2)];
+        d(o) = 1;
+        edge_hi[e] = corner_col[d(0)][d(1)][d(2)];
+        edge_axis[e] = o;
+      }
+    }
+  }
+  // An edge is identified by its lower corner and axis
+  const auto edge_key = [](const int lo, const int o)->std::int64_t
+  {
+    return 3*std::int64_t(lo)+o;
+  };
+
+  // Crossing edges (shared by up to four cells, so gather then deduplicate)
+  std::vector<std::pair<std::int64_t,int>> crossing;
+  {
+    std::vector<int> cell_count(m+1,0);
+    igl::parallel_for(m,[&](const int c)
+    {
+      int count = 0;
+      for(int e = 0;e<12;e++)
+      {
+        count += (S(J(c,edge_lo[e]))>0) != (S(J(c,edge_hi[e]))>0);
+      }
+      cell_count[c+1] = count;
+    },1000);
+    std::partial_sum(cell_count.begin(),cell_count.end(),cell_count.begin());
+    crossing.resize(cell_count[m]);
+    igl::parallel_for(m,[&](const int c)
+    {
+      int k = cell_count[c];
+      for(int e = 0;e<12;e++)
+      {
+        const int lo = J(c,edge_lo[e]);
+        const int hi = J(c,edge_hi[e]);
+        if((S(lo)>0) != (S(hi)>0))
+        {
+          crossing[k++] = {edge_key(lo,edge_axis[e]),hi};
+        }
+      }
+    },1000);
+    std::sort(crossing.begin(),crossing.end());
+    crossing.erase(std::unique(crossing.begin(),crossing.end()),crossing.end());
+  }
+  const int num_edges = crossing.size();
+  std::vector<std::int64_t> edge_keys(num_edges);
+  for(int e = 0;e<num_edges;e++) { edge_keys[e] = crossing[e].first; }
+
+  // Crossing points, by bisection (one batch of evaluations per step) or
+  // linear interpolation
+  MatrixSX3R P(num_edges,3);
+  {
+    VectorS tl = VectorS::Zero(num_edges);
+    VectorS tu = VectorS::Ones(num_edges);
+    const auto midpoints = [&]()
+    {
+      igl::parallel_for(num_edges,[&](const int e)
+      {
+        const int lo = crossing[e].first/3;
+        const int hi = crossing[e].second;
+        const Scalar t = 0.5*(tl(e)+tu(e));
+        P.row(e) = corners.row(lo) + t*(corners.row(hi)-corners.row(lo));
+      },1000);
+    };
+    if(root_finding)
+    {
+      const int max_riter = 7;
+      for(int riter = 0;riter<max_riter;riter++)
+      {
+        midpoints();
+        const VectorS St = eval(P);
+        igl::parallel_for(num_edges,[&](const int e)
+        {
+          const int lo = crossing[e].first/3;
+          const Scalar t = 0.5*(tl(e)+tu(e));
+          if((St(e)>0) == (S(lo)>0)) { tl(e) = t; } else { tu(e) = t; }
+        },1000);
+      }
+    }else
+    {
+      // inverse lerp (as tl=tu)
+      igl::parallel_for(num_edges,[&](const int e)
+      {
+        const int lo = crossing[e].first/3;
+        const int hi = crossing[e].second;
+        const Scalar delta = S(hi)-S(lo);
+        tl(e) = delta == 0 ? 0.5 : -S(lo)/delta;
+        tu(e) = tl(e);
+      },1000);
+    }
+    midpoints();
+  }
+  // Quadric of the tangent plane at each crossing point
+  std::vector<Matrix4S,Eigen::aligned_allocator<Matrix4S>> H(num_edges);
+  {
+    const MatrixSX3R N = eval_grad(P);
+    igl::parallel_for(num_edges,[&](const int e)
+    {
+      const RowVector3S p = P.row(e);
+      const RowVector3S n = N.row(e);
+      const RowVector4S plane(n(0),n(1),n(2),-n.dot(p));
+      H[e] = plane.transpose() * plane;
+    },1000);
+  }
+
+  // Leaf dual vertices
+  std::vector<Level> levels(1);
+  {
+    Level & leaves = levels[0];
+    leaves.resize(m);
+    const Scalar h = h0/(1<<max_depth);
+    igl::parallel_for(m,[&](const int c)
+    {
+      leaves.C.row(c) = xyz(ijk.row(c));
+      leaves.H[c].setZero();
+      leaves.mass[c].setZero();
+      leaves.count[c] = 0;
+      leaves.collapsed[c] = true;
+      for(int e = 0;e<12;e++)
+      {
+        const std::int64_t key = edge_key(J(c,edge_lo[e]),edge_axis[e]);
+        const auto it = std::lower_bound(edge_keys.begin(),edge_keys.end(),key);
+        if(it == edge_keys.end() || *it != key) { continue; }
+        const int k = it - edge_keys.begin();
+        leaves.H[c] += H[k];
+        leaves.mass[c] += P.row(k);
+        leaves.count[c]++;
+      }
+      if(leaves.count[c] == 0) { return; }
+      Scalar err;
+      const RowVector3S p0 = origin_row + h*leaves.C.row(c).template cast<Scalar>();
+      leaves.P.row(c) = octree_dual_contouring_solve(
+        leaves.H[c],leaves.mass[c],leaves.count[c],p0,h,constrained,err);
+    },1000);
+  }
+
+  // Collapse siblings bottom-up. A cell is collapsed if all of its children
+  // are and its own QEF residual is small enough. Each leaf uses the dual
+  // vertex of its coarsest collapsed ancestor.
+  std::vector<int> leaf2node(m);
+  std::iota(leaf2node.begin(),leaf2node.end(),0);
+  std::vector<int> leaf_level(m,0);
+  std::vector<int> leaf_node = leaf2node;
+  for(int depth = max_depth-1;depth>=0 && tolerance>0;depth--)
+  {
+    const Level & child = levels.back();
+    const int num_child = child.C.rows();
+    // Group children by parent
+    std::vector<std::pair<std::int64_t,int>> code(num_child);
+    const std::int64_t n = std::int64_t(1)<<depth;
+    igl::parallel_for(num_child,[&](const int c)
+    {
+      const Eigen::RowVector3i pc = child.C.row(c).array()/2;
+      code[c] = {pc(0)+n*(pc(1)+n*pc(2)),c};
+    },1000);
+    std::sort(code.begin(),code.end());
+    std::vector<int> start;
+    for(int c = 0;c<num_child;c++)
+    {
+      if(c == 0 || code[c].first != code[c-1].first) { start.push_back(c); }
+    }
+    const int num_parent = start.size();
+    start.push_back(num_child);
+    Level parent;
+    parent.resize(num_parent);
+    std::vector<int> child2parent(num_child);
+    const Scalar h = h0/(std::int64_t(1)<<depth);
+    igl::parallel_for(num_parent,[&](const int p)
+    {
+      parent.C.row(p) = child.C.row(code[start[p]].second).array()/2;
+      parent.H[p].setZero();
+      parent.mass[p].setZero();
+      parent.count[p] = 0;
+      bool collapsed = true;
+      for(int k = start[p];k<start[p+1];k++)
+      {
+        const int c = code[k].second;
+        child2parent[c] = p;
+        parent.H[p] += child.H[c];
+        parent.mass[p] += child.mass[c];
+        parent.count[p] += child.count[c];
+        collapsed = collapsed && child.collapsed[c];
+      }
+      if(collapsed && parent.count[p] > 0)
+      {
+        Scalar err;
+        const RowVector3S p0 =
+          origin_row + h*parent.C.row(p).template cast<Scalar>();
+        parent.P.row(p) = octree_dual_contouring_solve(
+          parent.H[p],parent.mass[p],parent.count[p],p0,h,constrained,err);
+        collapsed = std::sqrt(err/parent.count[p]) < tolerance;
+      }
+      parent.collapsed[p] = collapsed;
+    },1000);
+    bool any = false;
+    for(int p = 0;p<num_parent;p++)
+    {
+      any = any || (parent.collapsed[p] && parent.count[p] > 0);
+    }
+    if(!any) { break; }
+    const int l = levels.size();
+    igl::parallel_for(m,[&](const int c)
+    {
+      leaf2node[c] = child2parent[leaf2node[c]];
+      if(parent.collapsed[leaf2node[c]])
+      {
+        leaf_level[c] = l;
+        leaf_node[c] = leaf2node[c];
+      }
+    },1000);
+    levels.push_back(std::move(parent));
+  }
+  // Offset of each level's dual vertices
+  std::vector<int> level_offset(levels.size()+1,0);
+  for(int l = 0;l<(int)levels.size();l++)
+  {
+    level_offset[l+1] = level_offset[l] + levels[l].C.rows();
+  }
+
+  // Two triangles per crossing edge connecting the dual vertices of the four
+  // cells around it (oriented as in igl::dual_contouring)
+  std::vector<std::pair<std::int64_t,int>> leaf_code(m);
+  const std::int64_t n = std::int64_t(1)<<max_depth;
+  const auto cell_code = [&n](const Eigen::RowVector3i & kc)->std::int64_t
+  {
+    return kc(0)+n*(kc(1)+n*std::int64_t(kc(2)));
+  };
+  igl::parallel_for(m,[&](const int c)
+  {
+    leaf_code[c] = {cell_code(levels[0].C.row(c)),c};
+  },1000);
+  std::sort(leaf_code.begin(),leaf_code.end());
+  MatrixiX3R T(2*num_edges,3);
+  igl::parallel_for(num_edges,[&](const int e)
+  {
+    T.row(2*e+0).setConstant(-1);
+    T.row(2*e+1).setConstant(-1);
+    const int lo = crossing[e].first/3;
+    const int o = crossing[e].first%3;
+    const int hi = crossing[e].second;
+    const Eigen::RowVector3i ic = xyz(unique_ijk.row(lo));
+    Eigen::RowVector4i face;
+    int k = 0;
+    for(int i = -1;i<=0;i++)
+    {
+      for(int j = -1;j<=0;j++)
+      {
+        Eigen::RowVector3i kc = ic;
+        kc((o+1)%3)+=i;
+        kc((o+2)%3)+=j;
+        if((kc.array()<0).any() || (kc.array()>=n).any()) { return; }
+        const std::pair<std::int64_t,int> key(cell_code(kc),-1);
+        const auto it = std::lower_bound(leaf_code.begin(),leaf_code.end(),key);
+        if(it == leaf_code.end() || it->first != key.first) { return; }
+        const int c = it->second;
+        face(k++) = level_offset[leaf_level[c]] + leaf_node[c];
+      }
+    }
+    Eigen::RowVector4i q;
+    if(S(hi) > S(lo))
+    {
+      q << face(2),face(3),face(1),face(0);
+    }else
+    {
+      q << face(0),face(1),face(3),face(2);
+    }
+    // Skip triangles collapsed to an edge or point
+    const auto degenerate = [](const int a, const int b, const int c)
+    {
+      return a == b || b == c || c == a;
+    };
+    if(!degenerate(q(0),q(1),q(2))) { T.row(2*e+0) << q(0),q(1),q(2); }
+    if(!degenerate(q(0),q(2),q(3))) { T.row(2*e+1) << q(0),q(2),q(3); }
+  },1000);
+
+  // Keep only referenced dual vertices
+  std::vector<int> vid(level_offset.back(),-1);
+  int num_f = 0;
+  for(int t = 0;t<T.rows();t++)
+  {
+    if(T(t,0) < 0) { continue; }
+    for(int c = 0;c<3;c++) { vid[T(t,c)] = 0; }
+    T.row(num_f++) = T.row(t);
+  }
+  int num_v = 0;
+  for(auto & v : vid) { if(v == 0) { v = num_v++; } }
+  V.resize(num_v,3);
+  for(int l = 0;l<(int)levels.size();l++)
+  {
+    igl::parallel_for(levels[l].C.rows(),[&](const int c)
+    {
+      const int v = vid[level_offset[l]+c];
+      if(v < 0) { return; }
+      V.row(v) = levels[l].P.row(c).template cast<typename DerivedV::Scalar>();
+    },1000);
+  }
+  F.resize(num_f,3);
+  igl::parallel_for(num_f,[&](const int t)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      F(t,c) = vid[T(t,c)];
+    }
+  },1000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::octree_dual_contouring<false, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, std::function<Eigen::Matrix<double, 1, 3, 1, 1, 3> (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, std::function<Eigen::Matrix<double, 1, 3, 1, 1, 3> (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, bool, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&);
+template void igl::octree_dual_contouring<true, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, std::function<Eigen::Matrix<double, -1, 3, 1, -1, 3> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, std::function<Eigen::Matrix<double, -1, 3, 1, -1, 3> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, bool, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&);
+#endif
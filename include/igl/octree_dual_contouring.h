@@ -0,0 +1,86 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_OCTREE_DUAL_CONTOURING_H
+#define IGL_OCTREE_DUAL_CONTOURING_H
+
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  /// Dual contouring of the zero level set of a signed distance function on
+  /// an adaptive octree. Leaf cells at max_depth near the surface are found
+  /// with igl::lipschitz_octree, each gets a dual vertex minimizing its
+  /// quadric error function (QEF) as in igl::dual_contouring, and then
+  /// groups of eight sibling cells are collapsed bottom-up into their parent
+  /// whenever the parent's QEF residual (root mean squared distance to the
+  /// children's tangent planes) is below tolerance ("Dual Contouring of
+  /// Hermite Data" [Ju et al. 2002]). Every stage (corner evaluation,
+  /// crossing search, QEF solves, collapsing, face emission) runs in
+  /// parallel and the output does not depend on the number of threads.
+  ///
+  /// With tolerance=0 no cells are collapsed and the output is the same
+  /// surface as igl::dual_contouring on the dense grid at max_depth (with
+  /// each quad split into two triangles). Collapsing does not check that the
+  /// topology is preserved, so large tolerances may merge nearby sheets and
+  /// produce non-manifold output.
+  ///
+  /// @tparam batched  whether f and f_grad are called on many points at once
+  ///   (`f(P)` for #P by 3 P returning #P vector and `f_grad(P)` returning #P
+  ///   by 3 matrix) or on each point (`f(p)` for 1 by 3 p, called in
+  ///   parallel)
+  /// @param[in] origin  3-vector of root cell origin (minimum corner)
+  /// @param[in] h0   side length of root cell
+  /// @param[in] max_depth  depth of the finest cells (root is depth=0)
+  /// @param[in] f  signed distance function (negative inside). Must be
+  ///   1-Lipschitz for no cells near the surface to be missed.
+  /// @param[in] f_grad  (unit) gradient of f
+  /// @param[in] tolerance  maximum QEF residual of collapsed cells (in units
+  ///   of distance)
+  /// @param[in] constrained  whether to force dual vertices to lie strictly
+  ///   within their cell (slower)
+  /// @param[in] root_finding  whether to find crossings by bisection on f
+  ///   (more function evaluations) rather than linear interpolation of
+  ///   corner values
+  /// @param[out] V  #V by 3 list of mesh vertex positions
+  /// @param[out] F  #F by 3 list of mesh triangle indices into rows of V
+  ///
+  /// #### Example
+  ///
+  /// \code{cpp}
+  ///   igl::octree_dual_contouring(
+  ///     origin,h0,max_depth,sdf,sdf_grad,1e-3,false,true,V,F);
+  /// \endcode
+  ///
+  /// \see dual_contouring, lipschitz_octree, sparse_voxel_marching_cubes
+  template <
+    bool batched=false,
+    typename Derivedorigin,
+    typename Func,
+    typename GradFunc,
+    typename DerivedV,
+    typename DerivedF
+      >
+  IGL_INLINE void octree_dual_contouring(
+    const Eigen::MatrixBase<Derivedorigin> & origin,
+    const typename Derivedorigin::Scalar h0,
+    const int max_depth,
+    const Func & f,
+    const GradFunc & f_grad,
+    const typename Derivedorigin::Scalar tolerance,
+    const bool constrained,
+    const bool root_finding,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#    include "octree_dual_contouring.cpp"
+#endif
+
+#endif
@@ -8,6 +8,8 @@
 #ifndef IGL_PARALLEL_FOR_H
 #define IGL_PARALLEL_FOR_H
 #include "igl_inline.h"
+#include "ParallelForSchedule.h"
+#include <cstddef>
 #include <functional>
 
 //#warning "Defining IGL_PARALLEL_FOR_FORCE_SERIAL"
@@ -28,8 +30,10 @@ namespace igl
   /// \endcode
   ///
   /// then `parallel_for(loop_size,func,min_parallel)` will use as many threads as
-  /// available on the current hardware to parallelize this for loop so long as
-  /// loop_size<min_parallel, otherwise it will just use a serial for loop.
+  /// available in igl::default_thread_pool() to parallelize this for loop so
+  /// long as loop_size>=min_parallel, otherwise it will just use a serial for
+  /// loop. Threads persist across calls, and nested calls (issued from inside
+  /// func) share the same pool rather than spawning new threads.
   ///
   /// Often if your code looks like:
   ///
@@ -107,16 +111,67 @@ namespace igl
     const FunctionType & func,
     const AccumFunctionType & accum_func,
     const size_t min_parallel=0);
+  /// Scheduling policy for parallel_for
+  struct ParallelForPolicy
+  {
+    /// How iterations are handed out to threads
+    ParallelForSchedule schedule = PARALLEL_FOR_SCHEDULE_DYNAMIC;
+    /// (Minimum) number of iterations per chunk, 0 means automatic
+    size_t grain_size = 0;
+    /// Maximum number of threads working on this loop, 0 means the size of
+    /// igl::default_thread_pool()
+    size_t max_concurrency = 0;
+    /// min size of loop_size such that parallel (non-serial) thread pooling
+    /// should be attempted
+    size_t min_parallel = 0;
+  };
+  /// Parallel for loop with an explicit scheduling policy.
+  ///
+  /// Calls issued from inside func (e.g., an outer batch loop calling libigl
+  /// routines that are themselves parallelized) never create new threads:
+  /// the inner loop runs on the calling thread with help from whichever pool
+  /// workers are idle, so the total number of threads is bounded by the size
+  /// of igl::default_thread_pool().
+  ///
+  /// @param[in] loop_size  number of iterations
+  /// @param[in] func  function handle taking iteration index as only argument
+  /// @param[in] policy  scheduling policy
+  /// @return true iff thread pool was invoked
+  template<typename Index, typename FunctionType >
+  inline bool parallel_for(
+    const Index loop_size,
+    const FunctionType & func,
+    const ParallelForPolicy & policy);
+  /// Parallel for loop with accumulation and an explicit scheduling policy.
+  ///
+  /// @param[in] loop_size  number of iterations
+  /// @param[in] prep_func  function handle taking n >= number of threads as
+  ///   only argument; n is at most policy.max_concurrency
+  /// @param[in] func  function handle taking iteration index i and thread id t
+  ///   as only arguments
+  /// @param[in] accum_func  function handle taking thread index as only
+  ///   argument, called after all calls of func
+  /// @param[in] policy  scheduling policy
+  /// @return true iff thread pool was invoked
+  template<
+    typename Index,
+    typename PrepFunctionType,
+    typename FunctionType,
+    typename AccumFunctionType
+    >
+  inline bool parallel_for(
+    const Index loop_size,
+    const PrepFunctionType & prep_func,
+    const FunctionType & func,
+    const AccumFunctionType & accum_func,
+    const ParallelForPolicy & policy);
 }
 
 // Implementation
 
-#include "default_num_threads.h"
+#include "ThreadPool.h"
 
-#include <cmath>
 #include <cassert>
-#include <thread>
-#include <vector>
 #include <algorithm>
 
 template<typename Index, typename FunctionType >
@@ -143,17 +198,46 @@ inline bool igl::parallel_for(
   const FunctionType & func,
   const AccumFunctionType & accum_func,
   const size_t min_parallel)
+{
+  ParallelForPolicy policy;
+  policy.min_parallel = min_parallel;
+  return parallel_for(loop_size,prep_func,func,accum_func,policy);
+}
+
+template<typename Index, typename FunctionType >
+inline bool igl::parallel_for(
+  const Index loop_size,
+  const FunctionType & func,
+  const ParallelForPolicy & policy)
+{
+  const auto & no_op = [](const size_t /*n/t*/){};
+  const auto & wrapper = [&func](Index i,size_t /*t*/){ func(i); };
+  return parallel_for(loop_size,no_op,wrapper,no_op,policy);
+}
+
+template<
+  typename Index,
+  typename PreFunctionType,
+  typename FunctionType,
+  typename AccumFunctionType>
+inline bool igl::parallel_for(
+  const Index loop_size,
+  const PreFunctionType & prep_func,
+  const FunctionType & func,
+  const AccumFunctionType & accum_func,
+  const ParallelForPolicy & policy)
 {
   assert(loop_size>=0);
   if(loop_size==0) return false;
-  // Estimate number of threads in the pool
-  // http://ideone.com/Z7zldb
+  // Number of threads in the pool, possibly capped by the policy
 #ifdef IGL_PARALLEL_FOR_FORCE_SERIAL
   const size_t nthreads = 1;
 #else
-  const size_t nthreads = igl::default_num_threads();
+  const size_t pool_threads = igl::default_thread_pool().num_threads();
+  const size_t nthreads = policy.max_concurrency == 0 ?
+    pool_threads : std::min(policy.max_concurrency,pool_threads);
 #endif
-  if(loop_size<min_parallel || nthreads<=1)
+  if(static_cast<size_t>(loop_size)<policy.min_parallel || nthreads<=1)
   {
     // serial
     prep_func(1);
@@ -162,38 +246,23 @@ inline bool igl::parallel_for(
     return false;
   }else
   {
-    // Size of a slice for the range functions
-    Index slice =
-      std::max(
-        (Index)std::round((loop_size+1)/static_cast<double>(nthreads)),(Index)1);
-
-    // [Helper] Inner loop
-    const auto & range = [&func](const Index k1, const Index k2, const size_t t)
-    {
-      for(Index k = k1; k < k2; k++) func(k,t);
-    };
     prep_func(nthreads);
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(nthreads);
-    // Inner range extents
-    Index i1 = 0;
-    Index i2 = std::min(0 + slice, loop_size);
-    {
-      size_t t = 0;
-      for (; t+1 < nthreads && i1 < loop_size; ++t)
-      {
-        pool.emplace_back(range, i1, i2, t);
-        i1 = i2;
-        i2 = std::min(i2 + slice, loop_size);
-      }
-      if (i1 < loop_size)
+    // By default cut the loop into several chunks per thread so that uneven
+    // iterations balance out across the persistent pool.
+    const size_t grain = policy.grain_size > 0 ? policy.grain_size :
+      std::max(static_cast<size_t>(loop_size)/(8*nthreads),(size_t)1);
+    igl::default_thread_pool().run(
+      static_cast<size_t>(loop_size),
+      grain,
+      nthreads,
+      [&func](const size_t k1, const size_t k2, const size_t t)
       {
-        pool.emplace_back(range, i1, loop_size, t);
-      }
-    }
-    // Wait for jobs to finish
-    for (std::thread &t : pool) if (t.joinable()) t.join();
+        for(Index k = static_cast<Index>(k1); k < static_cast<Index>(k2); k++)
+        {
+          func(k,t);
+        }
+      },
+      policy.schedule);
     // Accumulate across threads
     for(size_t t = 0;t<nthreads;t++)
     {
@@ -13,6 +13,7 @@
 
 namespace igl
 {
+  template <typename DerivedV, int DIM> class AABB;
   /// Compute distances from a set of points P to a triangle mesh (V,F)
   ///
   /// @param[in] P  #P by 3 list of query point positions
@@ -59,6 +60,42 @@ namespace igl
     Eigen::PlainObjectBase<DerivedsqrD> &sqrD,
     Eigen::PlainObjectBase<DerivedI> &I,
     Eigen::PlainObjectBase<DerivedC> &C);
+  /// Mixed-precision variant: the hierarchy is built over (and traversed
+  /// with) a lower precision copy Vf of V, e.g., single precision to halve
+  /// its memory footprint and double the SIMD width of box tests. Only the
+  /// distance to the primitive found in the low precision pass is
+  /// recomputed in the precision of V.
+  ///
+  /// @param[in] P  #P by dim list of query point positions
+  /// @param[in] V  #V by dim list of vertex positions
+  /// @param[in] Ele  #Ele by (3|2|1) list of (triangle|edge|point) indices
+  /// @param[in] Vf  #V by dim list of vertex positions used to build tree,
+  ///   e.g., V.cast<float>()
+  /// @param[in] tree  hierarchy built for (Vf,Ele)
+  /// @param[out] sqrD  #P list of squared distances to primitives I in the
+  ///   precision of V
+  /// @param[out] I  #P list of primitive indices closest up to the precision
+  ///   of Vf
+  /// @param[out] C  #P by dim list of closest points on primitives I in
+  ///   the precision of V
+  template <
+    typename DerivedP,
+    typename DerivedV,
+    typename DerivedEle,
+    typename DerivedVf,
+    int DIM,
+    typename DerivedsqrD,
+    typename DerivedI,
+    typename DerivedC>
+  IGL_INLINE void point_mesh_squared_distance(
+    const Eigen::MatrixBase<DerivedP> &P,
+    const Eigen::MatrixBase<DerivedV> &V,
+    const Eigen::MatrixBase<DerivedEle> &Ele,
+    const Eigen::MatrixBase<DerivedVf> &Vf,
+    const igl::AABB<DerivedVf,DIM> &tree,
+    Eigen::PlainObjectBase<DerivedsqrD> &sqrD,
+    Eigen::PlainObjectBase<DerivedI> &I,
+    Eigen::PlainObjectBase<DerivedC> &C);
 }
 
 #ifndef IGL_STATIC_LIBRARY
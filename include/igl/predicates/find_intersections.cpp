@@ -16,11 +16,13 @@
 #include "../placeholders.h"
 #include "triangle_triangle_intersect.h"
 #include "../triangle_triangle_intersect.h"
+#include "../dual_tree_traversal.h"
 #include <stdio.h>
-// atomic
-#include <igl/parallel_for.h>
+#include <algorithm>
 #include <atomic>
-#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 template <
   typename DerivedV1,
@@ -33,6 +35,7 @@ IGL_INLINE bool igl::predicates::find_intersections(
   const igl::AABB<DerivedV1,3> & tree1,
   const Eigen::MatrixBase<DerivedV1> & V1,
   const Eigen::MatrixBase<DerivedF1> & F1,
+  const igl::AABB<DerivedV2,3> & tree2,
   const Eigen::MatrixBase<DerivedV2> & V2,
   const Eigen::MatrixBase<DerivedF2> & F2,
   const bool first_only,
@@ -41,7 +44,6 @@ IGL_INLINE bool igl::predicates::find_intersections(
 {
   const bool detect_only = true;
   constexpr bool stinker = false;
-  using AABBTree=igl::AABB<DerivedV1,3>;
   using Scalar=typename DerivedV1::Scalar;
   static_assert(
     std::is_same<Scalar,typename DerivedV2::Scalar>::value,
@@ -52,22 +54,9 @@ IGL_INLINE bool igl::predicates::find_intersections(
   const bool self_test = (&V1 == &V2) && (&F1 == &F2);
   if(stinker){ printf("%s\n",self_test?"🍎&(V1,F1) == 🍎&(V2,F2)":"🍎≠🍊"); }
 
-  int num_if = 0;
-  // mutex
-  std::mutex append_mutex;
-  const auto append_intersection = 
-    [&IF,&CP,&num_if,&append_mutex]( const int f1, const int f2, const bool coplanar = false)
-  {
-    std::lock_guard<std::mutex> lock(append_mutex);
-    if(num_if >= IF.rows())
-    {
-      IF.conservativeResize(2*IF.rows()+1,2);
-      CP.conservativeResize(IF.rows());
-    }
-    CP(num_if) = coplanar;
-    IF.row(num_if) << f1,f2;
-    num_if++;
-  };
+  // Each thread appends its own intersections (f1,f2,coplanar)
+  std::vector<std::vector<std::tuple<int,int,bool> > > found;
+  std::atomic<bool> any_found(false);
 
   // Returns corner in ith face opposite of shared edge; -1 otherwise
   const auto shared_edge = [&F1](const int f, const int g)->int
@@ -107,109 +96,162 @@ IGL_INLINE bool igl::predicates::find_intersections(
     return false;
   };
 
-  RowVector3S dummy;
-
-  igl::parallel_for(F2.rows(),[&](const int f2)
+  // Test a pair of triangles with overlapping boxes
+  const auto test_pair = [&](const int f1, const int f2, const size_t t)
   {
     if(stinker){ printf("f2: %d\n",f2); }
-    Eigen::AlignedBox<Scalar,3> box;
-    box.extend( V2.row( F2(f2,0) ).transpose() );
-    box.extend( V2.row( F2(f2,1) ).transpose() );
-    box.extend( V2.row( F2(f2,2) ).transpose() );
-    std::vector<const AABBTree*> candidates;
-    tree1.append_intersecting_leaves(box, candidates);
-    for(const auto * candidate : candidates)
+    const auto append_intersection = 
+      [&found,&any_found,t](const int f1, const int f2, const bool coplanar)
+    {
+      found[t].emplace_back(f1,f2,coplanar);
+      any_found = true;
+    };
+    if(stinker){ printf("  f1: %d\n",f1); }
+    bool found_intersection = false;
+    bool yes_shared_verted = false;
+    bool yes_shared_edge = false;
+    if(self_test)
     {
-      const int f1 = candidate->m_primitive;
-      if(stinker){ printf("  f1: %d\n",f1); }
-      bool found_intersection = false;
-      bool yes_shared_verted = false;
-      bool yes_shared_edge = false;
-      if(self_test)
+      // Skip self-test and direction f2>=f1 (assumes by symmetry we'll find
+      // the other direction since we're testing all pairs)
+      if(f1 >= f2)
       {
-        // Skip self-test and direction f2>=f1 (assumes by symmetry we'll find
-        // the other direction since we're testing all pairs)
-        if(f1 >= f2)
+        if(stinker){ printf("    ⏭\n"); }
+        return;
+      }
+      const int c = shared_edge(f1,f2);
+      yes_shared_edge = c != -1;
+      if(yes_shared_edge)
+      {
+        if(stinker){ printf("    ⚠️  shared edge\n"); }
+        if(stinker)
         {
-          if(stinker){ printf("    ⏭\n"); }
-          continue;
+          printf("    %d: %d %d %d\n",f1,F1(f1,0),F1(f1,1),F1(f1,2));
+          printf("    %d: %d %d %d\n",f2,F1(f2,0),F1(f2,1),F1(f2,2));
+          printf("   edge: %d %d\n",F1(f1,(c+1)%3),F1(f1,(c+2)%3));
         }
-        const int c = shared_edge(f1,f2);
-        yes_shared_edge = c != -1;
-        if(yes_shared_edge)
+        found_intersection = igl::triangle_triangle_intersect_shared_edge(
+          V1,F1,f1,c,V1.row(F1(f1,c)),f2,1e-8);
+        if(found_intersection)
         {
-          if(stinker){ printf("    ⚠️  shared edge\n"); }
-          if(stinker)
-          {
-            printf("    %d: %d %d %d\n",f1,F1(f1,0),F1(f1,1),F1(f1,2));
-            printf("    %d: %d %d %d\n",f2,F1(f2,0),F1(f2,1),F1(f2,2));
-            printf("   edge: %d %d\n",F1(f1,(c+1)%3),F1(f1,(c+2)%3));
-          }
-          found_intersection = igl::triangle_triangle_intersect_shared_edge(
-            V1,F1,f1,c,V1.row(F1(f1,c)),f2,1e-8);
-          if(found_intersection)
-          {
-            append_intersection(f1,f2,true);
-          }
-        }else
+          append_intersection(f1,f2,true);
+        }
+      }else
+      {
+        int sf,sg;
+        yes_shared_verted = shared_vertex(f1,f2,sf,sg);
+        if(yes_shared_verted)
         {
-          int sf,sg;
-          yes_shared_verted = shared_vertex(f1,f2,sf,sg);
-          if(yes_shared_verted)
+          if(stinker){ printf("    ⚠️  shared vertex\n"); }
+          // Just to be sure. c≠sf
+          const int c = (sf+1)%3;
+          assert(F1(f1,sf) == F1(f2,sg));
+          found_intersection = igl::triangle_triangle_intersect_shared_vertex(
+            V1,F1,f1,sf,c,V1.row(F1(f1,c)),f2,sg,1e-14);
+          if(found_intersection && detect_only)
           {
-            if(stinker){ printf("    ⚠️  shared vertex\n"); }
-            // Just to be sure. c≠sf
-            const int c = (sf+1)%3;
-            assert(F1(f1,sf) == F1(f2,sg));
-            found_intersection = igl::triangle_triangle_intersect_shared_vertex(
-              V1,F1,f1,sf,c,V1.row(F1(f1,c)),f2,sg,1e-14);
-            if(found_intersection && detect_only)
-            {
-              // But wait? Couldn't these be coplanar?
-              append_intersection(f1,f2,false);
-            }
+            // But wait? Couldn't these be coplanar?
+            append_intersection(f1,f2,false);
           }
-          
         }
+        
       }
-      // This logic is confusing. 
-      if(
-        !self_test || 
-        (!yes_shared_verted && !yes_shared_edge) || 
-        (yes_shared_verted && found_intersection && !detect_only))
+    }
+    // This logic is confusing. 
+    if(
+      !self_test || 
+      (!yes_shared_verted && !yes_shared_edge) || 
+      (yes_shared_verted && found_intersection && !detect_only))
+    {
+      bool coplanar = false;
+      RowVector3S v1,v2;
+      const bool tt_found_intersection = 
+        triangle_triangle_intersect(
+          V2.row(F2(f2,0)).template head<3>().eval(),
+          V2.row(F2(f2,1)).template head<3>().eval(),
+          V2.row(F2(f2,2)).template head<3>().eval(),
+          V1.row(F1(f1,0)).template head<3>().eval(),
+          V1.row(F1(f1,1)).template head<3>().eval(),
+          V1.row(F1(f1,2)).template head<3>().eval(),
+          coplanar);
+      if(found_intersection && !tt_found_intersection)
       {
-        bool coplanar = false;
-        RowVector3S v1,v2;
-        const bool tt_found_intersection = 
-          triangle_triangle_intersect(
-            V2.row(F2(f2,0)).template head<3>().eval(),
-            V2.row(F2(f2,1)).template head<3>().eval(),
-            V2.row(F2(f2,2)).template head<3>().eval(),
-            V1.row(F1(f1,0)).template head<3>().eval(),
-            V1.row(F1(f1,1)).template head<3>().eval(),
-            V1.row(F1(f1,2)).template head<3>().eval(),
-            coplanar);
-        if(found_intersection && !tt_found_intersection)
-        {
-          // We failed to find the edge. Mark it as an intersection but don't
-          // include edge.
-          append_intersection(f1,f2,coplanar);
-        }else if(tt_found_intersection)
-        {
-          found_intersection = true;
-          append_intersection(f1,f2,coplanar);
-        }
+        // We failed to find the edge. Mark it as an intersection but don't
+        // include edge.
+        append_intersection(f1,f2,coplanar);
+      }else if(tt_found_intersection)
+      {
+        found_intersection = true;
+        append_intersection(f1,f2,coplanar);
       }
-      if(stinker) { printf("    %s\n",found_intersection? "☠️":"❌"); }
-      if(num_if && first_only) { return; }
     }
-    if(num_if && first_only) { return; }
-  },1000);
-  IF.conservativeResize(num_if,2);
-  CP.conservativeResize(IF.rows());
+    if(stinker) { printf("    %s\n",found_intersection? "☠️":"❌"); }
+  };
+
+  // Only pairs of triangles with overlapping boxes are tested
+  igl::dual_tree_traversal(
+    tree1,tree2,
+    [&found](const size_t n){ found.resize(n); },
+    [&](
+      const Eigen::AlignedBox<Scalar,3> & box1,
+      const Eigen::AlignedBox<Scalar,3> & box2)->bool
+    {
+      return
+        !(first_only && any_found.load(std::memory_order_relaxed)) &&
+        box1.intersects(box2);
+    },
+    test_pair);
+
+  // Gather in a deterministic order
+  std::vector<std::tuple<int,int,bool> > all;
+  for(const auto & found_t : found)
+  {
+    all.insert(all.end(),found_t.begin(),found_t.end());
+  }
+  std::sort(all.begin(),all.end());
+  IF.resize(all.size(),2);
+  CP.resize(all.size());
+  for(int i = 0;i<static_cast<int>(all.size());i++)
+  {
+    IF(i,0) = std::get<0>(all[i]);
+    IF(i,1) = std::get<1>(all[i]);
+    CP(i) = std::get<2>(all[i]);
+  }
   return IF.rows();
 }
 
+template <
+  typename DerivedV1,
+  typename DerivedF1,
+  typename DerivedV2,
+  typename DerivedF2,
+  typename DerivedIF,
+  typename DerivedCP >
+IGL_INLINE bool igl::predicates::find_intersections(
+  const igl::AABB<DerivedV1,3> & tree1,
+  const Eigen::MatrixBase<DerivedV1> & V1,
+  const Eigen::MatrixBase<DerivedF1> & F1,
+  const Eigen::MatrixBase<DerivedV2> & V2,
+  const Eigen::MatrixBase<DerivedF2> & F2,
+  const bool first_only,
+  Eigen::PlainObjectBase<DerivedIF> & IF,
+  Eigen::PlainObjectBase<DerivedCP> & CP)
+{
+  // Self-intersection: tree1 is already the tree of (V2,F2)
+  if constexpr(
+    std::is_same<DerivedV1,DerivedV2>::value &&
+    std::is_same<DerivedF1,DerivedF2>::value)
+  {
+    if(&V1 == &V2 && &F1 == &F2)
+    {
+      return find_intersections(tree1,V1,F1,tree1,V2,F2,first_only,IF,CP);
+    }
+  }
+  igl::AABB<DerivedV2,3> tree2;
+  tree2.init(V2,F2);
+  return find_intersections(tree1,V1,F1,tree2,V2,F2,first_only,IF,CP);
+}
+
 template <
   typename DerivedV1,
   typename DerivedF1,
@@ -289,6 +331,7 @@ IGL_INLINE bool igl::predicates::find_intersections(
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template bool igl::predicates::find_intersections<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Array<bool, -1, 1, 0, -1, 1> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Array<bool, -1, 1, 0, -1, 1> >&);
 // generated by autoexplicit.sh
 template bool igl::predicates::find_intersections<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Array<bool, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Array<bool, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 // generated by autoexplicit.sh
@@ -24,11 +24,43 @@ namespace igl
     /// @param[in] F1  #F1 by 3 list representing triangles on the first mesh
     /// @param[in] V2  #V2 by 3 list representing vertices on the second mesh
     /// @param[in] F2  #F2 by 3 list representing triangles on the second mesh
+    /// @param[in] first_only  whether to stop once any intersection is found
     /// @param[out] IF #IF by 2 list of intersecting triangle pairs, so that 
     ///   F1(IF(i,0),:) intersects F2(IF(i,1),:)
     /// @param[out] CP #IF list of whether the intersection is coplanar
+    /// @return whether any intersections were found
     ///
-    /// \see copyleft::cgal::intersect_other
+    /// The AABB tree for the second mesh is built internally, unless (V2,F2)
+    /// are the very same objects as (V1,F1) in which case tree1 is reused.
+    /// Pairs in IF are sorted.
+    ///
+    /// \see copyleft::cgal::intersect_other, dual_tree_traversal
+    template <
+      typename DerivedV1,
+      typename DerivedF1,
+      typename DerivedV2,
+      typename DerivedF2,
+      typename DerivedIF,
+      typename DerivedCP>
+    IGL_INLINE bool find_intersections(
+      const AABB<DerivedV1,3> & tree1,
+      const Eigen::MatrixBase<DerivedV1> & V1,
+      const Eigen::MatrixBase<DerivedF1> & F1,
+      const Eigen::MatrixBase<DerivedV2> & V2,
+      const Eigen::MatrixBase<DerivedF2> & F2,
+      const bool first_only,
+      Eigen::PlainObjectBase<DerivedIF> & IF,
+      Eigen::PlainObjectBase<DerivedCP> & CP);
+    /// \overload
+    /// \brief Both trees given, e.g., for repeated collision checks between
+    /// meshes that are each refit as they move.
+    ///
+    /// Both hierarchies are traversed simultaneously so that only pairs of
+    /// triangles with overlapping boxes are visited, in parallel. This is
+    /// much cheaper than querying every triangle of (V2,F2) when the meshes
+    /// only overlap in small regions.
+    ///
+    /// @param[in] tree2 AABB tree for the second mesh
     template <
       typename DerivedV1,
       typename DerivedF1,
@@ -40,6 +72,7 @@ namespace igl
       const AABB<DerivedV1,3> & tree1,
       const Eigen::MatrixBase<DerivedV1> & V1,
       const Eigen::MatrixBase<DerivedF1> & F1,
+      const AABB<DerivedV2,3> & tree2,
       const Eigen::MatrixBase<DerivedV2> & V2,
       const Eigen::MatrixBase<DerivedF2> & F2,
       const bool first_only,
@@ -0,0 +1,142 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "readAABB.h"
+#include "MappedAABB.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  // Copy a row-major rows by cols array of T from data into M
+  template <typename T, typename DerivedM>
+  void readAABB_copy(
+    const unsigned char * data,
+    const std::uint64_t rows,
+    const std::uint64_t cols,
+    Eigen::PlainObjectBase<DerivedM> & M)
+  {
+    typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>
+      MatrixXT;
+    M = Eigen::Map<const MatrixXT>(
+      reinterpret_cast<const T *>(data),rows,cols)
+      .template cast<typename DerivedM::Scalar>();
+  }
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename Derivedleaf>
+IGL_INLINE bool igl::readAABB(
+  const std::string & filename,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedB> & B1,
+  Eigen::PlainObjectBase<DerivedB> & B2,
+  Eigen::PlainObjectBase<Derivedleaf> & leaf)
+{
+  FILE * fp = fopen(filename.c_str(),"rb");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"IOError: readAABB() could not open %s\n",filename.c_str());
+    return false;
+  }
+  fseek(fp,0,SEEK_END);
+  const long file_size = ftell(fp);
+  fseek(fp,0,SEEK_SET);
+  std::vector<unsigned char> buffer(
+    file_size > 0 ? static_cast<std::size_t>(file_size) : 0);
+  const bool read_ok =
+    fread(buffer.data(),1,buffer.size(),fp) == buffer.size();
+  fclose(fp);
+  AABBFileHeader header;
+  if(!read_ok || buffer.size() < sizeof(AABBFileHeader))
+  {
+    fprintf(stderr,"IOError: readAABB() could not read %s\n",filename.c_str());
+    return false;
+  }
+  std::memcpy(&header,buffer.data(),sizeof(AABBFileHeader));
+  if(!header.valid(buffer.size()))
+  {
+    fprintf(stderr,"Error: readAABB() %s is not a valid .aabb file\n",filename.c_str());
+    return false;
+  }
+  if(header.checksum != AABBFileHeader::compute_checksum(
+    buffer.data()+sizeof(AABBFileHeader),
+    buffer.size()-sizeof(AABBFileHeader)))
+  {
+    fprintf(stderr,"Error: readAABB() %s checksum mismatch\n",filename.c_str());
+    return false;
+  }
+  const unsigned char * data = buffer.data();
+  if(header.scalar_size == 8)
+  {
+    readAABB_copy<double>(data+header.offset_V,header.num_V,header.dim,V);
+    readAABB_copy<double>(data+header.offset_B1,header.num_B,header.dim,B1);
+    readAABB_copy<double>(data+header.offset_B2,header.num_B,header.dim,B2);
+  }else
+  {
+    readAABB_copy<float>(data+header.offset_V,header.num_V,header.dim,V);
+    readAABB_copy<float>(data+header.offset_B1,header.num_B,header.dim,B1);
+    readAABB_copy<float>(data+header.offset_B2,header.num_B,header.dim,B2);
+  }
+  if(header.index_size == 8)
+  {
+    readAABB_copy<std::int64_t>(
+      data+header.offset_F,header.num_F,header.simplex_size,F);
+    readAABB_copy<std::int64_t>(data+header.offset_leaf,header.num_B,1,leaf);
+  }else
+  {
+    readAABB_copy<std::int32_t>(
+      data+header.offset_F,header.num_F,header.simplex_size,F);
+    readAABB_copy<std::int32_t>(data+header.offset_leaf,header.num_B,1,leaf);
+  }
+  return true;
+}
+
+template <
+  typename DerivedV,
+  int DIM,
+  typename DerivedF>
+IGL_INLINE bool igl::readAABB(
+  const std::string & filename,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F,
+  igl::AABB<DerivedV,DIM> & tree)
+{
+  using Scalar = typename DerivedV::Scalar;
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> B1,B2;
+  Eigen::VectorXi leaf;
+  if(!readAABB(filename,V,F,B1,B2,leaf))
+  {
+    return false;
+  }
+  if(leaf.size() > 0 && (V.cols() != DIM || B1.cols() != DIM))
+  {
+    fprintf(stderr,"Error: readAABB() %s is not %d-dimensional\n",
+      filename.c_str(),DIM);
+    return false;
+  }
+  tree.clear();
+  if(leaf.size() > 0)
+  {
+    tree.init(V,F,B1,B2,leaf);
+  }
+  return true;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::readAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(std::string const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template bool igl::readAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(std::string const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 1, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 1, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>>&);
+template bool igl::readAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(std::string const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>&);
+template bool igl::readAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(std::string const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>&);
+#endif
@@ -0,0 +1,62 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_READAABB_H
+#define IGL_READAABB_H
+#include "igl_inline.h"
+#include "AABB.h"
+#include <Eigen/Core>
+#include <string>
+
+namespace igl
+{
+  /// Read a mesh and its bounding box hierarchy from an .aabb file (see
+  /// MappedAABB.h for the format) into owned matrices, converting scalar
+  /// and index widths as needed. Use MappedAABB instead to query the file
+  /// in place.
+  ///
+  /// @param[in] filename  path to .aabb file
+  /// @param[out] V  #V by dim list of vertex positions
+  /// @param[out] F  #F by ss list of simplex indices into V
+  /// @param[out] B1  #B by dim list of node minimum corners
+  /// @param[out] B2  #B by dim list of node maximum corners
+  /// @param[out] leaf  #B list of primitive indices into F (-1 internal, -2
+  ///   empty)
+  /// @return true on success (valid header and checksum)
+  ///
+  /// \see writeAABB, MappedAABB
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedB,
+    typename Derivedleaf>
+  IGL_INLINE bool readAABB(
+    const std::string & filename,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedB> & B1,
+    Eigen::PlainObjectBase<DerivedB> & B2,
+    Eigen::PlainObjectBase<Derivedleaf> & leaf);
+  /// \overload
+  ///
+  /// @param[out] tree  hierarchy for (V,F) restored without rebuilding
+  template <
+    typename DerivedV,
+    int DIM,
+    typename DerivedF>
+  IGL_INLINE bool readAABB(
+    const std::string & filename,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    igl::AABB<DerivedV,DIM> & tree);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "readAABB.cpp"
+#endif
+
+#endif
@@ -1,12 +1,145 @@
 #include "sparse_voxel_grid.h"
+#include "parallel_for.h"
 
-#include <unordered_map>
+#include <algorithm>
 #include <array>
-#include <vector>
+#include <atomic>
+#include <cassert>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  // Open-addressing hash map from non-negative 64-bit keys to int values.
+  // insert and find may be called concurrently; reserve may not.
+  class ConcurrentKeyMap
+  {
+  public:
+    static constexpr std::int64_t empty = -1;
+    static constexpr size_t npos = size_t(-1);
+    // Make room for n more keys (keeping the load below 1/2)
+    void reserve(const size_t n)
+    {
+      size_t capacity = std::max<size_t>(16,capacity_);
+      while(2*(count_+n) > capacity) { capacity *= 2; }
+      if(capacity == capacity_) { return; }
+      std::unique_ptr<std::atomic<std::int64_t>[]> old_keys = std::move(keys_);
+      std::vector<int> old_values = std::move(values_);
+      const size_t old_capacity = capacity_;
+      capacity_ = capacity;
+      keys_.reset(new std::atomic<std::int64_t>[capacity_]);
+      for(size_t i = 0;i<capacity_;i++)
+      {
+        keys_[i].store(empty,std::memory_order_relaxed);
+      }
+      values_.assign(capacity_,-1);
+      count_ = 0;
+      for(size_t i = 0;i<old_capacity;i++)
+      {
+        const std::int64_t key = old_keys[i].load(std::memory_order_relaxed);
+        if(key != empty)
+        {
+          values_[insert(key).first] = old_values[i];
+        }
+      }
+    }
+    // Returns slot of key and whether this call inserted it
+    std::pair<size_t,bool> insert(const std::int64_t key)
+    {
+      assert(key >= 0);
+      for(size_t i = hash(key);;i = (i+1) & (capacity_-1))
+      {
+        std::int64_t expected = keys_[i].load(std::memory_order_relaxed);
+        if(expected == key) { return {i,false}; }
+        if(expected == empty)
+        {
+          if(keys_[i].compare_exchange_strong(expected,key))
+          {
+            count_++;
+            return {i,true};
+          }
+          if(expected == key) { return {i,false}; }
+        }
+      }
+    }
+    size_t find(const std::int64_t key) const
+    {
+      for(size_t i = hash(key);;i = (i+1) & (capacity_-1))
+      {
+        const std::int64_t k = keys_[i].load(std::memory_order_relaxed);
+        if(k == key) { return i; }
+        if(k == empty) { return npos; }
+      }
+    }
+    int & value(const size_t slot) { return values_[slot]; }
+    int value(const size_t slot) const { return values_[slot]; }
+  private:
+    size_t hash(std::int64_t key) const
+    {
+      // splitmix64 finalizer
+      std::uint64_t z = static_cast<std::uint64_t>(key) + 0x9e3779b97f4a7c15ull;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return static_cast<size_t>(z ^ (z >> 31)) & (capacity_-1);
+    }
+    std::unique_ptr<std::atomic<std::int64_t>[]> keys_;
+    std::vector<int> values_;
+    size_t capacity_ = 0;
+    std::atomic<size_t> count_{0};
+  };
 
+  // Pack integer grid subscripts (each within ±2^20) into a non-negative key
+  inline std::int64_t sparse_voxel_grid_key(const Eigen::RowVector3i & q)
+  {
+    const std::int64_t bias = std::int64_t(1) << 20;
+    assert((q.array().abs() < bias).all() && "sparse_voxel_grid: too far from p0");
+    return
+      (std::int64_t(q(0)) + bias) |
+      ((std::int64_t(q(1)) + bias) << 21) |
+      ((std::int64_t(q(2)) + bias) << 42);
+  }
+  // Whether cube pi and all of its corners have subscripts that can be
+  // packed by sparse_voxel_grid_key
+  inline bool sparse_voxel_grid_in_range(const Eigen::RowVector3i & pi)
+  {
+    const int bias = 1 << 20;
+    return (pi.array() > -bias).all() && (pi.array() < bias-1).all();
+  }
+  inline Eigen::RowVector3i sparse_voxel_grid_subscripts(const std::int64_t key)
+  {
+    const std::int64_t bias = std::int64_t(1) << 20;
+    const std::int64_t mask = (std::int64_t(1) << 21) - 1;
+    return Eigen::RowVector3i(
+      int((key & mask) - bias),
+      int(((key >> 21) & mask) - bias),
+      int(((key >> 42) & mask) - bias));
+  }
+
+  // Gather thread-local lists into one sorted list (sorted so that results do
+  // not depend on the number of threads)
+  inline void sparse_voxel_grid_gather(
+    std::vector<std::vector<std::int64_t> > & local,
+    std::vector<std::int64_t> & all)
+  {
+    all.clear();
+    for(auto & l : local)
+    {
+      all.insert(all.end(),l.begin(),l.end());
+      l.clear();
+    }
+    std::sort(all.begin(),all.end());
+  }
+}
 
-template <typename DerivedP0, typename Func, typename DerivedS, typename DerivedV, typename DerivedI>
+template <
+  bool batched,
+  typename DerivedP0,
+  typename Func,
+  typename DerivedS,
+  typename DerivedV,
+  typename DerivedI>
 IGL_INLINE void igl::sparse_voxel_grid(const Eigen::MatrixBase<DerivedP0>& p0,
                                        const Func& scalarFunc,
                                        const double eps,
@@ -17,187 +150,186 @@ IGL_INLINE void igl::sparse_voxel_grid(const Eigen::MatrixBase<DerivedP0>& p0,
 {
   typedef typename DerivedV::Scalar ScalarV;
   typedef typename DerivedS::Scalar ScalarS;
-  typedef typename DerivedI::Scalar ScalarI;
   typedef Eigen::Matrix<ScalarV, 1, 3> VertexRowVector;
-  typedef Eigen::Matrix<ScalarI, 1, 8> IndexRowVector;
-
-
-  struct IndexRowVectorHash {
-    std::size_t operator()(const Eigen::RowVector3i& key) const {
-      std::size_t seed = 0;
-      std::hash<int> hasher;
-      for (int i = 0; i < 3; i++) {
-        seed ^= hasher(key[i]) + 0x9e3779b9 + (seed<<6) + (seed>>2); // Copied from boost::hash_combine
-      }
-      return seed;
-    }
-  };
+  typedef Eigen::Matrix<ScalarV, Eigen::Dynamic, 3, Eigen::RowMajor> MatrixV;
+  typedef Eigen::Matrix<ScalarS, Eigen::Dynamic, 1> VectorS;
 
   auto sgn = [](ScalarS val) -> int {
     return (ScalarS(0) < val) - (val < ScalarS(0));
   };
 
-  ScalarV half_eps = 0.5 * eps;
+  const ScalarV half_eps = 0.5 * eps;
+  const VertexRowVector p0_row = p0.template cast<ScalarV>();
 
-  std::vector<IndexRowVector> CI_vector;
-  std::vector<VertexRowVector> CV_vector;
-  std::vector<ScalarS> CS_vector;
-  CI_vector.reserve(expected_number_of_cubes);
-  CV_vector.reserve(8 * expected_number_of_cubes);
-  CS_vector.reserve(8 * expected_number_of_cubes);
+  // Cube corners are ordered y-x-z, so their xyz offsets are:
+  //
+  // +++
+  // ++-
+  // -+-
+  // -++
+  // +-+
+  // +--
+  // ---
+  // --+
+  //
+  // (with z flipped). Corner c of cube pi has subscripts pi + corner_offset[c]
+  // in the grid of corners and lies at p0 + eps*(pi + corner_offset[c]) -
+  // eps/2.
+  const std::array<Eigen::RowVector3i,8> corner_offset = {{
+    {1,1,0},{1,1,1},{0,1,1},{0,1,0},{1,0,0},{1,0,1},{0,0,1},{0,0,0}}};
+  // Face, edge and vertex neighbors
+  std::array<Eigen::RowVector3i,26> neighbors;
+  {
+    int n = 0;
+    for(int x = -1;x<=1;x++)
+    for(int y = -1;y<=1;y++)
+    for(int z = -1;z<=1;z++)
+    {
+      if(x != 0 || y != 0 || z != 0) { neighbors[n++] = {x,y,z}; }
+    }
+  }
 
-  // Track visisted neighbors
-  std::unordered_map<Eigen::RowVector3i, int, IndexRowVectorHash> visited;
+  // Cubes already queued (valid or not) and corners already evaluated
+  ConcurrentKeyMap visited, corner_map;
   visited.reserve(6 * expected_number_of_cubes);
-  visited.max_load_factor(0.5);
-
-  // BFS Queue
-  std::vector<Eigen::RowVector3i> queue;
-  queue.reserve(expected_number_of_cubes * 8);
-  queue.push_back(Eigen::RowVector3i(0, 0, 0));
+  corner_map.reserve(4 * expected_number_of_cubes);
+  // Evaluated corner positions and values
+  std::vector<VertexRowVector> E_V;
+  std::vector<ScalarS> E_S;
+  // Valid cubes (as indices into E_V)
+  std::vector<std::array<int,8> > cubes;
+  cubes.reserve(expected_number_of_cubes);
 
-  while (queue.size() > 0)
+  // Level-synchronous breadth first search from the cube containing p0
+  std::vector<std::int64_t> frontier(1,sparse_voxel_grid_key({0,0,0}));
+  visited.insert(frontier[0]);
+  std::vector<std::vector<std::int64_t> > local;
+  const auto prep = [&local](const size_t nt){ local.resize(nt); };
+  const auto no_accum = [](const size_t){};
+  std::vector<std::int64_t> new_corners;
+  while(!frontier.empty())
   {
-    Eigen::RowVector3i pi = queue.back();
-    queue.pop_back();
-    if(visited.count(pi)){ continue; }
-
-    VertexRowVector ctr = p0 + eps*pi.cast<ScalarV>(); // R^3 center of this cube
-
-    // X, Y, Z basis vectors, and array of neighbor offsets used to construct cubes
-    const Eigen::RowVector3i bx(1, 0, 0), by(0, 1, 0), bz(0, 0, -1);
-    const std::array<Eigen::RowVector3i, 26> neighbors = {
-      bx, -bx, by, -by, bz, -bz,
-      by-bz, -by+bz, // 1-2 4-7
-      bx+by, -bx-by, // 0-1 7-6
-      by+bz, -by-bz, // 0-3 6-5
-      by-bx, -by+bx, // 2-3 5-4
-      bx-bz, -bx+bz, // 1-5 3-7
-      bx+bz, -bx-bz, // 0-4 2-6
-      -bx+by+bz, bx-by-bz, // 3 5
-      bx+by+bz, -bx-by-bz, // 0 6
-      bx+by-bz, -bx-by+bz, //1 7
-      -bx+by-bz, bx-by+bz, // 2 4,
-  };
-
-    // Compute the position of the cube corners and the scalar values at those corners
-    //
-    // Cube corners are ordered y-x-z, so their xyz offsets are:
-    //
-    // +++
-    // ++-
-    // -+-
-    // -++
-    // +-+
-    // +--
-    // ---
-    // --+
-    std::array<VertexRowVector, 8> cubeCorners = {
-      ctr+half_eps*(bx+by+bz).cast<ScalarV>(), ctr+half_eps*(bx+by-bz).cast<ScalarV>(), ctr+half_eps*(-bx+by-bz).cast<ScalarV>(), ctr+half_eps*(-bx+by+bz).cast<ScalarV>(),
-      ctr+half_eps*(bx-by+bz).cast<ScalarV>(), ctr+half_eps*(bx-by-bz).cast<ScalarV>(), ctr+half_eps*(-bx-by-bz).cast<ScalarV>(), ctr+half_eps*(-bx-by+bz).cast<ScalarV>()
-    };
-    std::array<ScalarS, 8> cubeScalars;
-    for (int i = 0; i < 8; i++) { cubeScalars[i] = scalarFunc(cubeCorners[i]); }
-
-    // If this cube doesn't intersect the surface, disregard it
-    bool validCube = false;
-    int sign = sgn(cubeScalars[0]);
-    for (int i = 1; i < 8; i++) {
-      if (sign != sgn(cubeScalars[i])) {
-        validCube = true;
-        break;
+    // Claim the corners of the frontier not evaluated yet
+    corner_map.reserve(8*frontier.size());
+    igl::parallel_for(frontier.size(),prep,[&](const size_t f, const size_t t)
+    {
+      const Eigen::RowVector3i pi = sparse_voxel_grid_subscripts(frontier[f]);
+      for(int c = 0;c<8;c++)
+      {
+        const std::int64_t key = sparse_voxel_grid_key(pi + corner_offset[c]);
+        if(corner_map.insert(key).second) { local[t].push_back(key); }
       }
-    }
-    if (!validCube) {
-      continue;
-    }
+    },no_accum,1000);
+    sparse_voxel_grid_gather(local,new_corners);
 
-    // Add the cube vertices and indices to the output arrays if they are not there already
-    IndexRowVector cube;
-    std::uint8_t vertexAlreadyAdded = 0; // This is a bimask. If a bit is 1, it has been visited already by the BFS
-    constexpr std::array<std::uint8_t, 26> zv = {
-      (1 << 0) | (1 << 1) | (1 << 4) | (1 << 5),
-      (1 << 2) | (1 << 3) | (1 << 6) | (1 << 7),
-      (1 << 0) | (1 << 1) | (1 << 2) | (1 << 3),
-      (1 << 4) | (1 << 5) | (1 << 6) | (1 << 7),
-      (1 << 0) | (1 << 3) | (1 << 4) | (1 << 7),
-      (1 << 1) | (1 << 2) | (1 << 5) | (1 << 6),
-      (1 << 1) | (1 << 2),
-      (1 << 4) | (1 << 7),
-      (1 << 0) | (1 << 1),
-      (1 << 6) | (1 << 7),
-      (1 << 0) | (1 << 3),
-      (1 << 5) | (1 << 6),
-      (1 << 2) | (1 << 3),
-      (1 << 4) | (1 << 5),
-      (1 << 1) | (1 << 5),
-      (1 << 3) | (1 << 7),
-      (1 << 0) | (1 << 4),
-      (1 << 2) | (1 << 6),
-      (1 << 3), (1 << 5), // diagonals
-      (1 << 0), (1 << 6),
-      (1 << 1), (1 << 7),
-      (1 << 2), (1 << 4),
-    };
-    constexpr std::array<std::array<int, 4>, 26> zvv {{
-      {{0, 1, 4, 5}}, {{3, 2, 7, 6}}, {{0, 1, 2, 3}},
-      {{4, 5, 6, 7}}, {{0, 3, 4, 7}}, {{1, 2, 5, 6}},
-      {{-1,-1,1,2}}, {{-1,-1,4,7}}, {{-1,-1,0,1}},{{-1,-1,7,6}},
-      {{-1,-1,0,3}}, {{-1,-1,5,6}}, {{-1,-1,2,3}}, {{-1,-1,5,4}},
-      {{-1,-1,1,5}}, {{-1,-1,3,7}}, {{-1,-1,0,4}}, {{-1,-1,2,6}},
-      {{-1,-1,-1,3}}, {{-1,-1,-1,5}}, {{-1,-1,-1,0}}, {{-1,-1,-1,6}},
-      {{-1,-1,-1,1}}, {{-1,-1,-1,7}}, {{-1,-1,-1,2}}, {{-1,-1,-1,4}} }};
-
-    for (int n = 0; n < 26; n++) { // For each neighbor, check the hash table to see if its been added before
-      Eigen::RowVector3i nkey = pi + neighbors[n];
-      auto nbr = visited.find(nkey);
-      if (nbr != visited.end()) { // We've already visited this neighbor, use references to its vertices instead of duplicating them
-        vertexAlreadyAdded |= zv[n];
-        for (int i = 0; i < 4; i++) 
-        {
-          if (zvv[n][i]!=-1)
-          {
-            cube[zvv[n][i]] = CI_vector[nbr->second][zvv[n % 2 == 0 ? n + 1 : n - 1][i]];
-          }
-        }
-      } else {
-        queue.push_back(nkey); // Otherwise, we have not visited the neighbor, put it in the BFS queue
-      }
+    // Evaluate the new corners
+    const size_t e0 = E_S.size();
+    E_V.resize(e0+new_corners.size());
+    E_S.resize(e0+new_corners.size());
+    MatrixV P(new_corners.size(),3);
+    igl::parallel_for(new_corners.size(),[&](const size_t i)
+    {
+      corner_map.value(corner_map.find(new_corners[i])) = int(e0+i);
+      const Eigen::RowVector3i q = sparse_voxel_grid_subscripts(new_corners[i]);
+      E_V[e0+i] = p0_row + eps*q.cast<ScalarV>() -
+        VertexRowVector::Constant(half_eps);
+      P.row(i) = E_V[e0+i];
+    },1000);
+    if constexpr (batched)
+    {
+      const VectorS S = scalarFunc(P);
+      assert(S.size() == P.rows());
+      std::copy(S.data(),S.data()+S.size(),E_S.begin()+e0);
+    }else
+    {
+      igl::parallel_for(new_corners.size(),[&](const size_t i)
+      {
+        E_S[e0+i] = scalarFunc(E_V[e0+i]);
+      },1000);
     }
 
-    for (int i = 0; i < 8; i++) { // Add new, non-visited,2 vertices to the arrays
-      if (0 == ((1 << i) & vertexAlreadyAdded)) {
-        cube[i] = CS_vector.size();
-        CV_vector.push_back(cubeCorners[i]);
-        CS_vector.push_back(cubeScalars[i]);
+    // Keep cubes crossing the surface
+    std::vector<std::array<int,8> > frontier_cubes(frontier.size());
+    std::vector<char> valid(frontier.size());
+    igl::parallel_for(frontier.size(),[&](const size_t f)
+    {
+      const Eigen::RowVector3i pi = sparse_voxel_grid_subscripts(frontier[f]);
+      for(int c = 0;c<8;c++)
+      {
+        frontier_cubes[f][c] = corner_map.value(corner_map.find(
+          sparse_voxel_grid_key(pi + corner_offset[c])));
+      }
+      valid[f] = false;
+      const int sign = sgn(E_S[frontier_cubes[f][0]]);
+      for(int c = 1;c<8;c++)
+      {
+        if(sign != sgn(E_S[frontier_cubes[f][c]])) { valid[f] = true; break; }
+      }
+    },1000);
+    std::vector<std::int64_t> valid_keys;
+    for(size_t f = 0;f<frontier.size();f++)
+    {
+      if(valid[f])
+      {
+        cubes.push_back(frontier_cubes[f]);
+        valid_keys.push_back(frontier[f]);
       }
     }
 
-    visited[pi] = CI_vector.size();
-    CI_vector.push_back(cube);
+    // Next frontier: unvisited neighbors of valid cubes
+    visited.reserve(26*valid_keys.size());
+    igl::parallel_for(valid_keys.size(),prep,[&](const size_t v, const size_t t)
+    {
+      const Eigen::RowVector3i pi = sparse_voxel_grid_subscripts(valid_keys[v]);
+      for(const auto & n : neighbors)
+      {
+        // The shell stops where keys would alias
+        if(!sparse_voxel_grid_in_range(pi + n)) { continue; }
+        const std::int64_t key = sparse_voxel_grid_key(pi + n);
+        if(visited.insert(key).second) { local[t].push_back(key); }
+      }
+    },no_accum,1000);
+    sparse_voxel_grid_gather(local,frontier);
   }
 
-  CV.conservativeResize(CV_vector.size(), 3);
-  CS.conservativeResize(CS_vector.size(), 1);
-  CI.conservativeResize(CI_vector.size(), 8);
-  // If you pass in column-major matrices, this is going to be slooooowwwww
-  for (int i = 0; i < CV_vector.size(); i++) {
-    CV.row(i) = CV_vector[i];
-  }
-  for (int i = 0; i < CS_vector.size(); i++) {
-    CS(i) = CS_vector[i];
-  }
-  for (int i = 0; i < CI_vector.size(); i++) {
-    CI.row(i) = CI_vector[i];
+  // Output only corners of valid cubes, in order of first reference
+  std::vector<int> E2C(E_S.size(),-1);
+  int num_corners = 0;
+  for(const auto & cube : cubes)
+  {
+    for(const int e : cube)
+    {
+      if(E2C[e] < 0) { E2C[e] = num_corners++; }
+    }
   }
+  CV.resize(num_corners, 3);
+  CS.resize(num_corners, 1);
+  CI.resize(cubes.size(), 8);
+  igl::parallel_for(E_S.size(),[&](const size_t e)
+  {
+    if(E2C[e] >= 0)
+    {
+      CV.row(E2C[e]) = E_V[e];
+      CS(E2C[e]) = E_S[e];
+    }
+  },1000);
+  igl::parallel_for(cubes.size(),[&](const size_t c)
+  {
+    for(int i = 0;i<8;i++)
+    {
+      CI(c,i) = E2C[cubes[c][i]];
+    }
+  },1000);
 }
 
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
-template void igl::sparse_voxel_grid<Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 8, 0, -1, 8> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&);
-template void igl::sparse_voxel_grid<class Eigen::Matrix<double, -1, -1, 0, -1, -1>, class std::function<double(class Eigen::Matrix<double, -1, -1, 0, -1, -1> const &)>, class Eigen::Matrix<double, -1, 1, 0, -1, 1>, class Eigen::Matrix<double, -1, -1, 0, -1, -1>, class Eigen::Matrix<int, -1, -1, 0, -1, -1> >(class Eigen::MatrixBase<class Eigen::Matrix<double, -1, -1, 0, -1, -1> > const &, class std::function<double(class Eigen::Matrix<double, -1, -1, 0, -1, -1> const &)> const &, double, int, class Eigen::PlainObjectBase<class Eigen::Matrix<double, -1, 1, 0, -1, 1> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<double, -1, -1, 0, -1, -1> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1> > &);
-template void igl::sparse_voxel_grid<Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
-template void igl::sparse_voxel_grid<Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sparse_voxel_grid<false, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 8, 0, -1, 8> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&);
+template void igl::sparse_voxel_grid<false, class Eigen::Matrix<double, -1, -1, 0, -1, -1>, class std::function<double(class Eigen::Matrix<double, -1, -1, 0, -1, -1> const &)>, class Eigen::Matrix<double, -1, 1, 0, -1, 1>, class Eigen::Matrix<double, -1, -1, 0, -1, -1>, class Eigen::Matrix<int, -1, -1, 0, -1, -1> >(class Eigen::MatrixBase<class Eigen::Matrix<double, -1, -1, 0, -1, -1> > const &, class std::function<double(class Eigen::Matrix<double, -1, -1, 0, -1, -1> const &)> const &, double, int, class Eigen::PlainObjectBase<class Eigen::Matrix<double, -1, 1, 0, -1, 1> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<double, -1, -1, 0, -1, -1> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1> > &);
+template void igl::sparse_voxel_grid<false, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sparse_voxel_grid<false, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sparse_voxel_grid<true, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 8, 0, -1, 8> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&);
+template void igl::sparse_voxel_grid<true, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 8, 1, -1, 8> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 1, -1, 8> >&);
 #endif
@@ -16,6 +16,20 @@ namespace igl
   /// Given a point, p0, on an isosurface, construct a shell of epsilon sized cubes surrounding the surface.
   /// These cubes can be used as the input to marching cubes.
   ///
+  /// The shell is grown one layer of neighboring cubes at a time; each layer
+  /// is expanded in parallel and its new cube corners are evaluated together
+  /// (in parallel, or in one call if batched). The output does not depend on
+  /// the number of threads.
+  ///
+  /// Cubes are indexed by integer offsets from the cube containing p0, packed
+  /// into 21 bits per axis. Only cubes with offsets in [1-2^20,2^20-2] along
+  /// every axis are visited, so a surface extending further than about a
+  /// million cubes from p0 is cut off there.
+  ///
+  /// @tparam batched  whether scalarFunc is called on all new corners of a
+  ///   layer at once (`scalarFunc(P)` for #P by 3 row-major P returning a #P
+  ///   vector) or on each corner (`scalarFunc(p)` for 1 by 3 p, called
+  ///   concurrently)
   /// @param[in] p0  A 3D point on the isosurface surface defined by scalarFunc(x) = 0
   /// @param[in] scalarFunc  A scalar function from R^3 to R -- points which map to 0 lie
   ///   on the surface, points which are negative lie inside the surface,
@@ -28,6 +42,7 @@ namespace igl
   ///   represents 8 corners of cube in y-x-z binary counting order.
   ///
   template <
+    bool batched=false,
     typename DerivedP0, 
     typename Func, 
     typename DerivedS, 
@@ -0,0 +1,86 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "sparse_voxel_marching_cubes.h"
+#include "unique_sparse_voxel_corners.h"
+#include "marching_cubes.h"
+#include "parallel_for.h"
+#include <cassert>
+#include <functional>
+
+template <
+  bool batched,
+  typename Derivedorigin,
+  typename Func,
+  typename Derivedijk,
+  typename DerivedV,
+  typename DerivedF
+    >
+IGL_INLINE void igl::sparse_voxel_marching_cubes(
+  const Eigen::MatrixBase<Derivedorigin> & origin,
+  const typename Derivedorigin::Scalar h0,
+  const int depth,
+  const Func & sdf,
+  const Eigen::MatrixBase<Derivedijk> & ijk,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F)
+{
+  assert((origin.rows() == 3 || origin.cols() == 3) && origin.size() == 3 &&
+    "origin must be a 3D vector");
+  using Scalar = typename Derivedorigin::Scalar;
+  using RowVectorS3 = Eigen::Matrix<Scalar,1,3>;
+  using MatrixSX3R = Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor>;
+  using MatrixiX3R = Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor>;
+  using MatrixiX8R = Eigen::Matrix<int,Eigen::Dynamic,8,Eigen::RowMajor>;
+  using VectorS = Eigen::Matrix<Scalar,Eigen::Dynamic,1>;
+  if(ijk.rows() == 0)
+  {
+    V.resize(0,3);
+    F.resize(0,3);
+    return;
+  }
+
+  // Shared corners of the cells (in the order expected by marching_cubes)
+  MatrixiX3R unique_ijk;
+  MatrixiX8R J;
+  MatrixSX3R unique_corners;
+  igl::unique_sparse_voxel_corners(
+    origin,h0,depth,MatrixiX3R(ijk.template cast<int>()),
+    unique_ijk,J,unique_corners);
+
+  // Evaluate the function once per corner
+  VectorS S(unique_corners.rows());
+  // Requires C++17
+  if constexpr (batched)
+  {
+    S = sdf(unique_corners);
+    assert(S.size() == unique_corners.rows());
+  }else
+  {
+    igl::parallel_for(
+      unique_corners.rows(),
+      [&](const int i)
+      {
+        const RowVectorS3 corner = unique_corners.row(i);
+        S(i) = sdf(corner);
+      },
+      1000);
+  }
+
+  Eigen::Matrix<Scalar,Eigen::Dynamic,3> mV;
+  Eigen::Matrix<int,Eigen::Dynamic,3> mF;
+  igl::marching_cubes(S,unique_corners,J,Scalar(0),mV,mF);
+  V = mV.template cast<typename DerivedV::Scalar>();
+  F = mF.template cast<typename DerivedF::Scalar>();
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::sparse_voxel_marching_cubes<false, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3>>&);
+template void igl::sparse_voxel_marching_cubes<true, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<Eigen::Matrix<double, -1, 1, 0, -1, 1> (Eigen::Matrix<double, -1, 3, 1, -1, 3> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3>>&);
+template void igl::sparse_voxel_marching_cubes<false, Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3>> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar, int, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3>> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>>&);
+#endif
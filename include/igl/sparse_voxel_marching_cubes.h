@@ -0,0 +1,70 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_VOXEL_MARCHING_CUBES_H
+#define IGL_SPARSE_VOXEL_MARCHING_CUBES_H
+
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl 
+{
+  /// Extract the zero level set of a signed distance function only inside a
+  /// sparse set of octree leaf cells (e.g., as output by
+  /// igl::lipschitz_octree) so that cost scales with the number of cells
+  /// near the surface rather than the volume of the root cell. Corners shared
+  /// by neighboring cells are evaluated once and mesh vertices on shared
+  /// edges are merged.
+  ///
+  /// If ijk contains every cell whose edges see a sign change (which
+  /// lipschitz_octree guarantees for a 1-Lipschitz sdf), the output is the
+  /// same surface as marching_cubes on the dense grid and is watertight away
+  /// from the root cell's boundary.
+  ///
+  /// @tparam batched  whether sdf is called on all corners at once
+  ///   (`sdf(P)` for #P by 3 P returning #P vector) or on each corner
+  ///   (`sdf(p)` for 1 by 3 p, called in parallel)
+  /// @param[in] origin  3-vector of root cell origin (minimum corner)
+  /// @param[in] h0   side length of root cell
+  /// @param[in] depth  depth of the cells in ijk (root is depth=0)
+  /// @param[in] sdf  signed distance function (negative inside)
+  /// @param[in] ijk  #ijk by 3 list of octree leaf cell minimum corner
+  ///   subscripts
+  /// @param[out] V  #V by 3 list of mesh vertex positions
+  /// @param[out] F  #F by 3 list of mesh triangle indices into rows of V
+  ///
+  /// #### Example
+  ///
+  /// \code{cpp}
+  ///   igl::lipschitz_octree(origin,h0,max_depth,udf,ijk);
+  ///   igl::sparse_voxel_marching_cubes(origin,h0,max_depth,sdf,ijk,V,F);
+  /// \endcode
+  ///
+  /// \see lipschitz_octree, unique_sparse_voxel_corners, marching_cubes
+  template <
+    bool batched=false,
+    typename Derivedorigin,
+    typename Func,
+    typename Derivedijk,
+    typename DerivedV,
+    typename DerivedF
+      >
+  IGL_INLINE void sparse_voxel_marching_cubes(
+    const Eigen::MatrixBase<Derivedorigin> & origin,
+    const typename Derivedorigin::Scalar h0,
+    const int depth,
+    const Func & sdf,
+    const Eigen::MatrixBase<Derivedijk> & ijk,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#    include "sparse_voxel_marching_cubes.cpp"
+#endif
+
+#endif
@@ -14,9 +14,12 @@
 #include "per_face_normals.h"
 #include "per_vertex_normals.h"
 #include "per_edge_normals.h"
+#include "parallel_for.h"
 #include <Eigen/Geometry>
 #include <cmath>
 #include <algorithm>
+#include <tuple>
+#include <vector>
 
 IGL_INLINE void igl::swept_volume_signed_distance(
   const Eigen::MatrixXd & V,
@@ -32,12 +35,107 @@ IGL_INLINE void igl::swept_volume_signed_distance(
 {
   using namespace igl;
   S = S0;
-  const Eigen::VectorXd t = igl::LinSpaced<Eigen::VectorXd >(steps,0,1);
   const bool finite_iso = isfinite(isolevel);
   const double extension = (finite_iso ? isolevel : 0) + sqrt(3.0)*h;
   Eigen::AlignedBox3d box(
     V.colwise().minCoeff().array()-extension,
     V.colwise().maxCoeff().array()+extension);
+  // Time samples and their transformations (transform is only called here,
+  // so it need not be thread-safe)
+  std::vector<double> t;
+  std::vector<Eigen::Affine3d,Eigen::aligned_allocator<Eigen::Affine3d>> A;
+  if(steps > 0)
+  {
+    const Eigen::VectorXd lin = igl::LinSpaced<Eigen::VectorXd >(steps,0,1);
+    t.assign(lin.data(),lin.data()+lin.size());
+    for(const double ti : t) { A.push_back(transform(ti)); }
+  }else
+  {
+    // Bisect [0,1] until no corner of the mesh's bounding box moves more
+    // than h between consecutive samples
+    const Eigen::AlignedBox3d mesh_box(
+      V.colwise().minCoeff().transpose(),V.colwise().maxCoeff().transpose());
+    const auto displacement = [&mesh_box](
+      const Eigen::Affine3d & A0, const Eigen::Affine3d & A1)->double
+    {
+      double max_d = 0;
+      for(int c = 0;c<8;c++)
+      {
+        const Eigen::Vector3d p = 
+          mesh_box.corner(static_cast<Eigen::AlignedBox3d::CornerType>(c));
+        max_d = std::max(max_d,(A1*p-A0*p).norm());
+      }
+      return max_d;
+    };
+    const int max_depth = 16;
+    t.push_back(0);
+    A.push_back(transform(0));
+    // stack of (t1,A1,depth) right ends of intervals starting at t.back()
+    std::vector<std::tuple<double,Eigen::Affine3d,int>,
+      Eigen::aligned_allocator<std::tuple<double,Eigen::Affine3d,int>>> stack;
+    stack.emplace_back(1.0,transform(1),0);
+    while(!stack.empty())
+    {
+      const double t1 = std::get<0>(stack.back());
+      const Eigen::Affine3d A1 = std::get<1>(stack.back());
+      const int depth = std::get<2>(stack.back());
+      if(depth < max_depth && displacement(A.back(),A1) > h)
+      {
+        const double tm = 0.5*(t.back()+t1);
+        stack.emplace_back(tm,transform(tm),depth+1);
+        continue;
+      }
+      stack.pop_back();
+      t.push_back(t1);
+      A.push_back(A1);
+    }
+  }
+  // Grid points which could be within the extended box at each step (by
+  // the world-space bounding box of its transformed corners), padded by a
+  // cell to be safe against rounding
+  const Eigen::RowVector3d origin = GV.colwise().minCoeff();
+  const Eigen::Array3d step = 
+    ((GV.colwise().maxCoeff()-origin).array()/
+     (res.cast<double>().array()-1).max(1)).transpose();
+  std::vector<Eigen::AlignedBox3i> range(t.size());
+  for(int ti = 0;ti<(int)t.size();ti++)
+  {
+    if(!finite_iso)
+    {
+      range[ti] = Eigen::AlignedBox3i(
+        Eigen::Vector3i(0,0,0),(res.array()-1).matrix().transpose());
+      continue;
+    }
+    // gv = (GV.row(g)-translation)*linear below, so world = linear⁻ᵀ*gv+translation
+    const Eigen::Matrix3d L = A[ti].linear().transpose().inverse();
+    Eigen::AlignedBox3d world;
+    for(int c = 0;c<8;c++)
+    {
+      world.extend(
+        L*box.corner(static_cast<Eigen::AlignedBox3d::CornerType>(c)) +
+        A[ti].translation());
+    }
+    // Clamp in double before casting (a box far outside the grid would
+    // overflow int). An axis with a single grid point (zero step) is
+    // covered in full.
+    Eigen::Vector3i lo,hi;
+    for(int d = 0;d<3;d++)
+    {
+      double l = -1;
+      double u = res(d);
+      if(step(d) > 0)
+      {
+        const double wl = std::floor((world.min()(d)-origin(d))/step(d))-1;
+        const double wu = std::ceil((world.max()(d)-origin(d))/step(d))+1;
+        if(wl == wl) { l = std::min(std::max(wl,-1.0),double(res(d))); }
+        if(wu == wu) { u = std::min(std::max(wu,-1.0),double(res(d))); }
+      }
+      lo(d) = std::max(static_cast<int>(l),0);
+      hi(d) = std::min(static_cast<int>(u),res(d)-1);
+    }
+    range[ti] = Eigen::AlignedBox3i(lo,hi);
+  }
+
   // Precomputation
   Eigen::MatrixXd FN,VN,EN;
   Eigen::MatrixXi E;
@@ -48,45 +146,57 @@ IGL_INLINE void igl::swept_volume_signed_distance(
     V,F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,FN,EN,E,EMAP);
   AABB<Eigen::MatrixXd,3> tree;
   tree.init(V,F);
-  for(int ti = 0;ti<t.size();ti++)
+  const double min_sqrd = 
+    finite_iso ? 
+    pow(sqrt(3.)*h+isolevel,2) : 
+    std::numeric_limits<double>::infinity();
+  // Each z-slice of the grid is owned by one task which takes the minimum
+  // over all time steps in order, so the result does not depend on the
+  // number of threads.
+  igl::parallel_for(res(2),[&](const int z)
   {
-    const Eigen::Affine3d At = transform(t(ti));
-    for(int g = 0;g<GV.rows();g++)
+    for(int ti = 0;ti<(int)t.size();ti++)
     {
-      // Don't bother finding out how deep inside points are.
-      if(finite_iso && S(g)==S(g) && S(g)<isolevel-sqrt(3.0)*h)
+      const Eigen::AlignedBox3i & r = range[ti];
+      if(z < r.min()(2) || z > r.max()(2)) { continue; }
+      const Eigen::Affine3d & At = A[ti];
+      for(int y = r.min()(1);y<=r.max()(1);y++)
       {
-        continue;
-      }
-      const Eigen::RowVector3d gv =
-        (GV.row(g) - At.translation().transpose())*At.linear();
-      // If outside of extended box, then consider it "far away enough"
-      if(finite_iso && !box.contains(gv.transpose()))
-      {
-        continue;
-      }
-      Eigen::RowVector3d c,n;
-      int i;
-      double sqrd,s;
-      //signed_distance_pseudonormal(tree,V,F,FN,VN,EN,EMAP,gv,s,sqrd,i,c,n);
-      const double min_sqrd = 
-        finite_iso ? 
-        pow(sqrt(3.)*h+isolevel,2) : 
-        std::numeric_limits<double>::infinity();
-      sqrd = tree.squared_distance(V,F,gv,min_sqrd,i,c);
-      if(sqrd<min_sqrd)
-      {
-        pseudonormal_test(V,F,FN,VN,EN,EMAP,gv,i,c,s,n);
-        if(S(g) == S(g))
-        {
-          S(g) = std::min(S(g),s*sqrt(sqrd));
-        }else
+        for(int x = r.min()(0);x<=r.max()(0);x++)
         {
-          S(g) = s*sqrt(sqrd);
+          const int g = x+res(0)*(y+res(1)*z);
+          // Don't bother finding out how deep inside points are.
+          if(finite_iso && S(g)==S(g) && S(g)<isolevel-sqrt(3.0)*h)
+          {
+            continue;
+          }
+          const Eigen::RowVector3d gv =
+            (GV.row(g) - At.translation().transpose())*At.linear();
+          // If outside of extended box, then consider it "far away enough"
+          if(finite_iso && !box.contains(gv.transpose()))
+          {
+            continue;
+          }
+          Eigen::RowVector3d c,n;
+          int i;
+          double sqrd,s;
+          //signed_distance_pseudonormal(tree,V,F,FN,VN,EN,EMAP,gv,s,sqrd,i,c,n);
+          sqrd = tree.squared_distance(V,F,gv,min_sqrd,i,c);
+          if(sqrd<min_sqrd)
+          {
+            pseudonormal_test(V,F,FN,VN,EN,EMAP,gv,i,c,s,n);
+            if(S(g) == S(g))
+            {
+              S(g) = std::min(S(g),s*sqrt(sqrd));
+            }else
+            {
+              S(g) = s*sqrt(sqrd);
+            }
+          }
         }
       }
     }
-  }
+  },1);
 
   if(finite_iso)
   {
@@ -17,13 +17,21 @@ namespace igl
   /// an arbitrary motion V(t) discretely sampled at `steps`-many moments in
   /// time at a grid.
   ///
+  /// Each step only visits grid points near the transformed mesh, and grid
+  /// slices are processed in parallel (the result does not depend on the
+  /// number of threads).
+  ///
   /// @param[in] V  #V by 3 list of mesh positions in reference pose
   /// @param[in] F  #F by 3 list of triangle indices [0,n)
   /// @param[in] transform  function handle so that transform(t) returns the rigid
   ///     transformation at time t∈[0,1]
-  /// @param[in] steps  number of time steps: steps=3 --> t∈{0,0.5,1}
+  /// @param[in] steps  number of time steps: steps=3 --> t∈{0,0.5,1}. If
+  ///     steps=0, times are chosen adaptively by bisection so that no corner
+  ///     of the mesh's bounding box moves more than h between consecutive
+  ///     samples.
   /// @param[in] GV  #GV by 3 list of evaluation point grid positions
-  /// @param[in] res  3-long resolution of GV grid
+  /// @param[in] res  3-long resolution of GV grid (GV.row(x+res(0)*(y+res(1)*z))
+  ///     is the position of grid point x,y,z)
   /// @param[in] h  edge-length of grid
   /// @param[in] isolevel  isolevel to "focus" on; grid positions far enough away from
   ///     isolevel (based on h) will get approximate values). Set
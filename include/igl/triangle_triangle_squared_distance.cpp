@@ -0,0 +1,194 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "triangle_triangle_squared_distance.h"
+#include "tri_tri_intersect.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+  // Closest point to p on triangle abc ("Real-Time Collision Detection"
+  // [Ericson 2004], Section 5.1.5)
+  template <typename RowVector3S>
+  RowVector3S closest_point_on_triangle(
+    const RowVector3S & p,
+    const RowVector3S & a,
+    const RowVector3S & b,
+    const RowVector3S & c)
+  {
+    typedef typename RowVector3S::Scalar Scalar;
+    const RowVector3S ab = b-a;
+    const RowVector3S ac = c-a;
+    const RowVector3S ap = p-a;
+    const Scalar d1 = ab.dot(ap);
+    const Scalar d2 = ac.dot(ap);
+    if(d1 <= 0 && d2 <= 0) { return a; }
+    const RowVector3S bp = p-b;
+    const Scalar d3 = ab.dot(bp);
+    const Scalar d4 = ac.dot(bp);
+    if(d3 >= 0 && d4 <= d3) { return b; }
+    const Scalar vc = d1*d4-d3*d2;
+    if(vc <= 0 && d1 >= 0 && d3 <= 0)
+    {
+      return a+(d1/(d1-d3))*ab;
+    }
+    const RowVector3S cp = p-c;
+    const Scalar d5 = ab.dot(cp);
+    const Scalar d6 = ac.dot(cp);
+    if(d6 >= 0 && d5 <= d6) { return c; }
+    const Scalar vb = d5*d2-d1*d6;
+    if(vb <= 0 && d2 >= 0 && d6 <= 0)
+    {
+      return a+(d2/(d2-d6))*ac;
+    }
+    const Scalar va = d3*d6-d5*d4;
+    if(va <= 0 && (d4-d3) >= 0 && (d5-d6) >= 0)
+    {
+      return b+((d4-d3)/((d4-d3)+(d5-d6)))*(c-b);
+    }
+    const Scalar denom = 1/(va+vb+vc);
+    return a+ab*(vb*denom)+ac*(vc*denom);
+  }
+
+  // Closest points c1 on segment p1q1 and c2 on segment p2q2 (Ericson 2004,
+  // Section 5.1.9)
+  template <typename RowVector3S>
+  void closest_points_on_segments(
+    const RowVector3S & p1,
+    const RowVector3S & q1,
+    const RowVector3S & p2,
+    const RowVector3S & q2,
+    RowVector3S & c1,
+    RowVector3S & c2)
+  {
+    typedef typename RowVector3S::Scalar Scalar;
+    const auto clamp01 = [](const Scalar x)->Scalar
+    {
+      return std::min<Scalar>(std::max<Scalar>(x,0),1);
+    };
+    const RowVector3S d1 = q1-p1;
+    const RowVector3S d2 = q2-p2;
+    const RowVector3S r = p1-p2;
+    const Scalar a = d1.squaredNorm();
+    const Scalar e = d2.squaredNorm();
+    const Scalar f = d2.dot(r);
+    Scalar s = 0;
+    Scalar t = 0;
+    if(a <= 0 && e <= 0)
+    {
+    }else if(a <= 0)
+    {
+      t = clamp01(f/e);
+    }else
+    {
+      const Scalar c = d1.dot(r);
+      if(e <= 0)
+      {
+        s = clamp01(-c/a);
+      }else
+      {
+        const Scalar b = d1.dot(d2);
+        const Scalar denom = a*e-b*b;
+        // Parallel segments pick s=0
+        s = denom > 0 ? clamp01((b*f-c*e)/denom) : 0;
+        t = (b*s+f)/e;
+        if(t < 0)
+        {
+          t = 0;
+          s = clamp01(-c/a);
+        }else if(t > 1)
+        {
+          t = 1;
+          s = clamp01((b-c)/a);
+        }
+      }
+    }
+    c1 = p1+s*d1;
+    c2 = p2+t*d2;
+  }
+}
+
+template <
+  typename Derivedp1,
+  typename Derivedp2,
+  typename Derivedc1,
+  typename Derivedc2>
+IGL_INLINE typename Derivedp1::Scalar igl::triangle_triangle_squared_distance(
+  const Eigen::MatrixBase<Derivedp1> & p1,
+  const Eigen::MatrixBase<Derivedp1> & q1,
+  const Eigen::MatrixBase<Derivedp1> & r1,
+  const Eigen::MatrixBase<Derivedp2> & p2,
+  const Eigen::MatrixBase<Derivedp2> & q2,
+  const Eigen::MatrixBase<Derivedp2> & r2,
+  Eigen::PlainObjectBase<Derivedc1> & c1,
+  Eigen::PlainObjectBase<Derivedc2> & c2)
+{
+  typedef typename Derivedp1::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  const RowVector3S T1[3] = {
+    p1.template cast<Scalar>(),
+    q1.template cast<Scalar>(),
+    r1.template cast<Scalar>()};
+  const RowVector3S T2[3] = {
+    p2.template cast<Scalar>(),
+    q2.template cast<Scalar>(),
+    r2.template cast<Scalar>()};
+
+  // An edge of one triangle may pierce the other, which none of the boundary
+  // pairs below would notice
+  {
+    bool coplanar = false;
+    RowVector3S source,target;
+    if(igl::tri_tri_intersection_test_3d(
+      T1[0],T1[1],T1[2],T2[0],T2[1],T2[2],coplanar,source,target) &&
+      !coplanar)
+    {
+      c1 = source.template cast<typename Derivedc1::Scalar>();
+      c2 = source.template cast<typename Derivedc2::Scalar>();
+      return 0;
+    }
+  }
+
+  // Otherwise (or if coplanar) the closest points are on the boundary of one
+  // of the triangles
+  Scalar sqr_d = std::numeric_limits<Scalar>::infinity();
+  RowVector3S best1,best2;
+  const auto consider = [&](const RowVector3S & a,const RowVector3S & b)
+  {
+    const Scalar sqr_d_ab = (a-b).squaredNorm();
+    if(sqr_d_ab < sqr_d)
+    {
+      sqr_d = sqr_d_ab;
+      best1 = a;
+      best2 = b;
+    }
+  };
+  for(int i = 0;i<3;i++)
+  {
+    consider(T1[i],closest_point_on_triangle(T1[i],T2[0],T2[1],T2[2]));
+    consider(closest_point_on_triangle(T2[i],T1[0],T1[1],T1[2]),T2[i]);
+  }
+  for(int i = 0;i<3;i++)
+  {
+    for(int j = 0;j<3;j++)
+    {
+      RowVector3S a,b;
+      closest_points_on_segments(
+        T1[i],T1[(i+1)%3],T2[j],T2[(j+1)%3],a,b);
+      consider(a,b);
+    }
+  }
+  c1 = best1.template cast<typename Derivedc1::Scalar>();
+  c2 = best2.template cast<typename Derivedc2::Scalar>();
+  return sqr_d;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template double igl::triangle_triangle_squared_distance<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+#endif
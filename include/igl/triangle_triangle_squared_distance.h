@@ -0,0 +1,50 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_TRIANGLE_TRIANGLE_SQUARED_DISTANCE_H
+#define IGL_TRIANGLE_TRIANGLE_SQUARED_DISTANCE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  /// Given two triangles in 3D find the points on each of closest approach
+  /// and the squared distance thereof. If the triangles do not intersect the
+  /// closest points lie on the boundary of one of them, so they are found
+  /// among the six vertex-triangle and nine edge-edge closest pairs.
+  ///
+  /// @param[in] p1  3-long first corner of first triangle
+  /// @param[in] q1  3-long second corner of first triangle
+  /// @param[in] r1  3-long third corner of first triangle
+  /// @param[in] p2  3-long first corner of second triangle
+  /// @param[in] q2  3-long second corner of second triangle
+  /// @param[in] r2  3-long third corner of second triangle
+  /// @param[out] c1  3-long point on first triangle closest to second
+  /// @param[out] c2  3-long point on second triangle closest to first
+  /// @return squared distance between c1 and c2 (0 if the triangles
+  ///   intersect)
+  ///
+  /// \see copyleft::cgal::triangle_triangle_squared_distance,
+  ///   mesh_mesh_squared_distance
+  template <
+    typename Derivedp1,
+    typename Derivedp2,
+    typename Derivedc1,
+    typename Derivedc2>
+  IGL_INLINE typename Derivedp1::Scalar triangle_triangle_squared_distance(
+    const Eigen::MatrixBase<Derivedp1> & p1,
+    const Eigen::MatrixBase<Derivedp1> & q1,
+    const Eigen::MatrixBase<Derivedp1> & r1,
+    const Eigen::MatrixBase<Derivedp2> & p2,
+    const Eigen::MatrixBase<Derivedp2> & q2,
+    const Eigen::MatrixBase<Derivedp2> & r2,
+    Eigen::PlainObjectBase<Derivedc1> & c1,
+    Eigen::PlainObjectBase<Derivedc2> & c2);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "triangle_triangle_squared_distance.cpp"
+#endif
+#endif
@@ -6,15 +6,53 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "unique_sparse_voxel_corners.h"
-#include "matlab_format.h"
-#include "unique.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <cassert>
-#include <iostream>
+#include <cstdint>
+#include <vector>
 
 namespace
 {
   // Match the yxz binary counting order in marching_cubes/sparse_voxel_grid
   const int marching_cubes_reoder[] = {1,0,2,3,5,4,6,7};
+
+  struct CodeSlot
+  {
+    std::int64_t code;
+    // 8*cell+corner (beyond int for more than 2^28 cells)
+    std::int64_t slot;
+  };
+
+  // Least-significant-digit radix sort by code (codes are bounded by
+  // (2^depth+1)^3, so a few passes over the data suffice)
+  void radix_sort(std::vector<CodeSlot> & A, const std::int64_t max_code)
+  {
+    const int radix_bits = 11;
+    const std::int64_t num_buckets = std::int64_t(1) << radix_bits;
+    std::vector<CodeSlot> B(A.size());
+    std::vector<size_t> count(num_buckets);
+    for(int shift = 0;(max_code >> shift) > 0;shift += radix_bits)
+    {
+      std::fill(count.begin(),count.end(),0);
+      for(const auto & a : A)
+      {
+        count[(a.code >> shift) & (num_buckets-1)]++;
+      }
+      size_t sum = 0;
+      for(auto & c : count)
+      {
+        const size_t t = c;
+        c = sum;
+        sum += t;
+      }
+      for(const auto & a : A)
+      {
+        B[count[(a.code >> shift) & (num_buckets-1)]++] = a;
+      }
+      std::swap(A,B);
+    }
+  }
 }
 
 template <
@@ -28,20 +66,14 @@ IGL_INLINE void igl::unique_sparse_voxel_corners(
   Eigen::PlainObjectBase<Derivedunique_ijk> & unique_ijk,
   Eigen::PlainObjectBase<DerivedJ> & J)
 {
-  using MatrixiX3R = Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor>;
-  // slow, precise hashing. Not sure why I didn't just use unique_rows on #ijk*8
-  // by 3...
+  // Exact codes for every corner subscript at this depth
   const Eigen::Matrix<std::int64_t,1,3> coeffs(
     1,
-    //static_cast<std::int64_t>(std::pow(2,depth) + 1), 
     (1 << depth) + 1,
-    //static_cast<std::int64_t>(std::pow(2,depth) + 1) * (std::pow(2,depth) + 1));
     ((1 << depth) +1)*((1 << depth) +1));
   const auto ijk2code = [&coeffs](const int i, const int j, const int k)->std::int64_t
   {
     // code = i*(2.^depth + 1)^0 + j*(2.^depth + 1)^1 + k*(2.^depth + 1)^2;
-    // Probably can just use 2.^(depth+1) instead of (2.^depth + 1) and use bit
-    // shifting?
     const std::int64_t code =
       static_cast<std::int64_t>(i) * coeffs[0] +
       static_cast<std::int64_t>(j) * coeffs[1] +
@@ -55,56 +87,44 @@ IGL_INLINE void igl::unique_sparse_voxel_corners(
     i = static_cast<int>(code - j * coeffs[1] - k * coeffs[2]);
   };
 
-  // Should use parallel_for
-  Eigen::Matrix<std::int64_t,Eigen::Dynamic,8,Eigen::RowMajor> codes(ijk.rows(),8);
-  for(int c = 0;c<ijk.rows();c++)
+  const Eigen::Index n = ijk.rows();
+  std::vector<CodeSlot> codes(n*8);
+  igl::parallel_for(n,[&](const Eigen::Index c)
   {
     for(int i = 0;i<8;i++)
     {
-      Eigen::RowVector3i ijk_c(
+      const std::int64_t slot = c*8+marching_cubes_reoder[i];
+      codes[slot].code = ijk2code(
         ijk(c,0) + ((i&2) ? 1 : 0), 
         ijk(c,1) + ((i&4) ? 1 : 0), 
         ijk(c,2) + ((i&1) ? 1 : 0));
-      const std::int64_t code = ijk2code(ijk_c(0), ijk_c(1), ijk_c(2));
-      const int k = marching_cubes_reoder[i];
-      codes(c,k) = code;
-#ifndef NDEBUG
-      Eigen::RowVector3i ijk_c_check;
-      code2ijk(code,ijk_c_check(0),ijk_c_check(1),ijk_c_check(2));
-      //printf("ijk2code(%d,%d,%d) = %ld\n",
-      //       ijk_c(0),ijk_c(1),ijk_c(2),code);
-      //printf("  code2ijk(%ld) = %d,%d,%d\n",
-      //    code, ijk_c_check(0),ijk_c_check(1),ijk_c_check(2));
-      // Check that the code is correct
-      assert(ijk_c_check(0) == ijk_c(0) && ijk_c_check(1) == ijk_c(1) &&
-             ijk_c_check(2) == ijk_c(2) &&
-             "ijk2code and code2ijk are not consistent");
-#endif
+      codes[slot].slot = slot;
     }
-  }
-  // igl::unique is the bottleneck by far.
-  // unique_rows might actually be faster because it doesn't do roundtrips to
-  // std::vector
-  Eigen::VectorXi I;
+  },1000);
+
+  // Sorted unique codes (i.e., corners in the same order igl::unique would
+  // give)
+  radix_sort(codes,ijk2code(1<<depth,1<<depth,1<<depth));
+  std::vector<std::int64_t> unique_codes;
+  J.resize(n,8);
+  for(const auto & cs : codes)
   {
-    Eigen::Matrix<std::int64_t,Eigen::Dynamic,1> _;
-    Eigen::Matrix<typename DerivedJ::Scalar,Eigen::Dynamic,1> Jvec;
-    // igl::unique has a lot of internal copies :-(
-    igl::unique(codes,_,I,Jvec);
-    // reshape Jvec into ijk.rows() by 8
-    J = Jvec.reshaped(ijk.rows(),8);
+    if(unique_codes.empty() || unique_codes.back() != cs.code)
+    {
+      unique_codes.push_back(cs.code);
+    }
+    J(cs.slot/8,cs.slot%8) = unique_codes.size()-1;
   }
 
-  // Map of codes as vector
-  const auto codes_vec = codes.reshaped();
-
-  unique_ijk.resize(I.size(),3);
-  for(int c = 0;c<I.size();c++)
+  unique_ijk.resize(unique_codes.size(),3);
+  igl::parallel_for(unique_codes.size(),[&](const size_t c)
   {
-    Eigen::RowVector3i ijk_c;
-    code2ijk(codes_vec(I(c)),ijk_c(0),ijk_c(1),ijk_c(2));
-    unique_ijk.row(c) = ijk_c.cast<typename Derivedunique_ijk::Scalar>();
-  }
+    int i,j,k;
+    code2ijk(unique_codes[c],i,j,k);
+    unique_ijk(c,0) = i;
+    unique_ijk(c,1) = j;
+    unique_ijk(c,2) = k;
+  },1000);
 }
 
 template<
@@ -128,12 +148,12 @@ IGL_INLINE void igl::unique_sparse_voxel_corners(
   using Scalar = typename Derivedunique_corners::Scalar;
   const Scalar h = h0 / (1 << depth);
   unique_corners.resize(unique_ijk.rows(),3);
-  for(int c = 0;c<unique_ijk.rows();c++)
+  igl::parallel_for(unique_ijk.rows(),[&](const Eigen::Index c)
   {
     unique_corners(c,0) = origin(0) + h * unique_ijk(c,1);
     unique_corners(c,1) = origin(1) + h * unique_ijk(c,0);
     unique_corners(c,2) = origin(2) + h * unique_ijk(c,2);
-  }
+  },1000);
 }
 
 #ifdef IGL_STATIC_LIBRARY
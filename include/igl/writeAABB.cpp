@@ -0,0 +1,121 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "writeAABB.h"
+#include "MappedAABB.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename Derivedleaf>
+IGL_INLINE bool igl::writeAABB(
+  const std::string & filename,
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<DerivedB> & B1,
+  const Eigen::MatrixBase<DerivedB> & B2,
+  const Eigen::MatrixBase<Derivedleaf> & leaf)
+{
+  using Scalar = typename DerivedV::Scalar;
+  using Index = typename DerivedF::Scalar;
+  using MatrixXS =
+    Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>;
+  using MatrixXI =
+    Eigen::Matrix<Index,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>;
+  using VectorXI = Eigen::Matrix<Index,Eigen::Dynamic,1>;
+  static_assert(sizeof(Scalar) == 4 || sizeof(Scalar) == 8,
+    "V should be float or double");
+  static_assert(sizeof(Index) == 4 || sizeof(Index) == 8,
+    "F should have 4 or 8 byte indices");
+  assert(B1.rows() == B2.rows() && B1.rows() == leaf.size());
+  assert(B1.rows() == 0 || B1.cols() == V.cols());
+
+  AABBFileHeader header;
+  header.init(
+    sizeof(Scalar),sizeof(Index),V.cols(),F.cols(),V.rows(),F.rows(),leaf.size());
+  std::vector<unsigned char> buffer(header.file_size,0);
+  Eigen::Map<MatrixXS>(
+    reinterpret_cast<Scalar *>(buffer.data()+header.offset_V),V.rows(),V.cols()) = V;
+  Eigen::Map<MatrixXI>(
+    reinterpret_cast<Index *>(buffer.data()+header.offset_F),F.rows(),F.cols()) =
+    F.template cast<Index>();
+  Eigen::Map<MatrixXS> mB1(
+    reinterpret_cast<Scalar *>(buffer.data()+header.offset_B1),B1.rows(),V.cols());
+  Eigen::Map<MatrixXS> mB2(
+    reinterpret_cast<Scalar *>(buffer.data()+header.offset_B2),B2.rows(),V.cols());
+  Eigen::Map<VectorXI> mleaf(
+    reinterpret_cast<Index *>(buffer.data()+header.offset_leaf),leaf.size());
+  // Only copy nodes reachable from the root: AABB::serialize leaves gaps
+  // uninitialized, mark them as empty so files are reproducible.
+  mleaf.setConstant(-2);
+  std::vector<int> stack;
+  if(leaf.size() > 0) { stack.push_back(0); }
+  while(!stack.empty())
+  {
+    const int i = stack.back();
+    stack.pop_back();
+    mB1.row(i) = B1.row(i).template cast<Scalar>();
+    mB2.row(i) = B2.row(i).template cast<Scalar>();
+    mleaf(i) = static_cast<Index>(leaf(i));
+    if(leaf(i) == -1 && 2*i+2 < leaf.size())
+    {
+      stack.push_back(2*i+1);
+      stack.push_back(2*i+2);
+    }
+  }
+  header.checksum = AABBFileHeader::compute_checksum(
+    buffer.data()+sizeof(AABBFileHeader),
+    buffer.size()-sizeof(AABBFileHeader));
+  std::memcpy(buffer.data(),&header,sizeof(AABBFileHeader));
+
+  FILE * fp = fopen(filename.c_str(),"wb");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"IOError: writeAABB() could not open %s\n",filename.c_str());
+    return false;
+  }
+  const bool ok = fwrite(buffer.data(),1,buffer.size(),fp) == buffer.size();
+  fclose(fp);
+  if(!ok)
+  {
+    fprintf(stderr,"IOError: writeAABB() could not write %s\n",filename.c_str());
+  }
+  return ok;
+}
+
+template <
+  typename DerivedV,
+  int DIM,
+  typename DerivedF>
+IGL_INLINE bool igl::writeAABB(
+  const std::string & filename,
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const igl::AABB<DerivedV,DIM> & tree)
+{
+  using Scalar = typename DerivedV::Scalar;
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> B1,B2;
+  Eigen::VectorXi leaf;
+  if(!tree.is_leaf() || tree.m_primitive >= 0)
+  {
+    tree.serialize(B1,B2,leaf);
+  }
+  return writeAABB(filename,V,F,B1,B2,leaf);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::writeAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(std::string const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const&);
+template bool igl::writeAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>>(std::string const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 1, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 1, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const&);
+template bool igl::writeAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(std::string const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2> const&);
+template bool igl::writeAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3, Eigen::Matrix<int, -1, -1, 0, -1, -1>>(std::string const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&);
+#endif
@@ -0,0 +1,61 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WRITEAABB_H
+#define IGL_WRITEAABB_H
+#include "igl_inline.h"
+#include "AABB.h"
+#include <Eigen/Core>
+#include <string>
+
+namespace igl
+{
+  /// Write a mesh and its Eytzinger-layout bounding box hierarchy to an .aabb
+  /// file (see MappedAABB.h for the format). Scalars are written with the
+  /// precision of V and indices with the width of F.
+  ///
+  /// @param[in] filename  path to .aabb file
+  /// @param[in] V  #V by dim list of vertex positions
+  /// @param[in] F  #F by ss list of simplex indices into V
+  /// @param[in] B1  #B by dim list of node minimum corners
+  /// @param[in] B2  #B by dim list of node maximum corners
+  /// @param[in] leaf  #B list of primitive indices into F (-1 internal, -2
+  ///   empty)
+  /// @return true on success
+  ///
+  /// \see eytzinger_aabb, MappedAABB, readAABB
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedB,
+    typename Derivedleaf>
+  IGL_INLINE bool writeAABB(
+    const std::string & filename,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedB> & B1,
+    const Eigen::MatrixBase<DerivedB> & B2,
+    const Eigen::MatrixBase<Derivedleaf> & leaf);
+  /// \overload
+  ///
+  /// @param[in] tree  hierarchy built for (V,F)
+  template <
+    typename DerivedV,
+    int DIM,
+    typename DerivedF>
+  IGL_INLINE bool writeAABB(
+    const std::string & filename,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const igl::AABB<DerivedV,DIM> & tree);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "writeAABB.cpp"
+#endif
+
+#endif
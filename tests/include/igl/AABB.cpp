@@ -1,17 +1,20 @@
 #include <test_common.h>
 #include <igl/AABB.h>
 #include <igl/EPS.h>
+#include <igl/ThreadPool.h>
 #include <igl/avg_edge_length.h>
 #include <igl/barycenter.h>
 #include <igl/colon.h>
 #include <igl/placeholders.h>
 #include <igl/get_seconds.h>
+#include <igl/icosahedron.h>
 #include <igl/point_mesh_squared_distance.h>
 #include <igl/point_simplex_squared_distance.h>
 #include <igl/per_face_normals.h>
 #include <igl/barycenter.h>
 #include <igl/randperm.h>
 #include <igl/read_triangle_mesh.h>
+#include <igl/upsample.h>
 #include <iostream>
 
 TEST_CASE("AABB: find_2d", "[igl]")
@@ -315,3 +318,92 @@ TEST_CASE("AABB: intersect_tet", "[igl]")
   REQUIRE(UV(1) == Approx(0.52));
 
 }
+
+TEST_CASE("AABB: parallel_init", "[igl]")
+{
+  // Large enough to build the top levels in parallel
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,6);
+  V.rowwise().normalize();
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const unsigned int prev = pool.num_threads();
+  pool.resize(1);
+  igl::AABB<Eigen::MatrixXd,3> serial;
+  serial.init(V,F);
+  pool.resize(4);
+  igl::AABB<Eigen::MatrixXd,3> parallel;
+  parallel.init(V,F);
+  pool.resize(prev);
+  // Trees should be identical
+  std::vector<std::pair<
+    const igl::AABB<Eigen::MatrixXd,3>*,
+    const igl::AABB<Eigen::MatrixXd,3>*>> stack{{&serial,&parallel}};
+  int num_nodes = 0;
+  while(!stack.empty())
+  {
+    const auto * a = stack.back().first;
+    const auto * b = stack.back().second;
+    stack.pop_back();
+    num_nodes++;
+    REQUIRE(a->m_primitive == b->m_primitive);
+    REQUIRE(a->m_box.min() == b->m_box.min());
+    REQUIRE(a->m_box.max() == b->m_box.max());
+    REQUIRE((a->m_left == nullptr) == (b->m_left == nullptr));
+    REQUIRE((a->m_right == nullptr) == (b->m_right == nullptr));
+    if(a->m_left) { stack.push_back({a->m_left,b->m_left}); }
+    if(a->m_right) { stack.push_back({a->m_right,b->m_right}); }
+  }
+  REQUIRE(num_nodes == 2*F.rows()-1);
+}
+
+TEST_CASE("AABB: intersect_ray_packets", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,4);
+  V.rowwise().normalize();
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // Coherent rays from a pinhole camera followed by incoherent random rays
+  const int w = 36;
+  const int n = w*w + 1001;
+  Eigen::MatrixXd O(n,3),D(n,3);
+  for(int i = 0;i<w;i++)
+  {
+    for(int j = 0;j<w;j++)
+    {
+      O.row(i*w+j) << 0.1,0.2,3;
+      D.row(i*w+j) << -1.5+3.0*(i+0.5)/w, -1.5+3.0*(j+0.5)/w, -3.2;
+    }
+  }
+  O.bottomRows(1001) = 2.0*Eigen::MatrixXd::Random(1001,3);
+  D.bottomRows(1001) = Eigen::MatrixXd::Random(1001,3);
+  const double inf = std::numeric_limits<double>::infinity();
+  Eigen::VectorXi gt_I;
+  Eigen::VectorXd gt_T;
+  Eigen::MatrixXd gt_UV;
+  tree.intersect_ray(V,F,O,D,inf,gt_I,gt_T,gt_UV,1);
+  REQUIRE((gt_I.array() >= 0).count() > w*w/2);
+  for(const int packet_size : {4,8,16})
+  {
+    Eigen::VectorXi I;
+    Eigen::VectorXd T;
+    Eigen::MatrixXd UV;
+    tree.intersect_ray(V,F,O,D,inf,I,T,UV,packet_size);
+    test_common::assert_eq(I,gt_I);
+    for(int r = 0;r<n;r++)
+    {
+      if(gt_I(r) < 0)
+      {
+        REQUIRE(std::isnan(T(r)));
+        continue;
+      }
+      REQUIRE(T(r) == gt_T(r));
+      REQUIRE(UV(r,0) == gt_UV(r,0));
+      REQUIRE(UV(r,1) == gt_UV(r,1));
+    }
+  }
+}
@@ -0,0 +1,102 @@
+#include <test_common.h>
+#include <igl/FlatAABB.h>
+#include <igl/AABB.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/barycenter.h>
+#include <igl/triangulated_grid.h>
+#include <igl/point_mesh_squared_distance.h>
+
+TEST_CASE("FlatAABB: squared_distance", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,3);
+  V.rowwise().normalize();
+  igl::FlatAABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  REQUIRE(tree.size() > 0);
+  REQUIRE(tree.height() > 1);
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(500,3)*1.5;
+  Eigen::VectorXd sqrD,gt_sqrD;
+  Eigen::VectorXi I,gt_I;
+  Eigen::MatrixXd C,gt_C;
+  tree.squared_distance(V,F,P,sqrD,I,C);
+  igl::point_mesh_squared_distance(P,V,F,gt_sqrD,gt_I,gt_C);
+  for(int p = 0;p<P.rows();p++)
+  {
+    REQUIRE(sqrD(p) == Approx(gt_sqrD(p)).margin(1e-12));
+    REQUIRE(I(p) >= 0);
+  }
+  // Every leaf primitive is referenced exactly once
+  std::vector<int> count(F.rows(),0);
+  for(const auto & node : tree.m_nodes)
+  {
+    if(!node.is_leaf()) { continue; }
+    for(int k = node.offset;k<node.offset+node.count;k++)
+    {
+      count[tree.m_primitives[k]]++;
+    }
+  }
+  for(const int c : count) { REQUIRE(c == 1); }
+}
+
+TEST_CASE("FlatAABB: intersect_ray", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,2);
+  V.rowwise().normalize();
+  igl::FlatAABB<Eigen::MatrixXd,3> flat;
+  flat.init(V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // Rays from inside through each face's barycenter hit exactly once
+  Eigen::MatrixXd BC;
+  igl::barycenter(V,F,BC);
+  const Eigen::MatrixXd O =
+    Eigen::RowVector3d(0.01,0.02,0.03).replicate(BC.rows(),1);
+  const Eigen::MatrixXd D = BC-O;
+  Eigen::VectorXi I,gt_I;
+  Eigen::VectorXd T,gt_T;
+  Eigen::MatrixXd UV,gt_UV;
+  flat.intersect_ray(V,F,O,D,std::numeric_limits<double>::infinity(),I,T,UV);
+  tree.intersect_ray(V,F,O,D,std::numeric_limits<double>::infinity(),gt_I,gt_T,gt_UV);
+  for(int r = 0;r<BC.rows();r++)
+  {
+    REQUIRE(I(r) == r);
+    REQUIRE(I(r) == gt_I(r));
+    REQUIRE(T(r) == Approx(gt_T(r)));
+  }
+  // Rays from outside through the center hit twice
+  std::vector<igl::Hit<double>> hits;
+  const Eigen::RowVector3d src(3,0.1,0.2);
+  REQUIRE(flat.intersect_ray(V,F,src,Eigen::RowVector3d(-src),hits));
+  REQUIRE(hits.size() == 2);
+  REQUIRE(hits[0].t < hits[1].t);
+  igl::Hit<double> hit;
+  REQUIRE(flat.intersect_ray(V,F,src,Eigen::RowVector3d(-src),hit));
+  REQUIRE(hit.t == Approx(hits[0].t));
+  REQUIRE(!flat.intersect_ray(V,F,src,Eigen::RowVector3d(src),hit));
+}
+
+TEST_CASE("FlatAABB: find_2d", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(20,20,V,F);
+  igl::FlatAABB<Eigen::MatrixXd,2> tree;
+  tree.init(V,F);
+  Eigen::MatrixXd BC;
+  igl::barycenter(V,F,BC);
+  for(int f = 0;f<F.rows();f++)
+  {
+    const Eigen::RowVectorXd q = BC.row(f);
+    const std::vector<int> r = tree.find(V,F,q,true);
+    REQUIRE(r.size() == 1);
+    REQUIRE(r[0] == f);
+  }
+  REQUIRE(tree.find(V,F,Eigen::RowVectorXd(Eigen::RowVector2d(2,2))).empty());
+}
@@ -0,0 +1,117 @@
+#include <test_common.h>
+#include <igl/AABB.h>
+#include <igl/MappedAABB.h>
+#include <igl/eytzinger_aabb_sdf.h>
+#include <igl/icosahedron.h>
+#include <igl/point_simplex_squared_distance.h>
+#include <igl/readAABB.h>
+#include <igl/upsample.h>
+#include <igl/writeAABB.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+TEST_CASE("MappedAABB: round_trip", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,2);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  const std::string path = test_common::data_path("_tmp_round_trip.aabb");
+  REQUIRE(igl::writeAABB(path,V,F,tree));
+
+  const Eigen::MatrixXd P = 2*Eigen::MatrixXd::Random(100,3);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  tree.squared_distance(V,F,P,sqrD,I,C);
+
+  {
+    // Copying reader restores an equivalent tree
+    Eigen::MatrixXd rV;
+    Eigen::MatrixXi rF;
+    igl::AABB<Eigen::MatrixXd,3> rtree;
+    REQUIRE(igl::readAABB(path,rV,rF,rtree));
+    test_common::assert_eq(V,rV);
+    test_common::assert_eq(F,rF);
+    Eigen::VectorXd rsqrD;
+    Eigen::VectorXi rI;
+    Eigen::MatrixXd rC;
+    rtree.squared_distance(rV,rF,P,rsqrD,rI,rC);
+    test_common::assert_eq(sqrD,rsqrD);
+    test_common::assert_eq(I,rI);
+  }
+
+  {
+    // Mapped file can be queried in place
+    igl::MappedAABB<double,int> file;
+    REQUIRE(file.open(path));
+    const auto mV = file.V();
+    const auto mF = file.F();
+    test_common::assert_eq(V,Eigen::MatrixXd(mV));
+    test_common::assert_eq(F,Eigen::MatrixXi(mF));
+    for(int p = 0;p<P.rows();p++)
+    {
+      const Eigen::RowVector3d q = P.row(p);
+      const std::function<double(const int)> primitive = [&](const int f)
+      {
+        Eigen::RowVector3d c;
+        double d;
+        igl::point_simplex_squared_distance<3>(q,mV,mF,f,d,c);
+        return d;
+      };
+      double d;
+      igl::eytzinger_aabb_sdf<true>(
+        q,primitive,file.B1(),file.B2(),file.leaf(),d);
+      REQUIRE(d == Approx(sqrD(p)).margin(1e-15));
+    }
+    // Widths must match
+    igl::MappedAABB<float,int> wrong;
+    REQUIRE(!wrong.open(path));
+  }
+
+  {
+    // Corrupt a vertex: checksum no longer matches
+    std::fstream fs(path,std::ios::in|std::ios::out|std::ios::binary);
+    fs.seekp(sizeof(igl::AABBFileHeader)+3);
+    fs.put(char(0x7f));
+    fs.close();
+    igl::MappedAABB<double,int> file;
+    REQUIRE(!file.open(path));
+    REQUIRE(file.open(path,false));
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("MappedAABB: wrapping counts", "[igl]")
+{
+  // Layout of a small file, then a count so large that its byte size wraps
+  // around to the same offsets
+  igl::AABBFileHeader header;
+  header.init(8,4,4,3,10,5,9);
+  header.num_V += std::uint64_t(1) << 59;
+  std::vector<unsigned char> buffer(header.file_size,0);
+  header.checksum = igl::AABBFileHeader::compute_checksum(
+    buffer.data()+sizeof(igl::AABBFileHeader),
+    buffer.size()-sizeof(igl::AABBFileHeader));
+  std::memcpy(buffer.data(),&header,sizeof(igl::AABBFileHeader));
+  REQUIRE(!header.valid(buffer.size()));
+  const std::string path = test_common::data_path("_tmp_wrapping.aabb");
+  {
+    std::ofstream fs(path,std::ios::binary);
+    fs.write(reinterpret_cast<const char *>(buffer.data()),buffer.size());
+  }
+  igl::MappedAABB<double,int> file;
+  REQUIRE(!file.open(path));
+  REQUIRE(!file.open(path,false));
+  Eigen::MatrixXd V,B1,B2;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi leaf;
+  REQUIRE(!igl::readAABB(path,V,F,B1,B2,leaf));
+  std::remove(path.c_str());
+}
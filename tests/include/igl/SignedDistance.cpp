@@ -0,0 +1,65 @@
+#include <test_common.h>
+#include <igl/SignedDistance.h>
+#include <igl/signed_distance.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+
+TEST_CASE("SignedDistance: matches_signed_distance", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,2);
+  V.rowwise().normalize();
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(500,3);
+  for(const igl::SignedDistanceType type :
+    {
+      igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,
+      igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER,
+      igl::SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER,
+      igl::SIGNED_DISTANCE_TYPE_UNSIGNED
+    })
+  {
+    igl::SignedDistance<Eigen::MatrixXd,Eigen::MatrixXi> sdf;
+    sdf.init(V,F,type);
+    // Deform: the context is refit, the reference recomputed from scratch
+    for(int step = 0;step<3;step++)
+    {
+      const Eigen::MatrixXd U =
+        ((1.0+0.1*step)*V).rowwise() + Eigen::RowVector3d(0.05*step,0,0);
+      if(step > 0)
+      {
+        sdf.refit(U);
+      }
+      Eigen::VectorXd S,gt_S;
+      Eigen::VectorXi I,gt_I;
+      Eigen::MatrixXd C,N,gt_C,gt_N;
+      sdf.query(P,S,I,C,N);
+      igl::signed_distance(P,U,F,type,gt_S,gt_I,gt_C,gt_N);
+      if(type == igl::SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER && step > 0)
+      {
+        // The refit BVH differs from a fresh one, and so does the
+        // approximate winding number scaling S
+        for(int p = 0;p<P.rows();p++)
+        {
+          REQUIRE((S(p) < 0) == (gt_S(p) < 0));
+        }
+      }else
+      {
+        test_common::assert_near(S,gt_S,1e-12);
+      }
+      test_common::assert_near(C,gt_C,1e-12);
+      if(type == igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+      {
+        test_common::assert_near(N,gt_N,1e-12);
+      }
+      for(int p = 0;p<P.rows();p++)
+      {
+        int i;
+        Eigen::RowVector3d c;
+        REQUIRE(sdf.query(Eigen::RowVector3d(P.row(p)),i,c) ==
+          Approx(S(p)).margin(1e-12));
+      }
+    }
+  }
+}
@@ -0,0 +1,119 @@
+#include <test_common.h>
+#include <igl/dual_contouring.h>
+#include <igl/grid.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/ThreadPool.h>
+#include <igl/PI.h>
+#include <functional>
+
+namespace
+{
+  // Signed volume enclosed by a closed quad mesh (split into triangles)
+  double enclosed_volume(const Eigen::MatrixXd & V, const Eigen::MatrixXi & Q)
+  {
+    double vol = 0;
+    for(int q = 0;q<Q.rows();q++)
+    {
+      for(const auto & t : {Eigen::RowVector3i(0,1,2),Eigen::RowVector3i(0,2,3)})
+      {
+        const Eigen::RowVector3d a = V.row(Q(q,t(0)));
+        const Eigen::RowVector3d b = V.row(Q(q,t(1)));
+        const Eigen::RowVector3d c = V.row(Q(q,t(2)));
+        vol += a.dot(b.cross(c))/6.0;
+      }
+    }
+    return vol;
+  }
+}
+
+TEST_CASE("dual_contouring: sphere", "[igl]")
+{
+  const Eigen::RowVector3d center(0.1,-0.05,0.02);
+  const double r = 0.6;
+  const std::function<double(const Eigen::RowVector3d &)> f =
+    [&](const Eigen::RowVector3d & p)->double
+  {
+    return (p-center).norm()-r;
+  };
+  const std::function<Eigen::RowVector3d(const Eigen::RowVector3d &)> f_grad =
+    [&](const Eigen::RowVector3d & p)->Eigen::RowVector3d
+  {
+    return (p-center).normalized();
+  };
+  const Eigen::RowVector3d min_corner(-1,-1,-1);
+  const Eigen::RowVector3d max_corner(1,1,1);
+  const int n = 21;
+  for(const bool constrained : {false,true})
+  {
+    for(const bool triangles : {false,true})
+    {
+      Eigen::MatrixXd V;
+      Eigen::MatrixXi Q;
+      igl::dual_contouring(
+        f,f_grad,min_corner,max_corner,n,n,n,constrained,triangles,true,V,Q);
+      REQUIRE(Q.cols() == (triangles?3:4));
+      REQUIRE(Q.rows() > 0);
+      // Vertices lie on the surface
+      for(int v = 0;v<V.rows();v++)
+      {
+        REQUIRE(std::abs(f(V.row(v))) < 1e-2);
+      }
+      if(!triangles)
+      {
+        // Closed and consistently oriented outward
+        REQUIRE(enclosed_volume(V,Q) ==
+          Approx(4./3.*igl::PI*r*r*r).epsilon(1e-2));
+      }else
+      {
+        REQUIRE(igl::is_edge_manifold(Q));
+      }
+
+      // Precomputed grid values give the same result
+      Eigen::MatrixXd GV;
+      igl::grid(Eigen::RowVector3i(n,n,n),GV);
+      GV = (GV.array().rowwise()*(max_corner-min_corner).array()).rowwise()
+        + min_corner.array();
+      Eigen::VectorXd Gf(GV.rows());
+      for(int g = 0;g<GV.rows();g++) { Gf(g) = f(GV.row(g)); }
+      Eigen::MatrixXd GV_V;
+      Eigen::MatrixXi GV_Q;
+      igl::dual_contouring(
+        f,f_grad,Gf,GV,n,n,n,constrained,triangles,true,GV_V,GV_Q);
+      REQUIRE(GV_Q == Q);
+      test_common::assert_near(GV_V,V,1e-12);
+    }
+  }
+}
+
+TEST_CASE("dual_contouring: deterministic", "[igl]")
+{
+  // Shape with many components so cells are spread over all slices
+  const std::function<double(const Eigen::RowVector3d &)> f =
+    [](const Eigen::RowVector3d & p)->double
+  {
+    return std::sin(7*p(0))*std::sin(7*p(1))*std::sin(7*p(2))-0.2;
+  };
+  const std::function<Eigen::RowVector3d(const Eigen::RowVector3d &)> f_grad =
+    [](const Eigen::RowVector3d & p)->Eigen::RowVector3d
+  {
+    return Eigen::RowVector3d(
+      7*std::cos(7*p(0))*std::sin(7*p(1))*std::sin(7*p(2)),
+      7*std::sin(7*p(0))*std::cos(7*p(1))*std::sin(7*p(2)),
+      7*std::sin(7*p(0))*std::sin(7*p(1))*std::cos(7*p(2))).normalized();
+  };
+  Eigen::MatrixXd V1,V2;
+  Eigen::MatrixXi Q1,Q2;
+  const Eigen::RowVector3d min_corner(-1,-1,-1);
+  const Eigen::RowVector3d max_corner(1,1,1);
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const unsigned int prev = pool.num_threads();
+  pool.resize(1);
+  igl::dual_contouring(
+    f,f_grad,min_corner,max_corner,31,32,33,false,false,true,V1,Q1);
+  pool.resize(4);
+  igl::dual_contouring(
+    f,f_grad,min_corner,max_corner,31,32,33,false,false,true,V2,Q2);
+  pool.resize(prev);
+  REQUIRE(Q1 == Q2);
+  REQUIRE(V1 == V2);
+}
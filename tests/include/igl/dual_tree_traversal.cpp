@@ -0,0 +1,99 @@
+#include <test_common.h>
+#include <igl/dual_tree_traversal.h>
+#include <igl/AABB.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/ThreadPool.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  void sphere(const int levels, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    for(int l = 0;l<levels;l++)
+    {
+      igl::upsample(V,F);
+      V.rowwise().normalize();
+    }
+  }
+
+  Eigen::AlignedBox<double,3> triangle_box(
+    const Eigen::MatrixXd & V, const Eigen::MatrixXi & F, const int f)
+  {
+    Eigen::AlignedBox<double,3> box;
+    for(int c = 0;c<3;c++)
+    {
+      box.extend(V.row(F(f,c)).transpose());
+    }
+    return box;
+  }
+}
+
+TEST_CASE("dual_tree_traversal: overlapping boxes", "[igl]")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  sphere(3,VA,FA);
+  sphere(2,VB,FB);
+  // Only a cap of each sphere overlaps the other
+  VB = (0.7*VB).rowwise() + Eigen::RowVector3d(1.5,0.1,0.2);
+  igl::AABB<Eigen::MatrixXd,3> treeA,treeB;
+  treeA.init(VA,FA);
+  treeB.init(VB,FB);
+
+  const auto pairs = [&]()
+  {
+    std::vector<std::vector<std::pair<int,int> > > found;
+    igl::dual_tree_traversal(treeA,treeB,
+      [&](const size_t n){ found.resize(n); },
+      [](
+        const Eigen::AlignedBox<double,3> & a,
+        const Eigen::AlignedBox<double,3> & b){ return a.intersects(b); },
+      [&](const int a,const int b,const size_t t)
+        { found[t].emplace_back(a,b); });
+    std::vector<std::pair<int,int> > all;
+    for(const auto & f : found)
+    {
+      all.insert(all.end(),f.begin(),f.end());
+    }
+    std::sort(all.begin(),all.end());
+    return all;
+  };
+
+  std::vector<std::pair<int,int> > expected;
+  for(int a = 0;a<FA.rows();a++)
+  {
+    for(int b = 0;b<FB.rows();b++)
+    {
+      if(triangle_box(VA,FA,a).intersects(triangle_box(VB,FB,b)))
+      {
+        expected.emplace_back(a,b);
+      }
+    }
+  }
+  REQUIRE(expected.size() > 0);
+  REQUIRE(Eigen::Index(expected.size()) < FA.rows());
+
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const size_t prev = pool.num_threads();
+  pool.resize(1);
+  REQUIRE(pairs() == expected);
+  pool.resize(4);
+  REQUIRE(pairs() == expected);
+  pool.resize(prev);
+
+  // Nothing is visited when the roots are rejected
+  int num_leaves = 0;
+  int num_prep = 0;
+  igl::dual_tree_traversal(treeA,treeB,
+    [&](const size_t){ num_prep++; },
+    [](
+      const Eigen::AlignedBox<double,3> &,
+      const Eigen::AlignedBox<double,3> &){ return false; },
+    [&](const int,const int,const size_t){ num_leaves++; });
+  REQUIRE(num_prep == 1);
+  REQUIRE(num_leaves == 0);
+}
@@ -0,0 +1,46 @@
+#include <test_common.h>
+#include <igl/eytzinger_aabb.h>
+#include <vector>
+
+TEST_CASE("eytzinger_aabb: morton", "[igl]")
+{
+  for(const int m : {1,2,3,17,1000,5001})
+  {
+    const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> C =
+      Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor>::Random(m,3);
+    const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> PB1 =
+      C.array()-0.01;
+    const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> PB2 =
+      C.array()+0.01;
+    Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> B1,B2,MB1,MB2;
+    Eigen::VectorXi leaf,Mleaf;
+    igl::eytzinger_aabb(PB1,PB2,B1,B2,leaf);
+    igl::eytzinger_aabb(
+      PB1,PB2,MB1,MB2,Mleaf,igl::EYTZINGER_AABB_TYPE_MORTON);
+    // Same layout size, every primitive in exactly one leaf
+    REQUIRE(Mleaf.size() == leaf.size());
+    std::vector<int> count(m,0);
+    for(int i = 0;i<Mleaf.size();i++)
+    {
+      if(Mleaf(i) >= 0)
+      {
+        count[Mleaf(i)]++;
+        test_common::assert_eq(MB1.row(i),PB1.row(Mleaf(i)));
+        test_common::assert_eq(MB2.row(i),PB2.row(Mleaf(i)));
+      }else if(Mleaf(i) == -1)
+      {
+        // Internal nodes have two non-empty children bounding them tightly
+        REQUIRE(Mleaf(2*i+1) != -2);
+        REQUIRE(Mleaf(2*i+2) != -2);
+        test_common::assert_eq(
+          MB1.row(i),MB1.row(2*i+1).cwiseMin(MB1.row(2*i+2)).eval());
+        test_common::assert_eq(
+          MB2.row(i),MB2.row(2*i+1).cwiseMax(MB2.row(2*i+2)).eval());
+      }
+    }
+    for(const int c : count) { REQUIRE(c == 1); }
+    // Root bounds everything
+    test_common::assert_eq(MB1.row(0),B1.row(0));
+    test_common::assert_eq(MB2.row(0),B2.row(0));
+  }
+}
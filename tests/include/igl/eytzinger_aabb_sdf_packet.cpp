@@ -0,0 +1,66 @@
+#include <test_common.h>
+#include <igl/eytzinger_aabb.h>
+#include <igl/eytzinger_aabb_sdf.h>
+#include <igl/eytzinger_aabb_sdf_packet.h>
+#include <functional>
+
+TEST_CASE("eytzinger_aabb_sdf_packet: spheres", "[igl]")
+{
+  // Union of random spheres
+  const int m = 300;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> C =
+    Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor>::Random(m,3);
+  const Eigen::VectorXd R =
+    0.05*(Eigen::VectorXd::Random(m).array()+1.5);
+  const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> PB1 =
+    C - R.replicate(1,3);
+  const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> PB2 =
+    C + R.replicate(1,3);
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> B1,B2;
+  Eigen::VectorXi leaf;
+  igl::eytzinger_aabb(PB1,PB2,B1,B2,leaf);
+
+  // Grid of queries (plus a ragged tail for the last packet)
+  const int s = 13;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> P(s*s*s+3,3);
+  for(int i = 0;i<s*s*s;i++)
+  {
+    P.row(i) << i%s, (i/s)%s, i/(s*s);
+  }
+  P.topRows(s*s*s) = (P.topRows(s*s*s).array()/(s-1)*2.4-1.2).eval();
+  P.bottomRows(3).setRandom();
+
+  const std::function<double(const Eigen::Matrix<double,1,3> &,const int)>
+    sdf = [&](const Eigen::Matrix<double,1,3> & p,const int i)
+  {
+    return (p-C.row(i)).norm()-R(i);
+  };
+  const std::function<double(const Eigen::Matrix<double,1,3> &,const int)>
+    sqrD = [&](const Eigen::Matrix<double,1,3> & p,const int i)
+  {
+    return (p-C.row(i)).squaredNorm();
+  };
+  const std::function<Eigen::Array<double,8,1>(const Eigen::Array<double,8,3> &,const int)>
+    sdf8 = [&](const Eigen::Array<double,8,3> & Q,const int i)
+  {
+    return ((Q.rowwise()-C.row(i).array()).square().rowwise().sum().sqrt()-R(i)).eval();
+  };
+  const std::function<Eigen::Array<double,8,1>(const Eigen::Array<double,8,3> &,const int)>
+    sqrD8 = [&](const Eigen::Array<double,8,3> & Q,const int i)
+  {
+    return (Q.rowwise()-C.row(i).array()).square().rowwise().sum().eval();
+  };
+
+  Eigen::VectorXd S,S_packet;
+  igl::eytzinger_aabb_sdf<false>(P,sdf,B1,B2,leaf,S);
+  igl::eytzinger_aabb_sdf_packet<false,8>(P,sdf8,B1,B2,leaf,S_packet);
+  test_common::assert_near(S,S_packet,1e-15);
+  igl::eytzinger_aabb_sdf<true>(P,sqrD,B1,B2,leaf,S);
+  igl::eytzinger_aabb_sdf_packet<true,8>(P,sqrD8,B1,B2,leaf,S_packet);
+  test_common::assert_near(S,S_packet,1e-15);
+  // Brute force
+  for(int i = 0;i<P.rows();i++)
+  {
+    REQUIRE(S(i) == Approx((C.rowwise()-P.row(i)).rowwise().squaredNorm().minCoeff()).margin(1e-15));
+  }
+}
@@ -13,6 +13,8 @@
 #include <igl/barycenter.h>
 #include <igl/per_face_normals.h>
 #include <igl/doublearea.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 
 TEST_CASE("fast_winding_number: one_point_cloud", "[igl]")
 {
@@ -105,3 +107,131 @@ TEST_CASE("fast_winding_number: meshes", "[igl]" "[slow]")
     {"bunny.off", "elephant.off", "hemisphere.obj"},
     test_case);
 }
+
+TEST_CASE("fast_winding_number: refit", "[igl]")
+{
+  Eigen::MatrixXd V0;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V0,F);
+  igl::upsample(Eigen::MatrixXd(V0),Eigen::MatrixXi(F),V0,F,4);
+  V0.rowwise().normalize();
+  // Queries inside and outside of the deformed shapes
+  const Eigen::MatrixXd Q = 1.3*Eigen::MatrixXd::Random(200,3);
+  // Twist and stretch
+  const auto deform = [&](const double t)
+  {
+    Eigen::MatrixXd V = V0;
+    for(int i = 0;i<V.rows();i++)
+    {
+      const double a = t*V(i,2);
+      const double x = V(i,0), y = V(i,1);
+      V(i,0) = (1.0+0.5*t)*(std::cos(a)*x - std::sin(a)*y);
+      V(i,1) = std::sin(a)*x + std::cos(a)*y;
+    }
+    return V;
+  };
+
+  // SOUP
+  {
+    igl::FastWindingNumberBVH fwn_bvh;
+    igl::fast_winding_number(V0,F,2,fwn_bvh);
+    for(const double t : {0.1,0.5,1.0})
+    {
+      const Eigen::MatrixXd V = deform(t);
+      const float quality = igl::fast_winding_number_refit(V,fwn_bvh);
+      REQUIRE(quality > 0.5);
+      REQUIRE(quality < 1.5);
+      Eigen::VectorXd W_refit,W_exact;
+      igl::fast_winding_number(fwn_bvh,2,Q,W_refit);
+      igl::winding_number(V,F,Q,W_exact);
+      test_common::assert_near(W_refit,W_exact,1e-2);
+    }
+    // Scrambling vertices makes the tree useless
+    Eigen::MatrixXd V = V0;
+    for(int i = 0;i<V.rows();i++)
+    {
+      V.row(i).swap(V.row((i*7919)%V.rows()));
+    }
+    REQUIRE(igl::fast_winding_number_refit(V,fwn_bvh) > 1.5);
+  }
+
+  // CLOUD: same octree cells, new points
+  {
+    const auto cloud = [&F](
+      const Eigen::MatrixXd & V,
+      Eigen::MatrixXd & BC,
+      Eigen::MatrixXd & N,
+      Eigen::VectorXd & A)
+    {
+      igl::barycenter(V,F,BC);
+      igl::per_face_normals(V,F,N);
+      igl::doublearea(V,F,A);
+      A *= 0.5;
+    };
+    Eigen::MatrixXd BC,N;
+    Eigen::VectorXd A;
+    cloud(V0,BC,N,A);
+    std::vector<std::vector<int > > O_PI;
+    Eigen::MatrixXi O_CH;
+    Eigen::MatrixXd O_CN;
+    Eigen::VectorXd O_W;
+    igl::octree(BC,O_PI,O_CH,O_CN,O_W);
+    const Eigen::MatrixXd V = deform(0.5);
+    cloud(V,BC,N,A);
+    Eigen::MatrixXd O_CM;
+    Eigen::VectorXd O_R;
+    Eigen::MatrixXd O_EC;
+    igl::fast_winding_number(BC,N,A,O_PI,O_CH,2,O_CM,O_R,O_EC);
+    Eigen::VectorXd W_refit,W_direct;
+    igl::fast_winding_number(BC,N,A,O_PI,O_CH,O_CM,O_R,O_EC,Q,3,W_refit);
+    igl::fast_winding_number(BC,N,A,O_PI,O_CH,O_CM,O_R,O_EC,Q,0,W_direct);
+    test_common::assert_near(W_refit,W_direct,1e-2);
+  }
+}
+
+TEST_CASE("fast_winding_number: compact octree", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,4);
+  V.rowwise().normalize();
+  Eigen::MatrixXd BC,N;
+  Eigen::VectorXd A;
+  igl::barycenter(V,F,BC);
+  igl::per_face_normals(V,F,N);
+  igl::doublearea(V,F,A);
+  A *= 0.5;
+  const Eigen::MatrixXd Q = 1.3*Eigen::MatrixXd::Random(300,3);
+
+  std::vector<std::vector<int > > O_PI;
+  Eigen::MatrixXi O_CH;
+  Eigen::MatrixXd O_CN;
+  Eigen::VectorXd O_W;
+  igl::octree(BC,O_PI,O_CH,O_CN,O_W);
+  Eigen::MatrixXd O_CM;
+  Eigen::VectorXd O_R;
+  Eigen::MatrixXd O_EC;
+  igl::fast_winding_number(BC,N,A,O_PI,O_CH,2,O_CM,O_R,O_EC);
+  Eigen::VectorXd W_vectors;
+  igl::fast_winding_number(BC,N,A,O_PI,O_CH,O_CM,O_R,O_EC,Q,2,W_vectors);
+
+  Eigen::VectorXi PI;
+  Eigen::MatrixXi CP,CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(BC,PI,CP,CH,CN,W);
+  Eigen::MatrixXd CM;
+  Eigen::VectorXd R;
+  Eigen::MatrixXd EC;
+  igl::fast_winding_number(BC,N,A,PI,CP,CH,2,CM,R,EC);
+  Eigen::VectorXd W_compact;
+  igl::fast_winding_number(BC,N,A,PI,CP,CH,CM,R,EC,Q,2,W_compact);
+  // Same cells (numbered differently) so the same expansions up to
+  // summation order
+  test_common::assert_near(W_compact,W_vectors,1e-12);
+
+  Eigen::VectorXd W_uncached;
+  igl::fast_winding_number(BC,N,A,Q,2,2,W_uncached);
+  test_common::assert_near(W_uncached,W_compact,1e-12);
+}
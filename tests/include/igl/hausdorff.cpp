@@ -0,0 +1,154 @@
+#include <test_common.h>
+#include <igl/hausdorff.h>
+#include <igl/point_mesh_squared_distance.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/ThreadPool.h>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+  void sphere(const int levels, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    for(int l = 0;l<levels;l++)
+    {
+      igl::upsample(V,F);
+      V.rowwise().normalize();
+    }
+  }
+
+  // Lower bound on the Hausdorff distance from densely resampled vertices
+  double sampled(
+    const Eigen::MatrixXd & VA, const Eigen::MatrixXi & FA,
+    const Eigen::MatrixXd & VB, const Eigen::MatrixXi & FB,
+    const int levels)
+  {
+    Eigen::MatrixXd UA,UB;
+    Eigen::MatrixXi GA,GB;
+    igl::upsample(VA,FA,UA,GA,levels);
+    igl::upsample(VB,FB,UB,GB,levels);
+    double d;
+    igl::hausdorff(UA,GA,UB,GB,d);
+    return d;
+  }
+
+  // Check bounds against sampling and that (p,q) witnesses l
+  void check(
+    const Eigen::MatrixXd & VA, const Eigen::MatrixXi & FA,
+    const Eigen::MatrixXd & VB, const Eigen::MatrixXi & FB,
+    const double tol, const int levels)
+  {
+    double l,u;
+    Eigen::RowVector3d p,q;
+    igl::hausdorff(VA,FA,VB,FB,tol,l,u,p,q);
+    REQUIRE(l <= u);
+    REQUIRE(u-l <= tol);
+    REQUIRE((p-q).norm() == Approx(l).margin(1e-12));
+    const double s = sampled(VA,FA,VB,FB,levels);
+    REQUIRE(s <= u+1e-12);
+    REQUIRE(l >= s-tol);
+    // p is on one mesh and at distance l from the other
+    Eigen::VectorXd sqr_dA,sqr_dB;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    igl::point_mesh_squared_distance(Eigen::MatrixXd(p),VA,FA,sqr_dA,I,C);
+    igl::point_mesh_squared_distance(Eigen::MatrixXd(p),VB,FB,sqr_dB,I,C);
+    const double dA = std::sqrt(sqr_dA(0));
+    const double dB = std::sqrt(sqr_dB(0));
+    REQUIRE(std::min(dA,dB) == Approx(0).margin(1e-12));
+    REQUIRE(std::max(dA,dB) == Approx(l).margin(1e-12));
+  }
+}
+
+TEST_CASE("hausdorff: quad triangulations", "[igl]")
+{
+  // The two triangulations of a non-planar quad share all vertices, so
+  // vertex sampling sees no difference
+  Eigen::MatrixXd V(4,3);
+  V<<0,0,0, 1,0,0, 1,1,0, 0,1,1;
+  Eigen::MatrixXi FA(2,3),FB(2,3);
+  FA<<0,1,2, 0,2,3;
+  FB<<0,1,3, 1,2,3;
+  double d;
+  igl::hausdorff(V,FA,V,FB,d);
+  REQUIRE(d == Approx(0).margin(1e-12));
+  check(V,FA,V,FB,1e-4,6);
+  double l,u;
+  Eigen::RowVector3d p,q;
+  igl::hausdorff(V,FA,V,FB,1e-4,l,u,p,q);
+  REQUIRE(l > 0.25);
+}
+
+TEST_CASE("hausdorff: coarse and fine sphere", "[igl]")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  sphere(3,VA,FA);
+  sphere(1,VB,FB);
+  // Shift so that the two directions differ
+  VB.col(0).array() += 0.05;
+  check(VA,FA,VB,FB,1e-3,3);
+  // Bounded version is at least the vertex-sampled one
+  double d,l,u;
+  Eigen::RowVector3d p,q;
+  igl::hausdorff(VA,FA,VB,FB,d);
+  igl::hausdorff(VA,FA,VB,FB,1e-3,l,u,p,q);
+  REQUIRE(l >= d-1e-12);
+}
+
+TEST_CASE("hausdorff: thread count", "[igl]")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  sphere(4,VA,FA);
+  sphere(2,VB,FB);
+  VB *= 1.02;
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const size_t prev = pool.num_threads();
+  double l1,u1,l4,u4;
+  Eigen::RowVector3d p1,q1,p4,q4;
+  pool.resize(1);
+  igl::hausdorff(VA,FA,VB,FB,1e-5,l1,u1,p1,q1);
+  pool.resize(4);
+  igl::hausdorff(VA,FA,VB,FB,1e-5,l4,u4,p4,q4);
+  pool.resize(prev);
+  REQUIRE(l1 == l4);
+  REQUIRE(u1 == u4);
+  REQUIRE(p1 == p4);
+  REQUIRE(q1 == q4);
+}
+
+TEST_CASE("hausdorff: identical and empty", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  sphere(2,V,F);
+  double l,u;
+  Eigen::RowVector3d p,q;
+  igl::hausdorff(V,F,V,F,1e-6,l,u,p,q);
+  REQUIRE(l == Approx(0).margin(1e-12));
+  REQUIRE(u <= 1e-6);
+  igl::hausdorff(V,F,V,Eigen::MatrixXi(0,3),1e-6,l,u,p,q);
+  REQUIRE(l == std::numeric_limits<double>::infinity());
+  REQUIRE(u == std::numeric_limits<double>::infinity());
+  REQUIRE(p.array().isNaN().all());
+  REQUIRE(q.array().isNaN().all());
+}
+
+TEST_CASE("hausdorff: triangle bounds", "[igl]")
+{
+  Eigen::MatrixXd V(3,3);
+  V<<0,0,0, 1,0,0, 0,1,0;
+  // Distance to the point (0,0,1)
+  const std::function<double(const double &,const double &,const double &)>
+    dist_to_B = [](const double & x,const double & y,const double & z)
+  {
+    return Eigen::RowVector3d(x,y,z-1).norm();
+  };
+  double l,u;
+  igl::hausdorff(V,dist_to_B,l,u);
+  REQUIRE(l == Approx(std::sqrt(2.0)));
+  REQUIRE(u >= l);
+}
@@ -7,6 +7,11 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include <test_common.h>
 #include <igl/iterative_closest_point.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/ThreadPool.h>
+#include <Eigen/Geometry>
+#include <cmath>
 
 
 TEST_CASE("iterative_closest_point: identity","[igl]" "[slow]")
@@ -30,3 +35,132 @@ TEST_CASE("iterative_closest_point: identity","[igl]" "[slow]")
 
   test_common::run_test_cases(test_common::all_meshes(), test_case);
 }
+
+namespace
+{
+  // Sphere squashed into an egg with a bump (no rigid symmetries)
+  void lumpy(Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    for(int l = 0;l<3;l++)
+    {
+      igl::upsample(V,F);
+      V.rowwise().normalize();
+    }
+    for(int v = 0;v<V.rows();v++)
+    {
+      const Eigen::RowVector3d b(0.6,0.5,0.6);
+      V.row(v) *= 1.0+0.4*std::exp(-8.0*(V.row(v)-b).squaredNorm());
+      V.row(v) = V.row(v).cwiseProduct(Eigen::RowVector3d(1.0,0.8,0.6));
+    }
+  }
+
+  // Y moved by a rotation of 0.2 radians and a translation
+  void moved(const Eigen::MatrixXd & VY, Eigen::MatrixXd & VX)
+  {
+    const Eigen::Matrix3d R0 = Eigen::AngleAxisd(
+      0.2,Eigen::Vector3d(1,2,3).normalized()).toRotationMatrix();
+    VX = (VY*R0).rowwise()+Eigen::RowVector3d(0.1,-0.05,0.08);
+  }
+
+  double max_error(
+    const Eigen::MatrixXd & VX,
+    const Eigen::MatrixXd & VY,
+    const Eigen::Matrix3d & R,
+    const Eigen::RowVector3d & t)
+  {
+    return ((VX.topRows(VY.rows())*R).rowwise()+t-VY)
+      .rowwise().norm().maxCoeff();
+  }
+}
+
+TEST_CASE("iterative_closest_point: objectives","[igl]")
+{
+  Eigen::MatrixXd VX,VY;
+  Eigen::MatrixXi F;
+  lumpy(VY,F);
+  moved(VY,VX);
+  for(const igl::ICPObjective objective :
+    {igl::ICP_OBJECTIVE_POINT_TO_POINT,
+     igl::ICP_OBJECTIVE_POINT_TO_PLANE,
+     igl::ICP_OBJECTIVE_SYMMETRIC})
+  {
+    srand(0);
+    igl::ICPParams params;
+    params.objective = objective;
+    params.num_samples = 2000;
+    // Point-to-point converges only linearly
+    params.max_iters = 1000;
+    Eigen::Matrix3d R;
+    Eigen::RowVector3d t;
+    const int iters = igl::iterative_closest_point(VX,F,VY,F,params,R,t);
+    // Converged before running out of iterations
+    REQUIRE(iters < params.max_iters);
+    REQUIRE(max_error(VX,VY,R,t) < 1e-4);
+    test_common::assert_near(
+      (R.transpose()*R).eval(),Eigen::Matrix3d::Identity(),1e-12);
+  }
+}
+
+TEST_CASE("iterative_closest_point: robust weights","[igl]")
+{
+  Eigen::MatrixXd VY,VX;
+  Eigen::MatrixXi FY,FX;
+  lumpy(VY,FY);
+  moved(VY,VX);
+  // X also contains a part that is not in Y
+  {
+    Eigen::MatrixXd VO;
+    Eigen::MatrixXi FO;
+    igl::icosahedron(VO,FO);
+    VO = ((0.3*VO).rowwise()+Eigen::RowVector3d(1.5,0,0)).eval();
+    VX.conservativeResize(VX.rows()+VO.rows(),3);
+    VX.bottomRows(VO.rows()) = VO;
+    FX.resize(FY.rows()+FO.rows(),3);
+    FX<<FY,FO.array()+VY.rows();
+  }
+  double error[3];
+  for(const igl::ICPWeight weight :
+    {igl::ICP_WEIGHT_NONE,igl::ICP_WEIGHT_HUBER,igl::ICP_WEIGHT_TUKEY})
+  {
+    srand(0);
+    igl::ICPParams params;
+    params.weight = weight;
+    params.num_samples = 4000;
+    params.levels = 3;
+    Eigen::Matrix3d R;
+    Eigen::RowVector3d t;
+    igl::iterative_closest_point(VX,FX,VY,FY,params,R,t);
+    error[weight] = max_error(VX,VY,R,t);
+  }
+  // The outlying part pulls least squares away
+  REQUIRE(error[igl::ICP_WEIGHT_NONE] > 1e-2);
+  REQUIRE(error[igl::ICP_WEIGHT_HUBER] < error[igl::ICP_WEIGHT_NONE]);
+  REQUIRE(error[igl::ICP_WEIGHT_TUKEY] < 1e-4);
+}
+
+TEST_CASE("iterative_closest_point: levels and thread count","[igl]")
+{
+  Eigen::MatrixXd VX,VY;
+  Eigen::MatrixXi F;
+  lumpy(VY,F);
+  moved(VY,VX);
+  igl::ICPParams params;
+  params.num_samples = 20000;
+  params.levels = 3;
+  params.weight = igl::ICP_WEIGHT_HUBER;
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const size_t prev = pool.num_threads();
+  Eigen::Matrix3d R1,R4;
+  Eigen::RowVector3d t1,t4;
+  pool.resize(1);
+  srand(0);
+  igl::iterative_closest_point(VX,F,VY,F,params,R1,t1);
+  pool.resize(4);
+  srand(0);
+  igl::iterative_closest_point(VX,F,VY,F,params,R4,t4);
+  pool.resize(prev);
+  REQUIRE(R1 == R4);
+  REQUIRE(t1 == t4);
+  REQUIRE(max_error(VX,VY,R1,t1) < 1e-4);
+}
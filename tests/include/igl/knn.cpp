@@ -2,6 +2,8 @@
 #include <igl/list_to_matrix.h>
 #include <igl/knn.h>
 #include <igl/octree.h>
+#include <igl/ThreadPool.h>
+#include <limits>
 
 
 
@@ -76,3 +78,128 @@ TEST_CASE("knn", "[igl]")
 
 
 }
+
+TEST_CASE("knn: compact octree", "[igl]")
+{
+    const Eigen::MatrixXd V = Eigen::MatrixXd::Random(3000,3);
+    const Eigen::MatrixXd P = 1.2*Eigen::MatrixXd::Random(500,3);
+    const int k = 7;
+    std::vector<std::vector<int> > point_indices;
+    Eigen::MatrixXi CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(V,point_indices,CH,CN,W);
+    Eigen::MatrixXi I;
+    igl::knn(P,V,k,point_indices,CH,CN,W,I);
+
+    Eigen::VectorXi PI;
+    Eigen::MatrixXi CP,cCH;
+    Eigen::MatrixXd cCN;
+    Eigen::VectorXd cW;
+    igl::octree(V,PI,CP,cCH,cCN,cW);
+    Eigen::MatrixXi cI;
+    igl::knn(P,V,k,PI,CP,cCH,cCN,cW,cI);
+    REQUIRE(cI.rows() == P.rows());
+    REQUIRE(cI.cols() == k);
+    for(int i = 0;i<P.rows();i++)
+    {
+        // Brute force distances in increasing order
+        Eigen::VectorXd D = (V.rowwise()-P.row(i)).rowwise().norm();
+        std::sort(D.data(),D.data()+D.size());
+        for(int j = 0;j<k;j++)
+        {
+            REQUIRE((V.row(I(i,j))-P.row(i)).norm() == Approx(D(j)));
+            REQUIRE((V.row(cI(i,j))-P.row(i)).norm() == Approx(D(j)));
+        }
+    }
+
+    // Each point is its own nearest neighbor
+    igl::knn(V,k,PI,CP,cCH,cCN,cW,cI);
+    for(int i = 0;i<V.rows();i++)
+    {
+        REQUIRE(cI(i,0) == i);
+    }
+}
+
+TEST_CASE("knn: radius and approximate", "[igl]")
+{
+    const Eigen::MatrixXd V = Eigen::MatrixXd::Random(3000,3);
+    const Eigen::MatrixXd P = 1.2*Eigen::MatrixXd::Random(500,3);
+    const double radius = 0.15;
+    Eigen::VectorXi PI;
+    Eigen::MatrixXi CP,CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(V,PI,CP,CH,CN,W);
+
+    // All neighbors within radius
+    Eigen::VectorXi N,NI;
+    igl::knn_radius(P,V,radius,PI,CP,CH,CN,W,N,NI);
+    REQUIRE(NI.size() == P.rows()+1);
+    REQUIRE(NI(0) == 0);
+    REQUIRE(N.size() == NI(P.rows()));
+    // k nearest within radius
+    const int k = 5;
+    Eigen::MatrixXi I;
+    const double inf = std::numeric_limits<double>::infinity();
+    igl::knn(P,V,k,radius,0.0,PI,CP,CH,CN,W,I);
+    REQUIRE(I.rows() == P.rows());
+    REQUIRE(I.cols() == k);
+    int num_padded = 0;
+    for(int i = 0;i<P.rows();i++)
+    {
+        Eigen::VectorXd D = (V.rowwise()-P.row(i)).rowwise().norm();
+        const int n = (D.array() <= radius).count();
+        std::sort(D.data(),D.data()+D.size());
+        REQUIRE(NI(i+1)-NI(i) == n);
+        for(int j = 0;j<n;j++)
+        {
+            REQUIRE((V.row(N(NI(i)+j))-P.row(i)).norm() == Approx(D(j)));
+        }
+        for(int j = 0;j<k;j++)
+        {
+            if(j < n)
+            {
+                REQUIRE((V.row(I(i,j))-P.row(i)).norm() == Approx(D(j)));
+            }else
+            {
+                REQUIRE(I(i,j) == -1);
+                num_padded++;
+            }
+        }
+    }
+    // Some queries (outside the cube) should have too few neighbors
+    REQUIRE(num_padded > 0);
+
+    // Approximate neighbors are within a factor of (1+epsilon)
+    const double epsilon = 0.5;
+    igl::knn(P,V,k,inf,epsilon,PI,CP,CH,CN,W,I);
+    for(int i = 0;i<P.rows();i++)
+    {
+        Eigen::VectorXd D = (V.rowwise()-P.row(i)).rowwise().norm();
+        std::sort(D.data(),D.data()+D.size());
+        for(int j = 0;j<k;j++)
+        {
+            REQUIRE(I(i,j) >= 0);
+            REQUIRE((V.row(I(i,j))-P.row(i)).norm() <= (1+epsilon)*D(j)+1e-12);
+        }
+    }
+
+    // Same output for any number of threads
+    igl::ThreadPool & pool = igl::default_thread_pool();
+    const size_t prev = pool.num_threads();
+    pool.resize(1);
+    Eigen::MatrixXi I1;
+    Eigen::VectorXi N1,NI1;
+    igl::knn(P,V,k,inf,epsilon,PI,CP,CH,CN,W,I1);
+    igl::knn_radius(P,V,radius,PI,CP,CH,CN,W,N1,NI1);
+    pool.resize(4);
+    Eigen::MatrixXi I4;
+    Eigen::VectorXi N4,NI4;
+    igl::knn(P,V,k,inf,epsilon,PI,CP,CH,CN,W,I4);
+    igl::knn_radius(P,V,radius,PI,CP,CH,CN,W,N4,NI4);
+    pool.resize(prev);
+    REQUIRE(I1 == I4);
+    REQUIRE(N1 == N4);
+    REQUIRE(NI1 == NI4);
+}
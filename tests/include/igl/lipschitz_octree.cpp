@@ -0,0 +1,117 @@
+#include <test_common.h>
+#include <igl/lipschitz_octree.h>
+#include <igl/unique_sparse_voxel_corners.h>
+#include <functional>
+#include <set>
+#include <array>
+
+TEST_CASE("lipschitz_octree: sphere", "[igl]")
+{
+  const Eigen::RowVector3d center(0.1,-0.05,0.02);
+  const double r = 0.6;
+  const std::function<double(const Eigen::RowVector3d &)> sdf =
+    [&](const Eigen::RowVector3d & p)->double
+  {
+    return (p-center).norm()-r;
+  };
+  const std::function<double(const Eigen::RowVector3d &)> udf =
+    [&](const Eigen::RowVector3d & p)->double
+  {
+    return std::abs(sdf(p));
+  };
+  const Eigen::RowVector3d origin(-1,-1,-1);
+  const double h0 = 2;
+  const int depth = 5;
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk;
+  igl::lipschitz_octree(origin,h0,depth,udf,ijk);
+  REQUIRE(ijk.rows() > 0);
+
+  // Every cell with a sign change at its corners is kept
+  {
+    std::set<std::array<int,3>> kept;
+    for(int c = 0;c<ijk.rows();c++)
+    {
+      kept.insert({ijk(c,0),ijk(c,1),ijk(c,2)});
+    }
+    REQUIRE(kept.size() == (size_t)ijk.rows());
+    const double h = h0/(1<<depth);
+    const auto position = [&](const int i,const int j,const int k)
+    {
+      // ijk subscripts are (y,x,z)
+      return Eigen::RowVector3d(origin + h*Eigen::RowVector3d(j,i,k));
+    };
+    for(int i = 0;i<(1<<depth);i++)
+    for(int j = 0;j<(1<<depth);j++)
+    for(int k = 0;k<(1<<depth);k++)
+    {
+      bool pos = false, neg = false;
+      for(int c = 0;c<8;c++)
+      {
+        const double s = sdf(position(i+(c&1),j+((c>>1)&1),k+((c>>2)&1)));
+        pos = pos || s > 0;
+        neg = neg || s <= 0;
+      }
+      if(pos && neg)
+      {
+        REQUIRE(kept.count({i,j,k}) == 1);
+      }
+    }
+  }
+
+  // Bounded batches give the same cells
+  {
+    Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk_small;
+    igl::lipschitz_octree(origin,h0,depth,udf,100,ijk_small);
+    test_common::assert_eq(ijk_small,ijk);
+  }
+
+  // Batched udf gives the same cells
+  {
+    int max_batch = 0;
+    const std::function<Eigen::VectorXd(
+      const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)>
+      udf_batch = [&](
+        const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & P)
+    {
+      max_batch = std::max<int>(max_batch,P.rows());
+      return ((P.rowwise()-center).rowwise().norm().array()-r)
+        .abs().matrix().eval();
+    };
+    Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk_batch;
+    igl::lipschitz_octree<true>(origin,h0,depth,udf_batch,ijk_batch);
+    test_common::assert_eq(ijk_batch,ijk);
+    REQUIRE(max_batch > 8*50);
+    // At most 8 corners per cell
+    max_batch = 0;
+    igl::lipschitz_octree<true>(origin,h0,depth,udf_batch,50,ijk_batch);
+    test_common::assert_eq(ijk_batch,ijk);
+    REQUIRE(max_batch <= 8*50);
+  }
+}
+
+TEST_CASE("unique_sparse_voxel_corners: shared corners", "[igl]")
+{
+  // Two cells sharing a face and one diagonal neighbor
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk(3,3);
+  ijk<<
+    0,0,0,
+    1,0,0,
+    2,1,1;
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> unique_ijk;
+  Eigen::Matrix<int,Eigen::Dynamic,8,Eigen::RowMajor> J;
+  igl::unique_sparse_voxel_corners(2,ijk,unique_ijk,J);
+  REQUIRE(unique_ijk.rows() == 12+8-1);
+  REQUIRE(J.rows() == 3);
+  for(int c = 0;c<J.rows();c++)
+  {
+    for(int k = 0;k<8;k++)
+    {
+      const Eigen::RowVector3i d = unique_ijk.row(J(c,k)) - ijk.row(c);
+      REQUIRE(d.minCoeff() >= 0);
+      REQUIRE(d.maxCoeff() <= 1);
+    }
+    // All 8 distinct
+    std::set<int> s(J.row(c).data(),J.row(c).data()+8);
+    REQUIRE(s.size() == 8);
+  }
+}
@@ -0,0 +1,90 @@
+#include <test_common.h>
+#include <igl/marching_cubes.h>
+#include <igl/grid.h>
+#include <functional>
+#include <unordered_map>
+
+namespace
+{
+  // Signed distance to a sphere sampled on an nx by ny by nz grid
+  void sphere_grid(
+    const int nx,
+    const int ny,
+    const int nz,
+    Eigen::MatrixXd & GV,
+    Eigen::VectorXd & S)
+  {
+    igl::grid(Eigen::RowVector3i(nx,ny,nz),GV);
+    S = (GV.rowwise()-Eigen::RowVector3d(0.5,0.45,0.55))
+      .rowwise().norm().array()-0.37;
+  }
+}
+
+TEST_CASE("marching_cubes: parallel matches serial", "[igl]")
+{
+  for(const auto & n : {
+    Eigen::RowVector3i(2,2,2),
+    Eigen::RowVector3i(9,7,5),
+    Eigen::RowVector3i(31,33,97)})
+  {
+    Eigen::MatrixXd GV;
+    Eigen::VectorXd S;
+    sphere_grid(n(0),n(1),n(2),GV,S);
+    Eigen::MatrixXd V,V_serial;
+    Eigen::MatrixXi F,F_serial;
+    igl::marching_cubes(S,GV,n(0),n(1),n(2),0.0,V,F);
+    std::unordered_map<std::int64_t,int> E2V;
+    igl::marching_cubes(S,GV,n(0),n(1),n(2),0.0,V_serial,F_serial,E2V);
+    REQUIRE(V.rows() == V_serial.rows());
+    REQUIRE(F.rows() == F_serial.rows());
+    test_common::assert_eq(F,F_serial);
+    test_common::assert_near(V,V_serial,1e-14);
+  }
+}
+
+TEST_CASE("marching_cubes: streaming", "[igl]")
+{
+  const int nx = 23, ny = 19, nz = 71;
+  Eigen::MatrixXd GV;
+  Eigen::VectorXd S;
+  sphere_grid(nx,ny,nz,GV,S);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::marching_cubes(S,GV,nx,ny,nz,0.0,V,F);
+
+  // Evaluate the field slice by slice instead of reading S
+  const std::function<void(
+    int,Eigen::Matrix<double,Eigen::Dynamic,3>&,
+    Eigen::Matrix<double,Eigen::Dynamic,1>&)> slice =
+    [&](
+      const int z,
+      Eigen::Matrix<double,Eigen::Dynamic,3> & GVz,
+      Eigen::Matrix<double,Eigen::Dynamic,1> & Sz)
+  {
+    GVz = GV.middleRows(z*nx*ny,nx*ny);
+    Sz = (GVz.rowwise()-Eigen::RowVector3d(0.5,0.45,0.55))
+      .rowwise().norm().array()-0.37;
+  };
+  Eigen::MatrixXd V_stream(0,3);
+  Eigen::MatrixXi F_stream(0,3);
+  int chunks = 0;
+  const std::function<void(
+    const Eigen::Matrix<double,Eigen::Dynamic,3>&,
+    const Eigen::Matrix<int,Eigen::Dynamic,3>&)> emit =
+    [&](
+      const Eigen::Matrix<double,Eigen::Dynamic,3> & Vc,
+      const Eigen::Matrix<int,Eigen::Dynamic,3> & Fc)
+  {
+    // Only refers to vertices emitted so far
+    REQUIRE((Fc.size() == 0 || Fc.maxCoeff() < V_stream.rows()+Vc.rows()));
+    V_stream.conservativeResize(V_stream.rows()+Vc.rows(),3);
+    V_stream.bottomRows(Vc.rows()) = Vc;
+    F_stream.conservativeResize(F_stream.rows()+Fc.rows(),3);
+    F_stream.bottomRows(Fc.rows()) = Fc;
+    chunks++;
+  };
+  igl::marching_cubes(slice,nx,ny,nz,0.0,emit);
+  REQUIRE(chunks > 1);
+  test_common::assert_eq(F_stream,F);
+  test_common::assert_near(V_stream,V,1e-14);
+}
@@ -0,0 +1,75 @@
+#include <test_common.h>
+#include <igl/marching_tets.h>
+#include <igl/tetrahedralized_grid.h>
+#include <igl/boundary_facets.h>
+#include <igl/ThreadPool.h>
+
+TEST_CASE("marching_tets: sphere", "[igl]")
+{
+  Eigen::MatrixXd TV;
+  Eigen::MatrixXi TT;
+  const int n = 21;
+  igl::tetrahedralized_grid(n,n,n,igl::TETRAHEDRALIZED_GRID_TYPE_5,TV,TT);
+  const Eigen::VectorXd S =
+    (TV.rowwise()-Eigen::RowVector3d(0.5,0.45,0.52)).rowwise().norm().array()-0.3;
+  Eigen::MatrixXd SV;
+  Eigen::MatrixXi SF;
+  Eigen::VectorXi J;
+  Eigen::SparseMatrix<double> BC;
+  igl::marching_tets(TV,TT,S,0.0,SV,SF,J,BC);
+  REQUIRE(SF.rows() > 0);
+  REQUIRE(J.size() == SF.rows());
+  // Closed surface: every edge crossing is shared, not duplicated
+  Eigen::MatrixXi B;
+  igl::boundary_facets(SF,B);
+  REQUIRE(B.rows() == 0);
+  // Vertices are unique and used
+  Eigen::VectorXi count = Eigen::VectorXi::Zero(SV.rows());
+  for(int f = 0;f<SF.rows();f++)
+  {
+    for(int c = 0;c<3;c++) { count(SF(f,c))++; }
+  }
+  REQUIRE(count.minCoeff() > 0);
+  test_common::assert_near(Eigen::MatrixXd(BC*TV),SV,1e-12);
+  REQUIRE((BC*S).cwiseAbs().maxCoeff() < 1e-12);
+  // Each face lies on edges of its tet
+  const Eigen::SparseMatrix<double> BCt = BC.transpose();
+  for(int f = 0;f<SF.rows();f++)
+  {
+    REQUIRE(J(f) >= 0);
+    REQUIRE(J(f) < TT.rows());
+    for(int c = 0;c<3;c++)
+    {
+      for(Eigen::SparseMatrix<double>::InnerIterator it(BCt,SF(f,c));it;++it)
+      {
+        REQUIRE((TT.row(J(f)).array() == it.row()).any());
+      }
+    }
+  }
+  // Vertices are numbered in order of first use by the faces (like the
+  // serial algorithm)
+  {
+    int next = 0;
+    for(int f = 0;f<SF.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        REQUIRE(SF(f,c) <= next);
+        if(SF(f,c) == next) { next++; }
+      }
+    }
+  }
+
+  // Same output on any number of threads
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const unsigned int prev = pool.num_threads();
+  pool.resize(4);
+  Eigen::MatrixXd SV4;
+  Eigen::MatrixXi SF4;
+  Eigen::VectorXi J4;
+  igl::marching_tets(TV,TT,S,0.0,SV4,SF4,J4);
+  pool.resize(prev);
+  REQUIRE(SF4 == SF);
+  REQUIRE(J4 == J);
+  REQUIRE(SV4 == SV);
+}
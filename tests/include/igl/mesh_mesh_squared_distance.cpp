@@ -0,0 +1,114 @@
+#include <test_common.h>
+#include <igl/mesh_mesh_squared_distance.h>
+#include <igl/triangle_triangle_squared_distance.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/ThreadPool.h>
+#include <limits>
+
+namespace
+{
+  void sphere(const int levels, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    for(int l = 0;l<levels;l++)
+    {
+      igl::upsample(V,F);
+      V.rowwise().normalize();
+    }
+  }
+
+  double brute_force(
+    const Eigen::MatrixXd & VA, const Eigen::MatrixXi & FA,
+    const Eigen::MatrixXd & VB, const Eigen::MatrixXi & FB)
+  {
+    double sqr_d = std::numeric_limits<double>::infinity();
+    for(int a = 0;a<FA.rows();a++)
+    {
+      for(int b = 0;b<FB.rows();b++)
+      {
+        Eigen::RowVector3d ca,cb;
+        sqr_d = std::min(sqr_d,igl::triangle_triangle_squared_distance(
+          Eigen::RowVector3d(VA.row(FA(a,0))),
+          Eigen::RowVector3d(VA.row(FA(a,1))),
+          Eigen::RowVector3d(VA.row(FA(a,2))),
+          Eigen::RowVector3d(VB.row(FB(b,0))),
+          Eigen::RowVector3d(VB.row(FB(b,1))),
+          Eigen::RowVector3d(VB.row(FB(b,2))),
+          ca,cb));
+      }
+    }
+    return sqr_d;
+  }
+}
+
+TEST_CASE("triangle_triangle_squared_distance: cases", "[igl]")
+{
+  const Eigen::RowVector3d p1(0,0,0),q1(1,0,0),r1(0,1,0);
+  Eigen::RowVector3d c1,c2;
+  // Parallel, directly above
+  REQUIRE(igl::triangle_triangle_squared_distance(
+    p1,q1,r1,
+    Eigen::RowVector3d(0.1,0.1,2),Eigen::RowVector3d(0.5,0.1,2),
+    Eigen::RowVector3d(0.1,0.5,2),c1,c2) == Approx(4.0));
+  REQUIRE((c1-c2).squaredNorm() == Approx(4.0));
+  // Vertex above interior
+  REQUIRE(igl::triangle_triangle_squared_distance(
+    p1,q1,r1,
+    Eigen::RowVector3d(0.2,0.2,0.5),Eigen::RowVector3d(0,0,3),
+    Eigen::RowVector3d(1,1,3),c1,c2) == Approx(0.25));
+  REQUIRE(c1.isApprox(Eigen::RowVector3d(0.2,0.2,0)));
+  // Skew edges
+  REQUIRE(igl::triangle_triangle_squared_distance(
+    p1,q1,r1,
+    Eigen::RowVector3d(2,-1,1),Eigen::RowVector3d(2,1,1),
+    Eigen::RowVector3d(3,0,5),c1,c2) == Approx(2.0));
+  // Piercing (no vertex or edge pair is close)
+  REQUIRE(igl::triangle_triangle_squared_distance(
+    Eigen::RowVector3d(-5,-5,0),Eigen::RowVector3d(5,-5,0),
+    Eigen::RowVector3d(0,5,0),
+    Eigen::RowVector3d(0,0,-1),Eigen::RowVector3d(0.1,0,1),
+    Eigen::RowVector3d(-0.1,0.1,1),c1,c2) == 0);
+  REQUIRE(std::abs(c1(2)) < 1e-12);
+  REQUIRE(c1 == c2);
+}
+
+TEST_CASE("mesh_mesh_squared_distance: spheres", "[igl]")
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  sphere(3,VA,FA);
+  sphere(2,VB,FB);
+  VB = (0.5*VB).rowwise() + Eigen::RowVector3d(1.7,0.3,-0.2);
+  int fa,fb;
+  Eigen::RowVector3d ca,cb;
+  const double sqr_d =
+    igl::mesh_mesh_squared_distance(VA,FA,VB,FB,fa,fb,ca,cb);
+  REQUIRE(sqr_d > 0);
+  REQUIRE(sqr_d == Approx(brute_force(VA,FA,VB,FB)));
+  REQUIRE((ca-cb).squaredNorm() == Approx(sqr_d));
+  // Centers are ~1.75 apart, radii 1 and 0.5
+  REQUIRE(std::sqrt(sqr_d) == Approx(0.25).margin(0.03));
+
+  // Same closest pair for any number of threads
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const size_t prev = pool.num_threads();
+  pool.resize(4);
+  int fa4,fb4;
+  Eigen::RowVector3d ca4,cb4;
+  REQUIRE(igl::mesh_mesh_squared_distance(VA,FA,VB,FB,fa4,fb4,ca4,cb4) ==
+    sqr_d);
+  pool.resize(prev);
+  REQUIRE(fa4 == fa);
+  REQUIRE(fb4 == fb);
+
+  // Overlapping meshes
+  VB.rowwise() -= Eigen::RowVector3d(0.5,0,0);
+  REQUIRE(igl::mesh_mesh_squared_distance(VA,FA,VB,FB,fa,fb,ca,cb) == 0);
+
+  // Empty mesh
+  const Eigen::MatrixXi FE(0,3);
+  REQUIRE(std::isinf(
+    igl::mesh_mesh_squared_distance(VA,FA,VB,FE,fa,fb,ca,cb)));
+  REQUIRE(fa == -1);
+}
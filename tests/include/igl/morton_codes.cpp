@@ -0,0 +1,40 @@
+#include <test_common.h>
+#include <igl/morton_codes.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("morton_codes: order", "[igl]")
+{
+  Eigen::MatrixXd P(4,2);
+  P<<
+    1,1,
+    0,0,
+    1,0,
+    0,1;
+  Eigen::VectorXi I;
+  igl::morton_order(P,I);
+  // Z-order: (0,0), (1,0), (0,1), (1,1)
+  REQUIRE(I(0) == 1);
+  REQUIRE(I(1) == 2);
+  REQUIRE(I(2) == 3);
+  REQUIRE(I(3) == 0);
+}
+
+TEST_CASE("morton_codes: stable_sort", "[igl]")
+{
+  // Enough points for several radix sort blocks and plenty of duplicates
+  const int n = 100000;
+  Eigen::MatrixXd P = (8*Eigen::MatrixXd::Random(n,3)).array().round();
+  Eigen::Matrix<std::uint64_t,Eigen::Dynamic,1> C;
+  igl::morton_codes(P,C);
+  std::vector<int> J(n);
+  std::iota(J.begin(),J.end(),0);
+  std::stable_sort(J.begin(),J.end(),
+    [&C](const int a, const int b){ return C(a) < C(b); });
+  Eigen::VectorXi I;
+  igl::morton_order(P,I);
+  REQUIRE(I.size() == n);
+  for(int i = 0;i<n;i++) { REQUIRE(I(i) == J[i]); }
+}
@@ -0,0 +1,81 @@
+#include <test_common.h>
+#include <igl/narrow_band_signed_distance.h>
+#include <igl/signed_distance.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/grid.h>
+
+TEST_CASE("narrow_band_signed_distance: sphere", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,3);
+  V.rowwise().normalize();
+  // Not a multiple of the brick size
+  const Eigen::RowVector3i res(45,40,37);
+  const double h = 3.0/40.0;
+  const Eigen::RowVector3d origin(-1.6,-1.5,-1.4);
+  const double band = 2.5*h;
+  // Dense reference
+  Eigen::MatrixXd GV;
+  igl::grid(res,GV);
+  GV = ((GV.array().rowwise()*(res.cast<double>().array()-1)*h).rowwise() +
+    origin.array()).matrix();
+  for(const igl::SignedDistanceType type :
+    {
+      igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,
+      igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER,
+      igl::SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER,
+      igl::SIGNED_DISTANCE_TYPE_UNSIGNED
+    })
+  {
+    Eigen::VectorXd S;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C,N;
+    igl::signed_distance(GV,V,F,type,S,I,C,N);
+    igl::SparseBrickGrid<double> G;
+    igl::narrow_band_signed_distance(V,F,origin,h,res,band,type,G);
+    // Only bricks near the sphere are stored
+    REQUIRE(G.num_active() > 0);
+    REQUIRE(G.num_active() < G.brick_res.prod());
+    Eigen::VectorXd NS;
+    G.dense(NS);
+    REQUIRE(NS.size() == S.size());
+    for(int i = 0;i<S.size();i++)
+    {
+      // Winding number signs scale S by |1-2w|≈1, so skip a sliver at the
+      // edge of the band
+      if(std::abs(S(i)) < band-1e-4)
+      {
+        REQUIRE(NS(i) == Approx(S(i)).margin(1e-6));
+      }else if(std::abs(S(i)) > band+1e-4)
+      {
+        REQUIRE(std::abs(NS(i)) == band);
+        REQUIRE((NS(i) < 0) == (S(i) < 0));
+      }
+    }
+  }
+}
+
+TEST_CASE("narrow_band_signed_distance: far", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  const Eigen::RowVector3i res(20,20,20);
+  const double h = 0.01;
+  igl::SparseBrickGrid<double> G;
+  // Grid entirely inside the mesh
+  igl::narrow_band_signed_distance(
+    V,F,Eigen::RowVector3d(-0.1,-0.1,-0.1),h,res,2*h,
+    igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,G);
+  REQUIRE(G.num_active() == 0);
+  REQUIRE(G(3,4,5) == -2*h);
+  // Grid entirely outside the mesh
+  igl::narrow_band_signed_distance(
+    V,F,Eigen::RowVector3d(5,5,5),h,res,2*h,
+    igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER,G);
+  REQUIRE(G.num_active() == 0);
+  REQUIRE(G(3,4,5) == 2*h);
+}
@@ -0,0 +1,126 @@
+#include <test_common.h>
+#include <igl/octree.h>
+#include <igl/ThreadPool.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+TEST_CASE("octree: compact layout matches point_indices", "[igl]")
+{
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(2000,3);
+  std::vector<std::vector<int> > point_indices;
+  Eigen::MatrixXi CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,point_indices,CH,CN,W);
+
+  Eigen::VectorXi PI;
+  Eigen::MatrixXi CP,cCH;
+  Eigen::MatrixXd cCN;
+  Eigen::VectorXd cW;
+  igl::octree(P,PI,CP,cCH,cCN,cW);
+  // Cell numbering differs, so compare the sets of cells
+  REQUIRE(cCH.rows() == CH.rows());
+  REQUIRE(CP.rows() == cCH.rows());
+  REQUIRE(CP(0,0) == 0);
+  REQUIRE(CP(0,1) == P.rows());
+  {
+    std::vector<int> sorted_PI(PI.data(),PI.data()+PI.size());
+    std::sort(sorted_PI.begin(),sorted_PI.end());
+    for(int i = 0;i<P.rows();i++) { REQUIRE(sorted_PI[i] == i); }
+  }
+  typedef std::pair<std::vector<double>,std::vector<int> > Cell;
+  const auto cell = [](
+    const Eigen::MatrixXd & CN,const Eigen::VectorXd & W,const int c,
+    std::vector<int> points)
+  {
+    std::sort(points.begin(),points.end());
+    return Cell({CN(c,0),CN(c,1),CN(c,2),W(c)},points);
+  };
+  std::set<Cell> cells,compact_cells;
+  for(int c = 0;c<CH.rows();c++)
+  {
+    cells.insert(cell(CN,W,c,point_indices[c]));
+    compact_cells.insert(cell(cCN,cW,c,
+      std::vector<int>(PI.data()+CP(c,0),PI.data()+CP(c,0)+CP(c,1))));
+  }
+  REQUIRE(cells == compact_cells);
+  // Children partition their parent's range in octant order
+  for(int c = 0;c<cCH.rows();c++)
+  {
+    if(cCH(c,0) == -1)
+    {
+      REQUIRE(CP(c,1) <= 1);
+      continue;
+    }
+    int offset = CP(c,0);
+    for(int j = 0;j<8;j++)
+    {
+      const int d = cCH(c,j);
+      REQUIRE(d > c);
+      REQUIRE(CP(d,0) == offset);
+      offset += CP(d,1);
+      for(int k = CP(d,0);k<CP(d,0)+CP(d,1);k++)
+      {
+        for(int a = 0;a<3;a++)
+        {
+          REQUIRE(P(PI(k),a) >= cCN(d,a)-cW(d)/2-1e-12);
+          REQUIRE(P(PI(k),a) <= cCN(d,a)+cW(d)/2+1e-12);
+        }
+      }
+    }
+    REQUIRE(offset == CP(c,0)+CP(c,1));
+  }
+}
+
+TEST_CASE("octree: compact layout duplicates", "[igl]")
+{
+  // Coincident points share a leaf instead of being split forever
+  Eigen::MatrixXd P(5,3);
+  P<<
+    0,0,0,
+    1,1,1,
+    1,1,1,
+    0.5,0.2,0.1,
+    1,1,1;
+  Eigen::VectorXi PI;
+  Eigen::MatrixXi CP,CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,PI,CP,CH,CN,W);
+  int leaves_with_duplicates = 0;
+  for(int c = 0;c<CH.rows();c++)
+  {
+    if(CH(c,0) == -1 && CP(c,1) > 1)
+    {
+      leaves_with_duplicates++;
+      REQUIRE(CP(c,1) == 3);
+      for(int k = CP(c,0);k<CP(c,0)+CP(c,1);k++)
+      {
+        REQUIRE(P.row(PI(k)) == Eigen::RowVector3d(1,1,1));
+      }
+    }
+  }
+  REQUIRE(leaves_with_duplicates == 1);
+}
+
+TEST_CASE("octree: compact layout deterministic", "[igl]")
+{
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(50000,3).array().cube();
+  Eigen::VectorXi PI1,PI8;
+  Eigen::MatrixXi CP1,CH1,CP8,CH8;
+  Eigen::MatrixXd CN1,CN8;
+  Eigen::VectorXd W1,W8;
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const size_t prev = pool.num_threads();
+  pool.resize(1);
+  igl::octree(P,PI1,CP1,CH1,CN1,W1);
+  pool.resize(8);
+  igl::octree(P,PI8,CP8,CH8,CN8,W8);
+  pool.resize(prev);
+  REQUIRE(PI1 == PI8);
+  REQUIRE(CP1 == CP8);
+  REQUIRE(CH1 == CH8);
+  REQUIRE(CN1 == CN8);
+  REQUIRE(W1 == W8);
+}
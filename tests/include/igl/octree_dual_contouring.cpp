@@ -0,0 +1,107 @@
+#include <test_common.h>
+#include <igl/octree_dual_contouring.h>
+#include <igl/dual_contouring.h>
+#include <igl/doublearea.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/ThreadPool.h>
+#include <functional>
+
+TEST_CASE("octree_dual_contouring: sphere", "[igl]")
+{
+  const Eigen::RowVector3d center(0.1,-0.05,0.02);
+  const double r = 0.6;
+  const std::function<double(const Eigen::RowVector3d &)> sdf =
+    [&](const Eigen::RowVector3d & p)->double
+  {
+    return (p-center).norm()-r;
+  };
+  const std::function<Eigen::RowVector3d(const Eigen::RowVector3d &)> sdf_grad =
+    [&](const Eigen::RowVector3d & p)->Eigen::RowVector3d
+  {
+    return (p-center).normalized();
+  };
+  const Eigen::RowVector3d origin(-1,-1,-1);
+  const double h0 = 2;
+  const int depth = 5;
+  const auto area = [](const Eigen::MatrixXd & V, const Eigen::MatrixXi & F)
+  {
+    Eigen::VectorXd A;
+    igl::doublearea(V,F,A);
+    return 0.5*A.sum();
+  };
+
+  // Without collapsing, same surface as dense dual contouring
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::octree_dual_contouring(
+    origin,h0,depth,sdf,sdf_grad,0.0,false,true,V,F);
+  REQUIRE(F.rows() > 0);
+  REQUIRE(igl::is_edge_manifold(F));
+  {
+    const int n = (1<<depth)+1;
+    Eigen::MatrixXd dV;
+    Eigen::MatrixXi dQ;
+    igl::dual_contouring(
+      sdf,sdf_grad,origin,Eigen::RowVector3d(origin.array()+h0),n,n,n,
+      false,false,true,dV,dQ);
+    REQUIRE(F.rows() == 2*dQ.rows());
+    REQUIRE(V.rows() == dV.rows());
+    Eigen::MatrixXi dF(2*dQ.rows(),3);
+    dF << dQ.col(0),dQ.col(1),dQ.col(2),
+          dQ.col(0),dQ.col(2),dQ.col(3);
+    REQUIRE(area(V,F) == Approx(area(dV,dF)).epsilon(1e-10));
+  }
+
+  // Collapsing flat regions of a sphere needs a tolerance on the order of
+  // the curvature over the cell size
+  Eigen::MatrixXd cV;
+  Eigen::MatrixXi cF;
+  igl::octree_dual_contouring(
+    origin,h0,depth,sdf,sdf_grad,1e-3,false,true,cV,cF);
+  REQUIRE(cF.rows() > 0);
+  REQUIRE(cF.rows() < F.rows());
+  for(int v = 0;v<cV.rows();v++)
+  {
+    REQUIRE(std::abs(sdf(cV.row(v))) < 1e-2);
+  }
+  // Every vertex is used
+  {
+    Eigen::VectorXi count = Eigen::VectorXi::Zero(cV.rows());
+    for(int f = 0;f<cF.rows();f++) { for(int c = 0;c<3;c++) { count(cF(f,c))++; } }
+    REQUIRE(count.minCoeff() > 0);
+  }
+
+  // Batched calls give the same result
+  const std::function<Eigen::VectorXd(const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)> sdf_batch =
+    [&](const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & P)->Eigen::VectorXd
+  {
+    return (P.rowwise()-center).rowwise().norm().array()-r;
+  };
+  const std::function<Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor>(const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)> sdf_grad_batch =
+    [&](const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & P)
+  {
+    return Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor>(
+      (P.rowwise()-center).rowwise().normalized());
+  };
+  Eigen::MatrixXd bV;
+  Eigen::MatrixXi bF;
+  igl::octree_dual_contouring<true>(
+    origin,h0,depth,sdf_batch,sdf_grad_batch,1e-3,false,true,bV,bF);
+  REQUIRE(bF == cF);
+  test_common::assert_near(bV,cV,1e-12);
+
+  // Same output on any number of threads
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const unsigned int prev = pool.num_threads();
+  pool.resize(4);
+  Eigen::MatrixXd tV;
+  Eigen::MatrixXi tF;
+  igl::octree_dual_contouring(
+    origin,h0,depth,sdf,sdf_grad,1e-3,true,true,tV,tF);
+  pool.resize(1);
+  igl::octree_dual_contouring(
+    origin,h0,depth,sdf,sdf_grad,1e-3,true,true,cV,cF);
+  pool.resize(prev);
+  REQUIRE(tF == cF);
+  REQUIRE(tV == cV);
+}
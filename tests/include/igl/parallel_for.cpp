@@ -0,0 +1,100 @@
+#include <test_common.h>
+#include <igl/parallel_for.h>
+#include <igl/ThreadPool.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("parallel_for: every iteration once", "[igl]")
+{
+  const int n = 100000;
+  std::vector<int> count(n,0);
+  igl::parallel_for(n,[&count](const int i){ count[i]++; },1000);
+  for(int i = 0;i<n;i++) { REQUIRE(count[i] == 1); }
+}
+
+TEST_CASE("parallel_for: accumulation", "[igl]")
+{
+  const long n = 123457;
+  std::vector<long> S;
+  long sum = 0;
+  igl::parallel_for(
+    n,
+    [&S](const size_t nt){ S.assign(nt,0); },
+    [&S](const long i, const size_t t){ S[t] += i; },
+    [&S,&sum](const size_t t){ sum += S[t]; },
+    0);
+  REQUIRE(sum == n*(n-1)/2);
+}
+
+TEST_CASE("parallel_for: nested", "[igl]")
+{
+  const int m = 64;
+  const int n = 1000;
+  std::atomic<long> total(0);
+  igl::parallel_for(m,[&](const int)
+  {
+    igl::parallel_for(n,[&](const int j){ total += j; },0);
+  },0);
+  REQUIRE(total == long(m)*n*(n-1)/2);
+}
+
+TEST_CASE("ThreadPool: resize", "[igl]")
+{
+  igl::ThreadPool pool(3);
+  REQUIRE(pool.num_threads() == 3);
+  pool.resize(5);
+  REQUIRE(pool.num_threads() == 5);
+  std::vector<int> count(10000,0);
+  std::vector<size_t> T(count.size(),0);
+  pool.run(count.size(),7,5,[&](const size_t a, const size_t b, const size_t t)
+  {
+    for(size_t i = a;i<b;i++) { count[i]++; T[i] = t; }
+  });
+  for(const int c : count) { REQUIRE(c == 1); }
+  for(const size_t t : T) { REQUIRE(t < 5); }
+  pool.resize(1);
+  REQUIRE(pool.num_threads() == 1);
+}
+
+TEST_CASE("ThreadPool: exception", "[igl]")
+{
+  igl::ThreadPool pool(4);
+  REQUIRE_THROWS_AS(
+    pool.run(1000,1,4,[](const size_t a, const size_t, const size_t)
+    {
+      if(a == 500) { throw std::runtime_error("boom"); }
+    }),
+    std::runtime_error);
+}
+
+TEST_CASE("parallel_for: policy", "[igl]")
+{
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const unsigned int prev = pool.num_threads();
+  pool.resize(4);
+  for(int s = 0;s<igl::NUM_PARALLEL_FOR_SCHEDULES;s++)
+  {
+    igl::ParallelForPolicy policy;
+    policy.schedule = static_cast<igl::ParallelForSchedule>(s);
+    policy.grain_size = 3;
+    policy.max_concurrency = 2;
+    const int n = 10007;
+    std::vector<int> count(n,0);
+    size_t num_slots = 0;
+    std::vector<size_t> T(n,0);
+    REQUIRE(igl::parallel_for(
+      n,
+      [&num_slots](const size_t nt){ num_slots = nt; },
+      [&](const int i, const size_t t){ count[i]++; T[i] = t; },
+      [](const size_t){},
+      policy));
+    REQUIRE(num_slots == 2);
+    for(int i = 0;i<n;i++)
+    {
+      REQUIRE(count[i] == 1);
+      REQUIRE(T[i] < 2);
+    }
+  }
+  pool.resize(prev);
+}
@@ -0,0 +1,71 @@
+#include <test_common.h>
+#include <igl/point_mesh_squared_distance.h>
+#include <igl/AABB.h>
+#include <igl/signed_distance.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+
+TEST_CASE("point_mesh_squared_distance: float", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,3);
+  V.rowwise().normalize();
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(1000,3);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  igl::point_mesh_squared_distance(P,V,F,sqrD,I,C);
+
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  const Eigen::MatrixXf Pf = P.cast<float>();
+  Eigen::VectorXf sqrDf;
+  Eigen::VectorXi If;
+  Eigen::MatrixXf Cf;
+  igl::point_mesh_squared_distance(Pf,Vf,F,sqrDf,If,Cf);
+  test_common::assert_near(sqrDf.cast<double>().eval(),sqrD,1e-5);
+
+  // Signed distance through a float tree
+  Eigen::VectorXf Sf;
+  Eigen::MatrixXf Nf;
+  igl::signed_distance(
+    Pf,Vf,F,igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,Sf,If,Cf,Nf);
+  Eigen::VectorXd S;
+  Eigen::MatrixXd N;
+  igl::signed_distance(
+    P,V,F,igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,S,I,C,N);
+  test_common::assert_near(Sf.cast<double>().eval(),S,1e-5);
+}
+
+TEST_CASE("point_mesh_squared_distance: mixed_precision", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(V,F,3);
+  V.rowwise().normalize();
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(1000,3);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  igl::point_mesh_squared_distance(P,V,F,sqrD,I,C);
+
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  igl::AABB<Eigen::MatrixXf,3> tree;
+  tree.init(Vf,F);
+  Eigen::VectorXd msqrD;
+  Eigen::VectorXi mI;
+  Eigen::MatrixXd mC;
+  igl::point_mesh_squared_distance(P,V,F,Vf,tree,msqrD,mI,mC);
+  REQUIRE(msqrD.size() == P.rows());
+  REQUIRE(mC.rows() == P.rows());
+  // Each refined distance is exact for the primitive found, and that
+  // primitive is closest up to float rounding
+  for(int p = 0;p<P.rows();p++)
+  {
+    REQUIRE(msqrD(p) >= sqrD(p)-1e-12);
+    REQUIRE(msqrD(p) <= sqrD(p)+1e-5);
+    REQUIRE((P.row(p)-mC.row(p)).squaredNorm() == Approx(msqrD(p)));
+  }
+}
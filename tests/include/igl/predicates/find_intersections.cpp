@@ -1,11 +1,18 @@
 #include "test_common.h"
 #include <igl/predicates/find_intersections.h>
+#include <igl/predicates/triangle_triangle_intersect.h>
+#include <igl/AABB.h>
+#include <igl/ThreadPool.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 #include <igl/combine.h>
 #include <igl/triangle_triangle_intersect.h>
 #include <igl/unique.h>
 #include <igl/sortrows.h>
 #include <igl/matlab_format.h>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 
 
@@ -80,3 +87,100 @@ TEST_CASE("find_intersections: extract", "[igl/predicates]")
   test_common::assert_near_rows(EV,EV_gt,0);
   REQUIRE( EE.rows() == 2);
 }
+
+TEST_CASE("find_intersections: prebuilt trees", "[igl/predicates]")
+{
+  Eigen::MatrixXd V1,V2;
+  Eigen::MatrixXi F1,F2;
+  igl::icosahedron(V1,F1);
+  for(int l = 0;l<3;l++)
+  {
+    igl::upsample(V1,F1);
+    V1.rowwise().normalize();
+  }
+  V2 = (0.6*V1).rowwise() + Eigen::RowVector3d(1.2,0.1,0);
+  F2 = F1;
+  igl::AABB<Eigen::MatrixXd,3> tree1,tree2;
+  tree1.init(V1,F1);
+  tree2.init(V2,F2);
+
+  // Brute force
+  std::vector<std::pair<int,int> > expected;
+  for(int f1 = 0;f1<F1.rows();f1++)
+  {
+    for(int f2 = 0;f2<F2.rows();f2++)
+    {
+      bool coplanar;
+      if(igl::predicates::triangle_triangle_intersect(
+        Eigen::RowVector3d(V2.row(F2(f2,0))),
+        Eigen::RowVector3d(V2.row(F2(f2,1))),
+        Eigen::RowVector3d(V2.row(F2(f2,2))),
+        Eigen::RowVector3d(V1.row(F1(f1,0))),
+        Eigen::RowVector3d(V1.row(F1(f1,1))),
+        Eigen::RowVector3d(V1.row(F1(f1,2))),
+        coplanar))
+      {
+        expected.emplace_back(f1,f2);
+      }
+    }
+  }
+  REQUIRE(expected.size() > 0);
+
+  igl::ThreadPool & pool = igl::default_thread_pool();
+  const size_t prev = pool.num_threads();
+  for(const size_t threads : {1,4})
+  {
+    pool.resize(threads);
+    Eigen::MatrixXi IF;
+    Eigen::Array<bool,Eigen::Dynamic,1> CP;
+    REQUIRE(igl::predicates::find_intersections(
+      tree1,V1,F1,tree2,V2,F2,false,IF,CP));
+    REQUIRE(IF.rows() == Eigen::Index(expected.size()));
+    for(int i = 0;i<IF.rows();i++)
+    {
+      REQUIRE(IF(i,0) == expected[i].first);
+      REQUIRE(IF(i,1) == expected[i].second);
+    }
+    // Stopping early still finds something
+    REQUIRE(igl::predicates::find_intersections(
+      tree1,V1,F1,tree2,V2,F2,true,IF,CP));
+    REQUIRE(IF.rows() >= 1);
+    // Moved apart
+    const Eigen::MatrixXd V3 =
+      V2.rowwise() + Eigen::RowVector3d(1,0,0);
+    igl::AABB<Eigen::MatrixXd,3> tree3;
+    tree3.init(V3,F2);
+    REQUIRE(!igl::predicates::find_intersections(
+      tree1,V1,F1,tree3,V3,F2,false,IF,CP));
+    REQUIRE(IF.rows() == 0);
+  }
+  pool.resize(prev);
+}
+
+TEST_CASE("find_intersections: self with one tree", "[igl/predicates]")
+{
+  Eigen::MatrixXd VA;
+  Eigen::MatrixXi FA;
+  igl::icosahedron(VA,FA);
+  for(int l = 0;l<2;l++)
+  {
+    igl::upsample(VA,FA);
+    VA.rowwise().normalize();
+  }
+  const Eigen::MatrixXd VB = VA.rowwise() + Eigen::RowVector3d(0.5,0.1,0);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::combine<Eigen::MatrixXd,Eigen::MatrixXi>({VA,VB},{FA,FA},V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree,copy;
+  tree.init(V,F);
+  copy.init(V,F);
+  Eigen::MatrixXi IF,IF_copy;
+  Eigen::Array<bool,Eigen::Dynamic,1> CP,CP_copy;
+  // Same mesh objects reuse tree as the second tree
+  REQUIRE(igl::predicates::find_intersections(tree,V,F,V,F,false,IF,CP));
+  REQUIRE(igl::predicates::find_intersections(
+    tree,V,F,copy,V,F,false,IF_copy,CP_copy));
+  REQUIRE(IF.rows() > 0);
+  REQUIRE(IF == IF_copy);
+  REQUIRE((CP == CP_copy).all());
+}
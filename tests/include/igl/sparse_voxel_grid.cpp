@@ -1,5 +1,7 @@
 #include <test_common.h>
 #include <igl/sparse_voxel_grid.h>
+#include <igl/marching_cubes.h>
+#include <igl/boundary_facets.h>
 #include <igl/unique_rows.h>
 
 TEST_CASE("sparse_voxel_grid: unique", "[igl]" )
@@ -20,3 +22,51 @@ TEST_CASE("sparse_voxel_grid: unique", "[igl]" )
   REQUIRE(GV.rows() == uGV.rows());
 }
 
+TEST_CASE("sparse_voxel_grid: batched", "[igl]" )
+{
+  const Eigen::RowVector3d center(0.01,0.02,-0.03);
+  const std::function<double(const Eigen::RowVector3d & x)> f = 
+    [&](const Eigen::RowVector3d & x)->double
+  {
+    return (x-center).norm() - 1.0;
+  };
+  int calls = 0;
+  const std::function<Eigen::VectorXd(
+    const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)> f_batch =
+    [&](const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & X)
+  {
+    calls++;
+    return ((X.rowwise()-center).rowwise().norm().array() - 1.0).matrix().eval();
+  };
+  const Eigen::RowVector3d p0(center(0),center(1)+1.0,center(2));
+  const double eps = 0.05;
+  Eigen::MatrixXd GV,bGV;
+  Eigen::VectorXd Gf,bGf;
+  Eigen::Matrix<int,Eigen::Dynamic,8> GI,bGI;
+  igl::sparse_voxel_grid(p0,f,eps,1024,Gf,GV,GI);
+  igl::sparse_voxel_grid<true>(p0,f_batch,eps,1024,bGf,bGV,bGI);
+  // One call per layer of cubes, not per point
+  REQUIRE(calls > 1);
+  REQUIRE(calls < GV.rows()/10);
+  test_common::assert_eq(GI,bGI);
+  test_common::assert_near(GV,bGV,1e-15);
+  test_common::assert_near(Gf,bGf,1e-15);
+  // Every cube crosses the surface and no corner is duplicated
+  for(int c = 0;c<GI.rows();c++)
+  {
+    REQUIRE(Gf(GI.row(c)).minCoeff() <= 0);
+    REQUIRE(Gf(GI.row(c)).maxCoeff() >= 0);
+  }
+  Eigen::MatrixXd uGV;
+  Eigen::VectorXi _1,_2;
+  igl::unique_rows(GV,uGV,_1,_2);
+  REQUIRE(GV.rows() == uGV.rows());
+  // Whole shell is found: marching cubes gives a closed surface
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::marching_cubes(Gf,GV,GI,0.0,V,F);
+  REQUIRE(F.rows() > 0);
+  Eigen::MatrixXi B;
+  igl::boundary_facets(F,B);
+  REQUIRE(B.rows() == 0);
+}
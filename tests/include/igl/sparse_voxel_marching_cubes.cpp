@@ -0,0 +1,108 @@
+#include <test_common.h>
+#include <igl/sparse_voxel_marching_cubes.h>
+#include <igl/lipschitz_octree.h>
+#include <igl/marching_cubes.h>
+#include <igl/boundary_facets.h>
+#include <igl/grid.h>
+#include <igl/PI.h>
+#include <functional>
+
+namespace
+{
+  // Signed volume enclosed by a closed triangle mesh
+  template <typename DerivedV, typename DerivedF>
+  double enclosed_volume(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F)
+  {
+    double vol = 0;
+    for(int f = 0;f<F.rows();f++)
+    {
+      const Eigen::RowVector3d a = V.row(F(f,0));
+      const Eigen::RowVector3d b = V.row(F(f,1));
+      const Eigen::RowVector3d c = V.row(F(f,2));
+      vol += a.dot(b.cross(c))/6.0;
+    }
+    return vol;
+  }
+}
+
+TEST_CASE("sparse_voxel_marching_cubes: sphere", "[igl]")
+{
+  const Eigen::RowVector3d center(0.1,-0.05,0.02);
+  const double r = 0.6;
+  const std::function<double(const Eigen::RowVector3d &)> sdf =
+    [&](const Eigen::RowVector3d & p)->double
+  {
+    return (p-center).norm()-r;
+  };
+  const std::function<double(const Eigen::RowVector3d &)> udf =
+    [&](const Eigen::RowVector3d & p)->double
+  {
+    return std::abs(sdf(p));
+  };
+  const Eigen::RowVector3d origin(-1,-1,-1);
+  const double h0 = 2;
+  const int depth = 5;
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk;
+  igl::lipschitz_octree(origin,h0,depth,udf,ijk);
+  // Far fewer cells than the dense grid
+  REQUIRE(ijk.rows() > 0);
+  REQUIRE(ijk.rows() < (1<<(3*depth))/4);
+
+  Eigen::Matrix<double,Eigen::Dynamic,3> V;
+  Eigen::Matrix<int,Eigen::Dynamic,3> F;
+  igl::sparse_voxel_marching_cubes(origin,h0,depth,sdf,ijk,V,F);
+  REQUIRE(F.rows() > 0);
+
+  // Watertight
+  Eigen::MatrixXi B;
+  igl::boundary_facets(F,B);
+  REQUIRE(B.rows() == 0);
+  // On the surface
+  const double h = h0/(1<<depth);
+  for(int v = 0;v<V.rows();v++)
+  {
+    REQUIRE(std::abs(sdf(V.row(v))) < h);
+  }
+
+  // Same vertices as dense marching cubes on the same grid (the sparse corner
+  // ordering can split ambiguous cubes differently, so compare volumes)
+  {
+    const int n = (1<<depth)+1;
+    Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> GV;
+    igl::grid(Eigen::RowVector3i(n,n,n),GV);
+    GV *= h0;
+    GV.rowwise() += origin;
+    Eigen::VectorXd S(GV.rows());
+    for(int i = 0;i<GV.rows();i++)
+    {
+      S(i) = sdf(GV.row(i));
+    }
+    Eigen::Matrix<double,Eigen::Dynamic,3> dV;
+    Eigen::Matrix<int,Eigen::Dynamic,3> dF;
+    igl::marching_cubes(S,GV,n,n,n,0.0,dV,dF);
+    REQUIRE(F.rows() == dF.rows());
+    REQUIRE(V.rows() == dV.rows());
+    const double vol = enclosed_volume(V,F);
+    const double dvol = enclosed_volume(dV,dF);
+    REQUIRE(vol == Approx(dvol).epsilon(1e-4));
+    REQUIRE(std::abs(vol) == Approx(4./3.*igl::PI*r*r*r).epsilon(0.05));
+  }
+
+  // Batched
+  {
+    const std::function<Eigen::VectorXd(
+      const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> &)>
+      sdf_batch = [&](
+        const Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> & P)
+    {
+      return ((P.rowwise()-center).rowwise().norm().array()-r).matrix().eval();
+    };
+    Eigen::Matrix<double,Eigen::Dynamic,3> bV;
+    Eigen::Matrix<int,Eigen::Dynamic,3> bF;
+    igl::sparse_voxel_marching_cubes<true>(origin,h0,depth,sdf_batch,ijk,bV,bF);
+    test_common::assert_eq(bF,F);
+    test_common::assert_near(bV,V,1e-14);
+  }
+}
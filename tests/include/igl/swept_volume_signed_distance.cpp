@@ -0,0 +1,81 @@
+#include <test_common.h>
+#include <igl/swept_volume_signed_distance.h>
+#include <igl/voxel_grid.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/ThreadPool.h>
+
+TEST_CASE("swept_volume_signed_distance: capsule", "[igl]")
+{
+  // Sphere swept along a segment is a capsule
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,3);
+  const double r = 0.2;
+  V.rowwise().normalize();
+  V *= r;
+  const Eigen::Vector3d a(-0.5,0,0), b(0.5,0.1,0);
+  const std::function<Eigen::Affine3d(const double)> transform =
+    [&](const double t)
+  {
+    Eigen::Affine3d A = Eigen::Affine3d::Identity();
+    A.translate(a+t*(b-a));
+    return A;
+  };
+  const auto capsule = [&](const Eigen::RowVector3d & p)
+  {
+    const Eigen::Vector3d q = p.transpose();
+    const double t = std::clamp((q-a).dot(b-a)/(b-a).squaredNorm(),0.0,1.0);
+    return (q-(a+t*(b-a))).norm()-r;
+  };
+  Eigen::MatrixXd GV;
+  Eigen::RowVector3i res;
+  igl::voxel_grid(
+    Eigen::AlignedBox3d(Eigen::Vector3d(-0.8,-0.3,-0.3),Eigen::Vector3d(0.8,0.4,0.3)),
+    40,1,GV,res);
+  const double h = (GV.row(1)-GV.row(0)).norm();
+  for(const size_t steps : {0,50})
+  {
+    Eigen::VectorXd S;
+    igl::swept_volume_signed_distance(V,F,transform,steps,GV,res,h,0.0,S);
+    REQUIRE(S.size() == GV.rows());
+    for(int g = 0;g<GV.rows();g++)
+    {
+      const double d = capsule(GV.row(g));
+      // Accurate near the surface, correct sign elsewhere
+      if(std::abs(d) < h)
+      {
+        REQUIRE(S(g) == Approx(d).margin(0.2*h));
+      }else
+      {
+        REQUIRE((S(g) < 0) == (d < 0));
+      }
+    }
+
+    // Same values on any number of threads
+    igl::ThreadPool & pool = igl::default_thread_pool();
+    const unsigned int prev = pool.num_threads();
+    pool.resize(4);
+    Eigen::VectorXd S4;
+    igl::swept_volume_signed_distance(V,F,transform,steps,GV,res,h,0.0,S4);
+    pool.resize(prev);
+    REQUIRE(S4 == S);
+
+    // A single z-slice (zero grid step along z) agrees near the surface
+    const int k = res(2)/2;
+    const Eigen::Index nxy = Eigen::Index(res(0))*res(1);
+    const Eigen::MatrixXd GV1 = GV.middleRows(k*nxy,nxy);
+    const Eigen::RowVector3i res1(res(0),res(1),1);
+    Eigen::VectorXd S1;
+    igl::swept_volume_signed_distance(V,F,transform,steps,GV1,res1,h,0.0,S1);
+    REQUIRE(S1.size() == nxy);
+    for(Eigen::Index g = 0;g<nxy;g++)
+    {
+      if(std::abs(S(k*nxy+g)) < h)
+      {
+        REQUIRE(S1(g) == S(k*nxy+g));
+      }
+    }
+  }
+}